@@ -217,6 +217,6 @@ GPIO_ErrorStatus_t GPIO_getPinValue(void* GPIO_Port, u8 GPIO_pin, u8* GPIO_State
  *   - It accepts the GPIO port base address, pin number, and the alternate function value.
  *   - If the pin number is greater than 7, it configures the alternate function in AFRH register, otherwise in AFRL register.
  *****************************************************/
-GPIO_ErrorStatus_t GPIO_CfgAlternateFn(void* GPIO_Port, u32 GPIO_Pin, u32 GPIO_AF)
+GPIO_ErrorStatus_t GPIO_CfgAlternateFn(void* GPIO_Port, u32 GPIO_Pin, u32 GPIO_AF);
 
 #endif /* GPIO_H_ */
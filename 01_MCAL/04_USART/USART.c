@@ -15,6 +15,13 @@
 /********************************************************************************************************/
 #include "MCAL/USART/USART.h"
 #include "MCAL/USART/USART_Cfg.h"
+#include "MCAL/GPIO/GPIO.h"
+#include "MCAL/DWT/DWT.h"
+#include "MCAL/DMA/DMA.h"
+#include "MCAL/ICU/ICU.h"
+#ifdef HOST_BUILD
+#include "MCAL/USART/USART_Port.h"
+#endif
 
 /********************************************************************************************************/
 /************************************************Defines*************************************************/
@@ -23,18 +30,74 @@
 #define USART1_BASE_ADDR                0x40011000
 #define USART2_BASE_ADDR                0x40004400
 #define USART6_BASE_ADDR                0x40011400      
-#define USART_OVERSAMPLING_BIT          15
-#define USART_FRACTION_OVERFLOW_LIMIT   0x10
+#define USART_CR1_OVER8                 0x00008000
+#define USART_CR1_M                     0x00001000
+#define USART_CR1_PCE                   0x00000400
+#define USART_CR1_WAKE                  0x00000800
+#define USART_CR1_RWU_BIT               1
+#define USART_CR2_ADD_MASK              0x0000000F
 #define USART_ENABLE                    0x00002000
-#define USART_MAX_BAUDRATE              10500000
 #define USART_TX_ENABLE                 0x00000008
 #define USART_RX_ENABLE                 0x00000004
 #define USART_SR_TXE_MASK               0x00000080
 #define USART_SR_RXNE_MASK              0x00000020
+#define USART_SR_ORE_MASK               0x00000008
+#define USART_SR_IDLE_MASK              0x00000010
+#define USART_SR_ERRORS_MASK            0x0000000F      /*PE, FE, NE and ORE, same bits as USART_ERROR_x*/
+#define USART_IDLEIE_ENABLE             0x00000010
 #define USART_TXEIE_ENABLE              0x00000080
-#define USART_RXNEIE_ENABLE             0x00000004
-#define USART_TX_DONE_IRQ               0x00000080
-#define USART_RX_DONE_IRQ               0x00000020
+#define USART_RXNEIE_ENABLE             0x00000020
+#define USART_PEIE_ENABLE               0x00000100
+#define USART_CR3_EIE                   0x00000001
+#define USART_SR_TC_MASK                0x00000040
+#define USART_TCIE_ENABLE               0x00000040
+#define USART_CR3_DMAR                  0x00000040
+#define USART_CR3_DMAT                  0x00000080
+#define USART_CR1_OFFSET                0x0000000C
+#define USART_CR3_OFFSET                0x00000014
+#define USART_CR3_EIE_BIT               0
+#define USART_CR3_DMAR_BIT              6
+#define USART_MAX_DMA_CANDIDATES        2
+#define USART_TXEIE_BIT                 7
+#define USART_RXNEIE_BIT                5
+#define USART_RE_BIT                    2
+#define USART_PEIE_BIT                  8
+#define USART_IDLEIE_BIT                4
+#define USART_AUTOBAUD_EDGES            (USART_AUTOBAUD_BITS + 1)       /*Start bit falling edge included*/
+#define USART_AUTOBAUD_MAX_SPAN         (0xFFFFFFFFUL / USART_AUTOBAUD_BITS)
+#define USART_CR3_FLOW_MASK             (USART_FLOW_CONTROL_RTS | USART_FLOW_CONTROL_CTS)
+#define PERIPH_BASE_ADDR                0x40000000
+#define PERIPH_BITBAND_BASE_ADDR        0x42000000
+#define USART_TX_QUEUE_MASK             (USART_TX_QUEUE_SIZE - 1)
+#define USART_RX_RING_MASK              (USART_RX_RING_SIZE - 1)
+
+#if (USART_TX_QUEUE_SIZE == 0) || ((USART_TX_QUEUE_SIZE & USART_TX_QUEUE_MASK) != 0)
+#error "USART_TX_QUEUE_SIZE must be a power of two"
+#endif
+
+#if (USART_RX_RING_SIZE == 0) || ((USART_RX_RING_SIZE & USART_RX_RING_MASK) != 0) || (USART_RX_RING_SIZE > 0x8000)
+#error "USART_RX_RING_SIZE must be a power of two up to 32768"
+#endif
+
+#if (USART_RX_RTS_RESUME_LEVEL >= USART_RX_RING_SIZE)
+#error "USART_RX_RTS_RESUME_LEVEL must be below USART_RX_RING_SIZE"
+#endif
+
+/*Data and status register accesses: the host build hands them to the register access port (USART_Port.h),
+  implemented by a peripheral model with the side effects a plain memory block can't have*/
+#ifdef HOST_BUILD
+#define USART_READ_SR(NUMBER)           USART_Port_readSR(NUMBER)
+#define USART_READ_DR(NUMBER)           USART_Port_readDR(NUMBER)
+#define USART_WRITE_DR(NUMBER, VALUE)   USART_Port_writeDR((NUMBER), (VALUE))
+#else
+#define USART_READ_SR(NUMBER)           (USART[NUMBER]->SR)
+#define USART_READ_DR(NUMBER)           (USART[NUMBER]->DR)
+#define USART_WRITE_DR(NUMBER, VALUE)   (USART[NUMBER]->DR = (VALUE))
+#endif
+
+/*Bit-band alias of a peripheral register bit: setting it is a single store, so it can't undo a CR1 update
+  done by the interrupt between the read and the write of a read-modify-write*/
+#define PERIPH_BITBAND(ADDR, BIT)       (*(volatile u32*)(PERIPH_BITBAND_BASE_ADDR + (((ADDR) - PERIPH_BASE_ADDR) * 32) + ((BIT) * 4)))
 /********************************************************************************************************/
 /************************************************Types***************************************************/
 /********************************************************************************************************/
@@ -61,338 +124,1858 @@ typedef enum{
     Req_state_Busy
 }Req_State_t;
 
+/*Consumer of the running transmit request, only that path completes it and takes the next queued one*/
+typedef enum{
+    Tx_mode_Interrupt,
+    Tx_mode_Dma
+}Tx_Mode_t;
+
 typedef struct
 {
     buffer_t buffer;
     Req_State_t state;
-    CallBack_t CallBack;
+    volatile Tx_Mode_t mode;
+    USART_CallBack_t CallBack;
+    USART_CallBack_t HalfCallBack;
+    void* Context;
+    u32 transferred;                    /*Bytes of the gather list segments already sent*/
+    const USART_Segment_t* segments;    /*Gather list segments still to send after the current buffer*/
+    u8 segmentsLeft;
 }Tx_Req_t;
 
 typedef struct
 {
     buffer_t buffer;
     Req_State_t state;
-    CallBack_t CallBack;
+    USART_CallBack_t CallBack;
+    USART_CallBack_t HalfCallBack;
+    void* Context;
+    boolean frame;
+    u8 errors;
 }Rx_Req_t;
 
+typedef struct
+{
+    u8 *data;
+    u16 length;
+    USART_CallBack_t CallBack;
+    USART_CallBack_t HalfCallBack;
+    void* Context;
+    const USART_Segment_t* segments;
+    u8 segmentsLeft;
+}Tx_Descriptor_t;
+
+typedef struct
+{
+    u8 controller;
+    u8 stream;
+    u8 channel;
+}USART_DmaStream_t;
+
+/*Streams a USART request is mapped to, tried in order by USART_init*/
+typedef struct
+{
+    u8 count;
+    USART_DmaStream_t streams[USART_MAX_DMA_CANDIDATES];
+}USART_DmaCandidates_t;
+
+typedef struct
+{
+    boolean allocated;
+    volatile boolean active;
+    USART_DmaStream_t link;
+}USART_DmaLink_t;
+
+/*Single producer (USART_sendBufferAsyncZC) single consumer (Tx interrupt) queue, head and tail are free
+  running and each one is written by one side only so no locking is needed*/
+typedef struct
+{
+    volatile Tx_Descriptor_t descriptors[USART_TX_QUEUE_SIZE];
+    volatile u32 head;
+    volatile u32 tail;
+}Tx_Queue_t;
+
+typedef struct
+{
+    USART_CallBack_t CallBack;
+    void* Context;
+}Error_Notify_t;
+
+/*RS-485 transceiver driver enable pin of a half duplex instance*/
+typedef struct
+{
+    void* port;
+    u8 pin;
+    u8 active;
+    u8 inactive;
+    boolean enabled;
+}Driver_Enable_t;
+
+/*Baud rate detection: the last USART_AUTOBAUD_EDGES edges of the RX line, slots in arrival order*/
+typedef struct
+{
+    volatile boolean armed;
+    u8 input;                           /*ICU input wired to the RX pin*/
+    u8 count;
+    u8 next;                            /*Slot of the next edge*/
+    u16 rising;                         /*Bit i set when the edge of slot i is a rising edge*/
+    u64 times[USART_AUTOBAUD_EDGES];
+    USART_CallBack_t CallBack;
+    void* Context;
+}Auto_Baud_t;
+
+/*Double buffered receive: the buffer being filled and the buffers the consumer holds*/
+typedef struct
+{
+    u8* buffers[2];
+    u16 length;
+    u16 pos;                            /*Fill level of the current buffer, interrupt variant*/
+    volatile u8 current;
+    volatile boolean held[2];           /*Handed to the consumer and not released yet*/
+    volatile boolean enabled;
+    volatile boolean paused;            /*Current buffer full and the other one held, the bytes are dropped*/
+    boolean gap;                        /*Bytes were dropped since the last buffer handed over*/
+    u8 errors;                          /*Line errors of the current buffer*/
+    USART_CallBack_t CallBack;
+    void* Context;
+}Rx_DoubleBuffer_t;
+
+/*Continuous receive ring: head is written by the Rx interrupt only, tail by USART_read only*/
+typedef struct
+{
+    volatile u8 buffer[USART_RX_RING_SIZE];
+    volatile u32 head;
+    volatile u32 tail;
+    volatile boolean enabled;
+    volatile boolean paused;    /*Full ring with RTS: the next byte is left in DR so the hardware holds RTS*/
+}Rx_Ring_t;
+
+/*Context a handle points to, only handed out by USART_getHandle for a configuration USART_init accepted*/
+struct USART_Instance
+{
+    u8 USART_Number;
+    Tx_Queue_t* TxQueue;
+    Rx_Ring_t* RxRing;
+};
+
 /********************************************************************************************************/
 /************************************************Variables***********************************************/
 /********************************************************************************************************/
+#if defined(TEST) || defined(HOST_BUILD)
+USART_Registers_t USART_MockRegisters[NUMBER_OF_USART_INSTANCE];
+static USART_Registers_t* const USART[NUMBER_OF_USART_INSTANCE] = {&USART_MockRegisters[USART_NUMBER_1],
+                                                                   &USART_MockRegisters[USART_NUMBER_2],
+                                                                   &USART_MockRegisters[USART_NUMBER_6]};
+#else
 static USART_Registers_t* const USART[NUMBER_OF_USART_INSTANCE] = {(USART_Registers_t*)USART1_BASE_ADDR,
                                                                    (USART_Registers_t*)USART2_BASE_ADDR,
                                                                    (USART_Registers_t*)USART6_BASE_ADDR};
+#endif
+static const u32 USART_BaseAddress[NUMBER_OF_USART_INSTANCE] = {USART1_BASE_ADDR, USART2_BASE_ADDR, USART6_BASE_ADDR};
 
 extern const USART_Cfg_t USART_Cfg[_USART_Num];
 Tx_Req_t Tx_Req[NUMBER_OF_USART_INSTANCE] = {0};
 Rx_Req_t Rx_Req[NUMBER_OF_USART_INSTANCE] = {0};
+static Tx_Queue_t Tx_Queue[NUMBER_OF_USART_INSTANCE];
+static Rx_Ring_t Rx_Ring[NUMBER_OF_USART_INSTANCE];
+static volatile USART_RxStats_t Rx_Stats[NUMBER_OF_USART_INSTANCE];
+static Error_Notify_t Error_Notify[NUMBER_OF_USART_INSTANCE];
+static u32 Flow_Control[NUMBER_OF_USART_INSTANCE];
+static Driver_Enable_t Driver_Enable[NUMBER_OF_USART_INSTANCE];
+static Auto_Baud_t Auto_Baud[NUMBER_OF_USART_INSTANCE];
+static Rx_DoubleBuffer_t Rx_DoubleBuffer[NUMBER_OF_USART_INSTANCE];
+static const u32 USART_FlowAF[NUMBER_OF_USART_INSTANCE] = {GPIO_FUNC_AF7, GPIO_FUNC_AF7, GPIO_FUNC_AF8};
+static USART_DmaLink_t Tx_Dma[NUMBER_OF_USART_INSTANCE];
+static USART_DmaLink_t Rx_Dma[NUMBER_OF_USART_INSTANCE];
+static const struct USART_Instance USART_Instances[NUMBER_OF_USART_INSTANCE] = {
+    [USART_NUMBER_1] = {USART_NUMBER_1, &Tx_Queue[USART_NUMBER_1], &Rx_Ring[USART_NUMBER_1]},
+    [USART_NUMBER_2] = {USART_NUMBER_2, &Tx_Queue[USART_NUMBER_2], &Rx_Ring[USART_NUMBER_2]},
+    [USART_NUMBER_6] = {USART_NUMBER_6, &Tx_Queue[USART_NUMBER_6], &Rx_Ring[USART_NUMBER_6]}
+};
+/*Handle of each configuration entry, NULL_PTR until USART_init accepts it*/
+static USART_Handle_t USART_Handles[_USART_Num];
+
+_Static_assert(_USART_Num <= NUMBER_OF_USART_INSTANCE, "USART_Cfg has more entries than USART instances");
+
+static const USART_DmaCandidates_t USART_TxDmaCandidates[NUMBER_OF_USART_INSTANCE] = {
+    [USART_NUMBER_1] = {1, {{DMA_CONTROLLER_2, DMA_STREAM_7, DMA_CHANNEL_4}}},
+    [USART_NUMBER_2] = {1, {{DMA_CONTROLLER_1, DMA_STREAM_6, DMA_CHANNEL_4}}},
+    [USART_NUMBER_6] = {2, {{DMA_CONTROLLER_2, DMA_STREAM_6, DMA_CHANNEL_5}, {DMA_CONTROLLER_2, DMA_STREAM_7, DMA_CHANNEL_5}}}
+};
+
+static const USART_DmaCandidates_t USART_RxDmaCandidates[NUMBER_OF_USART_INSTANCE] = {
+    [USART_NUMBER_1] = {2, {{DMA_CONTROLLER_2, DMA_STREAM_2, DMA_CHANNEL_4}, {DMA_CONTROLLER_2, DMA_STREAM_5, DMA_CHANNEL_4}}},
+    [USART_NUMBER_2] = {1, {{DMA_CONTROLLER_1, DMA_STREAM_5, DMA_CHANNEL_4}}},
+    [USART_NUMBER_6] = {2, {{DMA_CONTROLLER_2, DMA_STREAM_1, DMA_CHANNEL_5}, {DMA_CONTROLLER_2, DMA_STREAM_2, DMA_CHANNEL_5}}}
+};
 
 /********************************************************************************************************/
-/*********************************************APIs Implementation****************************************/
+/*********************************************Static Functions*******************************************/
 /********************************************************************************************************/
+/*Sets a CR1 interrupt enable bit from the thread context without a read-modify-write the interrupt could undo*/
+static void USART_setCR1Bit(u8 USART_Number, u8 Bit)
+{
+#if defined(TEST) || defined(HOST_BUILD)
+    (void)USART_BaseAddress;
+    USART[USART_Number]->CR1 |= (1UL << Bit);
+#else
+    PERIPH_BITBAND(USART_BaseAddress[USART_Number] + USART_CR1_OFFSET, Bit) = 1;
+#endif
+}
 
-USART_ErrorStatus_t USART_init(void)
+static void USART_clearCR1Bit(u8 USART_Number, u8 Bit)
 {
-    USART_ErrorStatus_t ErrorStatus = USART_OK;
-    u8 idx = 0;
-    u32 USARTDIV_value = 0;
-    u8 overSampling_value = 0;
-    u32 Mantissa = 0;
-    u16 Fraction = 0;
-    u32 BRR_value = 0; 
-    u32 CR1_value = 0;
-    u32 CR2_value = 0;
-    for(idx = 0; idx < _USART_Num; idx++)
-    {
-        if(USART_Cfg[idx].USART_Number > NUMBER_OF_USART_INSTANCE)
-        {
-            ErrorStatus = USART_InvalidNumber;
-        }
-        else if(USART_Cfg[idx].USART_BaudRate > USART_MAX_BAUDRATE)
-        {
-            ErrorStatus = USART_InvalidBaudRate;
-        }
-        else
-        {
-            overSampling_value = ((USART_Cfg[idx].USART_OverSampling) >> USART_OVERSAMPLING_BIT);
-            USARTDIV_value = ((u64)USART_CLK * 1000)/((8 * (2 - overSampling_value) * (USART_Cfg[idx].USART_BaudRate)));
-            Mantissa = USARTDIV_value/1000;
-            Fraction = (USARTDIV_value % 1000) * (8 * (2 - overSampling_value));
-            if((Fraction % 1000)  >= 500)
-            {
-                Fraction = ( Fraction / 1000 ) + 1;
-            }
-            else
-            {
-                Fraction = Fraction / 1000;
-            }
-            if(Fraction >= USART_FRACTION_OVERFLOW_LIMIT)
-            {
-                Mantissa += Fraction & 0xF0;
-            }
-            BRR_value = (Mantissa << 4U) | (Fraction & 0x0F);
-            USART[USART_Cfg[idx].USART_Number]->BRR = BRR_value;
+#if defined(TEST) || defined(HOST_BUILD)
+    USART[USART_Number]->CR1 &= ~(1UL << Bit);
+#else
+    PERIPH_BITBAND(USART_BaseAddress[USART_Number] + USART_CR1_OFFSET, Bit) = 0;
+#endif
+}
 
-            CR1_value = (USART_Cfg[idx].USART_OverSampling) | USART_ENABLE | (USART_Cfg[idx].USART_WordLen)\
-                        |(USART_Cfg[idx].USART_ParityControl) | (USART_Cfg[idx].USART_ParitySelection);
-            USART[USART_Cfg[idx].USART_Number]->CR1 = CR1_value;
+/*Same for the CR3 error interrupt and DMA request bits, the Tx DMA path and the error handling change CR3 too*/
+static void USART_setCR3Bit(u8 USART_Number, u8 Bit)
+{
+#if defined(TEST) || defined(HOST_BUILD)
+    USART[USART_Number]->CR3 |= (1UL << Bit);
+#else
+    PERIPH_BITBAND(USART_BaseAddress[USART_Number] + USART_CR3_OFFSET, Bit) = 1;
+#endif
+}
 
-            CR2_value = USART_Cfg[idx].USART_StopBits;
-            USART[USART_Cfg[idx].USART_Number]->CR2 = CR2_value;
+static void USART_clearCR3Bit(u8 USART_Number, u8 Bit)
+{
+#if defined(TEST) || defined(HOST_BUILD)
+    USART[USART_Number]->CR3 &= ~(1UL << Bit);
+#else
+    PERIPH_BITBAND(USART_BaseAddress[USART_Number] + USART_CR3_OFFSET, Bit) = 0;
+#endif
+}
 
-            }        
+static void USART_enableTxInterrupt(u8 USART_Number)
+{
+    USART_setCR1Bit(USART_Number, USART_TXEIE_BIT);
+}
+
+/*Posts a buffer to the transmit queue, USART_Busy when it's full*/
+static USART_ErrorStatus_t USART_queueTx(u8 USART_Number, Tx_Queue_t* Queue, u8* Data, u16 Length,
+                                         USART_CallBack_t CB, USART_CallBack_t HalfCB, void* Context)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    const u32 head = Queue->head;
+    if((head - Queue->tail) >= USART_TX_QUEUE_SIZE)
+    {
+        ErrorStatus = USART_Busy;
+    }
+    else
+    {
+        Queue->descriptors[head & USART_TX_QUEUE_MASK].data = Data;
+        Queue->descriptors[head & USART_TX_QUEUE_MASK].length = Length;
+        Queue->descriptors[head & USART_TX_QUEUE_MASK].CallBack = CB;
+        Queue->descriptors[head & USART_TX_QUEUE_MASK].HalfCallBack = HalfCB;
+        Queue->descriptors[head & USART_TX_QUEUE_MASK].Context = Context;
+        Queue->descriptors[head & USART_TX_QUEUE_MASK].segments = NULL_PTR;
+        Queue->descriptors[head & USART_TX_QUEUE_MASK].segmentsLeft = 0;
+        Queue->head = head + 1;     /*Publish the descriptor after it's complete*/
+        /*TXE is set while the transmitter is idle, so the interrupt starts the first request immediately*/
+        USART_enableTxInterrupt(USART_Number);
     }
     return ErrorStatus;
 }
 
+/*Gives Length slots of the continuous receive ring back to the interrupt once their bytes are taken*/
+static void USART_releaseRing(u8 USART_Number, Rx_Ring_t* Ring, u16 Length)
+{
+    Ring->tail += Length;
+    if((Ring->paused == TRUE) && ((Ring->head - Ring->tail) <= USART_RX_RTS_RESUME_LEVEL))
+    {
+        /*The interrupt takes the byte waiting in DR, which lets the hardware assert RTS again*/
+        Ring->paused = FALSE;
+        USART_setCR1Bit(USART_Number, USART_RXNEIE_BIT);
+    }
+}
 
-USART_ErrorStatus_t USART_sendByte(USART_Req_t USART_Req)
+/*Copies up to Length bytes out of the continuous receive ring, returns how many*/
+static u16 USART_readRing(u8 USART_Number, Rx_Ring_t* Ring, u8* Data, u16 Length)
 {
-    USART_ErrorStatus_t ErrorStatus = USART_OK;
-    volatile u16 timeOut = 3000;
-    if(USART_Req.data == NULL_PTR)
+    const u32 tail = Ring->tail;
+    u32 available = Ring->head - tail;
+    u16 idx = 0;
+    if(available > Length)
     {
-        ErrorStatus = USART_NullPtr;
+        available = Length;
     }
-    else if(USART_Req.USART_Number > _USART_Num)
+    for(idx = 0; idx < available; idx++)
     {
-        ErrorStatus = USART_InvalidNumber;
+        Data[idx] = Ring->buffer[(tail + idx) & USART_RX_RING_MASK];
     }
-    else if (Tx_Req[USART_Req.USART_Number].state == Req_state_Busy)
+    USART_releaseRing(USART_Number, Ring, (u16)available);     /*Release the slots after they're copied*/
+    return (u16)available;
+}
+
+/*Checks a configuration entry field by field, Configured has a bit set for each instance taken already*/
+static USART_ErrorStatus_t USART_checkCfg(const USART_Cfg_t* Cfg, u32 Configured)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if(Cfg->USART_Number >= NUMBER_OF_USART_INSTANCE)
     {
-        ErrorStatus = USART_Busy;
+        ErrorStatus = USART_InvalidNumber;
     }
-    else
+    else if((Configured & (1UL << Cfg->USART_Number)) ||
+            ((Cfg->USART_WordLen != USART_WORD_LEN_8) && (Cfg->USART_WordLen != USART_WORD_LEN_9)) ||
+            ((Cfg->USART_OverSampling != USART_OVERSAMPLING_16) && (Cfg->USART_OverSampling != USART_OVERSAMPLING_8)) ||
+            ((Cfg->USART_ParityControl != USART_PARITY_CONTROL_DISABLE) && (Cfg->USART_ParityControl != USART_PARITY_CONTROL_ENABLE)) ||
+            ((Cfg->USART_ParitySelection != USART_PARITY_EVEN) && (Cfg->USART_ParitySelection != USART_PARITY_ODD)) ||
+            ((Cfg->USART_StopBits & ~USART_STOP_BITS_1_HALF) != 0) ||
+            ((Cfg->USART_FlowControl & ~USART_FLOW_CONTROL_RTS_CTS) != 0) ||
+            ((Cfg->USART_Wakeup != USART_WAKEUP_IDLE_LINE) && (Cfg->USART_Wakeup != USART_WAKEUP_ADDRESS_MARK)) ||
+            (Cfg->USART_Address > USART_ADDRESS_MAX))
     {
-        Tx_Req[USART_Req.USART_Number].state = Req_state_Busy;
-        USART[USART_Req.USART_Number]->DR = *(USART_Req.data);
-        USART[USART_Req.USART_Number]->CR1 |= USART_TX_ENABLE;
-        while (timeOut)
-        {
-            timeOut--;
-        }
-        
-        USART[USART_Req.USART_Number]->CR1 &= ~USART_TX_ENABLE; /*Disable Transmitting After Sending the Data*/
-        Tx_Req[USART_Req.USART_Number].state = Req_state_Idle;
+        /*Two entries for one instance or a field outside its USART_x values*/
+        ErrorStatus = USART_InvalidConfig;
     }
     return ErrorStatus;
 }
 
-USART_ErrorStatus_t USART_recieveByte(USART_Req_t USART_Req)
+static void USART_cfgFlowPin(u8 USART_Number, void* Port, u32 Pin, u32 Mode)
 {
-    USART_ErrorStatus_t ErrorStatus = USART_OK;
-    volatile u16 timeOut = 3000;
-    if((USART_Req.data == NULL_PTR))
+    GPIO_Pin_t FlowPin;
+    FlowPin.GPIO_Port = Port;
+    FlowPin.GPIO_Pin = Pin;
+    FlowPin.GPIO_Mode = Mode;
+    FlowPin.GPIO_Speed = GPIO_SPEED_HIGH;
+    GPIO_Init(&FlowPin);
+    GPIO_CfgAlternateFn(Port, Pin, USART_FlowAF[USART_Number]);
+}
+
+/*Drives the transceiver onto the bus, a no-op for full duplex instances*/
+static void USART_assertDe(u8 USART_Number)
+{
+    if(Driver_Enable[USART_Number].enabled == TRUE)
     {
-        ErrorStatus = USART_NullPtr;
+        GPIO_setPinValue(Driver_Enable[USART_Number].port, Driver_Enable[USART_Number].pin, Driver_Enable[USART_Number].active);
     }
-    else if(USART_Req.USART_Number > _USART_Num)
+}
+
+static void USART_releaseDe(u8 USART_Number)
+{
+    if(Driver_Enable[USART_Number].enabled == TRUE)
     {
-        ErrorStatus = USART_InvalidNumber;
+        GPIO_setPinValue(Driver_Enable[USART_Number].port, Driver_Enable[USART_Number].pin, Driver_Enable[USART_Number].inactive);
     }
-    else if (Rx_Req[USART_Req.USART_Number].state == Req_state_Busy)
+}
+
+/*The pin is preset inactive before it becomes an output so the transceiver never grabs the bus at startup*/
+static void USART_cfgDePin(u8 USART_Number, const USART_Cfg_t* Cfg)
+{
+    GPIO_Pin_t DePin;
+    Driver_Enable[USART_Number].port = Cfg->USART_DePort;
+    Driver_Enable[USART_Number].pin = (u8)Cfg->USART_DePin;
+    Driver_Enable[USART_Number].active = (Cfg->USART_DeActiveLow == TRUE) ? GPIO_STATE_RESET : GPIO_STATE_SET;
+    Driver_Enable[USART_Number].inactive = (Cfg->USART_DeActiveLow == TRUE) ? GPIO_STATE_SET : GPIO_STATE_RESET;
+    Driver_Enable[USART_Number].enabled = TRUE;
+    USART_releaseDe(USART_Number);
+    DePin.GPIO_Port = Cfg->USART_DePort;
+    DePin.GPIO_Pin = Cfg->USART_DePin;
+    DePin.GPIO_Mode = GPIO_MODE_OUT_PP;
+    DePin.GPIO_Speed = GPIO_SPEED_HIGH;
+    GPIO_Init(&DePin);
+}
+
+/*A half duplex instance releases the bus on TC, once the last stop bit has left the shift register*/
+static void USART_waitTxComplete(u8 USART_Number)
+{
+    if(Driver_Enable[USART_Number].enabled == TRUE)
     {
-        ErrorStatus = USART_Busy;
+        USART[USART_Number]->CR1 |= USART_TCIE_ENABLE;
     }
-    else
+}
+
+/*Most significant data bit of the configured frame: bit 8 of a 9 bit word, one lower for 8 bits or parity*/
+static u16 USART_addressMark(u8 USART_Number)
+{
+    u8 bit = (USART[USART_Number]->CR1 & USART_CR1_M) ? 8 : 7;
+    if(USART[USART_Number]->CR1 & USART_CR1_PCE)
     {
-        Rx_Req[USART_Req.USART_Number].state = Req_state_Busy;
-        USART[USART_Req.USART_Number]->CR1 |= USART_RX_ENABLE;
-        while (!(USART[USART_Req.USART_Number]->SR & USART_SR_RXNE_MASK) && timeOut)
+        bit--;
+    }
+    return (u16)(1U << bit);
+}
+
+/*Polls a status flag until it's set or the timeout (cycles since Start, wrap safe) elapses*/
+static boolean USART_waitFlag(u8 USART_Number, u32 Mask, u32 Start, u32 Timeout)
+{
+    boolean isSet = FALSE;
+    do
+    {
+        isSet = ((USART_READ_SR(USART_Number) & Mask) != 0) ? TRUE : FALSE;
+    }while((isSet == FALSE) && ((DWT_getCycles() - Start) < Timeout));
+    return isSet;
+}
+
+/*Sends Length bytes by polling, Mark is ORed into the first one (address character), returns once TC is set*/
+static USART_ErrorStatus_t USART_writeBlocking(u8 USART_Number, const u8* Data, u16 Length, u16 Mark, u32 TimeoutUS)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    const u32 start = DWT_getCycles();
+    const u32 timeout = DWT_US_TO_CYCLES(TimeoutUS);
+    u16 idx = 0;
+    USART_assertDe(USART_Number);
+    /*Each byte is written as soon as TXE frees DR, so the shift register never idles between bytes*/
+    for(idx = 0; (idx < Length) && (ErrorStatus == USART_OK); idx++)
+    {
+        if(USART_waitFlag(USART_Number, USART_SR_TXE_MASK, start, timeout) == TRUE)
         {
-            timeOut--;
+            USART_WRITE_DR(USART_Number, Data[idx] | ((idx == 0) ? Mark : 0));
         }
-
-        if(timeOut == 0)
+        else
         {
             ErrorStatus = USART_TimeOut;
         }
-        *(USART_Req.data) = USART[USART_Req.USART_Number]->DR;
-        USART[USART_Req.USART_Number]->CR1 |= ~USART_RX_ENABLE;
-        Rx_Req[USART_Req.USART_Number].state = Req_state_Idle; 
     }
+    /*Returns once the last stop bit is on the line*/
+    if((ErrorStatus == USART_OK) && (USART_waitFlag(USART_Number, USART_SR_TC_MASK, start, timeout) == FALSE))
+    {
+        ErrorStatus = USART_TimeOut;
+    }
+    USART_releaseDe(USART_Number);
     return ErrorStatus;
 }
 
-USART_ErrorStatus_t USART_sendBufferAsyncZC(USART_Req_t USART_Req)
+/*The receiver is always enabled: an overrun found when a receive starts means DR holds a byte from before
+  anyone listened, reading SR then DR drops it and clears ORE. A lone pending byte (held by RTS) is kept*/
+static void USART_discardStaleRx(u8 USART_Number)
 {
-    USART_ErrorStatus_t ErrorStatus = USART_OK;
-    if((USART_Req.data == NULL_PTR) || (USART_Req.CB == NULL_PTR))
+    if(USART_READ_SR(USART_Number) & USART_SR_ORE_MASK)
     {
-        ErrorStatus = USART_NullPtr;
+        (void)USART_READ_DR(USART_Number);
     }
-    else if(USART_Req.USART_Number > _USART_Num)
+}
+
+static void USART_allocDma(USART_DmaLink_t* Link, const USART_DmaCandidates_t* Candidates)
+{
+    u8 idx = 0;
+    for(idx = 0; (idx < Candidates->count) && (Link->allocated == FALSE); idx++)
     {
-        ErrorStatus = USART_InvalidNumber;
+        if(DMA_allocStream(Candidates->streams[idx].controller, Candidates->streams[idx].stream) == DMA_OK)
+        {
+            Link->link = Candidates->streams[idx];
+            Link->allocated = TRUE;
+        }
     }
-    else if (Tx_Req[USART_Req.USART_Number].state == Req_state_Busy)
+}
+
+static DMA_ErrorStatus_t USART_startDma(u8 USART_Number, USART_DmaLink_t* Link, u32 Direction, u8* Data, u16 Length,
+                                        DMA_CallBack_t CallBack)
+{
+    DMA_Transfer_t Transfer = {
+        .DMA_Controller = Link->link.controller,
+        .DMA_Stream = Link->link.stream,
+        .DMA_Channel = Link->link.channel,
+        .DMA_Direction = Direction,
+        .DMA_DataSize = DMA_SIZE_BYTE,
+        .DMA_Mode = DMA_MODE_NORMAL,
+        .DMA_Priority = DMA_PRIORITY_HIGH,
+        .DMA_PeriphAddress = (u32)&USART[USART_Number]->DR,
+        .DMA_MemAddress = (u32)Data,
+        .DMA_Count = Length,
+        .CB = CallBack,
+        .Context = (void*)&USART[USART_Number]
+    };
+    DMA_ErrorStatus_t ErrorStatus = DMA_startTransfer(&Transfer);
+    Link->active = (ErrorStatus == DMA_OK) ? TRUE : FALSE;
+    return ErrorStatus;
+}
+
+/*The DMA context points at the instance entry of USART[]*/
+static u8 USART_numberFromContext(void* Context)
+{
+    return (u8)((USART_Registers_t* const*)Context - USART);
+}
+
+/*Builds the completion record on the stack, the callback must copy what it needs to keep*/
+static void USART_notify(USART_CallBack_t CallBack, u8 USART_Number, u8 Event, u32 Length, u8 Errors, void* Context)
+{
+    USART_Completion_t Completion;
+    if(CallBack != NULL_PTR)
     {
-        ErrorStatus = USART_Busy;
-    }
-    else
-    { 
-        Tx_Req[USART_Req.USART_Number].buffer.data = USART_Req.data;
-        Tx_Req[USART_Req.USART_Number].buffer.pos = 0;
-        Tx_Req[USART_Req.USART_Number].buffer.size = USART_Req.length;
-        Tx_Req[USART_Req.USART_Number].CallBack = USART_Req.CB;
-        Tx_Req[USART_Req.USART_Number].state = Req_state_Busy;
-
-        USART[USART_Req.USART_Number]->CR1 |= USART_TX_ENABLE;
-        /*Sending First Byte To Enter Interrupt Then Continue Sending in the Hanlder*/
-        USART[USART_Req.USART_Number]->DR = Tx_Req[USART_Req.USART_Number].buffer.data[0];
-        Tx_Req[USART_Req.USART_Number].buffer.pos++;
-        USART[USART_Req.USART_Number]->CR1 |= USART_TXEIE_ENABLE;   /*Enable Tx Interrupts*/
+        Completion.USART_Number = USART_Number;
+        Completion.event = Event;
+        Completion.errors = Errors;
+        Completion.length = (u16)Length;
+        Completion.Context = Context;
+        Completion.data = NULL_PTR;
+        CallBack(&Completion);
     }
-    return ErrorStatus;
 }
 
-USART_ErrorStatus_t USART_recieveBufferAsyncZC(USART_Req_t USART_Req)
+/*
+ * Start bit to stop bit span of the window in ICU ticks if it holds a sync character: the earliest edge falls
+ * and edge k after it is a rising edge for odd k, within a quarter bit of k bit times (span * k / BITS).
+ * Multiplications only, it runs in the ICU interrupt for each edge of the sync character.
+ */
+static u32 USART_autoBaudSpan(const Auto_Baud_t* Detect)
 {
-    USART_ErrorStatus_t ErrorStatus = USART_OK;
-    if((USART_Req.data == NULL_PTR) || (USART_Req.CB == NULL_PTR))
+    u32 offsets[USART_AUTOBAUD_EDGES];
+    u8 rising[USART_AUTOBAUD_EDGES];
+    u64 start = Detect->times[0];
+    u64 elapsed = 0;
+    u32 offset = 0;
+    u32 span = 0;
+    u32 scaled = 0;
+    u32 expected = 0;
+    u8 isRising = 0;
+    u8 idx = 0;
+    u8 pos = 0;
+    for(idx = 1; idx < USART_AUTOBAUD_EDGES; idx++)
     {
-        ErrorStatus = USART_NullPtr;
+        if(Detect->times[idx] < start)
+        {
+            start = Detect->times[idx];
+        }
     }
-    else if(USART_Req.USART_Number > _USART_Num)
+    /*Insertion sort, the slots are only out of order for edges reported by the same interrupt*/
+    for(idx = 0; idx < USART_AUTOBAUD_EDGES; idx++)
     {
-        ErrorStatus = USART_InvalidNumber;
+        elapsed = Detect->times[idx] - start;
+        offset = (elapsed > USART_AUTOBAUD_MAX_SPAN) ? USART_AUTOBAUD_MAX_SPAN : (u32)elapsed;
+        isRising = (u8)((Detect->rising >> idx) & 1U);
+        for(pos = idx; (pos > 0) && (offsets[pos - 1] > offset); pos--)
+        {
+            offsets[pos] = offsets[pos - 1];
+            rising[pos] = rising[pos - 1];
+        }
+        offsets[pos] = offset;
+        rising[pos] = isRising;
     }
-    else if (Rx_Req[USART_Req.USART_Number].state == Req_state_Busy)
+    span = offsets[USART_AUTOBAUD_BITS];
+    if((span >= USART_AUTOBAUD_MAX_SPAN) || (rising[0] != 0))
     {
-        ErrorStatus = USART_Busy;
+        span = 0;
     }
-    else
-    { 
-        Rx_Req[USART_Req.USART_Number].buffer.data = USART_Req.data;
-        Rx_Req[USART_Req.USART_Number].buffer.pos = 0;
-        Rx_Req[USART_Req.USART_Number].buffer.size = USART_Req.length;
-        Rx_Req[USART_Req.USART_Number].CallBack = USART_Req.CB;
-        Rx_Req[USART_Req.USART_Number].state = Req_state_Busy;
-
-        USART[USART_Req.USART_Number]->CR1 |= USART_RX_ENABLE;
-        USART[USART_Req.USART_Number]->CR1 |= USART_RXNEIE_ENABLE;   /*Enable Rx Interrupts*/
+    for(idx = 1; (idx <= USART_AUTOBAUD_BITS) && (span != 0); idx++)
+    {
+        scaled = offsets[idx] * USART_AUTOBAUD_BITS;
+        expected = idx * span;
+        if((((scaled > expected) ? (scaled - expected) : (expected - scaled)) > (span / 4)) || (rising[idx] != (idx & 1U)))
+        {
+            span = 0;
+        }
     }
-    return ErrorStatus; 
+    return span;
 }
 
-void USART1_IRQHandler(void)
+/*The edge callback of an ICU input is shared by the instances armed on it*/
+static boolean USART_autoBaudInputArmed(u8 ICU_Name)
 {
-    if((USART[USART_NUMBER_1]->SR) & USART_TX_DONE_IRQ)
+    boolean armed = FALSE;
+    u8 USART_Number = 0;
+    for(USART_Number = 0; USART_Number < NUMBER_OF_USART_INSTANCE; USART_Number++)
     {
-        if(Tx_Req[USART_NUMBER_1].buffer.pos < Tx_Req[USART_NUMBER_1].buffer.size)
-        {
-            USART[USART_NUMBER_1]->DR = Tx_Req[USART_NUMBER_1].buffer.data[Tx_Req[USART_NUMBER_1].buffer.pos];
-            Tx_Req[USART_NUMBER_1].buffer.pos++;
-        }
-        else
+        if((Auto_Baud[USART_Number].armed == TRUE) && (Auto_Baud[USART_Number].input == ICU_Name))
         {
-            USART[USART_NUMBER_1]->CR1 &= ~USART_TX_ENABLE;
-            USART[USART_NUMBER_1]->CR1 &= ~USART_TXEIE_ENABLE;   /*Disable Tx Interrupts*/
-            Tx_Req[USART_NUMBER_1].state = Req_state_Idle;
-            if(Tx_Req[USART_NUMBER_1].CallBack != NULL_PTR)
-            {
-                Tx_Req[USART_NUMBER_1].CallBack();
-            }
+            armed = TRUE;
         }
     }
+    return armed;
+}
 
-    if((USART[USART_NUMBER_1]->SR) & USART_RX_DONE_IRQ)
+/*ICU interrupt: slides the window of the armed instances over the edges, a sync character completes on its
+  stop bit edge (or on the edge before it when one interrupt reported both)*/
+static void USART_autoBaudEdge(u8 ICU_Name, const ICU_Edge_t* Edge)
+{
+    Auto_Baud_t* Detect = NULL_PTR;
+    u32 span = 0;
+    u32 baudRate = 0;
+    u8 USART_Number = 0;
+    for(USART_Number = 0; USART_Number < NUMBER_OF_USART_INSTANCE; USART_Number++)
     {
-        if(Rx_Req[USART_NUMBER_1].buffer.pos < Rx_Req[USART_NUMBER_1].buffer.size)
-        {
-            Rx_Req[USART_NUMBER_1].buffer.data[Rx_Req[USART_NUMBER_1].buffer.pos] = USART[USART_NUMBER_1]->DR;
-            Rx_Req[USART_NUMBER_1].buffer.pos++;
-        }
-        else
+        Detect = &Auto_Baud[USART_Number];
+        if((Detect->armed == TRUE) && (Detect->input == ICU_Name))
         {
-            USART[USART_NUMBER_1]->CR1 &= ~USART_RX_ENABLE;
-            USART[USART_NUMBER_1]->CR1 &= ~USART_RXNEIE_ENABLE;   /*Disable Rx Interrupts*/
-            Rx_Req[USART_NUMBER_1].state = Req_state_Idle;
-            if(Rx_Req[USART_NUMBER_1].CallBack != NULL_PTR)
+            Detect->times[Detect->next] = Edge->ICU_Timestamp;
+            Detect->rising &= (u16)~(1U << Detect->next);
+            Detect->rising |= (u16)(((Edge->ICU_Edge == ICU_EDGE_RISING) ? 1U : 0U) << Detect->next);
+            Detect->next = (Detect->next + 1) % USART_AUTOBAUD_EDGES;
+            if(Detect->count < USART_AUTOBAUD_EDGES)
             {
-                Rx_Req[USART_NUMBER_1].CallBack();
+                Detect->count++;
+            }
+            if(Detect->count == USART_AUTOBAUD_EDGES)
+            {
+                span = USART_autoBaudSpan(Detect);
+                if(span != 0)
+                {
+                    baudRate = (u32)((((u64)ICU_TICK_FREQUENCY * USART_AUTOBAUD_BITS) + (span / 2)) / span);
+                    if(USART_setBaudRate(USART_Number, baudRate) == USART_OK)
+                    {
+                        Detect->armed = FALSE;
+                        if(USART_autoBaudInputArmed(ICU_Name) == FALSE)
+                        {
+                            ICU_setEdgeCallBack(ICU_Name, NULL_PTR);
+                        }
+                        USART_setCR1Bit(USART_Number, USART_RE_BIT);
+                        USART_notify(Detect->CallBack, USART_Number, USART_EVENT_AUTOBAUD, 0, USART_ERROR_NONE, Detect->Context);
+                    }
+                }
             }
         }
     }
 }
 
-void USART2_IRQHandler(void)
+static void USART_txByte(u8 USART_Number)
+{
+    Tx_Req_t* const Req = &Tx_Req[USART_Number];
+    USART_WRITE_DR(USART_Number, Req->buffer.data[Req->buffer.pos]);
+    Req->buffer.pos++;
+    if((Req->HalfCallBack != NULL_PTR) && (Req->buffer.pos == (Req->buffer.size / 2)))
+    {
+        USART_notify(Req->HalfCallBack, USART_Number, USART_EVENT_HALF, Req->buffer.pos, USART_ERROR_NONE, Req->Context);
+    }
+}
+
+static void USART_TxDmaCallBack(u8 Event, void* Context);
+
+/*Starts sending the current buffer on the DMA stream or on the TXE interrupt*/
+static void USART_startTxBuffer(u8 USART_Number)
 {
-    if((USART[USART_NUMBER_2]->SR) & USART_TX_DONE_IRQ)
+    Tx_Req_t* const Req = &Tx_Req[USART_Number];
+    Req->mode = Tx_mode_Dma;    /*Before the start, the completion may come first*/
+    if((Tx_Dma[USART_Number].allocated == TRUE) &&
+       (USART_startDma(USART_Number, &Tx_Dma[USART_Number], DMA_DIR_MEM_TO_PERIPH, Req->buffer.data,
+                       (u16)Req->buffer.size, USART_TxDmaCallBack) == DMA_OK))
     {
-        if(Tx_Req[USART_NUMBER_2].buffer.pos < Tx_Req[USART_NUMBER_2].buffer.size)
+        /*The stream feeds DR from now on, TXE requests go to the DMA. The stream writes don't clear TC, it's
+          cleared here (rc_w0, the other flags ignore the ones) so the release waits for this buffer*/
+        if(Driver_Enable[USART_Number].enabled == TRUE)
         {
-            USART[USART_NUMBER_2]->DR = Tx_Req[USART_NUMBER_2].buffer.data[Tx_Req[USART_NUMBER_2].buffer.pos];
-            Tx_Req[USART_NUMBER_2].buffer.pos++;
+            USART[USART_Number]->SR = ~USART_SR_TC_MASK;
         }
-        else
+        USART[USART_Number]->CR1 &= ~USART_TXEIE_ENABLE;
+        USART[USART_Number]->CR3 |= USART_CR3_DMAT;
+    }
+    else
+    {
+        Req->mode = Tx_mode_Interrupt;
+        USART_txByte(USART_Number);
+        USART_enableTxInterrupt(USART_Number);
+    }
+}
+
+/*Moves a gather request to its next segment, returns FALSE once the last one is sent*/
+static boolean USART_loadNextSegment(u8 USART_Number)
+{
+    Tx_Req_t* const Req = &Tx_Req[USART_Number];
+    boolean loaded = FALSE;
+    if(Req->segmentsLeft > 0)
+    {
+        Req->transferred += Req->buffer.size;
+        Req->buffer.data = (u8*)Req->segments->data;
+        Req->buffer.size = Req->segments->length;
+        Req->buffer.pos = 0;
+        Req->segments++;
+        Req->segmentsLeft--;
+        loaded = TRUE;
+    }
+    return loaded;
+}
+
+/*Takes the next queued request and starts it on the DMA stream or on the TXE interrupt, returns FALSE if the
+  queue is empty*/
+static boolean USART_startNextTx(u8 USART_Number)
+{
+    Tx_Req_t* const Req = &Tx_Req[USART_Number];
+    Tx_Queue_t* const Queue = &Tx_Queue[USART_Number];
+    boolean started = FALSE;
+    u32 tail = Queue->tail;
+    if(tail != Queue->head)
+    {
+        Req->buffer.data = Queue->descriptors[tail & USART_TX_QUEUE_MASK].data;
+        Req->buffer.size = Queue->descriptors[tail & USART_TX_QUEUE_MASK].length;
+        Req->buffer.pos = 0;
+        Req->CallBack = Queue->descriptors[tail & USART_TX_QUEUE_MASK].CallBack;
+        Req->HalfCallBack = Queue->descriptors[tail & USART_TX_QUEUE_MASK].HalfCallBack;
+        Req->Context = Queue->descriptors[tail & USART_TX_QUEUE_MASK].Context;
+        Req->transferred = 0;
+        Req->segments = Queue->descriptors[tail & USART_TX_QUEUE_MASK].segments;
+        Req->segmentsLeft = Queue->descriptors[tail & USART_TX_QUEUE_MASK].segmentsLeft;
+        Queue->tail = tail + 1;
+        if(Req->state == Req_state_Idle)
         {
-            USART[USART_NUMBER_2]->CR1 &= ~USART_TX_ENABLE;
-            USART[USART_NUMBER_2]->CR1 &= ~USART_TXEIE_ENABLE;   /*Disable Tx Interrupts*/
-            Tx_Req[USART_NUMBER_2].state = Req_state_Idle;
-            if(Tx_Req[USART_NUMBER_2].CallBack != NULL_PTR)
-            {
-                Tx_Req[USART_NUMBER_2].CallBack();
-            }
+            USART_assertDe(USART_Number);   /*Chained requests keep the bus, it's only taken by the first one*/
         }
+        Req->state = Req_state_Busy;
+        started = TRUE;
+        USART_startTxBuffer(USART_Number);
     }
+    return started;
+}
 
-    if((USART[USART_NUMBER_2]->SR) & USART_RX_DONE_IRQ)
+/*Called on TXE: keeps the data register loaded, the first byte of the next queued request is written in the
+  same interrupt that finishes the current one so consecutive requests leave no idle gap on the line*/
+static void USART_TxHandler(u8 USART_Number)
+{
+    Tx_Req_t* const Req = &Tx_Req[USART_Number];
+    USART_CallBack_t DoneCallBack = NULL_PTR;
+    void* DoneContext = NULL_PTR;
+    u32 DoneLength = 0;
+    if((Req->state == Req_state_Busy) && (Req->mode == Tx_mode_Dma))
+    {
+        /*A request was posted during a DMA transfer, the DMA completion chains it*/
+        USART[USART_Number]->CR1 &= ~USART_TXEIE_ENABLE;
+    }
+    else if((Req->state == Req_state_Busy) &&
+            ((Req->buffer.pos < Req->buffer.size) || (USART_loadNextSegment(USART_Number) == TRUE)))
+    {
+        USART_txByte(USART_Number);
+    }
+    else
     {
-        if(Rx_Req[USART_NUMBER_2].buffer.pos < Rx_Req[USART_NUMBER_2].buffer.size)
+        if(Req->state == Req_state_Busy)
         {
-            Rx_Req[USART_NUMBER_2].buffer.data[Rx_Req[USART_NUMBER_2].buffer.pos] = USART[USART_NUMBER_2]->DR;
-            Rx_Req[USART_NUMBER_2].buffer.pos++;
+            DoneCallBack = Req->CallBack;
+            DoneContext = Req->Context;
+            DoneLength = Req->transferred + Req->buffer.size;
         }
-        else
+        if(USART_startNextTx(USART_Number) == FALSE)
         {
-            USART[USART_NUMBER_2]->CR1 &= ~USART_RX_ENABLE;
-            USART[USART_NUMBER_2]->CR1 &= ~USART_RXNEIE_ENABLE;   /*Disable Rx Interrupts*/
-            Rx_Req[USART_NUMBER_2].state = Req_state_Idle;
-            if(Rx_Req[USART_NUMBER_2].CallBack != NULL_PTR)
-            {
-                Rx_Req[USART_NUMBER_2].CallBack();
-            }
+            USART[USART_Number]->CR1 &= ~USART_TXEIE_ENABLE;   /*Disable Tx Interrupts*/
+            Req->state = Req_state_Idle;
+            USART_waitTxComplete(USART_Number);
         }
+        USART_notify(DoneCallBack, USART_Number, USART_EVENT_DONE, DoneLength, USART_ERROR_NONE, DoneContext);
     }
 }
 
-void USART6_IRQHandler(void)
+/*The last byte is in DR when the transfer completes, starting the next request here keeps the line busy*/
+static void USART_TxDmaCallBack(u8 Event, void* Context)
 {
-    if((USART[USART_NUMBER_6]->SR) & USART_TX_DONE_IRQ)
+    u8 USART_Number = USART_numberFromContext(Context);
+    Tx_Req_t* const Req = &Tx_Req[USART_Number];
+    USART_CallBack_t DoneCallBack = Req->CallBack;
+    void* DoneContext = Req->Context;
+    u32 DoneLength = 0;
+    u16 remaining = 0;
+    /*Only the consumer of the running request completes it, the TXE interrupt owns it otherwise*/
+    if((Req->state == Req_state_Busy) && (Req->mode == Tx_mode_Dma))
     {
-        if(Tx_Req[USART_NUMBER_6].buffer.pos < Tx_Req[USART_NUMBER_6].buffer.size)
+        if(Event & DMA_EVENT_HALF)
         {
-            USART[USART_NUMBER_6]->DR = Tx_Req[USART_NUMBER_6].buffer.data[Tx_Req[USART_NUMBER_6].buffer.pos];
-            Tx_Req[USART_NUMBER_6].buffer.pos++;
+            USART_notify(Req->HalfCallBack, USART_Number, USART_EVENT_HALF, Req->buffer.size / 2, USART_ERROR_NONE, Req->Context);
         }
-        else
+        if(Event & (DMA_EVENT_FULL | DMA_EVENT_ERROR))
         {
-            USART[USART_NUMBER_6]->CR1 &= ~USART_TX_ENABLE;
-            USART[USART_NUMBER_6]->CR1 &= ~USART_TXEIE_ENABLE;   /*Disable Tx Interrupts*/
-            Tx_Req[USART_NUMBER_6].state = Req_state_Idle;
-            if(Tx_Req[USART_NUMBER_6].CallBack != NULL_PTR)
+            Tx_Dma[USART_Number].active = FALSE;
+            USART[USART_Number]->CR3 &= ~USART_CR3_DMAT;
+            if(((Event & DMA_EVENT_ERROR) == 0) && (USART_loadNextSegment(USART_Number) == TRUE))
+            {
+                USART_startTxBuffer(USART_Number);
+            }
+            else
             {
-                Tx_Req[USART_NUMBER_6].CallBack();
+                DMA_getRemaining(Tx_Dma[USART_Number].link.controller, Tx_Dma[USART_Number].link.stream, &remaining);
+                DoneLength = Req->transferred + Req->buffer.size - remaining;
+                if(USART_startNextTx(USART_Number) == FALSE)
+                {
+                    Req->state = Req_state_Idle;
+                    /*A request posted after the queue was found empty had its TXE interrupt turned away while
+                      this transfer still owned the instance, hand it to the interrupt*/
+                    if(Tx_Queue[USART_Number].head != Tx_Queue[USART_Number].tail)
+                    {
+                        USART_enableTxInterrupt(USART_Number);
+                    }
+                    USART_waitTxComplete(USART_Number);
+                }
+                USART_notify(DoneCallBack, USART_Number, USART_EVENT_DONE, DoneLength,
+                             (Event & DMA_EVENT_ERROR) ? USART_ERROR_DMA : USART_ERROR_NONE, DoneContext);
             }
         }
     }
+}
+
+/*
+ * Called on TC of a half duplex instance: the last stop bit is out, the bus is released unless a request is
+ * running or waits in the queue (its TXE interrupt starts it in this same interrupt, the bus stays taken).
+ */
+static void USART_TcHandler(u8 USART_Number)
+{
+    USART[USART_Number]->CR1 &= ~USART_TCIE_ENABLE;
+    if((Tx_Req[USART_Number].state == Req_state_Idle) && (Tx_Queue[USART_Number].head == Tx_Queue[USART_Number].tail))
+    {
+        USART_releaseDe(USART_Number);
+    }
+}
+
+/*Ends the pending receive, on a full buffer or on an idle line for frame requests*/
+static void USART_completeRx(u8 USART_Number, u16 Length, u8 Event)
+{
+    Rx_Req_t* const Req = &Rx_Req[USART_Number];
+    USART[USART_Number]->CR1 &= ~(USART_RXNEIE_ENABLE | USART_IDLEIE_ENABLE | USART_PEIE_ENABLE);   /*Disable Rx Interrupts*/
+    USART[USART_Number]->CR3 &= ~USART_CR3_EIE;
+    Req->buffer.pos = Length;
+    Req->state = Req_state_Idle;
+    USART_notify(Req->CallBack, USART_Number, Event, Length, Req->errors, Req->Context);
+}
 
-    if((USART[USART_NUMBER_6]->SR) & USART_RX_DONE_IRQ)
+static void USART_RxDmaCallBack(u8 Event, void* Context)
+{
+    u8 USART_Number = USART_numberFromContext(Context);
+    Rx_Req_t* const Req = &Rx_Req[USART_Number];
+    u16 remaining = 0;
+    if(Event & DMA_EVENT_HALF)
+    {
+        USART_notify(Req->HalfCallBack, USART_Number, USART_EVENT_HALF, Req->buffer.size / 2, USART_ERROR_NONE, Req->Context);
+    }
+    if(Event & (DMA_EVENT_FULL | DMA_EVENT_ERROR))
     {
-        if(Rx_Req[USART_NUMBER_6].buffer.pos < Rx_Req[USART_NUMBER_6].buffer.size)
+        if(Event & DMA_EVENT_ERROR)
         {
-            Rx_Req[USART_NUMBER_6].buffer.data[Rx_Req[USART_NUMBER_6].buffer.pos] = USART[USART_NUMBER_6]->DR;
-            Rx_Req[USART_NUMBER_6].buffer.pos++;
+            Req->errors |= USART_ERROR_DMA;
         }
-        else
-        {
-            USART[USART_NUMBER_6]->CR1 &= ~USART_RX_ENABLE;
-            USART[USART_NUMBER_6]->CR1 &= ~USART_RXNEIE_ENABLE;   /*Disable Rx Interrupts*/
-            Rx_Req[USART_NUMBER_6].state = Req_state_Idle;
-            if(Rx_Req[USART_NUMBER_6].CallBack != NULL_PTR)
-            {
-                Rx_Req[USART_NUMBER_6].CallBack();
-            }
+        DMA_getRemaining(Rx_Dma[USART_Number].link.controller, Rx_Dma[USART_Number].link.stream, &remaining);
+        Rx_Stats[USART_Number].received += Req->buffer.size - remaining;
+        Rx_Dma[USART_Number].active = FALSE;
+        USART[USART_Number]->CR3 &= ~USART_CR3_DMAR;
+        USART_completeRx(USART_Number, (u16)(Req->buffer.size - remaining), USART_EVENT_DONE);
+    }
+}
+
+static void USART_DoubleBufferDmaCallBack(u8 Event, void* Context);
+
+/*Fills the current buffer through the stream when the instance has one, by the Rx interrupt otherwise*/
+static void USART_fillDoubleBuffer(u8 USART_Number)
+{
+    Rx_DoubleBuffer_t* const Double = &Rx_DoubleBuffer[USART_Number];
+    if((Rx_Dma[USART_Number].allocated == TRUE) &&
+       (USART_startDma(USART_Number, &Rx_Dma[USART_Number], DMA_DIR_PERIPH_TO_MEM, Double->buffers[Double->current],
+                       Double->length, USART_DoubleBufferDmaCallBack) == DMA_OK))
+    {
+        /*A byte waiting in DR since the last buffer is the first request of the stream*/
+        USART_clearCR1Bit(USART_Number, USART_RXNEIE_BIT);
+        USART_setCR1Bit(USART_Number, USART_PEIE_BIT);
+        USART_setCR3Bit(USART_Number, USART_CR3_DMAR_BIT);
+        USART_setCR3Bit(USART_Number, USART_CR3_EIE_BIT);
+    }
+    else
+    {
+        USART_setCR1Bit(USART_Number, USART_RXNEIE_BIT);
+    }
+}
+
+/*
+ * The current buffer holds Length bytes: the other buffer starts filling before the callback if the consumer
+ * released it, otherwise the receive pauses, the Rx interrupt drops the bytes until USART_releaseRxBuffer.
+ */
+static void USART_swapDoubleBuffer(u8 USART_Number, u16 Length)
+{
+    Rx_DoubleBuffer_t* const Double = &Rx_DoubleBuffer[USART_Number];
+    USART_Completion_t Completion;
+    const u8 full = Double->current;
+    const u8 next = full ^ 1U;
+    Completion.USART_Number = USART_Number;
+    Completion.event = USART_EVENT_DONE;
+    Completion.errors = Double->errors | ((Double->gap == TRUE) ? USART_ERROR_BUFFER_OVERRUN : USART_ERROR_NONE);
+    Completion.length = Length;
+    Completion.Context = Double->Context;
+    Completion.data = Double->buffers[full];
+    Double->errors = USART_ERROR_NONE;
+    Double->gap = FALSE;
+    Double->held[full] = TRUE;
+    if(Double->held[next] == TRUE)
+    {
+        Rx_Stats[USART_Number].bufferOverruns++;
+        Double->gap = TRUE;
+        Double->paused = TRUE;
+        USART[USART_Number]->CR3 &= ~USART_CR3_DMAR;
+        USART_setCR1Bit(USART_Number, USART_RXNEIE_BIT);
+    }
+    else
+    {
+        Double->current = next;
+        Double->pos = 0;
+        USART_fillDoubleBuffer(USART_Number);
+    }
+    Double->CallBack(&Completion);
+}
+
+static void USART_DoubleBufferDmaCallBack(u8 Event, void* Context)
+{
+    u8 USART_Number = USART_numberFromContext(Context);
+    Rx_DoubleBuffer_t* const Double = &Rx_DoubleBuffer[USART_Number];
+    u16 remaining = 0;
+    if(Event & (DMA_EVENT_FULL | DMA_EVENT_ERROR))
+    {
+        if(Event & DMA_EVENT_ERROR)
+        {
+            Double->errors |= USART_ERROR_DMA;
+        }
+        DMA_getRemaining(Rx_Dma[USART_Number].link.controller, Rx_Dma[USART_Number].link.stream, &remaining);
+        Rx_Stats[USART_Number].received += Double->length - remaining;
+        Rx_Dma[USART_Number].active = FALSE;
+        USART_swapDoubleBuffer(USART_Number, (u16)(Double->length - remaining));
+    }
+}
+
+/*
+ * Called when the status snapshot holds PE, FE, NE or ORE: counts them, adds them to the pending request and
+ * reports them to the instance error callback.
+ * With RXNEIE the receive handler read of DR clears them, during a DMA receive (EIE and PEIE) the stream read
+ * of the pending byte does, DR is only read here when no byte is pending so the stream doesn't lose one.
+ */
+static void USART_ErrorHandler(u8 USART_Number, u32 status, u32 control)
+{
+    Rx_Req_t* const Req = &Rx_Req[USART_Number];
+    volatile USART_RxStats_t* const Stats = &Rx_Stats[USART_Number];
+    const u8 errors = (u8)(status & USART_SR_ERRORS_MASK);
+    if(errors & USART_ERROR_PARITY)
+    {
+        Stats->parityErrors++;
+    }
+    if(errors & USART_ERROR_FRAMING)
+    {
+        Stats->framingErrors++;
+    }
+    if(errors & USART_ERROR_NOISE)
+    {
+        Stats->noiseErrors++;
+    }
+    if(errors & USART_ERROR_OVERRUN)
+    {
+        Stats->overruns++;
+    }
+    if(((control & USART_RXNEIE_ENABLE) == 0) && ((status & USART_SR_RXNE_MASK) == 0))
+    {
+        (void)USART_READ_DR(USART_Number);
+    }
+    if((Rx_Ring[USART_Number].enabled == FALSE) && (Req->state == Req_state_Busy))
+    {
+        Req->errors |= errors;
+    }
+    else if(Rx_DoubleBuffer[USART_Number].enabled == TRUE)
+    {
+        Rx_DoubleBuffer[USART_Number].errors |= errors;
+    }
+    USART_notify(Error_Notify[USART_Number].CallBack, USART_Number, USART_EVENT_ERROR, 0, errors,
+                 Error_Notify[USART_Number].Context);
+}
+
+/*Called on RXNE: reading SR then DR clears both RXNE and ORE*/
+static void USART_RxHandler(u8 USART_Number)
+{
+    Rx_Req_t* const Req = &Rx_Req[USART_Number];
+    Rx_Ring_t* const Ring = &Rx_Ring[USART_Number];
+    Rx_DoubleBuffer_t* const Double = &Rx_DoubleBuffer[USART_Number];
+    volatile USART_RxStats_t* const Stats = &Rx_Stats[USART_Number];
+    u8 data = (u8)USART_READ_DR(USART_Number);      /*SR was read by the caller, reading DR clears RXNE, ORE and IDLE*/
+    u32 head = 0;
+    u32 level = 0;
+    if(Ring->enabled == TRUE)
+    {
+        head = Ring->head;
+        level = head - Ring->tail;
+        if(level < USART_RX_RING_SIZE)
+        {
+            Ring->buffer[head & USART_RX_RING_MASK] = data;
+            Ring->head = head + 1;
+            Stats->received++;
+            if((level + 1) > Stats->highWaterMark)
+            {
+                Stats->highWaterMark = level + 1;
+            }
+            if(((level + 1) == USART_RX_RING_SIZE) && (Flow_Control[USART_Number] & USART_FLOW_CONTROL_RTS))
+            {
+                /*RTS is deasserted while RXNE is set, leaving the next byte in DR stops the sender*/
+                Ring->paused = TRUE;
+                USART[USART_Number]->CR1 &= ~USART_RXNEIE_ENABLE;
+            }
+        }
+        else
+        {
+            Stats->dropped++;
+        }
+    }
+    else if(Req->state == Req_state_Busy)
+    {
+        Req->buffer.data[Req->buffer.pos] = data;
+        Req->buffer.pos++;
+        Stats->received++;
+        if((Req->HalfCallBack != NULL_PTR) && (Req->buffer.pos == (Req->buffer.size / 2)))
+        {
+            USART_notify(Req->HalfCallBack, USART_Number, USART_EVENT_HALF, Req->buffer.pos, USART_ERROR_NONE, Req->Context);
+        }
+        if(Req->buffer.pos >= Req->buffer.size)
+        {
+            USART_completeRx(USART_Number, (u16)Req->buffer.pos, USART_EVENT_DONE);
+        }
+    }
+    else if((Double->enabled == TRUE) && (Double->paused == FALSE))
+    {
+        Double->buffers[Double->current][Double->pos] = data;
+        Double->pos++;
+        Stats->received++;
+        if(Double->pos >= Double->length)
+        {
+            USART_swapDoubleBuffer(USART_Number, Double->pos);
+        }
+    }
+    else
+    {
+        Stats->dropped++;
+    }
+}
+
+/*
+ * Called on IDLE, after RXNE was handled: one idle character ends a frame request with what it received so far.
+ * An idle line before the first byte (a flag left from earlier traffic) keeps the request waiting.
+ */
+static void USART_IdleHandler(u8 USART_Number, u32 status)
+{
+    Rx_Req_t* const Req = &Rx_Req[USART_Number];
+    u16 remaining = 0;
+    if((status & USART_SR_RXNE_MASK) == 0)
+    {
+        (void)USART_READ_DR(USART_Number);    /*SR was read by the caller, reading DR clears IDLE*/
+    }
+    if(Req->state == Req_state_Busy)
+    {
+        if(Rx_Dma[USART_Number].active == TRUE)
+        {
+            DMA_getRemaining(Rx_Dma[USART_Number].link.controller, Rx_Dma[USART_Number].link.stream, &remaining);
+            if(remaining < Req->buffer.size)
+            {
+                /*Disabling the stream keeps its completion interrupt from reporting the same frame*/
+                DMA_stopTransfer(Rx_Dma[USART_Number].link.controller, Rx_Dma[USART_Number].link.stream);
+                DMA_getRemaining(Rx_Dma[USART_Number].link.controller, Rx_Dma[USART_Number].link.stream, &remaining);
+                Rx_Stats[USART_Number].received += Req->buffer.size - remaining;
+                Rx_Dma[USART_Number].active = FALSE;
+                USART[USART_Number]->CR3 &= ~USART_CR3_DMAR;
+                USART_completeRx(USART_Number, (u16)(Req->buffer.size - remaining), USART_EVENT_IDLE);
+            }
+        }
+        else if(Req->buffer.pos > 0)
+        {
+            USART_completeRx(USART_Number, (u16)Req->buffer.pos, USART_EVENT_IDLE);
+        }
+    }
+    else
+    {
+        USART[USART_Number]->CR1 &= ~USART_IDLEIE_ENABLE;
+    }
+}
+
+/*
+ * Shared body of the instance interrupts: SR and CR1 are read once and every pending event is served from
+ * that snapshot. TC of a half duplex instance comes first, the peer may answer one bit time after the stop bit
+ * and DE_TURNAROUND profiles the cycles from the interrupt entry to the release. The receiver is next since a
+ * late read loses a byte (ORE) while a late write only delays the transmitter, then IDLE which relies on RXNE
+ * being handled, then TXE.
+ * Errors are counted before the byte that carries them is stored. ORE is served with RXNE: it raises the
+ * interrupt on its own when DMA has already emptied DR, and the handler read of DR is what clears it.
+ */
+static inline void USART_IRQHandler(u8 USART_Number)
+{
+    USART_Registers_t* const Usart = USART[USART_Number];
+    DWT_PROFILE_BEGIN(DWT_PROFILE_USART_ISR);
+    const u32 status = USART_READ_SR(USART_Number);
+    const u32 control = Usart->CR1;
+    if((status & USART_SR_TC_MASK) && (control & USART_TCIE_ENABLE))
+    {
+        USART_TcHandler(USART_Number);
+        DWT_PROFILE_END_FROM(DWT_PROFILE_USART_DE_TURNAROUND, DWT_PROFILE_USART_ISR);
+    }
+
+    if((status & USART_SR_ERRORS_MASK) &&
+       ((control & (USART_RXNEIE_ENABLE | USART_PEIE_ENABLE)) || (Usart->CR3 & USART_CR3_EIE)))
+    {
+        USART_ErrorHandler(USART_Number, status, control);
+    }
+
+    if((status & (USART_SR_RXNE_MASK | USART_SR_ORE_MASK)) && (control & USART_RXNEIE_ENABLE))
+    {
+        USART_RxHandler(USART_Number);
+    }
+
+    if((status & USART_SR_IDLE_MASK) && (control & USART_IDLEIE_ENABLE))
+    {
+        USART_IdleHandler(USART_Number, status);
+    }
+
+    if((status & USART_SR_TXE_MASK) && (control & USART_TXEIE_ENABLE))
+    {
+        USART_TxHandler(USART_Number);
+    }
+    DWT_PROFILE_END(DWT_PROFILE_USART_ISR);
+}
+
+/********************************************************************************************************/
+/*********************************************APIs Implementation****************************************/
+/********************************************************************************************************/
+
+USART_ErrorStatus_t USART_init(void)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    u8 idx = 0;
+    u32 BRR_value = 0; 
+    u32 CR1_value = 0;
+    u32 CR2_value = 0;
+    u32 configured = 0;
+    USART_ErrorStatus_t CfgStatus = USART_OK;
+    for(idx = 0; idx < _USART_Num; idx++)
+    {
+        USART_Handles[idx] = NULL_PTR;
+        /*Configurations without a build time BRR (USART_BRR_CFG) are computed and checked here*/
+        BRR_value = USART_Cfg[idx].USART_BRR;
+        if((BRR_value == 0) &&
+           (USART_BAUD_VALID(USART_CLK, USART_Cfg[idx].USART_BaudRate, USART_Cfg[idx].USART_OverSampling)))
+        {
+            BRR_value = USART_BRR(USART_CLK, USART_Cfg[idx].USART_BaudRate, USART_Cfg[idx].USART_OverSampling);
+        }
+        CfgStatus = USART_checkCfg(&USART_Cfg[idx], configured);
+        if(CfgStatus != USART_OK)
+        {
+            ErrorStatus = CfgStatus;
+        }
+        else if(BRR_value == 0)
+        {
+            ErrorStatus = USART_InvalidBaudRate;
+        }
+        else
+        {
+            configured |= (1UL << USART_Cfg[idx].USART_Number);
+            USART[USART_Cfg[idx].USART_Number]->BRR = BRR_value;
+
+            /*Transmitter and receiver stay enabled, the requests only switch their interrupts and DMA requests*/
+            CR1_value = (USART_Cfg[idx].USART_OverSampling) | USART_ENABLE | USART_TX_ENABLE | USART_RX_ENABLE | (USART_Cfg[idx].USART_WordLen)\
+                        |(USART_Cfg[idx].USART_ParityControl) | (USART_Cfg[idx].USART_ParitySelection)\
+                        |(USART_Cfg[idx].USART_Wakeup & USART_CR1_WAKE);
+            USART[USART_Cfg[idx].USART_Number]->CR1 = CR1_value;
+
+            CR2_value = USART_Cfg[idx].USART_StopBits | (USART_Cfg[idx].USART_Address & USART_CR2_ADD_MASK);
+            USART[USART_Cfg[idx].USART_Number]->CR2 = CR2_value;
+
+            Flow_Control[USART_Cfg[idx].USART_Number] = USART_Cfg[idx].USART_FlowControl & USART_CR3_FLOW_MASK;
+            USART[USART_Cfg[idx].USART_Number]->CR3 = Flow_Control[USART_Cfg[idx].USART_Number];
+            if(USART_Cfg[idx].USART_FlowControl & USART_FLOW_CONTROL_RTS)
+            {
+                USART_cfgFlowPin(USART_Cfg[idx].USART_Number, USART_Cfg[idx].USART_RtsPort, USART_Cfg[idx].USART_RtsPin,
+                                 GPIO_MODE_AF_PP);
+            }
+            if(USART_Cfg[idx].USART_FlowControl & USART_FLOW_CONTROL_CTS)
+            {
+                /*Pulled up so an unconnected CTS holds the transmitter instead of letting it send blindly*/
+                USART_cfgFlowPin(USART_Cfg[idx].USART_Number, USART_Cfg[idx].USART_CtsPort, USART_Cfg[idx].USART_CtsPin,
+                                 GPIO_MODE_AF_PP_PU);
+            }
+            if(USART_Cfg[idx].USART_HalfDuplex == TRUE)
+            {
+                USART_cfgDePin(USART_Cfg[idx].USART_Number, &USART_Cfg[idx]);
+            }
+
+            /*Without a free stream the instance keeps using the interrupt path*/
+            if(USART_Cfg[idx].USART_DmaTx == TRUE)
+            {
+                USART_allocDma(&Tx_Dma[USART_Cfg[idx].USART_Number], &USART_TxDmaCandidates[USART_Cfg[idx].USART_Number]);
+            }
+            if(USART_Cfg[idx].USART_DmaRx == TRUE)
+            {
+                USART_allocDma(&Rx_Dma[USART_Cfg[idx].USART_Number], &USART_RxDmaCandidates[USART_Cfg[idx].USART_Number]);
+            }
+            USART_Handles[idx] = &USART_Instances[USART_Cfg[idx].USART_Number];
+        }
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_getHandle(u8 USART_CfgIndex, USART_Handle_t* Handle)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if(Handle == NULL_PTR)
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(USART_CfgIndex >= _USART_Num)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else if(USART_Handles[USART_CfgIndex] == NULL_PTR)
+    {
+        ErrorStatus = USART_InvalidConfig;
+    }
+    else
+    {
+        *Handle = USART_Handles[USART_CfgIndex];
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_getNumber(USART_Handle_t Handle, u8* USART_Number)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if((Handle == NULL_PTR) || (USART_Number == NULL_PTR))
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else
+    {
+        *USART_Number = Handle->USART_Number;
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_send(USART_Handle_t Handle, u8* Data, u16 Length, USART_CallBack_t CB, void* Context)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if((Handle == NULL_PTR) || (Data == NULL_PTR) || (CB == NULL_PTR))
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(Length == 0)
+    {
+        ErrorStatus = USART_InvalidLength;
+    }
+    else
+    {
+        ErrorStatus = USART_queueTx(Handle->USART_Number, Handle->TxQueue, Data, Length, CB, NULL_PTR, Context);
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_receive(USART_Handle_t Handle, u8* Data, u16 Length, u16* ReadLength)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if((Handle == NULL_PTR) || (Data == NULL_PTR) || (ReadLength == NULL_PTR))
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else
+    {
+        *ReadLength = USART_readRing(Handle->USART_Number, Handle->RxRing, Data, Length);
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_available(USART_Handle_t Handle, u16* Available)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if((Handle == NULL_PTR) || (Available == NULL_PTR))
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else
+    {
+        *Available = (u16)(Handle->RxRing->head - Handle->RxRing->tail);
+    }
+    return ErrorStatus;
+}
+
+
+USART_ErrorStatus_t USART_setBaudRate(u8 USART_Number, u32 BaudRate)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    u32 OverSampling = 0;
+    if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else
+    {
+        OverSampling = USART[USART_Number]->CR1 & USART_CR1_OVER8;
+        if(USART_BAUD_VALID(USART_CLK, BaudRate, OverSampling))
+        {
+            USART[USART_Number]->BRR = USART_BRR(USART_CLK, BaudRate, OverSampling);
+        }
+        else
+        {
+            ErrorStatus = USART_InvalidBaudRate;
+        }
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_getBaudRate(u8 USART_Number, u32* BaudRate)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    u32 divider = 0;
+    if(BaudRate == NULL_PTR)
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else
+    {
+        /*Back from the BRR layout to CLK / BAUD, the 3 bit fraction of OVER8 sits under a shifted mantissa*/
+        divider = USART[USART_Number]->BRR;
+        if(USART[USART_Number]->CR1 & USART_CR1_OVER8)
+        {
+            divider = ((divider >> 1) & ~0x7UL) | (divider & 0x7UL);
+        }
+        *BaudRate = (divider == 0) ? 0 : ((USART_CLK + (divider / 2)) / divider);
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_startAutoBaud(u8 USART_Number, u8 ICU_Name, USART_CallBack_t CB, void* Context)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else if(Rx_Req[USART_Number].state == Req_state_Busy)
+    {
+        ErrorStatus = USART_Busy;
+    }
+    else
+    {
+        /*The receiver sits out the sync character, it would only get a framing error out of it*/
+        Auto_Baud[USART_Number].armed = FALSE;
+        USART_clearCR1Bit(USART_Number, USART_RE_BIT);
+        Auto_Baud[USART_Number].input = ICU_Name;
+        Auto_Baud[USART_Number].count = 0;
+        Auto_Baud[USART_Number].next = 0;
+        Auto_Baud[USART_Number].rising = 0;
+        Auto_Baud[USART_Number].CallBack = CB;
+        Auto_Baud[USART_Number].Context = Context;
+        Auto_Baud[USART_Number].armed = TRUE;
+        if(ICU_setEdgeCallBack(ICU_Name, USART_autoBaudEdge) != ICU_OK)
+        {
+            Auto_Baud[USART_Number].armed = FALSE;
+            USART_setCR1Bit(USART_Number, USART_RE_BIT);
+            ErrorStatus = USART_InvalidCapture;
+        }
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_sendBlocking(u8 USART_Number, const u8* Data, u16 Length, u32 TimeoutUS)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if(Data == NULL_PTR)
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else if(Length == 0)
+    {
+        ErrorStatus = USART_InvalidLength;
+    }
+    else if(TimeoutUS > DWT_MAX_US)
+    {
+        ErrorStatus = USART_InvalidTimeout;
+    }
+    else if((Tx_Req[USART_Number].state == Req_state_Busy) || (Tx_Queue[USART_Number].head != Tx_Queue[USART_Number].tail))
+    {
+        ErrorStatus = USART_Busy;
+    }
+    else
+    {
+        ErrorStatus = USART_writeBlocking(USART_Number, Data, Length, 0, TimeoutUS);
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_sendAddress(u8 USART_Number, u8 Address, u32 TimeoutUS)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else if(Address > USART_ADDRESS_MAX)
+    {
+        ErrorStatus = USART_InvalidAddress;
+    }
+    else if(TimeoutUS > DWT_MAX_US)
+    {
+        ErrorStatus = USART_InvalidTimeout;
+    }
+    else if((Tx_Req[USART_Number].state == Req_state_Busy) || (Tx_Queue[USART_Number].head != Tx_Queue[USART_Number].tail))
+    {
+        ErrorStatus = USART_Busy;
+    }
+    else
+    {
+        ErrorStatus = USART_writeBlocking(USART_Number, &Address, 1, USART_addressMark(USART_Number), TimeoutUS);
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_enterMute(u8 USART_Number)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else
+    {
+        /*The hardware clears RWU on wakeup, a single store can't undo that or an interrupt CR1 update*/
+        USART_setCR1Bit(USART_Number, USART_CR1_RWU_BIT);
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_sendByte(USART_Req_t USART_Req)
+{
+    return USART_sendBlocking(USART_Req.USART_Number, USART_Req.data, 1, USART_BYTE_TIMEOUT_US);
+}
+
+USART_ErrorStatus_t USART_recieveByte(USART_Req_t USART_Req)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    const u32 start = DWT_getCycles();
+    if((USART_Req.data == NULL_PTR))
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(USART_Req.USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else if ((Rx_Req[USART_Req.USART_Number].state == Req_state_Busy) || (Rx_Ring[USART_Req.USART_Number].enabled == TRUE) ||
+             (Rx_DoubleBuffer[USART_Req.USART_Number].enabled == TRUE))
+    {
+        ErrorStatus = USART_Busy;
+    }
+    else
+    {
+        USART_discardStaleRx(USART_Req.USART_Number);
+        if(USART_waitFlag(USART_Req.USART_Number, USART_SR_RXNE_MASK, start, DWT_US_TO_CYCLES(USART_BYTE_TIMEOUT_US)) == TRUE)
+        {
+            *(USART_Req.data) = (u8)USART_READ_DR(USART_Req.USART_Number);
+        }
+        else
+        {
+            ErrorStatus = USART_TimeOut;
+        }
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_sendBufferAsyncZC(USART_Req_t USART_Req)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if((USART_Req.data == NULL_PTR) || (USART_Req.CB == NULL_PTR))
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(USART_Req.USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else if(USART_Req.length == 0)
+    {
+        ErrorStatus = USART_InvalidLength;
+    }
+    else
+    { 
+        ErrorStatus = USART_queueTx(USART_Req.USART_Number, &Tx_Queue[USART_Req.USART_Number], USART_Req.data,
+                                    USART_Req.length, USART_Req.CB, USART_Req.HalfCB, USART_Req.Context);
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_sendGatherAsyncZC(USART_GatherReq_t USART_GatherReq)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    Tx_Queue_t* Queue;
+    u32 head = 0;
+    u8 idx = 0;
+    if((USART_GatherReq.segments == NULL_PTR) || (USART_GatherReq.CB == NULL_PTR))
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(USART_GatherReq.USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else if(USART_GatherReq.count == 0)
+    {
+        ErrorStatus = USART_InvalidLength;
+    }
+    else if((Tx_Queue[USART_GatherReq.USART_Number].head - Tx_Queue[USART_GatherReq.USART_Number].tail) >= USART_TX_QUEUE_SIZE)
+    {
+        ErrorStatus = USART_Busy;
+    }
+    else
+    {
+        /*Empty segments would stall the interrupt walk, reject the whole list before queueing it*/
+        for(idx = 0; (idx < USART_GatherReq.count) && (ErrorStatus == USART_OK); idx++)
+        {
+            if(USART_GatherReq.segments[idx].data == NULL_PTR)
+            {
+                ErrorStatus = USART_NullPtr;
+            }
+            else if(USART_GatherReq.segments[idx].length == 0)
+            {
+                ErrorStatus = USART_InvalidLength;
+            }
+        }
+        if(ErrorStatus == USART_OK)
+        {
+            Queue = &Tx_Queue[USART_GatherReq.USART_Number];
+            head = Queue->head;
+            Queue->descriptors[head & USART_TX_QUEUE_MASK].data = (u8*)USART_GatherReq.segments[0].data;
+            Queue->descriptors[head & USART_TX_QUEUE_MASK].length = USART_GatherReq.segments[0].length;
+            Queue->descriptors[head & USART_TX_QUEUE_MASK].CallBack = USART_GatherReq.CB;
+            Queue->descriptors[head & USART_TX_QUEUE_MASK].HalfCallBack = NULL_PTR;
+            Queue->descriptors[head & USART_TX_QUEUE_MASK].Context = USART_GatherReq.Context;
+            Queue->descriptors[head & USART_TX_QUEUE_MASK].segments = &USART_GatherReq.segments[1];
+            Queue->descriptors[head & USART_TX_QUEUE_MASK].segmentsLeft = USART_GatherReq.count - 1;
+            Queue->head = head + 1;     /*Publish the descriptor after it's complete*/
+            USART_enableTxInterrupt(USART_GatherReq.USART_Number);
+        }
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_recieveBufferAsyncZC(USART_Req_t USART_Req)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if((USART_Req.data == NULL_PTR) || (USART_Req.CB == NULL_PTR))
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(USART_Req.USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else if(USART_Req.length == 0)
+    {
+        ErrorStatus = USART_InvalidLength;
+    }
+    else if ((Rx_Req[USART_Req.USART_Number].state == Req_state_Busy) || (Rx_Ring[USART_Req.USART_Number].enabled == TRUE) ||
+             (Rx_DoubleBuffer[USART_Req.USART_Number].enabled == TRUE))
+    {
+        ErrorStatus = USART_Busy;
+    }
+    else
+    { 
+        Rx_Req[USART_Req.USART_Number].buffer.data = USART_Req.data;
+        Rx_Req[USART_Req.USART_Number].buffer.pos = 0;
+        Rx_Req[USART_Req.USART_Number].buffer.size = USART_Req.length;
+        Rx_Req[USART_Req.USART_Number].CallBack = USART_Req.CB;
+        Rx_Req[USART_Req.USART_Number].HalfCallBack = USART_Req.HalfCB;
+        Rx_Req[USART_Req.USART_Number].Context = USART_Req.Context;
+        Rx_Req[USART_Req.USART_Number].frame = USART_Req.frame;
+        Rx_Req[USART_Req.USART_Number].errors = USART_ERROR_NONE;
+        Rx_Req[USART_Req.USART_Number].state = Req_state_Busy;
+        USART_discardStaleRx(USART_Req.USART_Number);
+
+        if((Rx_Dma[USART_Req.USART_Number].allocated == TRUE) &&
+           (USART_startDma(USART_Req.USART_Number, &Rx_Dma[USART_Req.USART_Number], DMA_DIR_PERIPH_TO_MEM, USART_Req.data,
+                           USART_Req.length, USART_RxDmaCallBack) == DMA_OK))
+        {
+            /*The stream takes the bytes, the error interrupts still report the line errors*/
+            USART_setCR3Bit(USART_Req.USART_Number, USART_CR3_DMAR_BIT);
+            USART_setCR3Bit(USART_Req.USART_Number, USART_CR3_EIE_BIT);
+            USART_setCR1Bit(USART_Req.USART_Number, USART_PEIE_BIT);
+        }
+        else
+        {
+            USART_setCR1Bit(USART_Req.USART_Number, USART_RXNEIE_BIT);   /*Enable Rx Interrupts*/
+        }
+        if(USART_Req.frame == TRUE)
+        {
+            USART_setCR1Bit(USART_Req.USART_Number, USART_IDLEIE_BIT);
+        }
+    }
+    return ErrorStatus; 
+}
+
+USART_ErrorStatus_t USART_startContinuousRx(u8 USART_Number)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else if ((Rx_Req[USART_Number].state == Req_state_Busy) || (Rx_DoubleBuffer[USART_Number].enabled == TRUE))
+    {
+        ErrorStatus = USART_Busy;
+    }
+    else
+    {
+        Rx_Ring[USART_Number].head = 0;
+        Rx_Ring[USART_Number].tail = 0;
+        Rx_Ring[USART_Number].paused = FALSE;
+        Rx_Ring[USART_Number].enabled = TRUE;
+        USART_discardStaleRx(USART_Number);
+        USART_setCR1Bit(USART_Number, USART_RXNEIE_BIT);   /*Enable Rx Interrupts*/
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_stopContinuousRx(u8 USART_Number)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else
+    {
+        USART_clearCR1Bit(USART_Number, USART_RXNEIE_BIT);   /*Disable Rx Interrupts*/
+        Rx_Ring[USART_Number].enabled = FALSE;
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_startDoubleBufferRx(USART_DoubleBufferReq_t USART_DoubleBufferReq)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    const u8 USART_Number = USART_DoubleBufferReq.USART_Number;
+    Rx_DoubleBuffer_t* Double = NULL_PTR;
+    if((USART_DoubleBufferReq.buffers[0] == NULL_PTR) || (USART_DoubleBufferReq.buffers[1] == NULL_PTR) ||
+       (USART_DoubleBufferReq.CB == NULL_PTR))
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else if(USART_DoubleBufferReq.length == 0)
+    {
+        ErrorStatus = USART_InvalidLength;
+    }
+    else if((Rx_Req[USART_Number].state == Req_state_Busy) || (Rx_Ring[USART_Number].enabled == TRUE) ||
+            (Rx_DoubleBuffer[USART_Number].enabled == TRUE))
+    {
+        ErrorStatus = USART_Busy;
+    }
+    else
+    {
+        Double = &Rx_DoubleBuffer[USART_Number];
+        Double->buffers[0] = USART_DoubleBufferReq.buffers[0];
+        Double->buffers[1] = USART_DoubleBufferReq.buffers[1];
+        Double->length = USART_DoubleBufferReq.length;
+        Double->pos = 0;
+        Double->current = 0;
+        Double->held[0] = FALSE;
+        Double->held[1] = FALSE;
+        Double->paused = FALSE;
+        Double->gap = FALSE;
+        Double->errors = USART_ERROR_NONE;
+        Double->CallBack = USART_DoubleBufferReq.CB;
+        Double->Context = USART_DoubleBufferReq.Context;
+        Double->enabled = TRUE;
+        USART_discardStaleRx(USART_Number);
+        USART_fillDoubleBuffer(USART_Number);
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_releaseRxBuffer(u8 USART_Number, const u8* Buffer)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    Rx_DoubleBuffer_t* Double = NULL_PTR;
+    u8 idx = 0;
+    if(Buffer == NULL_PTR)
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else
+    {
+        Double = &Rx_DoubleBuffer[USART_Number];
+        idx = (Buffer == Double->buffers[0]) ? 0 : 1;
+        if((Double->enabled == FALSE) || (Buffer != Double->buffers[idx]) || (Double->held[idx] == FALSE))
+        {
+            ErrorStatus = USART_InvalidBuffer;
+        }
+        else
+        {
+            Double->held[idx] = FALSE;
+            /*A paused receive waits for this buffer, the interrupt drops the bytes until paused is cleared. It's
+              masked while the buffer changes, a byte arriving meanwhile waits in DR for the stream or the
+              interrupt of the new buffer instead of being stored by the interrupt ahead of the stream*/
+            if(Double->paused == TRUE)
+            {
+                USART_clearCR1Bit(USART_Number, USART_RXNEIE_BIT);
+                Double->current = idx;
+                Double->pos = 0;
+                Double->paused = FALSE;
+                USART_fillDoubleBuffer(USART_Number);
+            }
+        }
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_stopDoubleBufferRx(u8 USART_Number)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else if(Rx_DoubleBuffer[USART_Number].enabled == TRUE)
+    {
+        USART_clearCR1Bit(USART_Number, USART_RXNEIE_BIT);
+        USART_clearCR1Bit(USART_Number, USART_PEIE_BIT);
+        USART_clearCR3Bit(USART_Number, USART_CR3_DMAR_BIT);
+        USART_clearCR3Bit(USART_Number, USART_CR3_EIE_BIT);
+        if(Rx_Dma[USART_Number].active == TRUE)
+        {
+            DMA_stopTransfer(Rx_Dma[USART_Number].link.controller, Rx_Dma[USART_Number].link.stream);
+            Rx_Dma[USART_Number].active = FALSE;
+        }
+        Rx_DoubleBuffer[USART_Number].enabled = FALSE;
+    }
+    else
+    {
+        /*Nothing to stop*/
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_getRxAvailable(u8 USART_Number, u16* Available)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if(Available == NULL_PTR)
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else
+    {
+        *Available = (u16)(Rx_Ring[USART_Number].head - Rx_Ring[USART_Number].tail);
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_read(u8 USART_Number, u8* Data, u16 Length, u16* ReadLength)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if((Data == NULL_PTR) || (ReadLength == NULL_PTR))
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else
+    {
+        *ReadLength = USART_readRing(USART_Number, &Rx_Ring[USART_Number], Data, Length);
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_peekRx(u8 USART_Number, const u8** Data, u16* Length)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    Rx_Ring_t* Ring = NULL_PTR;
+    u32 tail = 0;
+    u32 available = 0;
+    if((Data == NULL_PTR) || (Length == NULL_PTR))
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else
+    {
+        Ring = &Rx_Ring[USART_Number];
+        tail = Ring->tail;
+        available = Ring->head - tail;
+        /*Up to the end of the buffer, the bytes after the wrap come with the next call*/
+        if(available > (USART_RX_RING_SIZE - (tail & USART_RX_RING_MASK)))
+        {
+            available = USART_RX_RING_SIZE - (tail & USART_RX_RING_MASK);
         }
+        /*The interrupt doesn't write the slots between tail and head until they're released*/
+        *Data = (const u8*)&Ring->buffer[tail & USART_RX_RING_MASK];
+        *Length = (u16)available;
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_consumeRx(u8 USART_Number, u16 Length)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else if(Length > (Rx_Ring[USART_Number].head - Rx_Ring[USART_Number].tail))
+    {
+        ErrorStatus = USART_InvalidLength;
+    }
+    else
+    {
+        USART_releaseRing(USART_Number, &Rx_Ring[USART_Number], Length);
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_getRxStats(u8 USART_Number, USART_RxStats_t* Stats)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if(Stats == NULL_PTR)
+    {
+        ErrorStatus = USART_NullPtr;
+    }
+    else if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else
+    {
+        Stats->highWaterMark = Rx_Stats[USART_Number].highWaterMark;
+        Stats->received = Rx_Stats[USART_Number].received;
+        Stats->dropped = Rx_Stats[USART_Number].dropped;
+        Stats->overruns = Rx_Stats[USART_Number].overruns;
+        Stats->parityErrors = Rx_Stats[USART_Number].parityErrors;
+        Stats->framingErrors = Rx_Stats[USART_Number].framingErrors;
+        Stats->noiseErrors = Rx_Stats[USART_Number].noiseErrors;
+        Stats->bufferOverruns = Rx_Stats[USART_Number].bufferOverruns;
+    }
+    return ErrorStatus;
+}
+
+USART_ErrorStatus_t USART_setErrorCallBack(u8 USART_Number, USART_CallBack_t CB, void* Context)
+{
+    USART_ErrorStatus_t ErrorStatus = USART_OK;
+    if(USART_Number >= NUMBER_OF_USART_INSTANCE)
+    {
+        ErrorStatus = USART_InvalidNumber;
+    }
+    else
+    {
+        /*Cleared first so the interrupt never pairs the new callback with the old context*/
+        Error_Notify[USART_Number].CallBack = NULL_PTR;
+        Error_Notify[USART_Number].Context = Context;
+        Error_Notify[USART_Number].CallBack = CB;
     }
-}
\ No newline at end of file
+    return ErrorStatus;
+}
+
+void USART1_IRQHandler(void)
+{
+    USART_IRQHandler(USART_NUMBER_1);
+}
+
+void USART2_IRQHandler(void)
+{
+    USART_IRQHandler(USART_NUMBER_2);
+}
+
+void USART6_IRQHandler(void)
+{
+    USART_IRQHandler(USART_NUMBER_6);
+}
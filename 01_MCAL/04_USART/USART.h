@@ -26,7 +26,7 @@
 #define USART_NUMBER_6                  2U
 
 #define USART_WORD_LEN_8                0x00000000 
-#define USART_WORD_LEN_9                0x00010000 
+#define USART_WORD_LEN_9                0x00001000      /*CR1 M, bit 12*/
 
 #define USART_OVERSAMPLING_16           0x00000000
 #define USART_OVERSAMPLING_8            0x00008000
@@ -42,21 +42,124 @@
 #define USART_STOP_BITS_2               0x00002000
 #define USART_STOP_BITS_1_HALF          0x00003000
 
+/*
+ * Baud Rate Macros:
+ * -----------------
+ * BRR holds USARTDIV in 12.4 fixed point with oversampling 16 and in 12.3 with oversampling 8, in both cases
+ * USARTDIV * 8 * (2 - OVER8) = CLK / BAUD, so the divider is CLK / BAUD rounded to the nearest and a rounded
+ * up fraction carries into the mantissa by itself.
+ * They are constant expressions for constant arguments: USART_Cfg.c computes BRR and checks the achieved
+ * baud rate error against USART_MAX_BAUD_ERROR_PPM_x at build time with USART_BRR_CFG.
+ */
+#define USART_BAUD_DIVIDER(CLK, BAUD)           (((u32)(CLK) + ((u32)(BAUD) / 2)) / (u32)(BAUD))
+#define USART_BRR(CLK, BAUD, OVERSAMPLING)      (((OVERSAMPLING) == USART_OVERSAMPLING_8) ?\
+                                                 (((USART_BAUD_DIVIDER(CLK, BAUD) & ~0x7UL) << 1) | (USART_BAUD_DIVIDER(CLK, BAUD) & 0x7UL)) :\
+                                                 USART_BAUD_DIVIDER(CLK, BAUD))
+/*Achieved baud rate error in parts per million: |CLK / DIVIDER - BAUD| / BAUD*/
+#define USART_BAUD_ERROR_PPM(CLK, BAUD)         ((((u64)USART_BAUD_DIVIDER(CLK, BAUD) * (BAUD) > (u64)(CLK)) ?\
+                                                  ((u64)USART_BAUD_DIVIDER(CLK, BAUD) * (BAUD) - (u64)(CLK)) :\
+                                                  ((u64)(CLK) - (u64)USART_BAUD_DIVIDER(CLK, BAUD) * (BAUD))) * 1000000ULL /\
+                                                 ((u64)USART_BAUD_DIVIDER(CLK, BAUD) * (BAUD)))
+#define USART_MAX_BAUD_ERROR_PPM(OVERSAMPLING)  (((OVERSAMPLING) == USART_OVERSAMPLING_8) ?\
+                                                 USART_MAX_BAUD_ERROR_PPM_8 : USART_MAX_BAUD_ERROR_PPM_16)
+/*The mantissa must be 1 to 4095 and the error under the configured limit*/
+#define USART_BAUD_VALID(CLK, BAUD, OVERSAMPLING) (((BAUD) != 0) &&\
+                                                   (USART_BAUD_DIVIDER(CLK, BAUD) >= (((OVERSAMPLING) == USART_OVERSAMPLING_8) ? 0x8UL : 0x10UL)) &&\
+                                                   (USART_BAUD_DIVIDER(CLK, BAUD) <= (((OVERSAMPLING) == USART_OVERSAMPLING_8) ? 0x7FFFUL : 0xFFFFUL)) &&\
+                                                   (USART_BAUD_ERROR_PPM(CLK, BAUD) <= USART_MAX_BAUD_ERROR_PPM(OVERSAMPLING)))
+/*Configuration fields of a baud rate, refuses to build if it can't be reached within the error limit*/
+#define USART_BRR_CFG(BAUD, OVERSAMPLING)       .USART_BaudRate = (BAUD),\
+                                                .USART_OverSampling = (OVERSAMPLING),\
+                                                .USART_BRR = USART_BRR(USART_CLK, BAUD, OVERSAMPLING) +\
+                                                    0 * sizeof(struct{_Static_assert(USART_BAUD_VALID(USART_CLK, BAUD, OVERSAMPLING),\
+                                                    "USART baud rate out of range or above USART_MAX_BAUD_ERROR_PPM"); int USART_Unused;})
+
+/*
+ * Mute Mode Wakeup:
+ * -----------------
+ * A muted receiver (USART_enterMute) sets no RXNE, so it takes no interrupt, until:
+ *   - IDLE_LINE: the line stays idle for one character, the node wakes for every frame.
+ *   - ADDRESS_MARK: a character with its most significant bit set (bit 8 of a 9 bit word without parity)
+ *     carries the address of a node in its 4 low bits, the node with that USART_Address wakes and receives
+ *     the address character and the data after it, the others stay muted. An address character for another
+ *     node mutes the receiver again on its own.
+ */
+#define USART_WAKEUP_IDLE_LINE          0x00000000
+#define USART_WAKEUP_ADDRESS_MARK       0x00000800
+#define USART_ADDRESS_MAX               0x0FU
+
+/*
+ * Auto Baud:
+ * ----------
+ * The USART of the F401 can't time its own line, so the RX pin is also wired to an ICU input configured in
+ * ICU_MODE_PULSE (e.g. PA10 jumpered to PA6, TIM3_CH1) and USART_startAutoBaud times the edges of the sync
+ * character USART_AUTOBAUD_SYNC ('U' in 8N1): its start bit and data bits alternate, so the line has an edge
+ * on each of the USART_AUTOBAUD_BITS bit boundaries from the start bit falling edge to the stop bit rising
+ * edge. The baud rate is programmed on that last edge, the stop bit leaves one bit time before the next start.
+ */
+#define USART_AUTOBAUD_SYNC             0x55U
+#define USART_AUTOBAUD_BITS             9U
+
+#define USART_FLOW_CONTROL_NONE         0x00000000
+#define USART_FLOW_CONTROL_RTS          0x00000100
+#define USART_FLOW_CONTROL_CTS          0x00000200
+#define USART_FLOW_CONTROL_RTS_CTS      0x00000300
+
+/*Completion record events*/
+#define USART_EVENT_DONE                0U      /*Buffer sent or filled, gather list sent*/
+#define USART_EVENT_HALF                1U      /*Half of the buffer transferred (HalfCB)*/
+#define USART_EVENT_IDLE                2U      /*Frame receive ended by an idle line*/
+#define USART_EVENT_ERROR               3U      /*Line errors detected (error callback)*/
+#define USART_EVENT_AUTOBAUD            4U      /*Baud rate detected and programmed (USART_startAutoBaud)*/
+
+/*Completion record error flags*/
+#define USART_ERROR_NONE                0x00U
+#define USART_ERROR_PARITY              0x01U
+#define USART_ERROR_FRAMING             0x02U
+#define USART_ERROR_NOISE               0x04U
+#define USART_ERROR_OVERRUN             0x08U
+#define USART_ERROR_DMA                 0x10U
+#define USART_ERROR_BUFFER_OVERRUN      0x20U   /*Bytes lost before this double buffer, the consumer fell behind*/
+
 
 
 /********************************************************************************************************/
 /************************************************Types***************************************************/
 /********************************************************************************************************/
-typedef void (*CallBack_t)(void);
+typedef struct
+{
+    u8 USART_Number;
+    u8 event;           /*USART_EVENT_x*/
+    u8 errors;          /*USART_ERROR_x flags seen during the request*/
+    u16 length;         /*Bytes transferred*/
+    void* Context;      /*The request context*/
+    u8* data;           /*The full buffer of a double buffered receive, NULL_PTR for other events*/
+}USART_Completion_t;
+
+typedef void (*USART_CallBack_t)(const USART_Completion_t* Completion);
 
 typedef struct{
     u8 USART_Number;
     u32 USART_BaudRate;
+    u32 USART_BRR;              /*BRR of the baud rate set by USART_BRR_CFG, 0 computes it at init*/
     u32 USART_WordLen;
     u32 USART_OverSampling;
     u32 USART_ParityControl;
     u32 USART_ParitySelection;
     u32 USART_StopBits;
+    boolean USART_DmaTx;        /*Send through a DMA stream when one of the instance streams is free*/
+    boolean USART_DmaRx;        /*Receive buffers (not the continuous ring) through a DMA stream*/
+    u32 USART_FlowControl;      /*Hardware RTS/CTS, USART_FLOW_CONTROL_x*/
+    void* USART_RtsPort;        /*RTS and CTS pins, only used when their flow control is enabled*/
+    u32 USART_RtsPin;
+    void* USART_CtsPort;
+    u32 USART_CtsPin;
+    boolean USART_HalfDuplex;   /*RS-485: the driver enable pin takes the bus from the first byte to TC of the last*/
+    void* USART_DePort;         /*Transceiver driver enable (DE) pin, only used in half duplex*/
+    u32 USART_DePin;
+    boolean USART_DeActiveLow;  /*FALSE for the usual active high DE*/
+    u32 USART_Wakeup;           /*Mute mode wakeup, USART_WAKEUP_x*/
+    u8 USART_Address;           /*Node address of the address mark wakeup, 0 to USART_ADDRESS_MAX*/
 }USART_Cfg_t;
 
 typedef struct
@@ -64,30 +167,407 @@ typedef struct
     u8 USART_Number;
     u8 *data;
     u16 length;
-    CallBack_t CB;
+    USART_CallBack_t CB;
+    USART_CallBack_t HalfCB;    /*Optional, called once half of the buffer is transferred*/
+    boolean frame;              /*Receive only, also completes on an idle line with the received length*/
+    void* Context;              /*Optional, handed back in the completion record*/
 }USART_Req_t;
 
+/*One piece of a gather list, sent in place*/
+typedef struct
+{
+    const u8 *data;
+    u16 length;
+}USART_Segment_t;
+
+typedef struct
+{
+    u8 USART_Number;
+    const USART_Segment_t *segments;
+    u8 count;
+    USART_CallBack_t CB;        /*Called once, after the last segment is sent*/
+    void* Context;
+}USART_GatherReq_t;
+
+/*Two buffers of a double buffered receive, filled in turn*/
+typedef struct
+{
+    u8 USART_Number;
+    u8 *buffers[2];
+    u16 length;                 /*Size of each buffer*/
+    USART_CallBack_t CB;        /*Called with each full buffer*/
+    void* Context;
+}USART_DoubleBufferReq_t;
+
+typedef struct
+{
+    u16 highWaterMark;      /*Most bytes waiting in the continuous receive ring at once*/
+    u32 received;
+    u32 dropped;            /*Bytes lost because the ring was full or no receive was pending*/
+    u32 overruns;           /*Bytes lost by the hardware before the interrupt read the previous one (ORE)*/
+    u32 parityErrors;
+    u32 framingErrors;      /*Stop bit missing: baud rate mismatch, noise or a break*/
+    u32 noiseErrors;
+    u32 bufferOverruns;     /*Double buffers filled while the other one was still held by the consumer*/
+}USART_RxStats_t;
+
+/*Opaque instance of a configuration entry accepted by USART_init, see USART_getHandle*/
+typedef const struct USART_Instance* USART_Handle_t;
+
 typedef enum{
     USART_OK,
     USART_InvalidNumber,
     USART_InvalidBaudRate,
     USART_NullPtr,
     USART_Busy,
-    USART_TimeOut
+    USART_TimeOut,
+    USART_InvalidLength,
+    USART_InvalidAddress,
+    USART_InvalidCapture,
+    USART_InvalidBuffer,
+    USART_InvalidConfig,
+    USART_InvalidTimeout
 }USART_ErrorStatus_t;
 
 
 /********************************************************************************************************/
 /************************************************APIs****************************************************/
 /********************************************************************************************************/
+/*****************************************************
+ * Function: USART_init
+ * Description: Configures the instance of each USART_Cfg entry and binds a handle to it. An entry is
+ *              skipped, without a handle, when its USART_Number isn't an instance, another entry already
+ *              took the instance, a field isn't one of its USART_x values or the baud rate can't be reached.
+ *
+ * Return:
+ *   - USART_OK, or the error of the last skipped entry: USART_InvalidNumber, USART_InvalidConfig or
+ *     USART_InvalidBaudRate.
+ *****************************************************/
 USART_ErrorStatus_t USART_init(void);
 
+/*****************************************************
+ * Function: USART_getHandle
+ * Description: Gets the handle of a configuration entry (its USART_Cfg index, e.g. USART1), for the
+ *              handle APIs below.
+ *
+ * Return:
+ *   - USART_OK, USART_NullPtr, USART_InvalidNumber if the index is past the table or USART_InvalidConfig
+ *     if USART_init skipped the entry or didn't run.
+ *****************************************************/
+USART_ErrorStatus_t USART_getHandle(u8 USART_CfgIndex, USART_Handle_t* Handle);
+
+/*****************************************************
+ * Function: USART_getNumber
+ * Description: Gets the USART_NUMBER_x of a handle, for the APIs taking an instance number.
+ *****************************************************/
+USART_ErrorStatus_t USART_getNumber(USART_Handle_t Handle, u8* USART_Number);
+
+/*****************************************************
+ * Function: USART_send
+ * Description: USART_sendBufferAsyncZC through a handle: posts Data to the transmit queue, it's sent in
+ *              place and CB is called once it's out.
+ *
+ * Return:
+ *   - USART_OK, USART_NullPtr, USART_InvalidLength or USART_Busy if the transmit queue is full.
+ *
+ * Notes:
+ *   - A handle comes from a validated entry, so the handle APIs don't check the instance number again.
+ *****************************************************/
+USART_ErrorStatus_t USART_send(USART_Handle_t Handle, u8* Data, u16 Length, USART_CallBack_t CB, void* Context);
+
+/*****************************************************
+ * Function: USART_receive / USART_available
+ * Description: USART_read and USART_getRxAvailable through a handle, on the continuous receive ring.
+ *****************************************************/
+USART_ErrorStatus_t USART_receive(USART_Handle_t Handle, u8* Data, u16 Length, u16* ReadLength);
+
+USART_ErrorStatus_t USART_available(USART_Handle_t Handle, u16* Available);
+
+/*****************************************************
+ * Function: USART_setBaudRate
+ * Description: Changes the baud rate at runtime, with the oversampling set by the configuration.
+ *
+ * Return:
+ *   - USART_OK, USART_InvalidNumber or USART_InvalidBaudRate if it can't be reached within
+ *     USART_MAX_BAUD_ERROR_PPM_x.
+ *
+ * Notes:
+ *   - Change it while the line is idle, a byte on the wire would be corrupted.
+ *****************************************************/
+USART_ErrorStatus_t USART_setBaudRate(u8 USART_Number, u32 BaudRate);
+
+/*****************************************************
+ * Function: USART_getBaudRate
+ * Description: Reads the baud rate BRR achieves (USART_CLK over the divider), e.g. after a detection.
+ *
+ * Return:
+ *   - USART_OK, USART_NullPtr or USART_InvalidNumber.
+ *****************************************************/
+USART_ErrorStatus_t USART_getBaudRate(u8 USART_Number, u32* BaudRate);
+
+/*****************************************************
+ * Function: USART_startAutoBaud
+ * Description: Disables the receiver and times the edges of the RX line on an ICU input until they match a
+ *              sync character (USART_AUTOBAUD_SYNC), then programs its baud rate with USART_setBaudRate,
+ *              enables the receiver again and calls CB with the USART_EVENT_AUTOBAUD event, all from the ICU
+ *              interrupt at the start of the sync character stop bit.
+ *
+ * Parameters:
+ *   - ICU_Name: The ICU input wired to the RX pin, in ICU_MODE_PULSE.
+ *
+ * Return:
+ *   - USART_OK, USART_InvalidNumber, USART_InvalidCapture if ICU_Name isn't an ICU input or USART_Busy if a
+ *     USART_recieveBufferAsyncZC request is pending.
+ *
+ * Notes:
+ *   - Detection completes within the sync character: only the sync character itself isn't received, the
+ *     continuous ring gets everything after it. Send it again if a detection is missed.
+ *   - Each edge is checked within a quarter bit of its boundary, with its direction, so other characters and
+ *     glitches don't match. A baud rate out of USART_MAX_BAUD_ERROR_PPM_x keeps the detection running.
+ *   - The ICU interrupt must take the edges as they come (its two capture channels hold one edge each) and
+ *     run within the stop bit, which limits the rate to what the ICU interrupt and its priority allow.
+ *   - Call it again to restart a detection, the baud rate stays the previous one until a sync matches.
+ *   - Several instances may watch the same ICU input, its edge callback is released after the last detection.
+ *****************************************************/
+USART_ErrorStatus_t USART_startAutoBaud(u8 USART_Number, u8 ICU_Name, USART_CallBack_t CB, void* Context);
+
+/*****************************************************
+ * Function: USART_sendBlocking
+ * Description: Sends Length bytes by polling the status register, each byte is written as soon as TXE frees
+ *              the data register and the function returns once TC reports the last stop bit on the line.
+ *
+ * Parameters:
+ *   - TimeoutUS: Time allowed for the whole transfer, measured on the DWT cycle counter, up to DWT_MAX_US
+ *     (268 s at 16 MHz).
+ *
+ * Return:
+ *   - USART_OK, USART_NullPtr, USART_InvalidNumber, USART_InvalidLength, USART_InvalidTimeout above
+ *     DWT_MAX_US, USART_TimeOut (e.g. CTS held deasserted) or USART_Busy if an asynchronous transmit is
+ *     pending or queued.
+ *
+ * Notes:
+ *   - DWT_init must have started the cycle counter.
+ *   - A half duplex instance asserts its DE pin before the first byte and releases it after TC (or the timeout).
+ *****************************************************/
+USART_ErrorStatus_t USART_sendBlocking(u8 USART_Number, const u8* Data, u16 Length, u32 TimeoutUS);
+
+/*****************************************************
+ * Function: USART_sendAddress
+ * Description: Sends an address character (the address with the address mark bit set) by polling, the
+ *              node configured with that address wakes from mute mode and the others stay muted.
+ *
+ * Return:
+ *   - USART_OK, USART_InvalidNumber, USART_InvalidAddress if it's above USART_ADDRESS_MAX,
+ *     USART_InvalidTimeout if TimeoutUS is above DWT_MAX_US, USART_TimeOut or USART_Busy if an asynchronous
+ *     transmit is pending or queued.
+ *
+ * Notes:
+ *   - The mark is the most significant data bit: bit 8 of a 9 bit word (USART_WORD_LEN_9) without parity,
+ *     bit 7 of an 8 bit word, one lower with parity. Send the frame data after it with any send API.
+ *****************************************************/
+USART_ErrorStatus_t USART_sendAddress(u8 USART_Number, u8 Address, u32 TimeoutUS);
+
+/*****************************************************
+ * Function: USART_enterMute
+ * Description: Mutes the receiver until the configured wakeup (USART_Wakeup): the next idle line, or an
+ *              address character with the instance USART_Address.
+ *
+ * Return:
+ *   - USART_OK or USART_InvalidNumber.
+ *
+ * Notes:
+ *   - With the idle line wakeup call it once a frame turns out to be for another node, the receiver sleeps
+ *     through the rest of it. It needs one character received since startup to take effect.
+ *   - With the address mark wakeup call it once at startup, the hardware mutes again on every address
+ *     character for another node. It has no effect while a received byte waits in DR.
+ *   - The received address character keeps only its 8 low bits, like any other byte.
+ *****************************************************/
+USART_ErrorStatus_t USART_enterMute(u8 USART_Number);
+
+/*****************************************************
+ * Function: USART_sendByte
+ * Description: Sends the first byte of the request with USART_sendBlocking and USART_BYTE_TIMEOUT_US.
+ *****************************************************/
 USART_ErrorStatus_t USART_sendByte(USART_Req_t USART_Req);
 
+/*****************************************************
+ * Function: USART_recieveByte
+ * Description: Waits up to USART_BYTE_TIMEOUT_US for RXNE and reads the received byte.
+ *
+ * Return:
+ *   - USART_OK, USART_NullPtr, USART_InvalidNumber, USART_TimeOut or USART_Busy if an asynchronous receive
+ *     or the continuous ring owns the receiver.
+ *
+ * Notes:
+ *   - A byte already waiting in DR is returned, a byte that was overrun before the call is discarded.
+ *****************************************************/
 USART_ErrorStatus_t USART_recieveByte(USART_Req_t USART_Req);
 
+/*****************************************************
+ * Function: USART_sendBufferAsyncZC
+ * Description: Posts a buffer to the instance transmit queue without copying it, the queued requests are
+ *              sent back to back by the instance DMA stream (USART_DmaTx) or by the transmit interrupt when
+ *              no stream could be allocated, each request callback is called once it's sent.
+ *
+ * Return:
+ *   - USART_OK, USART_NullPtr, USART_InvalidNumber, USART_InvalidLength or USART_Busy if
+ *     USART_TX_QUEUE_SIZE requests are already pending.
+ *
+ * Notes:
+ *   - The buffer must stay valid until its callback is called.
+ *   - The queue is single producer: post from the thread context only, not from interrupts.
+ *   - A half duplex instance asserts its DE pin before the first byte of an idle queue and releases it in the
+ *     TC interrupt once the queue is empty, requests posted before that go out without releasing the bus.
+ *     The callback comes with the last byte in the shift register, before the release.
+ *****************************************************/
 USART_ErrorStatus_t USART_sendBufferAsyncZC(USART_Req_t USART_Req);
 
+/*****************************************************
+ * Function: USART_sendGatherAsyncZC
+ * Description: Posts a gather list (e.g. header, payload and CRC) as one transmit request, the segments are
+ *              sent in order straight from their buffers by the interrupt or the DMA stream, with no copy into
+ *              a contiguous buffer, and the request callback is called once after the last segment.
+ *
+ * Return:
+ *   - USART_OK, USART_NullPtr, USART_InvalidNumber, USART_InvalidLength (no segments or an empty segment)
+ *     or USART_Busy if USART_TX_QUEUE_SIZE requests are already pending.
+ *
+ * Notes:
+ *   - The segments array and every segment buffer must stay valid until the callback is called.
+ *   - On the DMA path the stream is restarted for each segment.
+ *****************************************************/
+USART_ErrorStatus_t USART_sendGatherAsyncZC(USART_GatherReq_t USART_GatherReq);
+
+/*****************************************************
+ * Function: USART_recieveBufferAsyncZC
+ * Description: Receives length bytes into the caller buffer through the instance DMA stream (USART_DmaRx)
+ *              or the receive interrupt when no stream could be allocated, then calls the request callback.
+ *              With frame set the request also completes when the line stays idle for one character
+ *              after the last received byte, with the USART_EVENT_IDLE event and the received length.
+ *
+ * Return:
+ *   - USART_OK, USART_NullPtr, USART_InvalidNumber, USART_InvalidLength or USART_Busy.
+ *
+ * Notes:
+ *   - The completion errors report the parity, framing, noise and overrun errors of the received bytes.
+ *****************************************************/
 USART_ErrorStatus_t USART_recieveBufferAsyncZC(USART_Req_t USART_Req);
 
+/*****************************************************
+ * Function: USART_startContinuousRx
+ * Description: Keeps the receiver running and stores every received byte in the instance ring buffer
+ *              (USART_RX_RING_SIZE bytes) until USART_stopContinuousRx, the bytes are taken with USART_read
+ *              or in place with USART_peekRx and USART_consumeRx.
+ *
+ * Return:
+ *   - USART_OK, USART_InvalidNumber or USART_Busy if a USART_recieveBufferAsyncZC request is pending or a
+ *     double buffered receive runs.
+ *
+ * Notes:
+ *   - Bytes received while the ring is full are dropped and counted in the statistics.
+ *   - With RTS flow control a full ring stops the sender instead: the next byte is left in the data register,
+ *     which keeps RTS deasserted until USART_read (or USART_consumeRx) brings the ring down to
+ *     USART_RX_RTS_RESUME_LEVEL.
+ *****************************************************/
+USART_ErrorStatus_t USART_startContinuousRx(u8 USART_Number);
+
+USART_ErrorStatus_t USART_stopContinuousRx(u8 USART_Number);
+
+/*****************************************************
+ * Function: USART_startDoubleBufferRx
+ * Description: Keeps the receiver filling the two request buffers in turn, through the instance DMA stream
+ *              (USART_DmaRx) or the receive interrupt when no stream could be allocated. Each full buffer goes
+ *              to the request callback in the completion record (data, length) without a copy while the other
+ *              one fills, and stays the consumer's until USART_releaseRxBuffer.
+ *
+ * Return:
+ *   - USART_OK, USART_NullPtr, USART_InvalidNumber, USART_InvalidLength or USART_Busy if a receive request,
+ *     the continuous ring or a double buffered receive owns the receiver.
+ *
+ * Notes:
+ *   - The DMA variant restarts its stream on the other buffer from the stream interrupt, the data register
+ *     holds the next byte meanwhile, so the restart has one character time.
+ *   - A buffer that fills while the other one is still held counts a buffer overrun: the receiver drops the
+ *     bytes (counted as dropped) until the release, the held buffer is never written, and the next buffer
+ *     handed over carries USART_ERROR_BUFFER_OVERRUN.
+ *   - The completion errors report the line errors received in that buffer.
+ *****************************************************/
+USART_ErrorStatus_t USART_startDoubleBufferRx(USART_DoubleBufferReq_t USART_DoubleBufferReq);
+
+/*****************************************************
+ * Function: USART_releaseRxBuffer
+ * Description: Gives a full buffer of the double buffered receive back to the driver once the consumer is done
+ *              with it, it can be released from the callback itself.
+ *
+ * Return:
+ *   - USART_OK, USART_NullPtr, USART_InvalidNumber or USART_InvalidBuffer if it isn't a held buffer of the
+ *     instance.
+ *****************************************************/
+USART_ErrorStatus_t USART_releaseRxBuffer(u8 USART_Number, const u8* Buffer);
+
+/*****************************************************
+ * Function: USART_stopDoubleBufferRx
+ * Description: Stops the double buffered receive, the bytes of the buffer being filled are discarded.
+ *****************************************************/
+USART_ErrorStatus_t USART_stopDoubleBufferRx(u8 USART_Number);
+
+/*****************************************************
+ * Function: USART_getRxAvailable
+ * Description: Reads how many received bytes are waiting in the ring.
+ *****************************************************/
+USART_ErrorStatus_t USART_getRxAvailable(u8 USART_Number, u16* Available);
+
+/*****************************************************
+ * Function: USART_read
+ * Description: Copies up to Length waiting bytes out of the ring without blocking.
+ *
+ * Parameters:
+ *   - ReadLength: Receives the number of copied bytes, 0 if nothing was waiting.
+ *
+ * Notes:
+ *   - Single consumer: call it from one context only.
+ *****************************************************/
+USART_ErrorStatus_t USART_read(u8 USART_Number, u8* Data, u16 Length, u16* ReadLength);
+
+/*****************************************************
+ * Function: USART_peekRx
+ * Description: Points Data at the oldest waiting bytes, in place in the ring, without copying or taking them.
+ *
+ * Parameters:
+ *   - Length: Receives the number of contiguous bytes at Data, 0 if nothing was waiting. The bytes after the
+ *     end of the ring buffer come with the next call once these are consumed.
+ *
+ * Notes:
+ *   - The bytes stay valid until USART_consumeRx releases them, the interrupt keeps filling the free slots.
+ *   - Single consumer, with USART_read and USART_consumeRx.
+ *****************************************************/
+USART_ErrorStatus_t USART_peekRx(u8 USART_Number, const u8** Data, u16* Length);
+
+/*****************************************************
+ * Function: USART_consumeRx
+ * Description: Releases the Length oldest waiting bytes of the ring, after USART_peekRx.
+ *
+ * Return:
+ *   - USART_OK, USART_InvalidNumber or USART_InvalidLength if fewer bytes are waiting.
+ *****************************************************/
+USART_ErrorStatus_t USART_consumeRx(u8 USART_Number, u16 Length);
+
+/*****************************************************
+ * Function: USART_getRxStats
+ * Description: Reads the receive statistics (high-water mark, received, dropped and overrun bytes) and
+ *              the line errors counters (parity, framing and noise).
+ *****************************************************/
+USART_ErrorStatus_t USART_getRxStats(u8 USART_Number, USART_RxStats_t* Stats);
+
+/*****************************************************
+ * Function: USART_setErrorCallBack
+ * Description: Sets the instance callback of the line errors, it's called from the interrupt with the
+ *              USART_EVENT_ERROR event and the USART_ERROR_x flags of each erroneous byte, NULL_PTR removes it.
+ *
+ * Notes:
+ *   - Overruns are cleared by the driver whether a callback is set or not.
+ *   - During a DMA receive the errors are reported through the error interrupts (EIE and PEIE).
+ *****************************************************/
+USART_ErrorStatus_t USART_setErrorCallBack(u8 USART_Number, USART_CallBack_t CB, void* Context);
+
 #endif // D__ITI_STM32F401CC_DRIVERS_INC_MCAL_UART_USART_H_
\ No newline at end of file
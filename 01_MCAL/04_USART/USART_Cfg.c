@@ -21,12 +21,14 @@
 const USART_Cfg_t USART_Cfg[_USART_Num] = {
     [USART1]={
         .USART_Number = USART_NUMBER_1,
-        .USART_BaudRate = 9600,
+        USART_BRR_CFG(9600, USART_OVERSAMPLING_8),
         .USART_WordLen = USART_WORD_LEN_8,
-        .USART_OverSampling = USART_OVERSAMPLING_8,
         .USART_ParityControl = USART_PARITY_CONTROL_DISABLE,
         .USART_ParitySelection = USART_PARITY_CONTROL_DISABLE,
-        .USART_StopBits = USART_STOPBITS_1
+        .USART_StopBits = USART_STOPBITS_1,
+        .USART_DmaTx = TRUE,
+        .USART_DmaRx = TRUE,
+        .USART_FlowControl = USART_FLOW_CONTROL_NONE
     }
 };
 
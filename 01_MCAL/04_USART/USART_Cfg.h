@@ -18,6 +18,14 @@
 /************************************************Defines*************************************************/
 /********************************************************************************************************/
 #define USART_CLK           16000000
+/*Highest baud rate error accepted for each oversampling, the receiver tolerance is about 3.75% at 16
+  and 3.4% at 8 with an ideal peer, half of it is left for the peer clock*/
+#define USART_MAX_BAUD_ERROR_PPM_16 18000
+#define USART_MAX_BAUD_ERROR_PPM_8  16000
+#define USART_TX_QUEUE_SIZE 8           /*Pending transmit requests per instance, must be a power of two*/
+#define USART_RX_RING_SIZE  256         /*Continuous receive buffer per instance, must be a power of two*/
+#define USART_BYTE_TIMEOUT_US       10000      /*USART_sendByte and USART_recieveByte timeout*/
+#define USART_RX_RTS_RESUME_LEVEL   (USART_RX_RING_SIZE / 2)   /*Waiting bytes under which a full ring lets RTS back*/
 
 enum{
     USART1,
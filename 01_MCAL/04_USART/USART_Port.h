@@ -0,0 +1,49 @@
+/******************************************************************************
+*
+* Module: USART
+*
+* File Name: USART_Port.h
+*
+* Description: Register access port of the USART driver for builds without the peripheral
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef D__ITI_STM32F401CC_DRIVERS_INC_MCAL_USART_USART_PORT_H_
+#define D__ITI_STM32F401CC_DRIVERS_INC_MCAL_USART_USART_PORT_H_
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "LIB/std_types.h"
+
+/********************************************************************************************************/
+/*********************************************APIs Prototypes********************************************/
+/********************************************************************************************************/
+/*
+ * With HOST_BUILD the driver reads SR and DR and writes DR through these functions instead of the register
+ * block, the host peripheral model implements them with the side effects plain memory can't have (a DR
+ * write starts the shift register, a DR read clears RXNE, the SR then DR sequence clears TC, ORE and IDLE).
+ * The other registers stay plain memory (USART_MockRegisters). The target build doesn't use this port.
+ */
+
+/*****************************************************
+ * Function: USART_Port_readSR
+ * Description: Status register of the instance after the model caught up with the current time.
+ *****************************************************/
+u32 USART_Port_readSR(u8 USART_Number);
+
+/*****************************************************
+ * Function: USART_Port_readDR
+ * Description: Received data register of the instance, reading it clears RXNE (and ORE, IDLE and the
+ *              error flags after an SR read).
+ *****************************************************/
+u32 USART_Port_readDR(u8 USART_Number);
+
+/*****************************************************
+ * Function: USART_Port_writeDR
+ * Description: Writes the transmit data register of the instance (clears TC after an SR read).
+ *****************************************************/
+void USART_Port_writeDR(u8 USART_Number, u32 Value);
+
+#endif /* D__ITI_STM32F401CC_DRIVERS_INC_MCAL_USART_USART_PORT_H_ */
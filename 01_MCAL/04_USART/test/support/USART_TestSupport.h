@@ -0,0 +1,181 @@
+/******************************************************************************
+*
+* Module: USART
+*
+* File Name: USART_TestSupport.h
+*
+* Description: Register mock and line simulation shared by the USART test suites
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef USART_TESTSUPPORT_H_
+#define USART_TESTSUPPORT_H_
+
+#include "USART.h"
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define NUMBER_OF_USART_INSTANCE        3
+
+/*SR*/
+#define USART_SR_PE                     0x00000001
+#define USART_SR_FE                     0x00000002
+#define USART_SR_ORE                    0x00000008
+#define USART_SR_IDLE                   0x00000010
+#define USART_SR_RXNE                   0x00000020
+#define USART_SR_TC                     0x00000040
+#define USART_SR_TXE                    0x00000080
+
+/*CR1*/
+#define USART_CR1_RWU                   0x00000002
+#define USART_RX_ENABLE                 0x00000004
+#define USART_TX_ENABLE                 0x00000008
+#define USART_IDLEIE_ENABLE             0x00000010
+#define USART_RXNEIE_ENABLE             0x00000020
+#define USART_TCIE_ENABLE               0x00000040
+#define USART_TXEIE_ENABLE              0x00000080
+#define USART_CR1_WAKE                  0x00000800
+
+/*CR2, CR3 and DR*/
+#define USART_CR2_ADD_MASK              0x0000000F
+#define USART_CR3_DMAR                  0x00000040
+#define USART_CR3_DMAT                  0x00000080
+#define USART_ADDRESS_MARK_9            0x00000100
+
+#define USART_TEST_MAX_INTERRUPTS       1000    /*Bounds the transmit loops of a broken driver*/
+
+/*
+ * Frame fields of a suite configuration entry, the suites add the fields of the feature they test:
+ *   [USART1] = {USART_TEST_CFG(USART_NUMBER_1, 115200, USART_WORD_LEN_8, USART_OVERSAMPLING_16), .USART_DmaTx = TRUE}
+ */
+#define USART_TEST_CFG(NUMBER, BAUD, WORD_LEN, OVERSAMPLING) \
+    .USART_Number = (NUMBER),                                 \
+    .USART_BaudRate = (BAUD),                                 \
+    .USART_WordLen = (WORD_LEN),                              \
+    .USART_OverSampling = (OVERSAMPLING),                     \
+    .USART_ParityControl = USART_PARITY_CONTROL_DISABLE,      \
+    .USART_ParitySelection = USART_PARITY_CONTROL_DISABLE,    \
+    .USART_StopBits = USART_STOPBITS_1
+
+#define USART_TEST_CFG_8N1(NUMBER, BAUD)    USART_TEST_CFG(NUMBER, BAUD, USART_WORD_LEN_8, USART_OVERSAMPLING_16)
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+/*Register block of USART.c, its instances are redirected to USART_MockRegisters under TEST*/
+typedef struct
+{
+    volatile u32 SR;
+    volatile u32 DR;
+    volatile u32 BRR;
+    volatile u32 CR1;
+    volatile u32 CR2;
+    volatile u32 CR3;
+    volatile u32 GTPR;
+}USART_Registers_t;
+
+extern USART_Registers_t USART_MockRegisters[NUMBER_OF_USART_INSTANCE];
+extern void USART1_IRQHandler(void);
+extern void USART2_IRQHandler(void);
+extern void USART6_IRQHandler(void);
+
+/********************************************************************************************************/
+/*******************************************Line Simulation**********************************************/
+/********************************************************************************************************/
+static inline void USART_TestIRQ(u8 USART_Number)
+{
+    if(USART_Number == USART_NUMBER_1)
+    {
+        USART1_IRQHandler();
+    }
+    else if(USART_Number == USART_NUMBER_2)
+    {
+        USART2_IRQHandler();
+    }
+    else
+    {
+        USART6_IRQHandler();
+    }
+}
+
+/*A word arriving on the line sets RXNE (and Status) and enters the handler when RXNEIE is enabled, the flags
+  are dropped afterwards like the handler read of DR does. Returns TRUE if the handler was entered*/
+static inline boolean USART_SimulateRxWord(u8 USART_Number, u16 Word, u32 Status)
+{
+    USART_Registers_t* Usart = &USART_MockRegisters[USART_Number];
+    boolean entered = FALSE;
+    Usart->DR = Word;
+    Usart->SR |= USART_SR_RXNE | Status;
+    if(Usart->CR1 & USART_RXNEIE_ENABLE)
+    {
+        USART_TestIRQ(USART_Number);
+        entered = TRUE;
+    }
+    Usart->SR &= ~(USART_SR_RXNE | Status);
+    return entered;
+}
+
+static inline void USART_SimulateRx(u8 USART_Number, const u8* Data, u32 Length, u32 Status)
+{
+    u32 idx = 0;
+    for(idx = 0; idx < Length; idx++)
+    {
+        USART_SimulateRxWord(USART_Number, Data[idx], Status);
+    }
+}
+
+/*One character time without a start bit sets IDLE*/
+static inline void USART_SimulateIdle(u8 USART_Number)
+{
+    USART_Registers_t* Usart = &USART_MockRegisters[USART_Number];
+    Usart->SR |= USART_SR_IDLE;
+    if(Usart->CR1 & USART_IDLEIE_ENABLE)
+    {
+        USART_TestIRQ(USART_Number);
+    }
+    Usart->SR &= ~USART_SR_IDLE;
+}
+
+/*One TXE interrupt, returns TRUE with the word the handler wrote to DR if it wrote one*/
+static inline boolean USART_SimulateTxe(u8 USART_Number, u16* Word)
+{
+    USART_Registers_t* Usart = &USART_MockRegisters[USART_Number];
+    boolean written = FALSE;
+    Usart->DR = 0xFFFF;
+    Usart->SR |= USART_SR_TXE;
+    USART_TestIRQ(USART_Number);
+    if(Usart->DR != 0xFFFF)
+    {
+        *Word = (u16)Usart->DR;
+        written = TRUE;
+    }
+    return written;
+}
+
+/*TXE interrupts move DR to Wire (when not NULL) until the handler disables them, returns the interrupts count*/
+static inline u32 USART_SimulateTx(u8 USART_Number, u8* Wire, u32* WireLength, u32 WireSize)
+{
+    u32 interrupts = 0;
+    u16 word = 0;
+    while((USART_MockRegisters[USART_Number].CR1 & USART_TXEIE_ENABLE) && (interrupts < USART_TEST_MAX_INTERRUPTS))
+    {
+        if((USART_SimulateTxe(USART_Number, &word) == TRUE) && (Wire != NULL_PTR) && (*WireLength < WireSize))
+        {
+            Wire[(*WireLength)++] = (u8)word;
+        }
+        interrupts++;
+    }
+    return interrupts;
+}
+
+/*The last stop bit left the shift register*/
+static inline void USART_SimulateTc(u8 USART_Number)
+{
+    USART_MockRegisters[USART_Number].SR = USART_SR_TXE | USART_SR_TC;
+    USART_TestIRQ(USART_Number);
+}
+
+#endif /* USART_TESTSUPPORT_H_ */
@@ -0,0 +1,582 @@
+#ifdef TEST
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "unity.h"
+#include "USART.h"
+#include "USART_TestSupport.h"
+#include "DWT.h"
+#include "mock_DMA.h"
+#include "mock_GPIO.h"
+
+#define BENCH_BYTES                     2000000
+#define BENCH_BLOCK                     64
+
+const USART_Cfg_t USART_Cfg[_USART_Num] = {
+    [USART1] = {USART_TEST_CFG_8N1(USART_NUMBER_1, 9600)}
+};
+
+static u8 wire[64];
+static u32 wireLen;
+static u32 txCallBackCount;
+static u32 dataRegisterAtCallBack[8];
+static USART_Completion_t lastCompletion;
+
+static void USART_TxCallBack(const USART_Completion_t* Completion)
+{
+    lastCompletion = *Completion;
+    if(txCallBackCount < 8)
+    {
+        dataRegisterAtCallBack[txCallBackCount] = USART_MockRegisters[USART_NUMBER_1].DR;
+    }
+    txCallBackCount++;
+}
+
+/*Transmits through the shared line model onto the suite wire, returns the interrupts count*/
+static u32 Line_transmit(void)
+{
+    return USART_SimulateTx(USART_NUMBER_1, wire, &wireLen, sizeof(wire));
+}
+
+static u32 rxCallBackCount;
+
+static void USART_RxCallBack(const USART_Completion_t* Completion)
+{
+    lastCompletion = *Completion;
+    rxCallBackCount++;
+}
+
+static USART_ErrorStatus_t USART_post(u8* data, u16 length)
+{
+    USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = data, .length = length, .CB = USART_TxCallBack};
+    return USART_sendBufferAsyncZC(Req);
+}
+
+void setUp(void)
+{
+    Line_transmit();     /*Drain anything a previous test left queued*/
+    USART_stopContinuousRx(USART_NUMBER_1);
+    rxCallBackCount = 0;
+    memset(&lastCompletion, 0xFF, sizeof(lastCompletion));
+    memset(USART_MockRegisters, 0, sizeof(USART_MockRegisters));
+    memset(wire, 0, sizeof(wire));
+    wireLen = 0;
+    txCallBackCount = 0;
+    USART_init();
+}
+
+void tearDown(void)
+{
+}
+
+void test_USART_init_keepsTransmitterEnabled(void)
+{
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_TX_ENABLE);
+}
+
+void test_USART_init_computesRuntimeBRR(void)
+{
+    /*16 MHz / 9600 = 1666.67: USARTDIV 104.17, mantissa 104 and fraction 3/16*/
+    TEST_ASSERT_EQUAL_HEX32(0x683, USART_MockRegisters[USART_NUMBER_1].BRR);
+}
+
+void test_USART_BRR_macros(void)
+{
+    /*Oversampling 8: USARTDIV 208.33, mantissa 208 and fraction 3/8*/
+    TEST_ASSERT_EQUAL_HEX32(0xD03, USART_BRR(16000000, 9600, USART_OVERSAMPLING_8));
+    TEST_ASSERT_EQUAL_HEX32(0x08B, USART_BRR(16000000, 115200, USART_OVERSAMPLING_16));
+    /*USARTDIV 1.998: the fraction rounds up to 16/16 and carries into the mantissa*/
+    TEST_ASSERT_EQUAL_HEX32(0x020, USART_BRR(16000000, 500469, USART_OVERSAMPLING_16));
+    TEST_ASSERT_EQUAL_HEX32(0x010, USART_BRR(16000000, 2000000, USART_OVERSAMPLING_8));
+    TEST_ASSERT_EQUAL(799, USART_BAUD_ERROR_PPM(16000000, 115200));      /*139 * 115200 = 16012800*/
+    TEST_ASSERT_TRUE(USART_BAUD_VALID(16000000, 2000000, USART_OVERSAMPLING_8));
+    TEST_ASSERT_FALSE(USART_BAUD_VALID(16000000, 2000000, USART_OVERSAMPLING_16));
+    TEST_ASSERT_FALSE(USART_BAUD_VALID(16000000, 921600, USART_OVERSAMPLING_8));
+    TEST_ASSERT_FALSE(USART_BAUD_VALID(16000000, 0, USART_OVERSAMPLING_16));
+}
+
+void test_USART_setBaudRate(void)
+{
+    TEST_ASSERT_EQUAL(USART_OK, USART_setBaudRate(USART_NUMBER_1, 115200));
+    TEST_ASSERT_EQUAL_HEX32(0x08B, USART_MockRegisters[USART_NUMBER_1].BRR);
+    TEST_ASSERT_EQUAL(USART_InvalidBaudRate, USART_setBaudRate(USART_NUMBER_1, 2000000));
+    TEST_ASSERT_EQUAL_HEX32(0x08B, USART_MockRegisters[USART_NUMBER_1].BRR);
+    TEST_ASSERT_EQUAL(USART_InvalidNumber, USART_setBaudRate(NUMBER_OF_USART_INSTANCE, 9600));
+}
+
+void test_USART_init_keepsReceiverEnabled(void)
+{
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RX_ENABLE);
+}
+
+void test_USART_sendBlocking_writesEveryByte(void)
+{
+    const u8 data[] = "xyz";
+    USART_MockRegisters[USART_NUMBER_1].SR = USART_SR_TXE | USART_SR_TC;
+    TEST_ASSERT_EQUAL(USART_OK, USART_sendBlocking(USART_NUMBER_1, data, 3, 1000));
+    TEST_ASSERT_EQUAL('z', USART_MockRegisters[USART_NUMBER_1].DR);
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_TX_ENABLE);
+}
+
+void test_USART_sendBlocking_timesOutWithoutTXE(void)
+{
+    const u8 data[] = "x";
+    USART_MockRegisters[USART_NUMBER_1].SR = 0;
+    TEST_ASSERT_EQUAL(USART_TimeOut, USART_sendBlocking(USART_NUMBER_1, data, 1, 100));
+    USART_MockRegisters[USART_NUMBER_1].SR = USART_SR_TXE;
+    TEST_ASSERT_EQUAL(USART_TimeOut, USART_sendBlocking(USART_NUMBER_1, data, 1, 100));
+}
+
+static u32 cycleReads;
+
+/*10 us of core cycles pass between two reads*/
+static u32 USART_TestCycles(void)
+{
+    return (cycleReads++) * DWT_US_TO_CYCLES(10);
+}
+
+void test_USART_sendBlocking_timeoutFollowsTheCycleSource(void)
+{
+    const u8 data[] = "x";
+    cycleReads = 0;
+    DWT_setCycleSource(USART_TestCycles);
+    USART_MockRegisters[USART_NUMBER_1].SR = 0;
+    TEST_ASSERT_EQUAL(USART_TimeOut, USART_sendBlocking(USART_NUMBER_1, data, 1, 100));
+    DWT_setCycleSource(NULL_PTR);
+    /*The start time, then one read per TXE poll until 100 us elapsed*/
+    TEST_ASSERT_EQUAL(11, cycleReads);
+}
+
+void test_USART_sendBlocking_invalidArgumentsAndBusy(void)
+{
+    u8 data[] = "x";
+    USART_MockRegisters[USART_NUMBER_1].SR = USART_SR_TXE | USART_SR_TC;
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_sendBlocking(USART_NUMBER_1, NULL_PTR, 1, 100));
+    TEST_ASSERT_EQUAL(USART_InvalidNumber, USART_sendBlocking(NUMBER_OF_USART_INSTANCE, data, 1, 100));
+    TEST_ASSERT_EQUAL(USART_InvalidLength, USART_sendBlocking(USART_NUMBER_1, data, 0, 100));
+    TEST_ASSERT_EQUAL(USART_InvalidTimeout, USART_sendBlocking(USART_NUMBER_1, data, 1, DWT_MAX_US + 1));
+    TEST_ASSERT_EQUAL(USART_InvalidTimeout, USART_sendAddress(USART_NUMBER_1, 1, DWT_MAX_US + 1));
+    TEST_ASSERT_EQUAL(USART_OK, USART_sendBlocking(USART_NUMBER_1, data, 1, DWT_MAX_US));
+    TEST_ASSERT_EQUAL(USART_OK, USART_post(data, 1));
+    TEST_ASSERT_EQUAL(USART_Busy, USART_sendBlocking(USART_NUMBER_1, data, 1, 100));
+}
+
+void test_USART_recieveByte_waitsForRXNE(void)
+{
+    u8 data = 0;
+    USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = &data};
+    USART_MockRegisters[USART_NUMBER_1].DR = 'r';
+    USART_MockRegisters[USART_NUMBER_1].SR = USART_SR_RXNE;
+    TEST_ASSERT_EQUAL(USART_OK, USART_recieveByte(Req));
+    TEST_ASSERT_EQUAL('r', data);
+    USART_MockRegisters[USART_NUMBER_1].SR = 0;
+    TEST_ASSERT_EQUAL(USART_TimeOut, USART_recieveByte(Req));
+    USART_startContinuousRx(USART_NUMBER_1);
+    TEST_ASSERT_EQUAL(USART_Busy, USART_recieveByte(Req));
+}
+
+void test_USART_sendBufferAsyncZC_invalidArguments(void)
+{
+    u8 data[2] = {1, 2};
+    USART_Req_t Req = {.USART_Number = NUMBER_OF_USART_INSTANCE, .data = data, .length = 2, .CB = USART_TxCallBack};
+    TEST_ASSERT_EQUAL(USART_InvalidNumber, USART_sendBufferAsyncZC(Req));
+    Req.USART_Number = USART_NUMBER_1;
+    Req.length = 0;
+    TEST_ASSERT_EQUAL(USART_InvalidLength, USART_sendBufferAsyncZC(Req));
+    Req.data = NULL_PTR;
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_sendBufferAsyncZC(Req));
+}
+
+void test_USART_sendBufferAsyncZC_queuesWhileBusy(void)
+{
+    u8 first[] = "ab";
+    u8 second[] = "cde";
+    u8 third[] = "f";
+    TEST_ASSERT_EQUAL(USART_OK, USART_post(first, 2));
+    TEST_ASSERT_EQUAL(USART_OK, USART_post(second, 3));
+    TEST_ASSERT_EQUAL(USART_OK, USART_post(third, 1));
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_TXEIE_ENABLE);
+
+    Line_transmit();
+    TEST_ASSERT_EQUAL(6, wireLen);
+    TEST_ASSERT_EQUAL_MEMORY("abcdef", wire, 6);
+    TEST_ASSERT_EQUAL(3, txCallBackCount);
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_TXEIE_ENABLE);
+}
+
+void test_USART_sendBufferAsyncZC_chainsWithoutIdleInterrupt(void)
+{
+    u8 first[] = "ab";
+    u8 second[] = "cd";
+    USART_post(first, 2);
+    USART_post(second, 2);
+    /*One interrupt per byte plus the final one that disables TXE, no interrupt is spent between the requests*/
+    TEST_ASSERT_EQUAL(5, Line_transmit());
+    /*The first byte of the second request is already loaded when the first request callback runs*/
+    TEST_ASSERT_EQUAL('c', dataRegisterAtCallBack[0]);
+    TEST_ASSERT_EQUAL(0xFFFF, dataRegisterAtCallBack[1]);
+}
+
+void test_USART_sendBufferAsyncZC_queueFull(void)
+{
+    u8 data[] = "x";
+    u32 idx = 0;
+    for(idx = 0; idx < USART_TX_QUEUE_SIZE; idx++)
+    {
+        TEST_ASSERT_EQUAL(USART_OK, USART_post(data, 1));
+    }
+    TEST_ASSERT_EQUAL(USART_Busy, USART_post(data, 1));
+    Line_transmit();
+    TEST_ASSERT_EQUAL(USART_TX_QUEUE_SIZE, txCallBackCount);
+    TEST_ASSERT_EQUAL(USART_OK, USART_post(data, 1));
+}
+
+void test_USART_sendBufferAsyncZC_restartsAfterIdle(void)
+{
+    u8 data[] = "zz";
+    USART_post(data, 2);
+    Line_transmit();
+    USART_post(data, 1);
+    Line_transmit();
+    TEST_ASSERT_EQUAL(3, wireLen);
+    TEST_ASSERT_EQUAL(2, txCallBackCount);
+}
+
+void test_USART_sendGatherAsyncZC_sendsSegmentsInPlace(void)
+{
+    const u8 header[] = {0x7E, 0x03};
+    const u8 payload[] = "abc";
+    const u8 crc[] = {0x12, 0x34};
+    const USART_Segment_t segments[] = {{header, 2}, {payload, 3}, {crc, 2}};
+    USART_GatherReq_t Req = {.USART_Number = USART_NUMBER_1, .segments = segments, .count = 3, .CB = USART_TxCallBack};
+    u8 tail[] = "z";
+    TEST_ASSERT_EQUAL(USART_OK, USART_sendGatherAsyncZC(Req));
+    TEST_ASSERT_EQUAL(USART_OK, USART_post(tail, 1));
+    /*One interrupt per byte plus the final one, moving to the next segment costs no interrupt*/
+    TEST_ASSERT_EQUAL(9, Line_transmit());
+    TEST_ASSERT_EQUAL(8, wireLen);
+    TEST_ASSERT_EQUAL_MEMORY("\x7E\x03" "abc" "\x12\x34" "z", wire, 8);
+    TEST_ASSERT_EQUAL(2, txCallBackCount);
+    TEST_ASSERT_EQUAL('z', dataRegisterAtCallBack[0]);
+    TEST_ASSERT_EQUAL(1, lastCompletion.length);
+}
+
+void test_USART_sendGatherAsyncZC_invalidArguments(void)
+{
+    const u8 data[] = "ab";
+    USART_Segment_t segments[] = {{data, 2}, {data, 0}};
+    USART_GatherReq_t Req = {.USART_Number = USART_NUMBER_1, .segments = segments, .count = 2, .CB = USART_TxCallBack};
+    TEST_ASSERT_EQUAL(USART_InvalidLength, USART_sendGatherAsyncZC(Req));
+    segments[1].length = 2;
+    segments[1].data = NULL_PTR;
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_sendGatherAsyncZC(Req));
+    Req.count = 0;
+    TEST_ASSERT_EQUAL(USART_InvalidLength, USART_sendGatherAsyncZC(Req));
+    Req.CB = NULL_PTR;
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_sendGatherAsyncZC(Req));
+    TEST_ASSERT_EQUAL(0, Line_transmit());
+}
+
+void test_USART_continuousRx_readsInOrder(void)
+{
+    u8 out[8] = {0};
+    u16 readLength = 0;
+    u16 available = 0;
+    TEST_ASSERT_EQUAL(USART_OK, USART_startContinuousRx(USART_NUMBER_1));
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"hello", 5, 0);
+    USART_getRxAvailable(USART_NUMBER_1, &available);
+    TEST_ASSERT_EQUAL(5, available);
+
+    TEST_ASSERT_EQUAL(USART_OK, USART_read(USART_NUMBER_1, out, 3, &readLength));
+    TEST_ASSERT_EQUAL(3, readLength);
+    TEST_ASSERT_EQUAL_MEMORY("hel", out, 3);
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"!", 1, 0);
+    TEST_ASSERT_EQUAL(USART_OK, USART_read(USART_NUMBER_1, out, sizeof(out), &readLength));
+    TEST_ASSERT_EQUAL(3, readLength);
+    TEST_ASSERT_EQUAL_MEMORY("lo!", out, 3);
+    TEST_ASSERT_EQUAL(USART_OK, USART_read(USART_NUMBER_1, out, sizeof(out), &readLength));
+    TEST_ASSERT_EQUAL(0, readLength);
+}
+
+void test_USART_continuousRx_wrapsAround(void)
+{
+    u8 in[USART_RX_RING_SIZE / 2 + 1];
+    u8 out[USART_RX_RING_SIZE / 2 + 1];
+    u16 readLength = 0;
+    u32 round = 0;
+    USART_startContinuousRx(USART_NUMBER_1);
+    for(round = 0; round < 4; round++)
+    {
+        memset(in, 'a' + round, sizeof(in));
+        USART_SimulateRx(USART_NUMBER_1, in, sizeof(in), 0);
+        USART_read(USART_NUMBER_1, out, sizeof(out), &readLength);
+        TEST_ASSERT_EQUAL(sizeof(in), readLength);
+        TEST_ASSERT_EQUAL_MEMORY(in, out, sizeof(in));
+    }
+}
+
+void test_USART_continuousRx_peekAndConsumeInPlace(void)
+{
+    u8 in[USART_RX_RING_SIZE - 2];
+    const u8* data = NULL_PTR;
+    u16 length = 0;
+    u16 available = 0;
+    memset(in, 'a', sizeof(in));
+    USART_startContinuousRx(USART_NUMBER_1);
+    USART_SimulateRx(USART_NUMBER_1, in, sizeof(in), 0);
+    TEST_ASSERT_EQUAL(USART_OK, USART_consumeRx(USART_NUMBER_1, sizeof(in)));
+    /*Four bytes from two slots before the end of the buffer: the first peek stops at the wrap*/
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"wxyz", 4, 0);
+    TEST_ASSERT_EQUAL(USART_OK, USART_peekRx(USART_NUMBER_1, &data, &length));
+    TEST_ASSERT_EQUAL(2, length);
+    TEST_ASSERT_EQUAL_MEMORY("wx", data, 2);
+    TEST_ASSERT_EQUAL(USART_OK, USART_consumeRx(USART_NUMBER_1, 1));
+    USART_getRxAvailable(USART_NUMBER_1, &available);
+    TEST_ASSERT_EQUAL(3, available);
+    TEST_ASSERT_EQUAL(USART_OK, USART_peekRx(USART_NUMBER_1, &data, &length));
+    TEST_ASSERT_EQUAL(1, length);
+    TEST_ASSERT_EQUAL('x', data[0]);
+    TEST_ASSERT_EQUAL(USART_OK, USART_consumeRx(USART_NUMBER_1, 1));
+    TEST_ASSERT_EQUAL(USART_OK, USART_peekRx(USART_NUMBER_1, &data, &length));
+    TEST_ASSERT_EQUAL(2, length);
+    TEST_ASSERT_EQUAL_MEMORY("yz", data, 2);
+    TEST_ASSERT_EQUAL(USART_InvalidLength, USART_consumeRx(USART_NUMBER_1, 3));
+    TEST_ASSERT_EQUAL(USART_OK, USART_consumeRx(USART_NUMBER_1, 2));
+    TEST_ASSERT_EQUAL(USART_OK, USART_peekRx(USART_NUMBER_1, &data, &length));
+    TEST_ASSERT_EQUAL(0, length);
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_peekRx(USART_NUMBER_1, NULL_PTR, &length));
+    TEST_ASSERT_EQUAL(USART_InvalidNumber, USART_consumeRx(NUMBER_OF_USART_INSTANCE, 0));
+}
+
+void test_USART_continuousRx_fullRingDropsAndCounts(void)
+{
+    USART_RxStats_t before;
+    USART_RxStats_t after;
+    u8 in[USART_RX_RING_SIZE + 3];
+    u16 available = 0;
+    memset(in, 0x55, sizeof(in));
+    USART_getRxStats(USART_NUMBER_1, &before);
+    USART_startContinuousRx(USART_NUMBER_1);
+    USART_SimulateRx(USART_NUMBER_1, in, sizeof(in), 0);
+    USART_getRxStats(USART_NUMBER_1, &after);
+    USART_getRxAvailable(USART_NUMBER_1, &available);
+    TEST_ASSERT_EQUAL(USART_RX_RING_SIZE, available);
+    TEST_ASSERT_EQUAL(3, after.dropped - before.dropped);
+    TEST_ASSERT_EQUAL(USART_RX_RING_SIZE, after.highWaterMark);
+}
+
+void test_USART_continuousRx_countsOverrun(void)
+{
+    USART_RxStats_t before;
+    USART_RxStats_t after;
+    USART_getRxStats(USART_NUMBER_1, &before);
+    USART_startContinuousRx(USART_NUMBER_1);
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"x", 1, USART_SR_ORE);
+    USART_getRxStats(USART_NUMBER_1, &after);
+    TEST_ASSERT_EQUAL(1, after.overruns - before.overruns);
+    TEST_ASSERT_EQUAL(1, after.received - before.received);
+}
+
+void test_USART_continuousRx_excludesRequestReceive(void)
+{
+    u8 data[4];
+    USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = data, .length = 4, .CB = USART_RxCallBack};
+    USART_startContinuousRx(USART_NUMBER_1);
+    TEST_ASSERT_EQUAL(USART_Busy, USART_recieveBufferAsyncZC(Req));
+    USART_stopContinuousRx(USART_NUMBER_1);
+    TEST_ASSERT_EQUAL(USART_OK, USART_recieveBufferAsyncZC(Req));
+    TEST_ASSERT_EQUAL(USART_Busy, USART_startContinuousRx(USART_NUMBER_1));
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"abcd", 4, 0);
+}
+
+void test_USART_recieveBufferAsyncZC_completesOnLastByte(void)
+{
+    u8 data[3] = {0};
+    USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = data, .length = 3, .CB = USART_RxCallBack};
+    TEST_ASSERT_EQUAL(USART_OK, USART_recieveBufferAsyncZC(Req));
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"abc", 3, 0);
+    TEST_ASSERT_EQUAL(1, rxCallBackCount);
+    TEST_ASSERT_EQUAL_MEMORY("abc", data, 3);
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RXNEIE_ENABLE);
+}
+
+void test_USART_recieveBufferAsyncZC_frameCompletesOnIdle(void)
+{
+    u8 data[16] = {0};
+    USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = data, .length = 16, .CB = USART_RxCallBack, .frame = TRUE};
+    TEST_ASSERT_EQUAL(USART_OK, USART_recieveBufferAsyncZC(Req));
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_IDLEIE_ENABLE);
+    USART_SimulateIdle(USART_NUMBER_1);
+    TEST_ASSERT_EQUAL(0, rxCallBackCount);
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"ping", 4, 0);
+    TEST_ASSERT_EQUAL(0, rxCallBackCount);
+    USART_SimulateIdle(USART_NUMBER_1);
+    TEST_ASSERT_EQUAL(1, rxCallBackCount);
+    TEST_ASSERT_EQUAL(4, lastCompletion.length);
+    TEST_ASSERT_EQUAL(USART_EVENT_IDLE, lastCompletion.event);
+    TEST_ASSERT_EQUAL_MEMORY("ping", data, 4);
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & (USART_RXNEIE_ENABLE | USART_IDLEIE_ENABLE));
+    TEST_ASSERT_EQUAL(USART_OK, USART_recieveBufferAsyncZC(Req));
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"x", 1, 0);
+    USART_SimulateIdle(USART_NUMBER_1);
+    TEST_ASSERT_EQUAL(2, rxCallBackCount);
+    TEST_ASSERT_EQUAL(1, lastCompletion.length);
+}
+
+void test_USART_recieveBufferAsyncZC_frameCompletesOnFullBuffer(void)
+{
+    u8 data[3] = {0};
+    USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = data, .length = 3, .CB = USART_RxCallBack, .frame = TRUE};
+    TEST_ASSERT_EQUAL(USART_OK, USART_recieveBufferAsyncZC(Req));
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"abc", 3, 0);
+    TEST_ASSERT_EQUAL(1, rxCallBackCount);
+    TEST_ASSERT_EQUAL(3, lastCompletion.length);
+    TEST_ASSERT_EQUAL(USART_EVENT_DONE, lastCompletion.event);
+    USART_SimulateIdle(USART_NUMBER_1);
+    TEST_ASSERT_EQUAL(1, rxCallBackCount);
+}
+
+void test_USART_recieveBufferAsyncZC_withoutFrameIgnoresIdle(void)
+{
+    u8 data[4] = {0};
+    USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = data, .length = 4, .CB = USART_RxCallBack};
+    TEST_ASSERT_EQUAL(USART_OK, USART_recieveBufferAsyncZC(Req));
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_IDLEIE_ENABLE);
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"ab", 2, 0);
+    USART_SimulateIdle(USART_NUMBER_1);
+    TEST_ASSERT_EQUAL(0, rxCallBackCount);
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"cd", 2, 0);
+    TEST_ASSERT_EQUAL(1, rxCallBackCount);
+}
+
+void test_USART_IRQHandler_servesByteAndIdleFromOneStatus(void)
+{
+    u8 data[8] = {0};
+    USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = data, .length = 8, .CB = USART_RxCallBack, .frame = TRUE};
+    TEST_ASSERT_EQUAL(USART_OK, USART_recieveBufferAsyncZC(Req));
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"ab", 2, 0);
+    /*The last byte and the idle line are both pending when the interrupt is entered*/
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"c", 1, USART_SR_IDLE);
+    TEST_ASSERT_EQUAL(1, rxCallBackCount);
+    TEST_ASSERT_EQUAL(3, lastCompletion.length);
+    TEST_ASSERT_EQUAL_MEMORY("abc", data, 3);
+    USART_MockRegisters[USART_NUMBER_1].SR &= ~USART_SR_IDLE;
+}
+
+/*Host time of the shared handler per received and per sent byte, on the mocked registers. With an idle
+  transmitter SR reads TXE and TC on every receive interrupt, as on the target*/
+void test_USART_IRQHandler_benchmarkPerByte(void)
+{
+    static u8 block[BENCH_BLOCK];
+    char message[128];
+    u16 readLength = 0;
+    u32 idx = 0;
+    u32 sent = 0;
+    clock_t start = 0;
+    double rxSeconds = 0;
+    double txSeconds = 0;
+    TEST_ASSERT_EQUAL(USART_OK, USART_startContinuousRx(USART_NUMBER_1));
+    start = clock();
+    for(idx = 0; idx < BENCH_BYTES; idx++)
+    {
+        USART_MockRegisters[USART_NUMBER_1].DR = (u8)idx;
+        USART_MockRegisters[USART_NUMBER_1].SR = USART_SR_RXNE | USART_SR_TXE | USART_SR_TC;
+        USART1_IRQHandler();
+        if((idx % BENCH_BLOCK) == (BENCH_BLOCK - 1))
+        {
+            USART_read(USART_NUMBER_1, block, BENCH_BLOCK, &readLength);
+        }
+    }
+    rxSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    TEST_ASSERT_EQUAL(BENCH_BLOCK, readLength);
+    start = clock();
+    while(sent < BENCH_BYTES)
+    {
+        TEST_ASSERT_EQUAL(USART_OK, USART_post(block, BENCH_BLOCK));
+        while(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_TXEIE_ENABLE)
+        {
+            USART_MockRegisters[USART_NUMBER_1].SR = USART_SR_TXE;
+            USART1_IRQHandler();
+        }
+        sent += BENCH_BLOCK;
+    }
+    txSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    snprintf(message, sizeof(message), "USART1_IRQHandler %.2f ns per received byte, %.2f ns per sent byte",
+             rxSeconds * 1e9 / BENCH_BYTES, txSeconds * 1e9 / sent);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_EQUAL(sent / BENCH_BLOCK, txCallBackCount);
+}
+
+static u32 errorCallBackCount;
+
+static void USART_ErrorCallBack(const USART_Completion_t* Completion)
+{
+    lastCompletion = *Completion;
+    errorCallBackCount++;
+}
+
+void test_USART_errors_countedAndReported(void)
+{
+    USART_RxStats_t before;
+    USART_RxStats_t after;
+    u32 context = 0;
+    errorCallBackCount = 0;
+    USART_getRxStats(USART_NUMBER_1, &before);
+    TEST_ASSERT_EQUAL(USART_OK, USART_setErrorCallBack(USART_NUMBER_1, USART_ErrorCallBack, &context));
+    USART_startContinuousRx(USART_NUMBER_1);
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"a", 1, USART_SR_FE);
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"b", 1, 0);
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"c", 1, USART_SR_PE | USART_SR_ORE);
+    USART_getRxStats(USART_NUMBER_1, &after);
+    TEST_ASSERT_EQUAL(2, errorCallBackCount);
+    TEST_ASSERT_EQUAL(USART_EVENT_ERROR, lastCompletion.event);
+    TEST_ASSERT_EQUAL(USART_ERROR_PARITY | USART_ERROR_OVERRUN, lastCompletion.errors);
+    TEST_ASSERT_EQUAL_PTR(&context, lastCompletion.Context);
+    TEST_ASSERT_EQUAL(1, after.framingErrors - before.framingErrors);
+    TEST_ASSERT_EQUAL(1, after.parityErrors - before.parityErrors);
+    TEST_ASSERT_EQUAL(1, after.overruns - before.overruns);
+    TEST_ASSERT_EQUAL(3, after.received - before.received);
+    TEST_ASSERT_EQUAL(USART_OK, USART_setErrorCallBack(USART_NUMBER_1, NULL_PTR, NULL_PTR));
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"d", 1, USART_SR_FE);
+    TEST_ASSERT_EQUAL(2, errorCallBackCount);
+    TEST_ASSERT_EQUAL(USART_InvalidNumber, USART_setErrorCallBack(NUMBER_OF_USART_INSTANCE, NULL_PTR, NULL_PTR));
+}
+
+void test_USART_completion_reportsInstanceContextAndLength(void)
+{
+    u8 first[] = "abc";
+    u8 second[] = "de";
+    u32 firstContext = 0;
+    u32 secondContext = 0;
+    USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = first, .length = 3, .CB = USART_TxCallBack,
+                       .Context = &firstContext};
+    TEST_ASSERT_EQUAL(USART_OK, USART_sendBufferAsyncZC(Req));
+    Req.data = second;
+    Req.length = 2;
+    Req.Context = &secondContext;
+    TEST_ASSERT_EQUAL(USART_OK, USART_sendBufferAsyncZC(Req));
+    Line_transmit();
+    TEST_ASSERT_EQUAL(USART_NUMBER_1, lastCompletion.USART_Number);
+    TEST_ASSERT_EQUAL(USART_EVENT_DONE, lastCompletion.event);
+    TEST_ASSERT_EQUAL(USART_ERROR_NONE, lastCompletion.errors);
+    TEST_ASSERT_EQUAL(2, lastCompletion.length);
+    TEST_ASSERT_EQUAL_PTR(&secondContext, lastCompletion.Context);
+}
+
+void test_USART_completion_reportsReceiveErrors(void)
+{
+    u8 data[3] = {0};
+    USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = data, .length = 3, .CB = USART_RxCallBack};
+    TEST_ASSERT_EQUAL(USART_OK, USART_recieveBufferAsyncZC(Req));
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"a", 1, 0);
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"b", 1, USART_SR_ORE);
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"c", 1, 0);
+    TEST_ASSERT_EQUAL(1, rxCallBackCount);
+    TEST_ASSERT_EQUAL(USART_ERROR_OVERRUN, lastCompletion.errors);
+    TEST_ASSERT_EQUAL(USART_OK, USART_recieveBufferAsyncZC(Req));
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"abc", 3, 0);
+    TEST_ASSERT_EQUAL(USART_ERROR_NONE, lastCompletion.errors);
+}
+
+#endif // TEST
@@ -0,0 +1,257 @@
+#ifdef TEST
+
+#include <string.h>
+#include "unity.h"
+#include "USART.h"
+#include "USART_TestSupport.h"
+#include "mock_DMA.h"
+#include "mock_GPIO.h"
+#include "mock_ICU.h"
+
+#define RX_CAPTURE                      ICU_PulseTrain
+#define LINE_START_TICKS                1000000ULL
+#define FRAME_BITS                      10
+
+const USART_Cfg_t USART_Cfg[_USART_Num] = {
+    [USART1] = {USART_TEST_CFG_8N1(USART_NUMBER_1, 9600)}
+};
+
+static ICU_EdgeCallBack_t edgeCallBack;
+static u64 lineTime;
+static u32 detections;
+static u32 edgesAtDetection;
+static u32 edgesSent;
+static boolean receiverOffDuringSync;
+static u32 secondDetections;
+static u32 armSecondAtEdge;
+
+ICU_ErrorStatus_t ICU_setEdgeCallBack_Callback(u8 ICU_Name, ICU_EdgeCallBack_t CB, int cmock_num_calls)
+{
+    ICU_ErrorStatus_t ErrorStatus = ICU_OK;
+    if(ICU_Name >= _ICU_Num)
+    {
+        ErrorStatus = ICU_InvalidName;
+    }
+    else
+    {
+        edgeCallBack = CB;
+    }
+    return ErrorStatus;
+}
+
+static void AutoBaud_done(const USART_Completion_t* Completion)
+{
+    TEST_ASSERT_EQUAL(USART_NUMBER_1, Completion->USART_Number);
+    TEST_ASSERT_EQUAL(USART_EVENT_AUTOBAUD, Completion->event);
+    TEST_ASSERT_EQUAL_PTR(&detections, Completion->Context);
+    detections++;
+    edgesAtDetection = edgesSent;
+}
+
+static void AutoBaud_secondDone(const USART_Completion_t* Completion)
+{
+    TEST_ASSERT_EQUAL(USART_NUMBER_2, Completion->USART_Number);
+    secondDetections++;
+}
+
+static void Line_edge(u64 Ticks, u8 Edge)
+{
+    ICU_Edge_t Captured = {.ICU_Timestamp = Ticks, .ICU_Edge = Edge};
+    if(edgeCallBack != NULL_PTR)
+    {
+        if(detections == 0)
+        {
+            receiverOffDuringSync = ((USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RX_ENABLE) == 0) ? receiverOffDuringSync : FALSE;
+        }
+        edgesSent++;
+        if(edgesSent == armSecondAtEdge)
+        {
+            /*Another instance listens to the same input from the middle of the character*/
+            TEST_ASSERT_EQUAL(USART_OK, USART_startAutoBaud(USART_NUMBER_2, RX_CAPTURE, AutoBaud_secondDone, NULL_PTR));
+        }
+        edgeCallBack(RX_CAPTURE, &Captured);
+    }
+}
+
+/*
+ * Puts an 8N1 character on the line at BaudRate from lineTime (ICU ticks) and reports its edges, with
+ * Swapped the edge pairs come rising first like two captures served by one ICU interrupt.
+ */
+static void Line_sendChar(u8 Data, u32 BaudRate, boolean Swapped)
+{
+    u8 levels[FRAME_BITS];
+    u64 times[FRAME_BITS];
+    u8 edges[FRAME_BITS];
+    u8 count = 0;
+    u8 previous = 1;
+    u8 bit = 0;
+    levels[0] = 0;
+    for(bit = 0; bit < 8; bit++)
+    {
+        levels[bit + 1] = (Data >> bit) & 1U;
+    }
+    levels[FRAME_BITS - 1] = 1;
+    for(bit = 0; bit < FRAME_BITS; bit++)
+    {
+        if(levels[bit] != previous)
+        {
+            times[count] = lineTime + ((((u64)bit * ICU_TICK_FREQUENCY) + (BaudRate / 2)) / BaudRate);
+            edges[count] = (levels[bit] == 1) ? ICU_EDGE_RISING : ICU_EDGE_FALLING;
+            count++;
+        }
+        previous = levels[bit];
+    }
+    for(bit = 0; bit < count; bit++)
+    {
+        if((Swapped == TRUE) && ((bit + 1) < count) && ((bit & 1U) == 0))
+        {
+            Line_edge(times[bit + 1], edges[bit + 1]);
+            Line_edge(times[bit], edges[bit]);
+            bit++;
+        }
+        else
+        {
+            Line_edge(times[bit], edges[bit]);
+        }
+    }
+    lineTime += (((u64)FRAME_BITS * ICU_TICK_FREQUENCY) + (BaudRate / 2)) / BaudRate;
+}
+
+static void AutoBaud_assertDetected(u32 BaudRate)
+{
+    u32 detected = 0;
+    TEST_ASSERT_EQUAL(1, detections);
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RX_ENABLE);
+    TEST_ASSERT_NULL(edgeCallBack);
+    TEST_ASSERT_EQUAL(USART_OK, USART_getBaudRate(USART_NUMBER_1, &detected));
+    /*16 MHz ticks time the 9 bits close enough to land on the divider of the exact baud rate*/
+    TEST_ASSERT_EQUAL_HEX32(USART_BRR(USART_CLK, BaudRate, USART_OVERSAMPLING_16), USART_MockRegisters[USART_NUMBER_1].BRR);
+    TEST_ASSERT_UINT32_WITHIN((u32)(((u64)BaudRate * USART_MAX_BAUD_ERROR_PPM_16) / 1000000), BaudRate, detected);
+}
+
+void setUp(void)
+{
+    USART_stopContinuousRx(USART_NUMBER_1);
+    memset(USART_MockRegisters, 0, sizeof(USART_MockRegisters));
+    ICU_setEdgeCallBack_StubWithCallback(ICU_setEdgeCallBack_Callback);
+    USART_init();
+    edgeCallBack = NULL_PTR;
+    lineTime = LINE_START_TICKS;
+    detections = 0;
+    edgesAtDetection = 0;
+    edgesSent = 0;
+    receiverOffDuringSync = TRUE;
+    secondDetections = 0;
+    armSecondAtEdge = 0;
+}
+
+void tearDown(void)
+{
+}
+
+void test_USART_getBaudRate_readsBackBRR(void)
+{
+    u32 baudRate = 0;
+    TEST_ASSERT_EQUAL(USART_OK, USART_getBaudRate(USART_NUMBER_1, &baudRate));
+    TEST_ASSERT_UINT32_WITHIN(9600 / 1000, 9600, baudRate);
+    USART_MockRegisters[USART_NUMBER_1].CR1 |= USART_OVERSAMPLING_8;
+    TEST_ASSERT_EQUAL(USART_OK, USART_setBaudRate(USART_NUMBER_1, 115200));
+    TEST_ASSERT_EQUAL(USART_OK, USART_getBaudRate(USART_NUMBER_1, &baudRate));
+    TEST_ASSERT_UINT32_WITHIN(115200 / 100, 115200, baudRate);
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_getBaudRate(USART_NUMBER_1, NULL_PTR));
+    TEST_ASSERT_EQUAL(USART_InvalidNumber, USART_getBaudRate(NUMBER_OF_USART_INSTANCE, &baudRate));
+}
+
+void test_USART_startAutoBaud_checksItsArguments(void)
+{
+    TEST_ASSERT_EQUAL(USART_InvalidNumber, USART_startAutoBaud(NUMBER_OF_USART_INSTANCE, RX_CAPTURE, AutoBaud_done, &detections));
+    TEST_ASSERT_EQUAL(USART_InvalidCapture, USART_startAutoBaud(USART_NUMBER_1, _ICU_Num, AutoBaud_done, &detections));
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RX_ENABLE);
+    TEST_ASSERT_EQUAL(USART_OK, USART_startAutoBaud(USART_NUMBER_1, RX_CAPTURE, AutoBaud_done, &detections));
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RX_ENABLE);
+    TEST_ASSERT_NOT_NULL(edgeCallBack);
+}
+
+/*The baud rate is programmed on the stop bit edge of the sync character, the last of its 10 edges*/
+void test_USART_autoBaud_detectsWithinTheSyncCharacter(void)
+{
+    static const u32 BaudRates[] = {1200, 9600, 19200, 57600, 115200, 230400};
+    u8 idx = 0;
+    for(idx = 0; idx < (sizeof(BaudRates) / sizeof(BaudRates[0])); idx++)
+    {
+        detections = 0;
+        edgesSent = 0;
+        receiverOffDuringSync = TRUE;
+        TEST_ASSERT_EQUAL(USART_OK, USART_startAutoBaud(USART_NUMBER_1, RX_CAPTURE, AutoBaud_done, &detections));
+        Line_sendChar(USART_AUTOBAUD_SYNC, BaudRates[idx], FALSE);
+        TEST_ASSERT_EQUAL(USART_AUTOBAUD_BITS + 1, edgesAtDetection);
+        TEST_ASSERT_TRUE(receiverOffDuringSync);
+        AutoBaud_assertDetected(BaudRates[idx]);
+    }
+}
+
+void test_USART_autoBaud_ignoresOtherCharacters(void)
+{
+    static const u8 Noise[] = {'A', 0x00, 0xF0, 0x33, 0x5A, 0xAA};
+    u8 idx = 0;
+    TEST_ASSERT_EQUAL(USART_OK, USART_startAutoBaud(USART_NUMBER_1, RX_CAPTURE, AutoBaud_done, &detections));
+    for(idx = 0; idx < sizeof(Noise); idx++)
+    {
+        Line_sendChar(Noise[idx], 115200, FALSE);
+    }
+    /*A glitch, then a 2 bit wide start bit of another rate*/
+    Line_edge(lineTime, ICU_EDGE_FALLING);
+    Line_edge(lineTime + 3, ICU_EDGE_RISING);
+    lineTime += 5000;
+    Line_sendChar(0x54, 115200, FALSE);
+    TEST_ASSERT_EQUAL(0, detections);
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RX_ENABLE);
+    TEST_ASSERT_EQUAL_HEX32(USART_BRR(USART_CLK, 9600, USART_OVERSAMPLING_16), USART_MockRegisters[USART_NUMBER_1].BRR);
+
+    Line_sendChar(USART_AUTOBAUD_SYNC, 57600, FALSE);
+    AutoBaud_assertDetected(57600);
+}
+
+void test_USART_autoBaud_acceptsEdgesServedByOneInterrupt(void)
+{
+    TEST_ASSERT_EQUAL(USART_OK, USART_startAutoBaud(USART_NUMBER_1, RX_CAPTURE, AutoBaud_done, &detections));
+    Line_sendChar(USART_AUTOBAUD_SYNC, 38400, TRUE);
+    AutoBaud_assertDetected(38400);
+}
+
+/*The character right after the sync one reaches the continuous ring at the detected rate*/
+void test_USART_autoBaud_receivesTheNextCharacter(void)
+{
+    u8 received = 0;
+    u16 readLength = 0;
+    TEST_ASSERT_EQUAL(USART_OK, USART_startContinuousRx(USART_NUMBER_1));
+    TEST_ASSERT_EQUAL(USART_OK, USART_startAutoBaud(USART_NUMBER_1, RX_CAPTURE, AutoBaud_done, &detections));
+    Line_sendChar(USART_AUTOBAUD_SYNC, 115200, FALSE);
+    AutoBaud_assertDetected(115200);
+
+    Line_sendChar('K', 115200, FALSE);
+    TEST_ASSERT_TRUE(USART_SimulateRxWord(USART_NUMBER_1, 'K', 0));
+    TEST_ASSERT_EQUAL(USART_OK, USART_read(USART_NUMBER_1, &received, 1, &readLength));
+    TEST_ASSERT_EQUAL(1, readLength);
+    TEST_ASSERT_EQUAL('K', received);
+    TEST_ASSERT_EQUAL(1, detections);
+}
+
+/*The first detection leaves the shared input to the instance still waiting for its sync character*/
+void test_USART_autoBaud_keepsTheInputOfAnotherArmedInstance(void)
+{
+    TEST_ASSERT_EQUAL(USART_OK, USART_startAutoBaud(USART_NUMBER_1, RX_CAPTURE, AutoBaud_done, &detections));
+    armSecondAtEdge = 3;
+    Line_sendChar(USART_AUTOBAUD_SYNC, 19200, FALSE);
+    TEST_ASSERT_EQUAL(1, detections);
+    TEST_ASSERT_EQUAL(0, secondDetections);
+    TEST_ASSERT_NOT_NULL(edgeCallBack);
+
+    Line_sendChar(USART_AUTOBAUD_SYNC, 19200, FALSE);
+    TEST_ASSERT_EQUAL(1, secondDetections);
+    TEST_ASSERT_EQUAL(1, detections);
+    TEST_ASSERT_NULL(edgeCallBack);
+    TEST_ASSERT_EQUAL_HEX32(USART_BRR(USART_CLK, 19200, USART_OVERSAMPLING_16), USART_MockRegisters[USART_NUMBER_2].BRR);
+}
+
+#endif // TEST
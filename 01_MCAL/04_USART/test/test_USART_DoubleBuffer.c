@@ -0,0 +1,336 @@
+#ifdef TEST
+
+#include <string.h>
+#include "unity.h"
+#include "USART.h"
+#include "USART_TestSupport.h"
+#include "mock_DMA.h"
+#include "mock_GPIO.h"
+
+#define BUFFER_SIZE                     16
+#define MAX_HANDED                      8
+
+const USART_Cfg_t USART_Cfg[_USART_Num] = {
+    [USART1] = {USART_TEST_CFG_8N1(USART_NUMBER_1, 115200), .USART_DmaRx = TRUE}
+};
+
+/*Full buffers as the consumer got them: pointer, length, errors, first byte and the DMA starts issued before*/
+typedef struct
+{
+    u8* data;
+    u16 length;
+    u8 errors;
+    u8 first;
+    u32 dmaStarts;
+}Handed_t;
+
+static u8 pingBuffer[BUFFER_SIZE];
+static u8 pongBuffer[BUFFER_SIZE];
+static Handed_t handed[MAX_HANDED];
+static u32 handedCount;
+static boolean releaseInCallBack;
+static boolean dmaAvailable;
+static DMA_Transfer_t lastTransfer;
+static u32 dmaStarts;
+static u16 dmaRemaining;
+static u8 lineByte;
+static boolean rxDuringStart;
+static boolean rxHandledDuringStart;
+
+DMA_ErrorStatus_t DMA_allocStream_Callback(u8 DMA_Controller, u8 DMA_Stream, int cmock_num_calls)
+{
+    return (dmaAvailable == TRUE) ? DMA_OK : DMA_Busy;
+}
+
+DMA_ErrorStatus_t DMA_startTransfer_Callback(const DMA_Transfer_t* DMA_Transfer, int cmock_num_calls)
+{
+    TEST_ASSERT_EQUAL(DMA_DIR_PERIPH_TO_MEM, DMA_Transfer->DMA_Direction);
+    TEST_ASSERT_EQUAL(BUFFER_SIZE, DMA_Transfer->DMA_Count);
+    lastTransfer = *DMA_Transfer;
+    dmaStarts++;
+    if(rxDuringStart == TRUE)
+    {
+        /*A byte arrives while the stream is being started*/
+        rxHandledDuringStart = USART_SimulateRxWord(USART_NUMBER_1, lineByte, 0);
+    }
+    return DMA_OK;
+}
+
+DMA_ErrorStatus_t DMA_stopTransfer_Callback(u8 DMA_Controller, u8 DMA_Stream, int cmock_num_calls)
+{
+    return DMA_OK;
+}
+
+DMA_ErrorStatus_t DMA_getRemaining_Callback(u8 DMA_Controller, u8 DMA_Stream, u16* Remaining, int cmock_num_calls)
+{
+    *Remaining = dmaRemaining;
+    return DMA_OK;
+}
+
+static void Consumer_done(const USART_Completion_t* Completion)
+{
+    TEST_ASSERT_EQUAL(USART_NUMBER_1, Completion->USART_Number);
+    TEST_ASSERT_EQUAL(USART_EVENT_DONE, Completion->event);
+    TEST_ASSERT_EQUAL_PTR(&handedCount, Completion->Context);
+    if(handedCount < MAX_HANDED)
+    {
+        handed[handedCount].data = Completion->data;
+        handed[handedCount].length = Completion->length;
+        handed[handedCount].errors = Completion->errors;
+        handed[handedCount].first = Completion->data[0];
+        handed[handedCount].dmaStarts = dmaStarts;
+    }
+    handedCount++;
+    if(releaseInCallBack == TRUE)
+    {
+        TEST_ASSERT_EQUAL(USART_OK, USART_releaseRxBuffer(USART_NUMBER_1, Completion->data));
+    }
+}
+
+static USART_DoubleBufferReq_t DoubleBuffer_req(void)
+{
+    USART_DoubleBufferReq_t Req = {.USART_Number = USART_NUMBER_1, .buffers = {pingBuffer, pongBuffer},
+                                   .length = BUFFER_SIZE, .CB = Consumer_done, .Context = &handedCount};
+    return Req;
+}
+
+/*Receives the next bytes of a counting stream through the Rx interrupt*/
+static void Line_receive(u32 Count)
+{
+    u32 idx = 0;
+    for(idx = 0; idx < Count; idx++)
+    {
+        USART_SimulateRxWord(USART_NUMBER_1, lineByte++, 0);
+    }
+}
+
+/*The stream fills its buffer with the next bytes and completes*/
+static void Dma_complete(void)
+{
+    u8* buffer = (u8*)lastTransfer.DMA_MemAddress;
+    u32 idx = 0;
+    for(idx = 0; idx < BUFFER_SIZE; idx++)
+    {
+        buffer[idx] = lineByte++;
+    }
+    dmaRemaining = 0;
+    lastTransfer.CB(DMA_EVENT_FULL, lastTransfer.Context);
+}
+
+void setUp(void)
+{
+    USART_stopDoubleBufferRx(USART_NUMBER_1);
+    USART_stopContinuousRx(USART_NUMBER_1);
+    memset(USART_MockRegisters, 0, sizeof(USART_MockRegisters));
+    DMA_allocStream_StubWithCallback(DMA_allocStream_Callback);
+    DMA_startTransfer_StubWithCallback(DMA_startTransfer_Callback);
+    DMA_stopTransfer_StubWithCallback(DMA_stopTransfer_Callback);
+    DMA_getRemaining_StubWithCallback(DMA_getRemaining_Callback);
+    dmaAvailable = FALSE;
+    dmaStarts = 0;
+    USART_init();
+    memset(handed, 0, sizeof(handed));
+    memset(pingBuffer, 0, sizeof(pingBuffer));
+    memset(pongBuffer, 0, sizeof(pongBuffer));
+    handedCount = 0;
+    releaseInCallBack = TRUE;
+    lineByte = 0;
+    rxDuringStart = FALSE;
+    rxHandledDuringStart = FALSE;
+}
+
+void tearDown(void)
+{
+}
+
+void test_USART_startDoubleBufferRx_checksItsArguments(void)
+{
+    USART_DoubleBufferReq_t Req = DoubleBuffer_req();
+    u8 single = 0;
+    USART_Req_t RxReq = {.USART_Number = USART_NUMBER_1, .data = &single, .length = 1, .CB = Consumer_done};
+    Req.buffers[1] = NULL_PTR;
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_startDoubleBufferRx(Req));
+    Req = DoubleBuffer_req();
+    Req.CB = NULL_PTR;
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_startDoubleBufferRx(Req));
+    Req = DoubleBuffer_req();
+    Req.USART_Number = NUMBER_OF_USART_INSTANCE;
+    TEST_ASSERT_EQUAL(USART_InvalidNumber, USART_startDoubleBufferRx(Req));
+    Req = DoubleBuffer_req();
+    Req.length = 0;
+    TEST_ASSERT_EQUAL(USART_InvalidLength, USART_startDoubleBufferRx(Req));
+
+    TEST_ASSERT_EQUAL(USART_OK, USART_startContinuousRx(USART_NUMBER_1));
+    TEST_ASSERT_EQUAL(USART_Busy, USART_startDoubleBufferRx(DoubleBuffer_req()));
+    TEST_ASSERT_EQUAL(USART_OK, USART_stopContinuousRx(USART_NUMBER_1));
+
+    TEST_ASSERT_EQUAL(USART_OK, USART_startDoubleBufferRx(DoubleBuffer_req()));
+    TEST_ASSERT_EQUAL(USART_Busy, USART_startDoubleBufferRx(DoubleBuffer_req()));
+    TEST_ASSERT_EQUAL(USART_Busy, USART_startContinuousRx(USART_NUMBER_1));
+    TEST_ASSERT_EQUAL(USART_Busy, USART_recieveBufferAsyncZC(RxReq));
+    TEST_ASSERT_EQUAL(USART_InvalidBuffer, USART_releaseRxBuffer(USART_NUMBER_1, pingBuffer));
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_releaseRxBuffer(USART_NUMBER_1, NULL_PTR));
+}
+
+void test_USART_doubleBuffer_interruptHandsFullBuffersInTurn(void)
+{
+    USART_RxStats_t before;
+    USART_RxStats_t after;
+    USART_getRxStats(USART_NUMBER_1, &before);
+    TEST_ASSERT_EQUAL(USART_OK, USART_startDoubleBufferRx(DoubleBuffer_req()));
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RXNEIE_ENABLE);
+    Line_receive(BUFFER_SIZE - 1);
+    TEST_ASSERT_EQUAL(0, handedCount);
+    Line_receive(1 + (2 * BUFFER_SIZE));
+    TEST_ASSERT_EQUAL(3, handedCount);
+    TEST_ASSERT_EQUAL_PTR(pingBuffer, handed[0].data);
+    TEST_ASSERT_EQUAL_PTR(pongBuffer, handed[1].data);
+    TEST_ASSERT_EQUAL_PTR(pingBuffer, handed[2].data);
+    TEST_ASSERT_EQUAL(BUFFER_SIZE, handed[1].length);
+    TEST_ASSERT_EQUAL(0, handed[0].first);
+    TEST_ASSERT_EQUAL(BUFFER_SIZE, handed[1].first);
+    TEST_ASSERT_EQUAL(2 * BUFFER_SIZE, handed[2].first);
+    TEST_ASSERT_EQUAL(USART_ERROR_NONE, handed[2].errors);
+    TEST_ASSERT_EQUAL(USART_OK, USART_getRxStats(USART_NUMBER_1, &after));
+    TEST_ASSERT_EQUAL(before.bufferOverruns, after.bufferOverruns);
+    TEST_ASSERT_EQUAL(3 * BUFFER_SIZE, after.received - before.received);
+}
+
+void test_USART_doubleBuffer_reportsLineErrorsWithTheirBuffer(void)
+{
+    TEST_ASSERT_EQUAL(USART_OK, USART_startDoubleBufferRx(DoubleBuffer_req()));
+    Line_receive(3);
+    USART_SimulateRxWord(USART_NUMBER_1, lineByte++, USART_SR_PE);
+    Line_receive(BUFFER_SIZE + BUFFER_SIZE - 4);
+    TEST_ASSERT_EQUAL(2, handedCount);
+    TEST_ASSERT_EQUAL(USART_ERROR_PARITY, handed[0].errors);
+    TEST_ASSERT_EQUAL(USART_ERROR_NONE, handed[1].errors);
+}
+
+/*A consumer that keeps both buffers: the receive pauses instead of writing into them*/
+void test_USART_doubleBuffer_interruptCountsBufferOverruns(void)
+{
+    USART_RxStats_t before;
+    USART_RxStats_t after;
+    releaseInCallBack = FALSE;
+    USART_getRxStats(USART_NUMBER_1, &before);
+    TEST_ASSERT_EQUAL(USART_OK, USART_startDoubleBufferRx(DoubleBuffer_req()));
+    Line_receive(2 * BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(2, handedCount);
+    Line_receive(5);
+    TEST_ASSERT_EQUAL(2, handedCount);
+    TEST_ASSERT_EQUAL(0, pingBuffer[0]);
+    TEST_ASSERT_EQUAL(BUFFER_SIZE, pongBuffer[0]);
+    TEST_ASSERT_EQUAL(USART_OK, USART_getRxStats(USART_NUMBER_1, &after));
+    TEST_ASSERT_EQUAL(1, after.bufferOverruns - before.bufferOverruns);
+    TEST_ASSERT_EQUAL(5, after.dropped - before.dropped);
+    TEST_ASSERT_EQUAL(2 * BUFFER_SIZE, after.received - before.received);
+
+    /*The released buffer fills next and comes back flagged: bytes are missing before it*/
+    TEST_ASSERT_EQUAL(USART_OK, USART_releaseRxBuffer(USART_NUMBER_1, pongBuffer));
+    TEST_ASSERT_EQUAL(USART_InvalidBuffer, USART_releaseRxBuffer(USART_NUMBER_1, pongBuffer));
+    Line_receive(BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(3, handedCount);
+    TEST_ASSERT_EQUAL_PTR(pongBuffer, handed[2].data);
+    TEST_ASSERT_EQUAL((2 * BUFFER_SIZE) + 5, handed[2].first);
+    TEST_ASSERT_EQUAL(USART_ERROR_BUFFER_OVERRUN, handed[2].errors);
+    TEST_ASSERT_EQUAL(USART_OK, USART_getRxStats(USART_NUMBER_1, &after));
+    TEST_ASSERT_EQUAL(2, after.bufferOverruns - before.bufferOverruns);     /*ping is still held*/
+}
+
+void test_USART_doubleBuffer_dmaRestartsOnTheOtherBufferFirst(void)
+{
+    USART_RxStats_t before;
+    USART_RxStats_t after;
+    dmaAvailable = TRUE;
+    USART_init();
+    USART_getRxStats(USART_NUMBER_1, &before);
+    TEST_ASSERT_EQUAL(USART_OK, USART_startDoubleBufferRx(DoubleBuffer_req()));
+    TEST_ASSERT_EQUAL(1, dmaStarts);
+    TEST_ASSERT_EQUAL_PTR(pingBuffer, (u8*)lastTransfer.DMA_MemAddress);
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR3 & USART_CR3_DMAR);
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RXNEIE_ENABLE);
+
+    Dma_complete();
+    Dma_complete();
+    Dma_complete();
+    TEST_ASSERT_EQUAL(3, handedCount);
+    TEST_ASSERT_EQUAL_PTR(pingBuffer, handed[0].data);
+    TEST_ASSERT_EQUAL_PTR(pongBuffer, handed[1].data);
+    TEST_ASSERT_EQUAL(BUFFER_SIZE, handed[1].first);
+    /*The consumer gets a buffer once the stream already fills the other one*/
+    TEST_ASSERT_EQUAL(2, handed[0].dmaStarts);
+    TEST_ASSERT_EQUAL(3, handed[1].dmaStarts);
+    TEST_ASSERT_EQUAL(USART_OK, USART_getRxStats(USART_NUMBER_1, &after));
+    TEST_ASSERT_EQUAL(3 * BUFFER_SIZE, after.received - before.received);
+}
+
+void test_USART_doubleBuffer_dmaPausesWhileBothBuffersAreHeld(void)
+{
+    USART_RxStats_t before;
+    USART_RxStats_t after;
+    dmaAvailable = TRUE;
+    releaseInCallBack = FALSE;
+    USART_init();
+    USART_getRxStats(USART_NUMBER_1, &before);
+    TEST_ASSERT_EQUAL(USART_OK, USART_startDoubleBufferRx(DoubleBuffer_req()));
+    Dma_complete();
+    Dma_complete();
+    TEST_ASSERT_EQUAL(2, handedCount);
+    TEST_ASSERT_EQUAL(2, dmaStarts);
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR3 & USART_CR3_DMAR);
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RXNEIE_ENABLE);
+    Line_receive(3);
+    TEST_ASSERT_EQUAL(USART_OK, USART_getRxStats(USART_NUMBER_1, &after));
+    TEST_ASSERT_EQUAL(1, after.bufferOverruns - before.bufferOverruns);
+    TEST_ASSERT_EQUAL(3, after.dropped - before.dropped);
+
+    TEST_ASSERT_EQUAL(USART_OK, USART_releaseRxBuffer(USART_NUMBER_1, pingBuffer));
+    TEST_ASSERT_EQUAL(3, dmaStarts);
+    TEST_ASSERT_EQUAL_PTR(pingBuffer, (u8*)lastTransfer.DMA_MemAddress);
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR3 & USART_CR3_DMAR);
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RXNEIE_ENABLE);
+    Dma_complete();
+    TEST_ASSERT_EQUAL(3, handedCount);
+    TEST_ASSERT_EQUAL(USART_ERROR_BUFFER_OVERRUN, handed[2].errors);
+}
+
+/*The interrupt dropping the bytes of the pause must not take the first byte of the restarted stream*/
+void test_USART_doubleBuffer_dmaReleaseMasksTheInterruptWhileRestarting(void)
+{
+    USART_RxStats_t before;
+    USART_RxStats_t after;
+    dmaAvailable = TRUE;
+    releaseInCallBack = FALSE;
+    USART_init();
+    TEST_ASSERT_EQUAL(USART_OK, USART_startDoubleBufferRx(DoubleBuffer_req()));
+    Dma_complete();
+    Dma_complete();
+    USART_getRxStats(USART_NUMBER_1, &before);
+
+    rxDuringStart = TRUE;
+    TEST_ASSERT_EQUAL(USART_OK, USART_releaseRxBuffer(USART_NUMBER_1, pingBuffer));
+    TEST_ASSERT_EQUAL(3, dmaStarts);
+    TEST_ASSERT_FALSE(rxHandledDuringStart);
+    TEST_ASSERT_EQUAL(USART_OK, USART_getRxStats(USART_NUMBER_1, &after));
+    TEST_ASSERT_EQUAL(before.received, after.received);
+    TEST_ASSERT_EQUAL(before.dropped, after.dropped);
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RXNEIE_ENABLE);
+    rxDuringStart = FALSE;
+    Dma_complete();
+    TEST_ASSERT_EQUAL(3, handedCount);
+    TEST_ASSERT_EQUAL_PTR(pingBuffer, handed[2].data);
+}
+
+void test_USART_stopDoubleBufferRx_freesTheReceiver(void)
+{
+    TEST_ASSERT_EQUAL(USART_OK, USART_startDoubleBufferRx(DoubleBuffer_req()));
+    Line_receive(BUFFER_SIZE + 2);
+    TEST_ASSERT_EQUAL(USART_OK, USART_stopDoubleBufferRx(USART_NUMBER_1));
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RXNEIE_ENABLE);
+    TEST_ASSERT_EQUAL(USART_InvalidBuffer, USART_releaseRxBuffer(USART_NUMBER_1, pingBuffer));
+    TEST_ASSERT_EQUAL(USART_OK, USART_startContinuousRx(USART_NUMBER_1));
+    TEST_ASSERT_EQUAL(USART_InvalidNumber, USART_stopDoubleBufferRx(NUMBER_OF_USART_INSTANCE));
+}
+
+#endif // TEST
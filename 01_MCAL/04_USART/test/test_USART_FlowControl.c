@@ -0,0 +1,99 @@
+#ifdef TEST
+
+#include <string.h>
+#include "unity.h"
+#include "USART.h"
+#include "USART_TestSupport.h"
+#include "mock_DMA.h"
+#include "mock_GPIO.h"
+
+const USART_Cfg_t USART_Cfg[_USART_Num] = {
+    [USART1] = {
+        USART_TEST_CFG(USART_NUMBER_1, 2000000, USART_WORD_LEN_8, USART_OVERSAMPLING_8),
+        .USART_FlowControl = USART_FLOW_CONTROL_RTS_CTS,
+        .USART_RtsPort = GPIO_PORT_A,
+        .USART_RtsPin = GPIO_PIN_12,        /*PA12 = USART1_RTS*/
+        .USART_CtsPort = GPIO_PORT_A,
+        .USART_CtsPin = GPIO_PIN_11         /*PA11 = USART1_CTS*/
+    }
+};
+
+static u8 ringData[USART_RX_RING_SIZE];
+
+void setUp(void)
+{
+    GPIO_Pin_t RtsPin;
+    GPIO_Pin_t CtsPin;
+    memset(&RtsPin, 0, sizeof(RtsPin));
+    memset(&CtsPin, 0, sizeof(CtsPin));
+    RtsPin.GPIO_Port = GPIO_PORT_A;
+    RtsPin.GPIO_Pin = GPIO_PIN_12;
+    RtsPin.GPIO_Mode = GPIO_MODE_AF_PP;
+    RtsPin.GPIO_Speed = GPIO_SPEED_HIGH;
+    CtsPin = RtsPin;
+    CtsPin.GPIO_Pin = GPIO_PIN_11;
+    CtsPin.GPIO_Mode = GPIO_MODE_AF_PP_PU;
+    GPIO_Init_ExpectAndReturn(&RtsPin, GPIO_OK);
+    GPIO_CfgAlternateFn_ExpectAndReturn(GPIO_PORT_A, GPIO_PIN_12, GPIO_FUNC_AF7, GPIO_OK);
+    GPIO_Init_ExpectAndReturn(&CtsPin, GPIO_OK);
+    GPIO_CfgAlternateFn_ExpectAndReturn(GPIO_PORT_A, GPIO_PIN_11, GPIO_FUNC_AF7, GPIO_OK);
+    USART_stopContinuousRx(USART_NUMBER_1);
+    memset(USART_MockRegisters, 0, sizeof(USART_MockRegisters));
+    memset(ringData, 'r', sizeof(ringData));
+    USART_init();
+}
+
+void tearDown(void)
+{
+}
+
+void test_USART_init_enablesHardwareFlowControl(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(USART_FLOW_CONTROL_RTS_CTS, USART_MockRegisters[USART_NUMBER_1].CR3);
+    mock_GPIO_Verify();
+}
+
+void test_USART_continuousRx_fullRingHoldsRts(void)
+{
+    USART_RxStats_t before;
+    USART_RxStats_t after;
+    u16 readLength = 0;
+    u16 available = 0;
+    USART_getRxStats(USART_NUMBER_1, &before);
+    USART_startContinuousRx(USART_NUMBER_1);
+    USART_SimulateRx(USART_NUMBER_1, ringData, USART_RX_RING_SIZE, 0);
+    /*The ring is full: the receive interrupt stops and the next byte stays in DR, the hardware holds RTS*/
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RXNEIE_ENABLE);
+    TEST_ASSERT_FALSE(USART_SimulateRxWord(USART_NUMBER_1, 'n', 0));
+    USART_MockRegisters[USART_NUMBER_1].SR |= USART_SR_RXNE;     /*Nobody read DR*/
+
+    USART_read(USART_NUMBER_1, ringData, 10, &readLength);
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RXNEIE_ENABLE);
+    USART_read(USART_NUMBER_1, ringData, USART_RX_RING_SIZE - USART_RX_RTS_RESUME_LEVEL - 10, &readLength);
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RXNEIE_ENABLE);
+    /*Re-enabling RXNEIE with the byte pending enters the interrupt*/
+    USART_TestIRQ(USART_NUMBER_1);
+    USART_MockRegisters[USART_NUMBER_1].SR &= ~USART_SR_RXNE;
+
+    USART_getRxAvailable(USART_NUMBER_1, &available);
+    TEST_ASSERT_EQUAL(USART_RX_RTS_RESUME_LEVEL + 1, available);
+    USART_getRxStats(USART_NUMBER_1, &after);
+    TEST_ASSERT_EQUAL(0, after.dropped - before.dropped);
+    TEST_ASSERT_EQUAL(USART_RX_RING_SIZE + 1, after.received - before.received);
+}
+
+void test_USART_stopContinuousRx_clearsPause(void)
+{
+    u16 available = 0;
+    USART_startContinuousRx(USART_NUMBER_1);
+    USART_SimulateRx(USART_NUMBER_1, ringData, USART_RX_RING_SIZE, 0);
+    USART_stopContinuousRx(USART_NUMBER_1);
+    USART_MockRegisters[USART_NUMBER_1].SR &= ~USART_SR_RXNE;
+    USART_startContinuousRx(USART_NUMBER_1);
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_RXNEIE_ENABLE);
+    USART_SimulateRx(USART_NUMBER_1, (const u8*)"ab", 2, 0);
+    USART_getRxAvailable(USART_NUMBER_1, &available);
+    TEST_ASSERT_EQUAL(2, available);
+}
+
+#endif // TEST
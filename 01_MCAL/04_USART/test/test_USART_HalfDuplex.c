@@ -0,0 +1,163 @@
+#ifdef TEST
+
+#include <string.h>
+#include "unity.h"
+#include "USART.h"
+#include "USART_TestSupport.h"
+#include "mock_DMA.h"
+#include "mock_GPIO.h"
+
+#define DE_PORT                         GPIO_PORT_A
+#define DE_PIN                          GPIO_PIN_8
+
+const USART_Cfg_t USART_Cfg[_USART_Num] = {
+    [USART1] = {
+        USART_TEST_CFG_8N1(USART_NUMBER_1, 115200),
+        .USART_HalfDuplex = TRUE,
+        .USART_DePort = DE_PORT,
+        .USART_DePin = DE_PIN
+    }
+};
+
+/*Bus activity log: 'A' for a DE assert, 'R' for a release and the bytes in between as they leave DR*/
+static char busLog[64];
+static u32 busLogLen;
+static u8 deState;
+static u32 doneCount;
+static boolean dePresetBeforeInit;
+
+static void Bus_log(char Event)
+{
+    if(busLogLen < (sizeof(busLog) - 1))
+    {
+        busLog[busLogLen++] = Event;
+    }
+}
+
+GPIO_ErrorStatus_t GPIO_setPinValue_CallbackDe(void* GPIO_Port, u8 GPIO_pin, u8 GPIO_State, int cmock_num_calls)
+{
+    TEST_ASSERT_EQUAL_PTR(DE_PORT, GPIO_Port);
+    TEST_ASSERT_EQUAL(DE_PIN, GPIO_pin);
+    deState = GPIO_State;
+    Bus_log((GPIO_State == GPIO_STATE_SET) ? 'A' : 'R');
+    return GPIO_OK;
+}
+
+GPIO_ErrorStatus_t GPIO_Init_CallbackDe(GPIO_Pin_t* gpioPin, int cmock_num_calls)
+{
+    TEST_ASSERT_EQUAL_PTR(DE_PORT, gpioPin->GPIO_Port);
+    TEST_ASSERT_EQUAL(DE_PIN, gpioPin->GPIO_Pin);
+    TEST_ASSERT_EQUAL(GPIO_MODE_OUT_PP, gpioPin->GPIO_Mode);
+    dePresetBeforeInit = ((busLogLen == 1) && (deState == GPIO_STATE_RESET)) ? TRUE : FALSE;
+    return GPIO_OK;
+}
+
+static void Tx_Done(const USART_Completion_t* Completion)
+{
+    doneCount++;
+}
+
+/*TXE interrupts move DR to the line until the queue is empty, DE must be asserted for every byte*/
+static void Line_transmit(void)
+{
+    u32 interrupts = 0;
+    u16 word = 0;
+    while((USART_MockRegisters[USART_NUMBER_1].CR1 & USART_TXEIE_ENABLE) && (interrupts < USART_TEST_MAX_INTERRUPTS))
+    {
+        if(USART_SimulateTxe(USART_NUMBER_1, &word) == TRUE)
+        {
+            TEST_ASSERT_EQUAL(GPIO_STATE_SET, deState);
+            Bus_log((char)word);
+        }
+        interrupts++;
+    }
+}
+
+static USART_ErrorStatus_t USART_post(const char* Data)
+{
+    USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = (u8*)Data, .length = (u16)strlen(Data), .CB = Tx_Done};
+    return USART_sendBufferAsyncZC(Req);
+}
+
+void setUp(void)
+{
+    memset(USART_MockRegisters, 0, sizeof(USART_MockRegisters));
+    memset(busLog, 0, sizeof(busLog));
+    busLogLen = 0;
+    doneCount = 0;
+    GPIO_setPinValue_StubWithCallback(GPIO_setPinValue_CallbackDe);
+    GPIO_Init_StubWithCallback(GPIO_Init_CallbackDe);
+    USART_init();
+}
+
+void tearDown(void)
+{
+}
+
+void test_USART_halfDuplex_initReleasesDeBeforeOutput(void)
+{
+    TEST_ASSERT_TRUE(dePresetBeforeInit);
+    TEST_ASSERT_EQUAL_STRING("R", busLog);
+}
+
+void test_USART_halfDuplex_asyncReleasesOnTc(void)
+{
+    busLogLen = 0;
+    TEST_ASSERT_EQUAL(USART_OK, USART_post("ab"));
+    Line_transmit();
+    /*Completed with the last byte in the shift register: the bus is still held until TC*/
+    TEST_ASSERT_EQUAL(1, doneCount);
+    TEST_ASSERT_EQUAL(GPIO_STATE_SET, deState);
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_TCIE_ENABLE);
+    USART_SimulateTc(USART_NUMBER_1);
+    TEST_ASSERT_EQUAL(GPIO_STATE_RESET, deState);
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_TCIE_ENABLE);
+    TEST_ASSERT_EQUAL_STRING("AabR", busLog);
+}
+
+void test_USART_halfDuplex_queuedRequestsKeepTheBus(void)
+{
+    busLogLen = 0;
+    USART_post("ab");
+    USART_post("cd");
+    USART_post("e");
+    Line_transmit();
+    USART_SimulateTc(USART_NUMBER_1);
+    TEST_ASSERT_EQUAL(3, doneCount);
+    TEST_ASSERT_EQUAL_STRING("AabcdeR", busLog);
+}
+
+void test_USART_halfDuplex_postDuringTcWaitKeepsTheBus(void)
+{
+    busLogLen = 0;
+    USART_post("ab");
+    Line_transmit();
+    USART_post("c");
+    /*TC and TXE in the same interrupt: the queued request starts instead of the release*/
+    USART_SimulateTc(USART_NUMBER_1);
+    TEST_ASSERT_EQUAL(GPIO_STATE_SET, deState);
+    Bus_log((char)USART_MockRegisters[USART_NUMBER_1].DR);
+    Line_transmit();
+    USART_SimulateTc(USART_NUMBER_1);
+    TEST_ASSERT_EQUAL_STRING("AabAcR", busLog);
+}
+
+void test_USART_halfDuplex_sendBlockingHoldsDeUntilTc(void)
+{
+    busLogLen = 0;
+    USART_MockRegisters[USART_NUMBER_1].SR = USART_SR_TXE | USART_SR_TC;
+    TEST_ASSERT_EQUAL(USART_OK, USART_sendBlocking(USART_NUMBER_1, (const u8*)"xyz", 3, 1000));
+    TEST_ASSERT_EQUAL('z', USART_MockRegisters[USART_NUMBER_1].DR);
+    TEST_ASSERT_EQUAL_STRING("AR", busLog);
+}
+
+void test_USART_halfDuplex_sendBlockingTimeoutReleasesDe(void)
+{
+    busLogLen = 0;
+    USART_MockRegisters[USART_NUMBER_1].SR = 0;
+    TEST_ASSERT_EQUAL(USART_TimeOut, USART_sendBlocking(USART_NUMBER_1, (const u8*)"x", 1, 100));
+    TEST_ASSERT_EQUAL(GPIO_STATE_RESET, deState);
+    TEST_ASSERT_EQUAL_STRING("AR", busLog);
+}
+
+#endif // TEST
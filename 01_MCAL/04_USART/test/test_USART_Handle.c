@@ -0,0 +1,115 @@
+#ifdef TEST
+
+#include <string.h>
+#include "unity.h"
+#include "USART.h"
+#include "USART_TestSupport.h"
+#include "mock_DMA.h"
+#include "mock_GPIO.h"
+
+/*The only entry drives USART2: its handle must lead there and not to the instance of index 0*/
+const USART_Cfg_t USART_Cfg[_USART_Num] = {
+    [USART1] = {
+        .USART_Number = USART_NUMBER_2,
+        USART_BRR_CFG(115200, USART_OVERSAMPLING_16),
+        .USART_WordLen = USART_WORD_LEN_8,
+        .USART_ParityControl = USART_PARITY_CONTROL_DISABLE,
+        .USART_ParitySelection = USART_PARITY_EVEN,
+        .USART_StopBits = USART_STOPBITS_1
+    }
+};
+
+static u32 sentCount;
+
+static void Handle_sent(const USART_Completion_t* Completion)
+{
+    TEST_ASSERT_EQUAL(USART_NUMBER_2, Completion->USART_Number);
+    TEST_ASSERT_EQUAL_PTR(&sentCount, Completion->Context);
+    sentCount++;
+}
+
+void setUp(void)
+{
+    USART_stopContinuousRx(USART_NUMBER_2);
+    memset(USART_MockRegisters, 0, sizeof(USART_MockRegisters));
+    TEST_ASSERT_EQUAL(USART_OK, USART_init());
+    sentCount = 0;
+}
+
+void tearDown(void)
+{
+}
+
+void test_USART_getHandle_bindsTheConfiguredInstance(void)
+{
+    USART_Handle_t handle = NULL_PTR;
+    u8 number = 0;
+    TEST_ASSERT_EQUAL(USART_OK, USART_getHandle(USART1, &handle));
+    TEST_ASSERT_NOT_NULL(handle);
+    TEST_ASSERT_EQUAL(USART_OK, USART_getNumber(handle, &number));
+    TEST_ASSERT_EQUAL(USART_NUMBER_2, number);
+    TEST_ASSERT_NOT_EQUAL(0, USART_MockRegisters[USART_NUMBER_2].BRR);
+    TEST_ASSERT_EQUAL(0, USART_MockRegisters[USART_NUMBER_1].BRR);
+
+    TEST_ASSERT_EQUAL(USART_InvalidNumber, USART_getHandle(_USART_Num, &handle));
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_getHandle(USART1, NULL_PTR));
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_getNumber(NULL_PTR, &number));
+}
+
+void test_USART_send_queuesOnTheHandleInstance(void)
+{
+    USART_Handle_t handle = NULL_PTR;
+    u8 data[] = {'o', 'k'};
+    u8 wire[4] = {0};
+    u32 wireLen = 0;
+    TEST_ASSERT_EQUAL(USART_OK, USART_getHandle(USART1, &handle));
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_send(NULL_PTR, data, sizeof(data), Handle_sent, &sentCount));
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_send(handle, data, sizeof(data), NULL_PTR, &sentCount));
+    TEST_ASSERT_EQUAL(USART_InvalidLength, USART_send(handle, data, 0, Handle_sent, &sentCount));
+
+    TEST_ASSERT_EQUAL(USART_OK, USART_send(handle, data, sizeof(data), Handle_sent, &sentCount));
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_2].CR1 & USART_TXEIE_ENABLE);
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_TXEIE_ENABLE);
+    TEST_ASSERT_EQUAL(3, USART_SimulateTx(USART_NUMBER_2, wire, &wireLen, sizeof(wire)));
+    TEST_ASSERT_EQUAL(2, wireLen);
+    TEST_ASSERT_EQUAL_MEMORY("ok", wire, 2);
+    TEST_ASSERT_EQUAL(1, sentCount);
+}
+
+void test_USART_send_reportsAFullQueue(void)
+{
+    USART_Handle_t handle = NULL_PTR;
+    u8 data = 'x';
+    u8 idx = 0;
+    TEST_ASSERT_EQUAL(USART_OK, USART_getHandle(USART1, &handle));
+    for(idx = 0; idx < USART_TX_QUEUE_SIZE; idx++)
+    {
+        TEST_ASSERT_EQUAL(USART_OK, USART_send(handle, &data, 1, Handle_sent, &sentCount));
+    }
+    TEST_ASSERT_EQUAL(USART_Busy, USART_send(handle, &data, 1, Handle_sent, &sentCount));
+    USART_SimulateTx(USART_NUMBER_2, NULL_PTR, NULL_PTR, 0);
+    TEST_ASSERT_EQUAL(USART_TX_QUEUE_SIZE, sentCount);
+}
+
+void test_USART_receive_readsTheHandleRing(void)
+{
+    USART_Handle_t handle = NULL_PTR;
+    u8 received[4] = {0};
+    u16 readLength = 0;
+    u16 available = 0;
+    TEST_ASSERT_EQUAL(USART_OK, USART_getHandle(USART1, &handle));
+    TEST_ASSERT_EQUAL(USART_OK, USART_startContinuousRx(USART_NUMBER_2));
+    USART_SimulateRx(USART_NUMBER_2, (const u8*)"hi", 2, 0);
+
+    TEST_ASSERT_EQUAL(USART_OK, USART_available(handle, &available));
+    TEST_ASSERT_EQUAL(2, available);
+    TEST_ASSERT_EQUAL(USART_OK, USART_receive(handle, received, sizeof(received), &readLength));
+    TEST_ASSERT_EQUAL(2, readLength);
+    TEST_ASSERT_EQUAL_MEMORY("hi", received, 2);
+    TEST_ASSERT_EQUAL(USART_OK, USART_receive(handle, received, sizeof(received), &readLength));
+    TEST_ASSERT_EQUAL(0, readLength);
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_receive(NULL_PTR, received, sizeof(received), &readLength));
+    TEST_ASSERT_EQUAL(USART_NullPtr, USART_available(handle, NULL_PTR));
+}
+
+#endif // TEST
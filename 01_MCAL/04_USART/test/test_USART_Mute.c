@@ -0,0 +1,181 @@
+#ifdef TEST
+
+#include <string.h>
+#include "unity.h"
+#include "USART.h"
+#include "USART_TestSupport.h"
+#include "mock_DMA.h"
+#include "mock_GPIO.h"
+
+#define NODE_ADDRESS                    2
+#define BUS_NODES                       5
+#define BUS_FRAMES                      50
+#define BUS_FRAME_DATA                  16
+
+const USART_Cfg_t USART_Cfg[_USART_Num] = {
+    [USART1] = {
+        USART_TEST_CFG(USART_NUMBER_1, 115200, USART_WORD_LEN_9, USART_OVERSAMPLING_16),
+        .USART_Wakeup = USART_WAKEUP_ADDRESS_MARK,
+        .USART_Address = NODE_ADDRESS
+    }
+};
+
+static u32 interrupts;
+
+/*
+ * Simulated receiver with the mute mode rules of the hardware: an address character (WAKE set) wakes the
+ * node with its address and mutes any other, a muted receiver sets no RXNE so the handler isn't entered.
+ */
+static void Bus_receive(u16 Word)
+{
+    USART_Registers_t* Usart = &USART_MockRegisters[USART_NUMBER_1];
+    boolean deliver = TRUE;
+    if((Usart->CR1 & USART_CR1_WAKE) && (Word & USART_ADDRESS_MARK_9))
+    {
+        if((Word & USART_CR2_ADD_MASK) == (Usart->CR2 & USART_CR2_ADD_MASK))
+        {
+            Usart->CR1 &= ~USART_CR1_RWU;
+        }
+        else
+        {
+            Usart->CR1 |= USART_CR1_RWU;
+        }
+    }
+    if(Usart->CR1 & USART_CR1_RWU)
+    {
+        deliver = FALSE;
+    }
+    if((deliver == TRUE) && (USART_SimulateRxWord(USART_NUMBER_1, Word, 0) == TRUE))
+    {
+        interrupts++;
+    }
+}
+
+/*An idle character wakes an idle line muted receiver, without setting IDLE*/
+static void Bus_idle(void)
+{
+    USART_Registers_t* Usart = &USART_MockRegisters[USART_NUMBER_1];
+    if((Usart->CR1 & USART_CR1_WAKE) == 0)
+    {
+        Usart->CR1 &= ~USART_CR1_RWU;
+    }
+}
+
+/*Frame Idx of the bus traffic: the target address, then BUS_FRAME_DATA bytes*/
+static u8 Bus_frameAddress(u32 Idx)
+{
+    return (u8)(Idx % BUS_NODES);
+}
+
+static u8 Bus_frameByte(u32 Idx, u32 Byte)
+{
+    return (u8)(Idx * 7 + Byte);
+}
+
+/*Address mark traffic: the node only wakes for its frames, the hardware mutes it again on the next address*/
+static void Bus_sendAddressMarkTraffic(void)
+{
+    u32 frame = 0;
+    u32 byte = 0;
+    for(frame = 0; frame < BUS_FRAMES; frame++)
+    {
+        Bus_receive(USART_ADDRESS_MARK_9 | Bus_frameAddress(frame));
+        for(byte = 0; byte < BUS_FRAME_DATA; byte++)
+        {
+            Bus_receive(Bus_frameByte(frame, byte));
+        }
+    }
+}
+
+/*Idle line traffic: the address is the first data byte, a node mutes itself for frames of other nodes*/
+static void Bus_sendIdleLineTraffic(void)
+{
+    u32 frame = 0;
+    u32 byte = 0;
+    u16 readLength = 0;
+    u8 address = 0;
+    u8 discard[BUS_FRAME_DATA + 1];
+    for(frame = 0; frame < BUS_FRAMES; frame++)
+    {
+        Bus_idle();
+        Bus_receive(Bus_frameAddress(frame));
+        USART_read(USART_NUMBER_1, &address, 1, &readLength);
+        if(address != NODE_ADDRESS)
+        {
+            USART_enterMute(USART_NUMBER_1);
+        }
+        for(byte = 0; byte < BUS_FRAME_DATA; byte++)
+        {
+            Bus_receive(Bus_frameByte(frame, byte));
+        }
+        if(address == NODE_ADDRESS)
+        {
+            USART_read(USART_NUMBER_1, discard, sizeof(discard), &readLength);
+            TEST_ASSERT_EQUAL(BUS_FRAME_DATA, readLength);
+            TEST_ASSERT_EQUAL(Bus_frameByte(frame, 0), discard[0]);
+        }
+    }
+}
+
+void setUp(void)
+{
+    USART_stopContinuousRx(USART_NUMBER_1);
+    memset(USART_MockRegisters, 0, sizeof(USART_MockRegisters));
+    USART_init();
+    USART_startContinuousRx(USART_NUMBER_1);
+    interrupts = 0;
+}
+
+void tearDown(void)
+{
+}
+
+void test_USART_init_setsWakeupAndAddress(void)
+{
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_CR1_WAKE);
+    TEST_ASSERT_FALSE(USART_MockRegisters[USART_NUMBER_1].CR1 & USART_CR1_RWU);
+    TEST_ASSERT_EQUAL(NODE_ADDRESS, USART_MockRegisters[USART_NUMBER_1].CR2 & USART_CR2_ADD_MASK);
+    TEST_ASSERT_EQUAL(USART_InvalidNumber, USART_enterMute(NUMBER_OF_USART_INSTANCE));
+}
+
+void test_USART_sendAddress_setsTheMarkBit(void)
+{
+    USART_MockRegisters[USART_NUMBER_1].SR = USART_SR_TXE | USART_SR_TC;
+    TEST_ASSERT_EQUAL(USART_OK, USART_sendAddress(USART_NUMBER_1, 5, 1000));
+    TEST_ASSERT_EQUAL_HEX32(USART_ADDRESS_MARK_9 | 5, USART_MockRegisters[USART_NUMBER_1].DR);
+    TEST_ASSERT_EQUAL(USART_InvalidAddress, USART_sendAddress(USART_NUMBER_1, USART_ADDRESS_MAX + 1, 1000));
+    TEST_ASSERT_EQUAL(USART_InvalidNumber, USART_sendAddress(NUMBER_OF_USART_INSTANCE, 5, 1000));
+    /*8 bit words carry the mark in bit 7*/
+    USART_MockRegisters[USART_NUMBER_1].CR1 &= ~USART_WORD_LEN_9;
+    TEST_ASSERT_EQUAL(USART_OK, USART_sendAddress(USART_NUMBER_1, 5, 1000));
+    TEST_ASSERT_EQUAL_HEX32(0x85, USART_MockRegisters[USART_NUMBER_1].DR);
+}
+
+void test_USART_addressMark_receivesOnlyOwnFrames(void)
+{
+    u8 received[BUS_FRAME_DATA + 1];
+    u16 readLength = 0;
+    u32 frame = 0;
+    USART_enterMute(USART_NUMBER_1);
+    Bus_sendAddressMarkTraffic();
+    TEST_ASSERT_EQUAL((BUS_FRAMES / BUS_NODES) * (BUS_FRAME_DATA + 1), interrupts);
+    for(frame = NODE_ADDRESS; frame < BUS_FRAMES; frame += BUS_NODES)
+    {
+        USART_read(USART_NUMBER_1, received, sizeof(received), &readLength);
+        TEST_ASSERT_EQUAL(sizeof(received), readLength);
+        TEST_ASSERT_EQUAL(NODE_ADDRESS, received[0]);
+        TEST_ASSERT_EQUAL(Bus_frameByte(frame, 0), received[1]);
+        TEST_ASSERT_EQUAL(Bus_frameByte(frame, BUS_FRAME_DATA - 1), received[BUS_FRAME_DATA]);
+    }
+}
+
+/*The interrupt counts of the real handler on the hardware model are printed by the USART emulator benchmark*/
+void test_USART_idleLine_receivesOnlyOwnFrames(void)
+{
+    /*Without WAKE the node wakes on an idle line and mutes itself for the frames of other nodes*/
+    USART_MockRegisters[USART_NUMBER_1].CR1 &= ~USART_CR1_WAKE;
+    Bus_sendIdleLineTraffic();
+    TEST_ASSERT_EQUAL(BUS_FRAMES + ((BUS_FRAMES / BUS_NODES) * BUS_FRAME_DATA), interrupts);
+}
+
+#endif // TEST
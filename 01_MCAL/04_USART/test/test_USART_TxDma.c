@@ -0,0 +1,140 @@
+#ifdef TEST
+
+#include <string.h>
+#include "unity.h"
+#include "USART.h"
+#include "USART_TestSupport.h"
+#include "mock_DMA.h"
+#include "mock_GPIO.h"
+
+const USART_Cfg_t USART_Cfg[_USART_Num] = {
+    [USART1] = {USART_TEST_CFG_8N1(USART_NUMBER_1, 115200), .USART_DmaTx = TRUE}
+};
+
+static boolean dmaStartFails;
+static DMA_Transfer_t lastTransfer;
+static u32 dmaStarts;
+static u8 wire[32];
+static u32 wireLen;
+static u32 doneCount;
+static u32 doneLength[4];
+
+DMA_ErrorStatus_t DMA_allocStream_Callback(u8 DMA_Controller, u8 DMA_Stream, int cmock_num_calls)
+{
+    return DMA_OK;
+}
+
+DMA_ErrorStatus_t DMA_startTransfer_Callback(const DMA_Transfer_t* DMA_Transfer, int cmock_num_calls)
+{
+    TEST_ASSERT_EQUAL(DMA_DIR_MEM_TO_PERIPH, DMA_Transfer->DMA_Direction);
+    lastTransfer = *DMA_Transfer;
+    dmaStarts++;
+    return (dmaStartFails == TRUE) ? DMA_Busy : DMA_OK;
+}
+
+DMA_ErrorStatus_t DMA_getRemaining_Callback(u8 DMA_Controller, u8 DMA_Stream, u16* Remaining, int cmock_num_calls)
+{
+    *Remaining = 0;
+    return DMA_OK;
+}
+
+static void Sender_done(const USART_Completion_t* Completion)
+{
+    if(doneCount < 4)
+    {
+        doneLength[doneCount] = Completion->length;
+    }
+    doneCount++;
+}
+
+static USART_ErrorStatus_t Sender_post(u8* Data, u16 Length)
+{
+    USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = Data, .length = Length, .CB = Sender_done};
+    return USART_sendBufferAsyncZC(Req);
+}
+
+static void Line_transmit(void)
+{
+    USART_SimulateTx(USART_NUMBER_1, wire, &wireLen, sizeof(wire));
+}
+
+static void Dma_complete(void)
+{
+    lastTransfer.CB(DMA_EVENT_FULL, lastTransfer.Context);
+}
+
+void setUp(void)
+{
+    memset(USART_MockRegisters, 0, sizeof(USART_MockRegisters));
+    DMA_allocStream_StubWithCallback(DMA_allocStream_Callback);
+    DMA_startTransfer_StubWithCallback(DMA_startTransfer_Callback);
+    DMA_getRemaining_StubWithCallback(DMA_getRemaining_Callback);
+    dmaStartFails = FALSE;
+    dmaStarts = 0;
+    memset(wire, 0, sizeof(wire));
+    wireLen = 0;
+    doneCount = 0;
+    USART_init();
+}
+
+void tearDown(void)
+{
+    /*Leave the instance idle for the next test*/
+    dmaStartFails = TRUE;
+    Line_transmit();
+}
+
+void test_USART_TxDma_completionChainsTheNextRequest(void)
+{
+    u8 first[] = "abc";
+    u8 second[] = "de";
+    TEST_ASSERT_EQUAL(USART_OK, Sender_post(first, 3));
+    Line_transmit();                    /*The first TXE interrupt hands the request to the stream*/
+    TEST_ASSERT_EQUAL(1, dmaStarts);
+    TEST_ASSERT_TRUE(USART_MockRegisters[USART_NUMBER_1].CR3 & USART_CR3_DMAT);
+
+    /*Posted during the transfer: its TXE interrupt is turned away, the completion takes it*/
+    TEST_ASSERT_EQUAL(USART_OK, Sender_post(second, 2));
+    Line_transmit();
+    TEST_ASSERT_EQUAL(0, wireLen);
+    TEST_ASSERT_EQUAL(1, dmaStarts);
+
+    Dma_complete();
+    TEST_ASSERT_EQUAL(2, dmaStarts);
+    TEST_ASSERT_EQUAL_PTR(second, (u8*)lastTransfer.DMA_MemAddress);
+    Dma_complete();
+    TEST_ASSERT_EQUAL(2, doneCount);
+    TEST_ASSERT_EQUAL(3, doneLength[0]);
+    TEST_ASSERT_EQUAL(2, doneLength[1]);
+}
+
+void test_USART_TxDma_fallbackRequestHasOneConsumer(void)
+{
+    u8 first[] = "abc";
+    u8 second[] = "de";
+    u8 third[] = "f";
+    u16 word = 0;
+    TEST_ASSERT_EQUAL(USART_OK, Sender_post(first, 3));
+    Line_transmit();
+    Dma_complete();
+
+    /*No stream for the next request, it falls back to the TXE interrupt*/
+    dmaStartFails = TRUE;
+    TEST_ASSERT_EQUAL(USART_OK, Sender_post(second, 2));
+    TEST_ASSERT_EQUAL(USART_OK, Sender_post(third, 1));
+    TEST_ASSERT_TRUE(USART_SimulateTxe(USART_NUMBER_1, &word));
+    wire[wireLen++] = (u8)word;
+
+    /*A late completion of the stream must neither complete the request nor take the queued one*/
+    Dma_complete();
+    TEST_ASSERT_EQUAL(1, doneCount);
+
+    Line_transmit();
+    TEST_ASSERT_EQUAL(3, wireLen);
+    TEST_ASSERT_EQUAL_MEMORY("def", wire, 3);
+    TEST_ASSERT_EQUAL(3, doneCount);
+    TEST_ASSERT_EQUAL(2, doneLength[1]);
+    TEST_ASSERT_EQUAL(1, doneLength[2]);
+}
+
+#endif // TEST
@@ -0,0 +1,290 @@
+/******************************************************************************
+*
+* Module: TIM
+*
+* File Name: TIM.c
+*
+* Description: Source file for the General Purpose 32-bit Timers (TIM2/TIM5) driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "MCAL/TIM/TIM.h"
+#include "MCAL/TIM/TIM_Cfg.h"
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define NUMBER_OF_TIM_INSTANCE          2
+#define NUMBER_OF_TIM_CHANNELS          4
+#define TIM2_BASE_ADDR                  0x40000000
+#define TIM5_BASE_ADDR                  0x40000C00
+#define TIM_CR1_CEN                     0x00000001
+#define TIM_EGR_UG                      0x00000001
+#define TIM_EGR_CC1G                    0x00000002
+#define TIM_DIER_CC1IE                  0x00000002
+#define TIM_SR_CC1IF                    0x00000002
+#define TIM_SR_CC_FLAGS_MASK            0x0000001E
+#define TIM_MAX_AUTO_RELOAD             0xFFFFFFFF
+#define TIM_MAX_PRESCALER               0x0000FFFF
+#define TIM_MAX_EVENT_TICKS             0x7FFFFFFF      /*Half the counter range to keep the compare unambiguous*/
+#define TIM_US_PER_SECOND               1000000
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef struct
+{
+    volatile u32 CR1;
+    volatile u32 CR2;
+    volatile u32 SMCR;
+    volatile u32 DIER;
+    volatile u32 SR;
+    volatile u32 EGR;
+    volatile u32 CCMR1;
+    volatile u32 CCMR2;
+    volatile u32 CCER;
+    volatile u32 CNT;
+    volatile u32 PSC;
+    volatile u32 ARR;
+    volatile u32 Reserved1;
+    volatile u32 CCR[NUMBER_OF_TIM_CHANNELS];
+    volatile u32 Reserved2;
+    volatile u32 DCR;
+    volatile u32 DMAR;
+    volatile u32 OR;
+}TIM_Registers_t;
+
+typedef enum{
+    Event_state_Idle,
+    Event_state_Armed
+}Event_State_t;
+
+typedef struct
+{
+    u32 period;
+    u8 mode;
+    Event_State_t state;
+    TIM_CallBack_t CallBack;
+    void* Context;
+}TIM_Event_t;
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+#ifdef TEST
+TIM_Registers_t TIM_MockRegisters[NUMBER_OF_TIM_INSTANCE];
+static TIM_Registers_t* const TIM[NUMBER_OF_TIM_INSTANCE] = {&TIM_MockRegisters[TIM_NUMBER_2],
+                                                             &TIM_MockRegisters[TIM_NUMBER_5]};
+#else
+static TIM_Registers_t* const TIM[NUMBER_OF_TIM_INSTANCE] = {(TIM_Registers_t*)TIM2_BASE_ADDR,
+                                                             (TIM_Registers_t*)TIM5_BASE_ADDR};
+#endif
+
+extern const TIM_Cfg_t TIM_Cfg[_TIM_Num];
+static u16 TIM_TicksPerUS[NUMBER_OF_TIM_INSTANCE] = {0};
+static TIM_Event_t TIM_Event[NUMBER_OF_TIM_INSTANCE][NUMBER_OF_TIM_CHANNELS] = {0};
+
+/********************************************************************************************************/
+/*********************************************Static Functions*******************************************/
+/********************************************************************************************************/
+static void TIM_IRQHandler(u8 TIM_Number)
+{
+    TIM_Registers_t* const Timer = TIM[TIM_Number];
+    u32 pendingFlags = Timer->SR & (Timer->DIER & TIM_SR_CC_FLAGS_MASK);
+    u8 channel = 0;
+    TIM_Event_t* Event;
+    for(channel = 0; channel < NUMBER_OF_TIM_CHANNELS; channel++)
+    {
+        if(pendingFlags & (TIM_SR_CC1IF << channel))
+        {
+            Event = &TIM_Event[TIM_Number][channel];
+            Timer->SR = ~(TIM_SR_CC1IF << channel);         /*rc_w0: Writing 1 to the other flags has no effect*/
+            if(Event->mode == TIM_MODE_PERIODIC)
+            {
+                Timer->CCR[channel] += Event->period;       /*Next compare relative to the previous one to avoid drift*/
+            }
+            else
+            {
+                Timer->DIER &= ~(TIM_DIER_CC1IE << channel);
+                Event->state = Event_state_Idle;
+            }
+            if(Event->CallBack != NULL_PTR)
+            {
+                Event->CallBack(Event->Context);
+            }
+        }
+    }
+}
+
+/********************************************************************************************************/
+/*********************************************APIs Implementation****************************************/
+/********************************************************************************************************/
+TIM_ErrorStatus_t TIM_init(void)
+{
+    TIM_ErrorStatus_t ErrorStatus = TIM_OK;
+    u8 idx = 0;
+    u32 tickFrequency = 0;
+    u32 prescaler = 0;
+    for(idx = 0; idx < _TIM_Num; idx++)
+    {
+        if(TIM_Cfg[idx].TIM_Number >= NUMBER_OF_TIM_INSTANCE)
+        {
+            ErrorStatus = TIM_InvalidNumber;
+        }
+        /*Bounded before multiplying, a large TicksPerUS would wrap the tick frequency*/
+        else if((TIM_Cfg[idx].TIM_TicksPerUS == 0) || (TIM_Cfg[idx].TIM_TicksPerUS > (TIM_CLK / TIM_US_PER_SECOND)))
+        {
+            ErrorStatus = TIM_InvalidResolution;
+        }
+        else if((TIM_CLK % ((u32)TIM_Cfg[idx].TIM_TicksPerUS * TIM_US_PER_SECOND)) ||
+                (((TIM_CLK / ((u32)TIM_Cfg[idx].TIM_TicksPerUS * TIM_US_PER_SECOND)) - 1) > TIM_MAX_PRESCALER))
+        {
+            ErrorStatus = TIM_InvalidResolution;
+        }
+        else
+        {
+            tickFrequency = (u32)TIM_Cfg[idx].TIM_TicksPerUS * TIM_US_PER_SECOND;
+            prescaler = (TIM_CLK / tickFrequency) - 1;
+            TIM[TIM_Cfg[idx].TIM_Number]->CR1 = 0;
+            TIM[TIM_Cfg[idx].TIM_Number]->DIER = 0;
+            TIM[TIM_Cfg[idx].TIM_Number]->PSC = prescaler;
+            TIM[TIM_Cfg[idx].TIM_Number]->ARR = TIM_MAX_AUTO_RELOAD;
+            TIM[TIM_Cfg[idx].TIM_Number]->EGR = TIM_EGR_UG;    /*Load the prescaler, it is buffered until the next update*/
+            TIM[TIM_Cfg[idx].TIM_Number]->SR = 0;
+            TIM[TIM_Cfg[idx].TIM_Number]->CR1 = TIM_CR1_CEN;
+            TIM_TicksPerUS[TIM_Cfg[idx].TIM_Number] = TIM_Cfg[idx].TIM_TicksPerUS;
+        }
+    }
+    return ErrorStatus;
+}
+
+TIM_ErrorStatus_t TIM_startEvent(TIM_Req_t TIM_Req)
+{
+    TIM_ErrorStatus_t ErrorStatus = TIM_OK;
+    u32 ticks = 0;
+    TIM_Registers_t* Timer;
+    if(TIM_Req.CB == NULL_PTR)
+    {
+        ErrorStatus = TIM_NullPtr;
+    }
+    else if(TIM_Req.TIM_Number >= NUMBER_OF_TIM_INSTANCE)
+    {
+        ErrorStatus = TIM_InvalidNumber;
+    }
+    else if(TIM_Req.TIM_Channel >= NUMBER_OF_TIM_CHANNELS)
+    {
+        ErrorStatus = TIM_InvalidChannel;
+    }
+    else if(TIM_Req.TIM_Mode > TIM_MODE_PERIODIC)
+    {
+        ErrorStatus = TIM_InvalidMode;
+    }
+    else if((TIM_Req.TIM_TimeUS == 0) || (TIM_TicksPerUS[TIM_Req.TIM_Number] == 0) ||
+            (TIM_Req.TIM_TimeUS > (TIM_MAX_EVENT_TICKS / TIM_TicksPerUS[TIM_Req.TIM_Number])))
+    {
+        ErrorStatus = TIM_InvalidTime;
+    }
+    else if(TIM_Event[TIM_Req.TIM_Number][TIM_Req.TIM_Channel].state == Event_state_Armed)
+    {
+        ErrorStatus = TIM_Busy;
+    }
+    else
+    {
+        Timer = TIM[TIM_Req.TIM_Number];
+        ticks = TIM_Req.TIM_TimeUS * TIM_TicksPerUS[TIM_Req.TIM_Number];
+        TIM_Event[TIM_Req.TIM_Number][TIM_Req.TIM_Channel].period = ticks;
+        TIM_Event[TIM_Req.TIM_Number][TIM_Req.TIM_Channel].mode = TIM_Req.TIM_Mode;
+        TIM_Event[TIM_Req.TIM_Number][TIM_Req.TIM_Channel].CallBack = TIM_Req.CB;
+        TIM_Event[TIM_Req.TIM_Number][TIM_Req.TIM_Channel].Context = TIM_Req.Context;
+        TIM_Event[TIM_Req.TIM_Number][TIM_Req.TIM_Channel].state = Event_state_Armed;
+
+        Timer->CCR[TIM_Req.TIM_Channel] = Timer->CNT + ticks;
+        Timer->SR = ~(TIM_SR_CC1IF << TIM_Req.TIM_Channel);
+        Timer->DIER |= (TIM_DIER_CC1IE << TIM_Req.TIM_Channel);
+        /*For very short times the counter may have already passed the compare value while arming,
+          generate the event by software instead of waiting a whole counter wrap around*/
+        if((s32)(Timer->CNT - Timer->CCR[TIM_Req.TIM_Channel]) >= 0)
+        {
+            Timer->EGR = (TIM_EGR_CC1G << TIM_Req.TIM_Channel);
+        }
+    }
+    return ErrorStatus;
+}
+
+TIM_ErrorStatus_t TIM_stopEvent(u8 TIM_Number, u8 TIM_Channel)
+{
+    TIM_ErrorStatus_t ErrorStatus = TIM_OK;
+    if(TIM_Number >= NUMBER_OF_TIM_INSTANCE)
+    {
+        ErrorStatus = TIM_InvalidNumber;
+    }
+    else if(TIM_Channel >= NUMBER_OF_TIM_CHANNELS)
+    {
+        ErrorStatus = TIM_InvalidChannel;
+    }
+    else
+    {
+        TIM[TIM_Number]->DIER &= ~(TIM_DIER_CC1IE << TIM_Channel);
+        TIM[TIM_Number]->SR = ~(TIM_SR_CC1IF << TIM_Channel);
+        TIM_Event[TIM_Number][TIM_Channel].state = Event_state_Idle;
+    }
+    return ErrorStatus;
+}
+
+TIM_ErrorStatus_t TIM_getTimeUS(u8 TIM_Number, u32* TimeUS)
+{
+    TIM_ErrorStatus_t ErrorStatus = TIM_OK;
+    if(TimeUS == NULL_PTR)
+    {
+        ErrorStatus = TIM_NullPtr;
+    }
+    else if((TIM_Number >= NUMBER_OF_TIM_INSTANCE) || (TIM_TicksPerUS[TIM_Number] == 0))
+    {
+        ErrorStatus = TIM_InvalidNumber;
+    }
+    else
+    {
+        *TimeUS = TIM[TIM_Number]->CNT / TIM_TicksPerUS[TIM_Number];
+    }
+    return ErrorStatus;
+}
+
+TIM_ErrorStatus_t TIM_delayUS(u8 TIM_Number, u32 TimeUS)
+{
+    TIM_ErrorStatus_t ErrorStatus = TIM_OK;
+    u32 start = 0;
+    u32 ticks = 0;
+    if((TIM_Number >= NUMBER_OF_TIM_INSTANCE) || (TIM_TicksPerUS[TIM_Number] == 0))
+    {
+        ErrorStatus = TIM_InvalidNumber;
+    }
+    else if(TimeUS > (TIM_MAX_EVENT_TICKS / TIM_TicksPerUS[TIM_Number]))
+    {
+        ErrorStatus = TIM_InvalidTime;
+    }
+    else
+    {
+        start = TIM[TIM_Number]->CNT;
+        ticks = TimeUS * TIM_TicksPerUS[TIM_Number];
+        while((TIM[TIM_Number]->CNT - start) < ticks)
+        {
+            /*Wait*/
+        }
+    }
+    return ErrorStatus;
+}
+
+void TIM2_IRQHandler(void)
+{
+    TIM_IRQHandler(TIM_NUMBER_2);
+}
+
+void TIM5_IRQHandler(void)
+{
+    TIM_IRQHandler(TIM_NUMBER_5);
+}
@@ -0,0 +1,144 @@
+/******************************************************************************
+*
+* Module: TIM
+*
+* File Name: TIM.h
+*
+* Description: Header file for the General Purpose 32-bit Timers (TIM2/TIM5) driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef D__ITI_STM32F401CC_DRIVERS_INC_MCAL_TIM_TIM_H_
+#define D__ITI_STM32F401CC_DRIVERS_INC_MCAL_TIM_TIM_H_
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "LIB/std_types.h"
+#include "MCAL/TIM/TIM_Cfg.h"
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define TIM_NUMBER_2                    0U
+#define TIM_NUMBER_5                    1U
+
+#define TIM_CHANNEL_1                   0U
+#define TIM_CHANNEL_2                   1U
+#define TIM_CHANNEL_3                   2U
+#define TIM_CHANNEL_4                   3U
+
+#define TIM_MODE_ONE_SHOT               0U
+#define TIM_MODE_PERIODIC               1U
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef void (*TIM_CallBack_t)(void* Context);
+
+typedef struct{
+    u8 TIM_Number;
+    u16 TIM_TicksPerUS;     /*Counter resolution, 1 gives one tick per microsecond*/
+}TIM_Cfg_t;
+
+typedef struct
+{
+    u8 TIM_Number;
+    u8 TIM_Channel;
+    u8 TIM_Mode;
+    u32 TIM_TimeUS;
+    TIM_CallBack_t CB;
+    void* Context;
+}TIM_Req_t;
+
+typedef enum{
+    TIM_OK,
+    TIM_InvalidNumber,
+    TIM_InvalidChannel,
+    TIM_InvalidMode,
+    TIM_InvalidTime,
+    TIM_InvalidResolution,
+    TIM_NullPtr,
+    TIM_Busy
+}TIM_ErrorStatus_t;
+
+/********************************************************************************************************/
+/************************************************APIs****************************************************/
+/********************************************************************************************************/
+/*****************************************************
+ * Function: TIM_init
+ * Description: Initializes every timer in "TIM_Cfg.c" as a free running 32-bit up counter
+ *              ticking TIM_TicksPerUS times every microsecond.
+ *
+ * Return:
+ *   - TIM_ErrorStatus_t: Status of the operation.
+ *     - TIM_OK: Operation successful.
+ *     - TIM_InvalidNumber: Returned if a configured timer is not TIM2 or TIM5.
+ *     - TIM_InvalidResolution: Returned if TIM_CLK can't be divided down to the requested resolution.
+ *
+ * Notes:
+ *   - Enable the timer clock using the RCC driver before calling this function.
+ *   - Enable TIM2_IRQn / TIM5_IRQn using the NVIC driver to receive the compare events.
+ *****************************************************/
+TIM_ErrorStatus_t TIM_init(void);
+
+/*****************************************************
+ * Function: TIM_startEvent
+ * Description: Arms a compare event on one of the four channels of the timer. The callback is
+ *              called with the request context from the timer interrupt once the time elapses,
+ *              then either every TIM_TimeUS (TIM_MODE_PERIODIC) or never again (TIM_MODE_ONE_SHOT).
+ *
+ * Parameters:
+ *   - TIM_Req: Timer, channel, mode, time in microseconds, callback and its context.
+ *
+ * Return:
+ *   - TIM_ErrorStatus_t: Status of the operation.
+ *     - TIM_OK: Event armed.
+ *     - TIM_NullPtr: Returned if the callback is NULL.
+ *     - TIM_InvalidNumber / TIM_InvalidChannel / TIM_InvalidMode: Returned on invalid request fields.
+ *     - TIM_InvalidTime: Returned if the time is zero or exceeds half of the counter range.
+ *     - TIM_Busy: Returned if the channel already has an armed event.
+ *
+ * Usage:
+ *   TIM_Req_t Req = {TIM_NUMBER_2, TIM_CHANNEL_1, TIM_MODE_ONE_SHOT, 40, LCD_pulseDone, NULL_PTR};
+ *   TIM_startEvent(Req);
+ *****************************************************/
+TIM_ErrorStatus_t TIM_startEvent(TIM_Req_t TIM_Req);
+
+/*****************************************************
+ * Function: TIM_stopEvent
+ * Description: Disarms the compare event of a channel, the callback will not be called afterwards.
+ *
+ * Return:
+ *   - TIM_OK, TIM_InvalidNumber or TIM_InvalidChannel.
+ *****************************************************/
+TIM_ErrorStatus_t TIM_stopEvent(u8 TIM_Number, u8 TIM_Channel);
+
+/*****************************************************
+ * Function: TIM_getTimeUS
+ * Description: Reads the current counter value converted to microseconds.
+ *
+ * Return:
+ *   - TIM_OK, TIM_InvalidNumber or TIM_NullPtr.
+ *
+ * Notes:
+ *   - The value wraps around after (2^32 / TIM_TicksPerUS) microseconds, use unsigned
+ *     subtraction when computing intervals.
+ *****************************************************/
+TIM_ErrorStatus_t TIM_getTimeUS(u8 TIM_Number, u32* TimeUS);
+
+/*****************************************************
+ * Function: TIM_delayUS
+ * Description: Busy waits for the given number of microseconds using the timer counter.
+ *
+ * Return:
+ *   - TIM_OK, TIM_InvalidNumber or TIM_InvalidTime.
+ *
+ * Notes:
+ *   - Intended for short hardware timings (e.g. LCD enable pulse width), use TIM_startEvent
+ *     for anything longer than a few tens of microseconds.
+ *****************************************************/
+TIM_ErrorStatus_t TIM_delayUS(u8 TIM_Number, u32 TimeUS);
+
+#endif // D__ITI_STM32F401CC_DRIVERS_INC_MCAL_TIM_TIM_H_
@@ -0,0 +1,26 @@
+/******************************************************************************
+*
+* Module: TIM
+*
+* File Name: TIM_Cfg.c
+*
+* Description: Source file for the TIM Configuration driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "MCAL/TIM/TIM.h"
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+const TIM_Cfg_t TIM_Cfg[_TIM_Num] = {
+    [TIM_Timebase]={
+        .TIM_Number = TIM_NUMBER_2,
+        .TIM_TicksPerUS = 1
+    }
+};
@@ -0,0 +1,27 @@
+/******************************************************************************
+*
+* Module: TIM
+*
+* File Name: TIM_Cfg.h
+*
+* Description: Header file for the TIM driver Configurations for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef D__ITI_STM32F401CC_DRIVERS_INC_MCAL_TIM_TIM_CFG_H_
+#define D__ITI_STM32F401CC_DRIVERS_INC_MCAL_TIM_TIM_CFG_H_
+
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define TIM_CLK             16000000    /*APB1 Timers Clock*/
+
+enum{
+    TIM_Timebase,
+    _TIM_Num
+};
+
+#endif // D__ITI_STM32F401CC_DRIVERS_INC_MCAL_TIM_TIM_CFG_H_
@@ -0,0 +1,184 @@
+#ifdef TEST
+
+#include "unity.h"
+#include "TIM.h"
+
+#define NUMBER_OF_TIM_INSTANCE          2
+#define NUMBER_OF_TIM_CHANNELS          4
+#define TIM_SR_CC1IF                    0x00000002
+#define TIM_DIER_CC1IE                  0x00000002
+#define TIM_EGR_CC1G                    0x00000002
+
+typedef struct
+{
+    volatile u32 CR1;
+    volatile u32 CR2;
+    volatile u32 SMCR;
+    volatile u32 DIER;
+    volatile u32 SR;
+    volatile u32 EGR;
+    volatile u32 CCMR1;
+    volatile u32 CCMR2;
+    volatile u32 CCER;
+    volatile u32 CNT;
+    volatile u32 PSC;
+    volatile u32 ARR;
+    volatile u32 Reserved1;
+    volatile u32 CCR[NUMBER_OF_TIM_CHANNELS];
+    volatile u32 Reserved2;
+    volatile u32 DCR;
+    volatile u32 DMAR;
+    volatile u32 OR;
+}TIM_Registers_t;
+
+extern TIM_Registers_t TIM_MockRegisters[NUMBER_OF_TIM_INSTANCE];
+extern void TIM2_IRQHandler(void);
+
+const TIM_Cfg_t TIM_Cfg[_TIM_Num] = {
+    [TIM_Timebase] = {.TIM_Number = TIM_NUMBER_2, .TIM_TicksPerUS = 1}
+};
+
+static u32 callBackCount;
+static void* callBackContext;
+static u32 callBackTime[8];
+
+static void TIM_TestCallBack(void* Context)
+{
+    if(callBackCount < 8)
+    {
+        callBackTime[callBackCount] = TIM_MockRegisters[TIM_NUMBER_2].CNT;
+    }
+    callBackCount++;
+    callBackContext = Context;
+}
+
+/*Simulated counter: advances CNT one tick at a time, raising the compare flags like the hardware
+  does (whether the interrupt is enabled or not) and entering the handler when an enabled flag is set*/
+static void TIM_SimulateTicks(u32 ticks)
+{
+    TIM_Registers_t* Timer = &TIM_MockRegisters[TIM_NUMBER_2];
+    u8 channel = 0;
+    while(ticks--)
+    {
+        Timer->CNT++;
+        for(channel = 0; channel < NUMBER_OF_TIM_CHANNELS; channel++)
+        {
+            if((Timer->CNT == Timer->CCR[channel]) || (Timer->EGR & (TIM_EGR_CC1G << channel)))
+            {
+                Timer->SR |= (TIM_SR_CC1IF << channel);
+            }
+        }
+        Timer->EGR = 0;
+        if(Timer->SR & Timer->DIER)
+        {
+            TIM2_IRQHandler();
+        }
+    }
+}
+
+void setUp(void)
+{
+    TIM_Registers_t cleared = {0};
+    TIM_MockRegisters[TIM_NUMBER_2] = cleared;
+    TIM_MockRegisters[TIM_NUMBER_5] = cleared;
+    callBackCount = 0;
+    callBackContext = NULL_PTR;
+    TIM_init();
+}
+
+void tearDown(void)
+{
+    u8 channel = 0;
+    for(channel = 0; channel < NUMBER_OF_TIM_CHANNELS; channel++)
+    {
+        TIM_stopEvent(TIM_NUMBER_2, channel);
+    }
+}
+
+void test_TIM_init_ConfiguresMicrosecondFreeRunningCounter(void)
+{
+    TEST_ASSERT_EQUAL(TIM_OK, TIM_init());
+    TEST_ASSERT_EQUAL_UINT32((TIM_CLK / 1000000) - 1, TIM_MockRegisters[TIM_NUMBER_2].PSC);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFF, TIM_MockRegisters[TIM_NUMBER_2].ARR);
+    TEST_ASSERT_EQUAL_HEX32(0x00000001, TIM_MockRegisters[TIM_NUMBER_2].CR1);
+}
+
+void test_TIM_startEvent_OneShotFiresOnceWithContext(void)
+{
+    u32 context = 0xABCD;
+    TIM_Req_t Req = {TIM_NUMBER_2, TIM_CHANNEL_1, TIM_MODE_ONE_SHOT, 40, TIM_TestCallBack, &context};
+    TIM_MockRegisters[TIM_NUMBER_2].CNT = 1000;
+
+    TEST_ASSERT_EQUAL(TIM_OK, TIM_startEvent(Req));
+    TIM_SimulateTicks(39);
+    TEST_ASSERT_EQUAL_UINT32(0, callBackCount);
+    TIM_SimulateTicks(1);
+    TEST_ASSERT_EQUAL_UINT32(1, callBackCount);
+    TEST_ASSERT_EQUAL_PTR(&context, callBackContext);
+    TEST_ASSERT_EQUAL_UINT32(1040, callBackTime[0]);
+    TIM_SimulateTicks(200);
+    TEST_ASSERT_EQUAL_UINT32(1, callBackCount);
+    TEST_ASSERT_BITS_LOW(TIM_DIER_CC1IE, TIM_MockRegisters[TIM_NUMBER_2].DIER);
+}
+
+void test_TIM_startEvent_PeriodicFiresWithoutDrift(void)
+{
+    TIM_Req_t Req = {TIM_NUMBER_2, TIM_CHANNEL_3, TIM_MODE_PERIODIC, 100, TIM_TestCallBack, NULL_PTR};
+
+    TEST_ASSERT_EQUAL(TIM_OK, TIM_startEvent(Req));
+    TIM_SimulateTicks(450);
+    TEST_ASSERT_EQUAL_UINT32(4, callBackCount);
+    TEST_ASSERT_EQUAL_UINT32(100, callBackTime[0]);
+    TEST_ASSERT_EQUAL_UINT32(400, callBackTime[3]);
+}
+
+void test_TIM_startEvent_BusyChannel(void)
+{
+    TIM_Req_t Req = {TIM_NUMBER_2, TIM_CHANNEL_4, TIM_MODE_ONE_SHOT, 10, TIM_TestCallBack, NULL_PTR};
+    TEST_ASSERT_EQUAL(TIM_OK, TIM_startEvent(Req));
+    TEST_ASSERT_EQUAL(TIM_Busy, TIM_startEvent(Req));
+    TEST_ASSERT_EQUAL(TIM_OK, TIM_stopEvent(TIM_NUMBER_2, TIM_CHANNEL_4));
+    TEST_ASSERT_EQUAL(TIM_OK, TIM_startEvent(Req));
+}
+
+void test_TIM_stopEvent_PreventsCallBack(void)
+{
+    TIM_Req_t Req = {TIM_NUMBER_2, TIM_CHANNEL_1, TIM_MODE_PERIODIC, 10, TIM_TestCallBack, NULL_PTR};
+    TEST_ASSERT_EQUAL(TIM_OK, TIM_startEvent(Req));
+    TIM_SimulateTicks(25);
+    TEST_ASSERT_EQUAL(TIM_OK, TIM_stopEvent(TIM_NUMBER_2, TIM_CHANNEL_1));
+    TIM_SimulateTicks(100);
+    TEST_ASSERT_EQUAL_UINT32(2, callBackCount);
+}
+
+void test_TIM_startEvent_InvalidRequests(void)
+{
+    TIM_Req_t Req = {TIM_NUMBER_2, TIM_CHANNEL_1, TIM_MODE_ONE_SHOT, 10, NULL_PTR, NULL_PTR};
+    TEST_ASSERT_EQUAL(TIM_NullPtr, TIM_startEvent(Req));
+    Req.CB = TIM_TestCallBack;
+    Req.TIM_Number = 5;
+    TEST_ASSERT_EQUAL(TIM_InvalidNumber, TIM_startEvent(Req));
+    Req.TIM_Number = TIM_NUMBER_2;
+    Req.TIM_Channel = 4;
+    TEST_ASSERT_EQUAL(TIM_InvalidChannel, TIM_startEvent(Req));
+    Req.TIM_Channel = TIM_CHANNEL_1;
+    Req.TIM_Mode = 7;
+    TEST_ASSERT_EQUAL(TIM_InvalidMode, TIM_startEvent(Req));
+    Req.TIM_Mode = TIM_MODE_ONE_SHOT;
+    Req.TIM_TimeUS = 0;
+    TEST_ASSERT_EQUAL(TIM_InvalidTime, TIM_startEvent(Req));
+    Req.TIM_TimeUS = 0x80000000;
+    TEST_ASSERT_EQUAL(TIM_InvalidTime, TIM_startEvent(Req));
+}
+
+void test_TIM_getTimeUS_ReadsCounter(void)
+{
+    u32 time = 0;
+    TIM_MockRegisters[TIM_NUMBER_2].CNT = 123456;
+    TEST_ASSERT_EQUAL(TIM_OK, TIM_getTimeUS(TIM_NUMBER_2, &time));
+    TEST_ASSERT_EQUAL_UINT32(123456, time);
+    TEST_ASSERT_EQUAL(TIM_NullPtr, TIM_getTimeUS(TIM_NUMBER_2, NULL_PTR));
+    TEST_ASSERT_EQUAL(TIM_InvalidNumber, TIM_getTimeUS(TIM_NUMBER_5, &time));   /*TIM5 is not configured*/
+}
+
+#endif // TEST
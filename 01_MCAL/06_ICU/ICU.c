@@ -0,0 +1,426 @@
+/******************************************************************************
+*
+* Module: ICU
+*
+* File Name: ICU.c
+*
+* Description: Source file for the Input Capture Unit (TIM3/TIM4) driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "MCAL/GPIO/GPIO.h"
+#include "MCAL/NVIC/NVIC.h"
+#include "MCAL/ICU/ICU.h"
+#include "MCAL/ICU/ICU_Cfg.h"
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define NUMBER_OF_ICU_TIMERS            2
+#define NUMBER_OF_ICU_CHANNELS          4
+#define TIM3_BASE_ADDR                  0x40000400
+#define TIM4_BASE_ADDR                  0x40000800
+#define ICU_CHANNEL_NOT_USED            0xFF
+#define ICU_COUNTER_BITS                16
+#define ICU_COUNTER_MAX                 0x0000FFFF
+#define ICU_COUNTER_HALF_RANGE          0x00008000
+#define ICU_MAX_PRESCALER               0x0000FFFF
+#define ICU_MAX_TICKS                   0xFFFFFFFF
+#define ICU_CR1_CEN                     0x00000001
+#define ICU_EGR_UG                      0x00000001
+#define ICU_DIER_UIE                    0x00000001
+#define ICU_DIER_CC1IE                  0x00000002
+#define ICU_SR_UIF                      0x00000001
+#define ICU_SR_CC1IF                    0x00000002
+#define ICU_SR_OVERCAPTURE_MASK         0x00001E00
+#define ICU_CCMR_CHANNEL_MASK           0x000000FF
+#define ICU_CCMR_CCS_DIRECT             0x00000001      /*ICx mapped on its own TIx*/
+#define ICU_CCMR_CCS_INDIRECT           0x00000002      /*ICx mapped on the TIx of the paired channel*/
+#define ICU_CCMR_ICF_POS                4U
+#define ICU_CCER_CCE                    0x00000001
+#define ICU_CCER_CCP                    0x00000002      /*Falling edge*/
+#define ICU_US_PER_SECOND               1000000
+#define ICU_PERMILLE                    1000
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef struct
+{
+    volatile u32 CR1;
+    volatile u32 CR2;
+    volatile u32 SMCR;
+    volatile u32 DIER;
+    volatile u32 SR;
+    volatile u32 EGR;
+    volatile u32 CCMR[2];
+    volatile u32 CCER;
+    volatile u32 CNT;
+    volatile u32 PSC;
+    volatile u32 ARR;
+    volatile u32 Reserved1;
+    volatile u32 CCR[NUMBER_OF_ICU_CHANNELS];
+    volatile u32 Reserved2;
+    volatile u32 DCR;
+    volatile u32 DMAR;
+}ICU_Registers_t;
+
+typedef struct
+{
+    ICU_Edge_t edges[ICU_EDGE_BUFFER_SIZE];
+    volatile u16 head;          /*Written by the interrupt only*/
+    volatile u16 tail;          /*Written by ICU_readEdges only*/
+    u64 lastRise;
+    u8 risingEdges;
+    volatile u32 period;
+    volatile u32 highTime;
+    volatile ICU_EdgeCallBack_t CallBack;
+}ICU_Input_t;
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+#ifdef TEST
+ICU_Registers_t ICU_MockRegisters[NUMBER_OF_ICU_TIMERS];
+static ICU_Registers_t* const ICU_TIM[NUMBER_OF_ICU_TIMERS] = {&ICU_MockRegisters[ICU_TIM_3],
+                                                               &ICU_MockRegisters[ICU_TIM_4]};
+#else
+static ICU_Registers_t* const ICU_TIM[NUMBER_OF_ICU_TIMERS] = {(ICU_Registers_t*)TIM3_BASE_ADDR,
+                                                               (ICU_Registers_t*)TIM4_BASE_ADDR};
+#endif
+
+static const IRQn_Type ICU_IRQn[NUMBER_OF_ICU_TIMERS] = {TIM3_IRQn, TIM4_IRQn};
+
+extern const ICU_Cfg_t ICU_Cfg[_ICU_Num];
+static ICU_Input_t ICU_Input[_ICU_Num];
+static u64 ICU_Overflows[NUMBER_OF_ICU_TIMERS] = {0};
+static u8 ICU_ChannelMap[NUMBER_OF_ICU_TIMERS][NUMBER_OF_ICU_CHANNELS];
+static u8 ICU_ChannelEdge[NUMBER_OF_ICU_TIMERS][NUMBER_OF_ICU_CHANNELS];
+
+/********************************************************************************************************/
+/*********************************************Static Functions*******************************************/
+/********************************************************************************************************/
+static void ICU_cfgChannel(ICU_Registers_t* Timer, u8 Channel, u32 Selection, u8 Edge)
+{
+    u32 CCMR_value = Timer->CCMR[Channel >> 1];
+    u32 CCER_value = Timer->CCER;
+    u8 CCMR_shift = (Channel & 1U) * 8U;
+    CCMR_value &= ~(ICU_CCMR_CHANNEL_MASK << CCMR_shift);
+    CCMR_value |= (Selection | (ICU_INPUT_FILTER << ICU_CCMR_ICF_POS)) << CCMR_shift;
+    Timer->CCMR[Channel >> 1] = CCMR_value;
+
+    CCER_value &= ~((ICU_CCER_CCE | ICU_CCER_CCP) << (Channel * 4U));
+    CCER_value |= (ICU_CCER_CCE | ((Edge == ICU_EDGE_FALLING) ? ICU_CCER_CCP : 0)) << (Channel * 4U);
+    Timer->CCER = CCER_value;
+
+    Timer->DIER |= (ICU_DIER_CC1IE << Channel);
+}
+
+static u32 ICU_clampTicks(u64 Ticks)
+{
+    return (Ticks > ICU_MAX_TICKS) ? ICU_MAX_TICKS : (u32)Ticks;
+}
+
+static void ICU_recordEdge(u8 ICU_Name, u8 Edge, u64 Timestamp)
+{
+    ICU_Input_t* const Input = &ICU_Input[ICU_Name];
+    ICU_Edge_t Captured;
+    u16 nextHead = (Input->head + 1) & (ICU_EDGE_BUFFER_SIZE - 1);
+    if(nextHead != Input->tail)
+    {
+        Input->edges[Input->head].ICU_Timestamp = Timestamp;
+        Input->edges[Input->head].ICU_Edge = Edge;
+        Input->head = nextHead;
+    }
+    /*Reported even when the ring buffer is full*/
+    if(Input->CallBack != NULL_PTR)
+    {
+        Captured.ICU_Timestamp = Timestamp;
+        Captured.ICU_Edge = Edge;
+        Input->CallBack(ICU_Name, &Captured);
+    }
+
+    if(Edge == ICU_EDGE_RISING)
+    {
+        if(Input->risingEdges)
+        {
+            Input->period = ICU_clampTicks(Timestamp - Input->lastRise);
+        }
+        Input->lastRise = Timestamp;
+        if(Input->risingEdges < 2)
+        {
+            Input->risingEdges++;
+        }
+    }
+    else if(Input->risingEdges)
+    {
+        Input->highTime = ICU_clampTicks(Timestamp - Input->lastRise);
+    }
+    else
+    {
+        /*Falling edge before any rising edge, no complete pulse yet*/
+    }
+}
+
+static void ICU_IRQHandler(u8 ICU_Timer)
+{
+    ICU_Registers_t* const Timer = ICU_TIM[ICU_Timer];
+    u32 status = Timer->SR;
+    u64 overflowTicks = ICU_Overflows[ICU_Timer] << ICU_COUNTER_BITS;
+    u32 capture = 0;
+    u64 timestamp = 0;
+    u8 channel = 0;
+    for(channel = 0; channel < NUMBER_OF_ICU_CHANNELS; channel++)
+    {
+        if((status & (ICU_SR_CC1IF << channel)) && (ICU_ChannelMap[ICU_Timer][channel] != ICU_CHANNEL_NOT_USED))
+        {
+            capture = Timer->CCR[channel];      /*Reading CCR clears CCxIF*/
+            timestamp = overflowTicks + capture;
+            /*An update pending together with a small capture means the edge came after the wrap around*/
+            if((status & ICU_SR_UIF) && (capture < ICU_COUNTER_HALF_RANGE))
+            {
+                timestamp += (ICU_COUNTER_MAX + 1);
+            }
+            ICU_recordEdge(ICU_ChannelMap[ICU_Timer][channel], ICU_ChannelEdge[ICU_Timer][channel], timestamp);
+        }
+    }
+    if(status & (ICU_SR_UIF | ICU_SR_OVERCAPTURE_MASK))
+    {
+        Timer->SR = ~(status & (ICU_SR_UIF | ICU_SR_OVERCAPTURE_MASK));
+        if(status & ICU_SR_UIF)
+        {
+            ICU_Overflows[ICU_Timer]++;
+        }
+    }
+}
+
+/********************************************************************************************************/
+/*********************************************APIs Implementation****************************************/
+/********************************************************************************************************/
+ICU_ErrorStatus_t ICU_init(void)
+{
+    ICU_ErrorStatus_t ErrorStatus = ICU_OK;
+    boolean TimerUsed[NUMBER_OF_ICU_TIMERS] = {FALSE};
+    GPIO_Pin_t ICU_Pin;
+    u8 idx = 0;
+    u8 channel = 0;
+    u8 timer = 0;
+    ICU_Pin.GPIO_Mode = GPIO_MODE_AF_PP;
+    ICU_Pin.GPIO_Speed = GPIO_SPEED_HIGH;
+    for(timer = 0; timer < NUMBER_OF_ICU_TIMERS; timer++)
+    {
+        for(channel = 0; channel < NUMBER_OF_ICU_CHANNELS; channel++)
+        {
+            ICU_ChannelMap[timer][channel] = ICU_CHANNEL_NOT_USED;
+        }
+    }
+    for(idx = 0; idx < _ICU_Num; idx++)
+    {
+        if(ICU_Cfg[idx].ICU_Timer >= NUMBER_OF_ICU_TIMERS)
+        {
+            ErrorStatus = ICU_InvalidTimer;
+        }
+        else if(ICU_Cfg[idx].ICU_Channel >= NUMBER_OF_ICU_CHANNELS)
+        {
+            ErrorStatus = ICU_InvalidChannel;
+        }
+        else if(ICU_Cfg[idx].ICU_Mode > ICU_MODE_PULSE)
+        {
+            ErrorStatus = ICU_InvalidMode;
+        }
+        else if((ICU_Cfg[idx].ICU_Mode == ICU_MODE_PULSE) &&
+                (ICU_Cfg[idx].ICU_Channel != ICU_CHANNEL_1) && (ICU_Cfg[idx].ICU_Channel != ICU_CHANNEL_3))
+        {
+            ErrorStatus = ICU_InvalidChannel;       /*Only channels 1/3 can share their input with channels 2/4*/
+        }
+        else
+        {
+            timer = ICU_Cfg[idx].ICU_Timer;
+            channel = ICU_Cfg[idx].ICU_Channel;
+            ICU_Input[idx].head = 0;
+            ICU_Input[idx].tail = 0;
+            ICU_Input[idx].risingEdges = 0;
+            ICU_Input[idx].period = 0;
+            ICU_Input[idx].highTime = 0;
+
+            ICU_Pin.GPIO_Port = ICU_Cfg[idx].ICU_Port;
+            ICU_Pin.GPIO_Pin = ICU_Cfg[idx].ICU_Pin;
+            GPIO_Init(&ICU_Pin);
+            GPIO_CfgAlternateFn(ICU_Cfg[idx].ICU_Port, ICU_Cfg[idx].ICU_Pin, ICU_Cfg[idx].ICU_AF);
+
+            ICU_ChannelMap[timer][channel] = idx;
+            ICU_ChannelEdge[timer][channel] = ICU_EDGE_RISING;
+            ICU_cfgChannel(ICU_TIM[timer], channel, ICU_CCMR_CCS_DIRECT, ICU_EDGE_RISING);
+            if(ICU_Cfg[idx].ICU_Mode == ICU_MODE_PULSE)
+            {
+                ICU_ChannelMap[timer][channel + 1] = idx;
+                ICU_ChannelEdge[timer][channel + 1] = ICU_EDGE_FALLING;
+                ICU_cfgChannel(ICU_TIM[timer], channel + 1, ICU_CCMR_CCS_INDIRECT, ICU_EDGE_FALLING);
+            }
+            TimerUsed[timer] = TRUE;
+        }
+    }
+    for(timer = 0; timer < NUMBER_OF_ICU_TIMERS; timer++)
+    {
+        if(TimerUsed[timer])
+        {
+            ICU_Overflows[timer] = 0;
+            ICU_TIM[timer]->PSC = (ICU_CLK / ICU_TICK_FREQUENCY) - 1;
+            ICU_TIM[timer]->ARR = ICU_COUNTER_MAX;
+            ICU_TIM[timer]->EGR = ICU_EGR_UG;
+            ICU_TIM[timer]->SR = 0;
+            ICU_TIM[timer]->DIER |= ICU_DIER_UIE;
+            ICU_TIM[timer]->CR1 = ICU_CR1_CEN;
+            NVIC_EnableIRQ(ICU_IRQn[timer]);
+        }
+    }
+    return ErrorStatus;
+}
+
+ICU_ErrorStatus_t ICU_readEdges(u8 ICU_Name, ICU_Edge_t* Edges, u16 MaxEdges, u16* EdgesCount)
+{
+    ICU_ErrorStatus_t ErrorStatus = ICU_OK;
+    u16 count = 0;
+    u16 tail = 0;
+    if((Edges == NULL_PTR) || (EdgesCount == NULL_PTR))
+    {
+        ErrorStatus = ICU_NullPtr;
+    }
+    else if(ICU_Name >= _ICU_Num)
+    {
+        ErrorStatus = ICU_InvalidName;
+    }
+    else
+    {
+        tail = ICU_Input[ICU_Name].tail;
+        while((count < MaxEdges) && (tail != ICU_Input[ICU_Name].head))
+        {
+            Edges[count] = ICU_Input[ICU_Name].edges[tail];
+            tail = (tail + 1) & (ICU_EDGE_BUFFER_SIZE - 1);
+            count++;
+        }
+        ICU_Input[ICU_Name].tail = tail;
+        *EdgesCount = count;
+    }
+    return ErrorStatus;
+}
+
+ICU_ErrorStatus_t ICU_setEdgeCallBack(u8 ICU_Name, ICU_EdgeCallBack_t CB)
+{
+    ICU_ErrorStatus_t ErrorStatus = ICU_OK;
+    if(ICU_Name >= _ICU_Num)
+    {
+        ErrorStatus = ICU_InvalidName;
+    }
+    else
+    {
+        ICU_Input[ICU_Name].CallBack = CB;
+    }
+    return ErrorStatus;
+}
+
+ICU_ErrorStatus_t ICU_getFrequency(u8 ICU_Name, u32* FrequencyHz)
+{
+    ICU_ErrorStatus_t ErrorStatus = ICU_OK;
+    u32 period = 0;
+    if(FrequencyHz == NULL_PTR)
+    {
+        ErrorStatus = ICU_NullPtr;
+    }
+    else if(ICU_Name >= _ICU_Num)
+    {
+        ErrorStatus = ICU_InvalidName;
+    }
+    else
+    {
+        period = ICU_Input[ICU_Name].period;
+        if(period == 0)
+        {
+            ErrorStatus = ICU_NoMeasurement;
+        }
+        else
+        {
+            *FrequencyHz = (ICU_TICK_FREQUENCY + (period / 2)) / period;
+        }
+    }
+    return ErrorStatus;
+}
+
+ICU_ErrorStatus_t ICU_getPulseWidthUS(u8 ICU_Name, u32* PulseWidthUS)
+{
+    ICU_ErrorStatus_t ErrorStatus = ICU_OK;
+    u32 highTime = 0;
+    if(PulseWidthUS == NULL_PTR)
+    {
+        ErrorStatus = ICU_NullPtr;
+    }
+    else if(ICU_Name >= _ICU_Num)
+    {
+        ErrorStatus = ICU_InvalidName;
+    }
+    else if(ICU_Cfg[ICU_Name].ICU_Mode != ICU_MODE_PULSE)
+    {
+        ErrorStatus = ICU_InvalidMode;
+    }
+    else
+    {
+        highTime = ICU_Input[ICU_Name].highTime;
+        if(highTime == 0)
+        {
+            ErrorStatus = ICU_NoMeasurement;
+        }
+        else
+        {
+            *PulseWidthUS = (u32)(((u64)highTime * ICU_US_PER_SECOND) / ICU_TICK_FREQUENCY);
+        }
+    }
+    return ErrorStatus;
+}
+
+ICU_ErrorStatus_t ICU_getDutyCycle(u8 ICU_Name, u16* DutyPermille)
+{
+    ICU_ErrorStatus_t ErrorStatus = ICU_OK;
+    u32 period = 0;
+    u32 highTime = 0;
+    if(DutyPermille == NULL_PTR)
+    {
+        ErrorStatus = ICU_NullPtr;
+    }
+    else if(ICU_Name >= _ICU_Num)
+    {
+        ErrorStatus = ICU_InvalidName;
+    }
+    else if(ICU_Cfg[ICU_Name].ICU_Mode != ICU_MODE_PULSE)
+    {
+        ErrorStatus = ICU_InvalidMode;
+    }
+    else
+    {
+        period = ICU_Input[ICU_Name].period;
+        highTime = ICU_Input[ICU_Name].highTime;
+        if((period == 0) || (highTime == 0))
+        {
+            ErrorStatus = ICU_NoMeasurement;
+        }
+        else
+        {
+            *DutyPermille = (highTime >= period) ? ICU_PERMILLE : (u16)(((u64)highTime * ICU_PERMILLE) / period);
+        }
+    }
+    return ErrorStatus;
+}
+
+void TIM3_IRQHandler(void)
+{
+    ICU_IRQHandler(ICU_TIM_3);
+}
+
+void TIM4_IRQHandler(void)
+{
+    ICU_IRQHandler(ICU_TIM_4);
+}
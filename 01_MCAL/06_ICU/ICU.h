@@ -0,0 +1,146 @@
+/******************************************************************************
+*
+* Module: ICU
+*
+* File Name: ICU.h
+*
+* Description: Header file for the Input Capture Unit (TIM3/TIM4) driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef D__ITI_STM32F401CC_DRIVERS_INC_MCAL_ICU_ICU_H_
+#define D__ITI_STM32F401CC_DRIVERS_INC_MCAL_ICU_ICU_H_
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "LIB/std_types.h"
+#include "MCAL/ICU/ICU_Cfg.h"
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define ICU_TIM_3                       0U
+#define ICU_TIM_4                       1U
+
+#define ICU_CHANNEL_1                   0U
+#define ICU_CHANNEL_2                   1U
+#define ICU_CHANNEL_3                   2U
+#define ICU_CHANNEL_4                   3U
+
+#define ICU_MODE_PERIOD                 0U      /*Rising edges only on the configured channel*/
+#define ICU_MODE_PULSE                  1U      /*Rising edges on ICU_CHANNEL_1/3 and falling edges of the same
+                                                  input on the next channel (ICU_CHANNEL_2/4), both are reserved*/
+
+#define ICU_EDGE_RISING                 0U
+#define ICU_EDGE_FALLING                1U
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef struct{
+    u8 ICU_Timer;
+    u8 ICU_Channel;
+    u8 ICU_Mode;
+    void* ICU_Port;
+    u32 ICU_Pin;
+    u32 ICU_AF;
+}ICU_Cfg_t;
+
+typedef struct
+{
+    u64 ICU_Timestamp;      /*Timer ticks (ICU_TICK_FREQUENCY) since ICU_init, extended from 16 to 64 bits*/
+    u8 ICU_Edge;
+}ICU_Edge_t;
+
+/*Called from the timer interrupt for every captured edge of the input*/
+typedef void (*ICU_EdgeCallBack_t)(u8 ICU_Name, const ICU_Edge_t* Edge);
+
+typedef enum{
+    ICU_OK,
+    ICU_InvalidName,
+    ICU_InvalidTimer,
+    ICU_InvalidChannel,
+    ICU_InvalidMode,
+    ICU_NullPtr,
+    ICU_NoMeasurement
+}ICU_ErrorStatus_t;
+
+/********************************************************************************************************/
+/************************************************APIs****************************************************/
+/********************************************************************************************************/
+/*****************************************************
+ * Function: ICU_init
+ * Description: Configures every input in "ICU_Cfg.c": muxes its pin to the timer alternate function,
+ *              configures the capture channels, starts the timers and enables their interrupts.
+ *
+ * Return:
+ *   - ICU_ErrorStatus_t: ICU_OK, ICU_InvalidTimer, ICU_InvalidChannel or ICU_InvalidMode.
+ *
+ * Notes:
+ *   - Enable the GPIO port and timer clocks using the RCC driver before calling this function.
+ *****************************************************/
+ICU_ErrorStatus_t ICU_init(void);
+
+/*****************************************************
+ * Function: ICU_readEdges
+ * Description: Pops the oldest captured edges of an input from its ring buffer.
+ *
+ * Parameters:
+ *   - ICU_Name: The input name in the configuration enum "ICU_Cfg.h".
+ *   - Edges: Array receiving the edges, oldest first.
+ *   - MaxEdges: Size of the Edges array.
+ *   - EdgesCount: Number of edges written to the array.
+ *
+ * Return:
+ *   - ICU_OK, ICU_InvalidName or ICU_NullPtr.
+ *
+ * Notes:
+ *   - When the ring buffer is full new edges are dropped, the computed measurements are still updated.
+ *****************************************************/
+ICU_ErrorStatus_t ICU_readEdges(u8 ICU_Name, ICU_Edge_t* Edges, u16 MaxEdges, u16* EdgesCount);
+
+/*****************************************************
+ * Function: ICU_setEdgeCallBack
+ * Description: Sets the callback called from the timer interrupt with each captured edge of an input, as it
+ *              is recorded in the ring buffer, NULL_PTR removes it.
+ *
+ * Return:
+ *   - ICU_OK or ICU_InvalidName.
+ *
+ * Notes:
+ *   - The edges captured by one interrupt are reported channel by channel: in ICU_MODE_PULSE a rising and a
+ *     falling edge of the same interrupt may come out of order, use their timestamps.
+ *****************************************************/
+ICU_ErrorStatus_t ICU_setEdgeCallBack(u8 ICU_Name, ICU_EdgeCallBack_t CB);
+
+/*****************************************************
+ * Function: ICU_getFrequency
+ * Description: Frequency of the input in Hz computed from the last two rising edges.
+ *
+ * Return:
+ *   - ICU_OK, ICU_InvalidName, ICU_NullPtr or ICU_NoMeasurement if two rising edges weren't captured yet.
+ *****************************************************/
+ICU_ErrorStatus_t ICU_getFrequency(u8 ICU_Name, u32* FrequencyHz);
+
+/*****************************************************
+ * Function: ICU_getPulseWidthUS
+ * Description: High time of the last complete pulse in microseconds (ICU_MODE_PULSE inputs only).
+ *
+ * Return:
+ *   - ICU_OK, ICU_InvalidName, ICU_InvalidMode, ICU_NullPtr or ICU_NoMeasurement.
+ *****************************************************/
+ICU_ErrorStatus_t ICU_getPulseWidthUS(u8 ICU_Name, u32* PulseWidthUS);
+
+/*****************************************************
+ * Function: ICU_getDutyCycle
+ * Description: Duty cycle of the input in permille computed from the last period and high time
+ *              (ICU_MODE_PULSE inputs only).
+ *
+ * Return:
+ *   - ICU_OK, ICU_InvalidName, ICU_InvalidMode, ICU_NullPtr or ICU_NoMeasurement.
+ *****************************************************/
+ICU_ErrorStatus_t ICU_getDutyCycle(u8 ICU_Name, u16* DutyPermille);
+
+#endif // D__ITI_STM32F401CC_DRIVERS_INC_MCAL_ICU_ICU_H_
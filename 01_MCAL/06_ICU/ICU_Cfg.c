@@ -0,0 +1,31 @@
+/******************************************************************************
+*
+* Module: ICU
+*
+* File Name: ICU_Cfg.c
+*
+* Description: Source file for the ICU Configuration driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "MCAL/GPIO/GPIO.h"
+#include "MCAL/ICU/ICU.h"
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+const ICU_Cfg_t ICU_Cfg[_ICU_Num] = {
+    [ICU_PulseTrain]={
+        .ICU_Timer = ICU_TIM_3,
+        .ICU_Channel = ICU_CHANNEL_1,
+        .ICU_Mode = ICU_MODE_PULSE,
+        .ICU_Port = GPIO_PORT_A,
+        .ICU_Pin = GPIO_PIN_6,          /*PA6 = TIM3_CH1*/
+        .ICU_AF = GPIO_FUNC_AF2
+    }
+};
@@ -0,0 +1,30 @@
+/******************************************************************************
+*
+* Module: ICU
+*
+* File Name: ICU_Cfg.h
+*
+* Description: Header file for the ICU driver Configurations for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef D__ITI_STM32F401CC_DRIVERS_INC_MCAL_ICU_ICU_CFG_H_
+#define D__ITI_STM32F401CC_DRIVERS_INC_MCAL_ICU_ICU_CFG_H_
+
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define ICU_CLK                     16000000    /*APB1 Timers Clock*/
+#define ICU_TICK_FREQUENCY          16000000    /*Capture resolution, ICU_CLK must be a multiple of it*/
+#define ICU_INPUT_FILTER            0x3         /*IC filter: fCK_INT with N=8 samples*/
+#define ICU_EDGE_BUFFER_SIZE        16          /*Edges kept per input, must be a power of two*/
+
+enum{
+    ICU_PulseTrain,
+    _ICU_Num
+};
+
+#endif // D__ITI_STM32F401CC_DRIVERS_INC_MCAL_ICU_ICU_CFG_H_
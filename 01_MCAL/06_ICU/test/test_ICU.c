@@ -0,0 +1,200 @@
+#ifdef TEST
+
+#include "unity.h"
+#include "ICU.h"
+#include "mock_GPIO.h"
+#include "mock_NVIC.h"
+
+#define NUMBER_OF_ICU_TIMERS            2
+#define NUMBER_OF_ICU_CHANNELS          4
+#define ICU_COUNTER_RANGE               0x00010000ULL
+#define ICU_SR_UIF                      0x00000001
+#define ICU_SR_CC1IF                    0x00000002
+#define ICU_SR_CC2IF                    0x00000004
+#define ICU_DIER_UIE                    0x00000001
+#define ICU_DIER_CC1IE                  0x00000002
+#define ICU_DIER_CC2IE                  0x00000004
+#define ICU_CCER_CC1E                   0x00000001
+#define ICU_CCER_CC2E                   0x00000010
+#define ICU_CCER_CC2P                   0x00000020
+
+typedef struct
+{
+    volatile u32 CR1;
+    volatile u32 CR2;
+    volatile u32 SMCR;
+    volatile u32 DIER;
+    volatile u32 SR;
+    volatile u32 EGR;
+    volatile u32 CCMR[2];
+    volatile u32 CCER;
+    volatile u32 CNT;
+    volatile u32 PSC;
+    volatile u32 ARR;
+    volatile u32 Reserved1;
+    volatile u32 CCR[NUMBER_OF_ICU_CHANNELS];
+    volatile u32 Reserved2;
+    volatile u32 DCR;
+    volatile u32 DMAR;
+}ICU_Registers_t;
+
+extern ICU_Registers_t ICU_MockRegisters[NUMBER_OF_ICU_TIMERS];
+extern void TIM3_IRQHandler(void);
+
+const ICU_Cfg_t ICU_Cfg[_ICU_Num] = {
+    [ICU_PulseTrain] = {.ICU_Timer = ICU_TIM_3, .ICU_Channel = ICU_CHANNEL_1, .ICU_Mode = ICU_MODE_PULSE,
+                        .ICU_Port = GPIO_PORT_A, .ICU_Pin = GPIO_PIN_6, .ICU_AF = GPIO_FUNC_AF2}
+};
+
+/*Simulated interrupt: raises the given flags with the captured counter values like the hardware does, enters
+  the handler, then drops the capture flags that reading CCR clears on the real timer*/
+static void ICU_SimulateInterrupt(u32 Flags, u16 Capture1, u16 Capture2)
+{
+    ICU_Registers_t* Timer = &ICU_MockRegisters[ICU_TIM_3];
+    Timer->CCR[ICU_CHANNEL_1] = Capture1;
+    Timer->CCR[ICU_CHANNEL_2] = Capture2;
+    Timer->SR |= Flags;
+    TIM3_IRQHandler();
+    Timer->SR &= ~(ICU_SR_CC1IF | ICU_SR_CC2IF);
+}
+
+static void ICU_SimulateOverflows(u32 Overflows)
+{
+    while(Overflows--)
+    {
+        ICU_SimulateInterrupt(ICU_SR_UIF, 0, 0);
+    }
+}
+
+static ICU_Edge_t ICU_ReadOneEdge(void)
+{
+    ICU_Edge_t Edge = {0};
+    u16 count = 0;
+    TEST_ASSERT_EQUAL(ICU_OK, ICU_readEdges(ICU_PulseTrain, &Edge, 1, &count));
+    TEST_ASSERT_EQUAL(1, count);
+    return Edge;
+}
+
+void setUp(void)
+{
+    ICU_Registers_t cleared = {0};
+    ICU_MockRegisters[ICU_TIM_3] = cleared;
+    ICU_MockRegisters[ICU_TIM_4] = cleared;
+    ICU_setEdgeCallBack(ICU_PulseTrain, NULL_PTR);
+    TEST_ASSERT_EQUAL(ICU_OK, ICU_init());
+}
+
+void tearDown(void)
+{
+}
+
+void test_ICU_init_ConfiguresPulseChannels(void)
+{
+    ICU_Registers_t* Timer = &ICU_MockRegisters[ICU_TIM_3];
+    TEST_ASSERT_EQUAL(0, Timer->PSC);
+    TEST_ASSERT_EQUAL(0xFFFF, Timer->ARR);
+    TEST_ASSERT_BITS_HIGH(ICU_DIER_UIE | ICU_DIER_CC1IE | ICU_DIER_CC2IE, Timer->DIER);
+    /*Channel 1 rising on TI1, channel 2 falling on the same input*/
+    TEST_ASSERT_BITS_HIGH(ICU_CCER_CC1E | ICU_CCER_CC2E | ICU_CCER_CC2P, Timer->CCER);
+    TEST_ASSERT_EQUAL(0x01, Timer->CCMR[0] & 0x03);
+    TEST_ASSERT_EQUAL(0x02, (Timer->CCMR[0] >> 8) & 0x03);
+}
+
+void test_ICU_Timestamp_ExtendedByOverflows(void)
+{
+    ICU_Edge_t Edge;
+    ICU_SimulateOverflows(3);
+    ICU_SimulateInterrupt(ICU_SR_CC1IF, 0x1234, 0);
+    Edge = ICU_ReadOneEdge();
+    TEST_ASSERT_EQUAL(ICU_EDGE_RISING, Edge.ICU_Edge);
+    TEST_ASSERT_EQUAL(3 * ICU_COUNTER_RANGE + 0x1234, Edge.ICU_Timestamp);
+}
+
+void test_ICU_Timestamp_ExtendsBeyond32Bits(void)
+{
+    ICU_Edge_t Edge;
+    ICU_SimulateOverflows(0x10001);     /*Past 2^32 ticks*/
+    ICU_SimulateInterrupt(ICU_SR_CC1IF, 0x0042, 0);
+    Edge = ICU_ReadOneEdge();
+    TEST_ASSERT_EQUAL(0x10001ULL * ICU_COUNTER_RANGE + 0x0042, Edge.ICU_Timestamp);
+    TEST_ASSERT_TRUE(Edge.ICU_Timestamp > 0xFFFFFFFFULL);
+}
+
+void test_ICU_UpdateAndCaptureInSameInterrupt_CaptureBeforeOverflow(void)
+{
+    ICU_Edge_t Edge;
+    ICU_SimulateOverflows(2);
+    /*The edge was captured at the top of the counter, the wrap around came right after it*/
+    ICU_SimulateInterrupt(ICU_SR_UIF | ICU_SR_CC1IF, 0xFFF0, 0);
+    Edge = ICU_ReadOneEdge();
+    TEST_ASSERT_EQUAL(2 * ICU_COUNTER_RANGE + 0xFFF0, Edge.ICU_Timestamp);
+
+    /*The overflow is still counted for the next captures*/
+    ICU_SimulateInterrupt(ICU_SR_CC1IF, 0x0010, 0);
+    Edge = ICU_ReadOneEdge();
+    TEST_ASSERT_EQUAL(3 * ICU_COUNTER_RANGE + 0x0010, Edge.ICU_Timestamp);
+}
+
+void test_ICU_UpdateAndCaptureInSameInterrupt_CaptureAfterOverflow(void)
+{
+    ICU_Edge_t Edge;
+    ICU_SimulateOverflows(2);
+    /*The counter wrapped around, then the edge was captured before the pending update was served*/
+    ICU_SimulateInterrupt(ICU_SR_UIF | ICU_SR_CC1IF, 0x0010, 0);
+    Edge = ICU_ReadOneEdge();
+    TEST_ASSERT_EQUAL(3 * ICU_COUNTER_RANGE + 0x0010, Edge.ICU_Timestamp);
+
+    ICU_SimulateInterrupt(ICU_SR_CC1IF, 0x0020, 0);
+    Edge = ICU_ReadOneEdge();
+    TEST_ASSERT_EQUAL(3 * ICU_COUNTER_RANGE + 0x0020, Edge.ICU_Timestamp);
+}
+
+void test_ICU_FrequencyAndDuty_FromPulseTrain(void)
+{
+    u32 frequency = 0;
+    u32 widthUS = 0;
+    u16 duty = 0;
+    TEST_ASSERT_EQUAL(ICU_NoMeasurement, ICU_getFrequency(ICU_PulseTrain, &frequency));
+    /*1 kHz at 16 MHz: 16000 ticks period, 4000 ticks (250 us) high*/
+    ICU_SimulateInterrupt(ICU_SR_CC1IF, 1000, 0);
+    ICU_SimulateInterrupt(ICU_SR_CC2IF, 0, 5000);
+    TEST_ASSERT_EQUAL(ICU_NoMeasurement, ICU_getFrequency(ICU_PulseTrain, &frequency));
+    ICU_SimulateInterrupt(ICU_SR_CC1IF, 17000, 0);
+    ICU_SimulateInterrupt(ICU_SR_CC2IF, 0, 21000);
+
+    TEST_ASSERT_EQUAL(ICU_OK, ICU_getFrequency(ICU_PulseTrain, &frequency));
+    TEST_ASSERT_EQUAL(1000, frequency);
+    TEST_ASSERT_EQUAL(ICU_OK, ICU_getPulseWidthUS(ICU_PulseTrain, &widthUS));
+    TEST_ASSERT_EQUAL(250, widthUS);
+    TEST_ASSERT_EQUAL(ICU_OK, ICU_getDutyCycle(ICU_PulseTrain, &duty));
+    TEST_ASSERT_EQUAL(250, duty);
+}
+
+void test_ICU_FrequencyAndDuty_AcrossOverflow(void)
+{
+    u32 frequency = 0;
+    u16 duty = 0;
+    /*Rising edge near the top of the counter, falling edge and next rising edge after the wrap around,
+      the falling edge shares its interrupt with the update*/
+    ICU_SimulateInterrupt(ICU_SR_CC1IF, 0xF000, 0);
+    ICU_SimulateInterrupt(ICU_SR_UIF | ICU_SR_CC2IF, 0, 0xF000 + 12000 - 0x10000);
+    ICU_SimulateInterrupt(ICU_SR_CC1IF, 0xF000 + 16000 - 0x10000, 0);
+
+    TEST_ASSERT_EQUAL(ICU_OK, ICU_getFrequency(ICU_PulseTrain, &frequency));
+    TEST_ASSERT_EQUAL(1000, frequency);
+    TEST_ASSERT_EQUAL(ICU_OK, ICU_getDutyCycle(ICU_PulseTrain, &duty));
+    TEST_ASSERT_EQUAL(750, duty);
+}
+
+void test_ICU_InvalidRequests(void)
+{
+    u32 frequency = 0;
+    u16 count = 0;
+    ICU_Edge_t Edge;
+    TEST_ASSERT_EQUAL(ICU_InvalidName, ICU_getFrequency(_ICU_Num, &frequency));
+    TEST_ASSERT_EQUAL(ICU_NullPtr, ICU_getFrequency(ICU_PulseTrain, NULL_PTR));
+    TEST_ASSERT_EQUAL(ICU_NullPtr, ICU_readEdges(ICU_PulseTrain, NULL_PTR, 1, &count));
+    TEST_ASSERT_EQUAL(ICU_InvalidName, ICU_readEdges(_ICU_Num, &Edge, 1, &count));
+}
+
+#endif // TEST
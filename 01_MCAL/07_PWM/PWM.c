@@ -0,0 +1,328 @@
+/******************************************************************************
+*
+* Module: PWM
+*
+* File Name: PWM.c
+*
+* Description: Source file for the Hardware PWM (TIM1/TIM3/TIM4) driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "MCAL/GPIO/GPIO.h"
+#include "MCAL/PWM/PWM.h"
+#include "MCAL/PWM/PWM_Cfg.h"
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define NUMBER_OF_PWM_TIMERS            3
+#define NUMBER_OF_PWM_CHANNELS          4
+#define NUMBER_OF_COMPLEMENTARY_CHANNELS 3
+#define TIM1_BASE_ADDR                  0x40010000
+#define TIM3_BASE_ADDR                  0x40000400
+#define TIM4_BASE_ADDR                  0x40000800
+#define PWM_COUNTER_MAX                 0x0000FFFF
+#define PWM_MAX_PRESCALER               0x0000FFFF
+#define PWM_CR1_CEN                     0x00000001
+#define PWM_CR1_UDIS                    0x00000002
+#define PWM_CR1_ARPE                    0x00000080
+#define PWM_EGR_UG                      0x00000001
+#define PWM_CCMR_CHANNEL_MASK           0x000000FF
+#define PWM_CCMR_OC_PWM1_PRELOAD        0x00000068      /*OCxM = 110 (PWM mode 1) and OCxPE*/
+#define PWM_CCER_CHANNEL_MASK           0x0000000F
+#define PWM_CCER_CCE                    0x00000001
+#define PWM_CCER_CCP                    0x00000002
+#define PWM_CCER_CCNE                   0x00000004
+#define PWM_CCER_CCNP                   0x00000008
+#define PWM_BDTR_MOE                    0x00008000
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef struct
+{
+    volatile u32 CR1;
+    volatile u32 CR2;
+    volatile u32 SMCR;
+    volatile u32 DIER;
+    volatile u32 SR;
+    volatile u32 EGR;
+    volatile u32 CCMR[2];
+    volatile u32 CCER;
+    volatile u32 CNT;
+    volatile u32 PSC;
+    volatile u32 ARR;
+    volatile u32 RCR;
+    volatile u32 CCR[NUMBER_OF_PWM_CHANNELS];
+    volatile u32 BDTR;          /*TIM1 only*/
+    volatile u32 DCR;
+    volatile u32 DMAR;
+}PWM_Registers_t;
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+#ifdef TEST
+PWM_Registers_t PWM_MockRegisters[NUMBER_OF_PWM_TIMERS];
+static PWM_Registers_t* const PWM_TIM[NUMBER_OF_PWM_TIMERS] = {&PWM_MockRegisters[PWM_TIM_1],
+                                                               &PWM_MockRegisters[PWM_TIM_3],
+                                                               &PWM_MockRegisters[PWM_TIM_4]};
+#else
+static PWM_Registers_t* const PWM_TIM[NUMBER_OF_PWM_TIMERS] = {(PWM_Registers_t*)TIM1_BASE_ADDR,
+                                                               (PWM_Registers_t*)TIM3_BASE_ADDR,
+                                                               (PWM_Registers_t*)TIM4_BASE_ADDR};
+#endif
+
+static const u32 PWM_TimerClk[NUMBER_OF_PWM_TIMERS] = {PWM_APB2_TIM_CLK, PWM_APB1_TIM_CLK, PWM_APB1_TIM_CLK};
+
+extern const PWM_Cfg_t PWM_Cfg[_PWM_Num];
+static u32 PWM_TimerFrequency[NUMBER_OF_PWM_TIMERS] = {0};
+static u16 PWM_Duty[_PWM_Num] = {0};
+
+/********************************************************************************************************/
+/*********************************************Static Functions*******************************************/
+/********************************************************************************************************/
+static boolean PWM_isValidFrequency(u8 PWM_Timer, u32 FrequencyHz)
+{
+    return (FrequencyHz != 0) && (FrequencyHz <= (PWM_TimerClk[PWM_Timer] / 2)) &&
+           ((((PWM_TimerClk[PWM_Timer] / FrequencyHz) - 1) / (PWM_COUNTER_MAX + 1)) <= PWM_MAX_PRESCALER);
+}
+
+/*Smallest prescaler that fits the period in the 16-bit counter to get the finest duty resolution*/
+static void PWM_cfgTimerFrequency(u8 PWM_Timer, u32 FrequencyHz)
+{
+    u32 periodTicks = PWM_TimerClk[PWM_Timer] / FrequencyHz;
+    u32 prescaler = (periodTicks - 1) / (PWM_COUNTER_MAX + 1);
+    PWM_TIM[PWM_Timer]->PSC = prescaler;
+    PWM_TIM[PWM_Timer]->ARR = (PWM_TimerClk[PWM_Timer] / ((prescaler + 1) * FrequencyHz)) - 1;
+    PWM_TimerFrequency[PWM_Timer] = FrequencyHz;
+}
+
+static void PWM_writeCompare(u8 PWM_Name, u16 DutyPermille)
+{
+    PWM_Registers_t* const Timer = PWM_TIM[PWM_Cfg[PWM_Name].PWM_Timer];
+    Timer->CCR[PWM_Cfg[PWM_Name].PWM_Channel] = ((Timer->ARR + 1) * DutyPermille) / PWM_DUTY_MAX;
+    PWM_Duty[PWM_Name] = DutyPermille;
+}
+
+static void PWM_cfgPin(void* PWM_Port, u32 PWM_Pin, u32 PWM_AF)
+{
+    GPIO_Pin_t PWM_OutputPin;
+    PWM_OutputPin.GPIO_Port = PWM_Port;
+    PWM_OutputPin.GPIO_Pin = PWM_Pin;
+    PWM_OutputPin.GPIO_Mode = GPIO_MODE_AF_PP;
+    PWM_OutputPin.GPIO_Speed = GPIO_SPEED_HIGH;
+    GPIO_Init(&PWM_OutputPin);
+    GPIO_CfgAlternateFn(PWM_Port, PWM_Pin, PWM_AF);
+}
+
+/********************************************************************************************************/
+/*********************************************APIs Implementation****************************************/
+/********************************************************************************************************/
+PWM_ErrorStatus_t PWM_init(void)
+{
+    PWM_ErrorStatus_t ErrorStatus = PWM_OK;
+    u8 idx = 0;
+    u8 timer = 0;
+    u8 channel = 0;
+    u32 CCMR_value = 0;
+    u32 CCER_value = 0;
+    for(timer = 0; timer < NUMBER_OF_PWM_TIMERS; timer++)
+    {
+        PWM_TimerFrequency[timer] = 0;
+    }
+    for(idx = 0; idx < _PWM_Num; idx++)
+    {
+        timer = PWM_Cfg[idx].PWM_Timer;
+        channel = PWM_Cfg[idx].PWM_Channel;
+        if(timer >= NUMBER_OF_PWM_TIMERS)
+        {
+            ErrorStatus = PWM_InvalidTimer;
+        }
+        else if(channel >= NUMBER_OF_PWM_CHANNELS)
+        {
+            ErrorStatus = PWM_InvalidChannel;
+        }
+        else if(!PWM_isValidFrequency(timer, PWM_Cfg[idx].PWM_FrequencyHz) ||
+                ((PWM_TimerFrequency[timer] != 0) && (PWM_TimerFrequency[timer] != PWM_Cfg[idx].PWM_FrequencyHz)))
+        {
+            ErrorStatus = PWM_InvalidFrequency;
+        }
+        else if(PWM_Cfg[idx].PWM_Complementary &&
+                ((timer != PWM_TIM_1) || (channel >= NUMBER_OF_COMPLEMENTARY_CHANNELS)))
+        {
+            ErrorStatus = PWM_InvalidComplementary;
+        }
+        else
+        {
+            if(PWM_TimerFrequency[timer] == 0)
+            {
+                PWM_TIM[timer]->CR1 = 0;
+                PWM_cfgTimerFrequency(timer, PWM_Cfg[idx].PWM_FrequencyHz);
+            }
+            PWM_TIM[timer]->CCR[channel] = 0;
+            PWM_Duty[idx] = 0;
+
+            CCMR_value = PWM_TIM[timer]->CCMR[channel >> 1];
+            CCMR_value &= ~(PWM_CCMR_CHANNEL_MASK << ((channel & 1U) * 8U));
+            CCMR_value |= PWM_CCMR_OC_PWM1_PRELOAD << ((channel & 1U) * 8U);
+            PWM_TIM[timer]->CCMR[channel >> 1] = CCMR_value;
+
+            CCER_value = PWM_TIM[timer]->CCER;
+            CCER_value &= ~(PWM_CCER_CHANNEL_MASK << (channel * 4U));
+            CCER_value |= PWM_CCER_CCE << (channel * 4U);
+            if(PWM_Cfg[idx].PWM_Polarity == PWM_POLARITY_ACTIVE_LOW)
+            {
+                CCER_value |= PWM_CCER_CCP << (channel * 4U);
+            }
+            if(PWM_Cfg[idx].PWM_Complementary)
+            {
+                CCER_value |= PWM_CCER_CCNE << (channel * 4U);
+                if(PWM_Cfg[idx].PWM_Polarity == PWM_POLARITY_ACTIVE_LOW)
+                {
+                    CCER_value |= PWM_CCER_CCNP << (channel * 4U);
+                }
+                PWM_cfgPin(PWM_Cfg[idx].PWM_ComplementaryPort, PWM_Cfg[idx].PWM_ComplementaryPin, PWM_Cfg[idx].PWM_AF);
+            }
+            PWM_TIM[timer]->CCER = CCER_value;
+            PWM_cfgPin(PWM_Cfg[idx].PWM_Port, PWM_Cfg[idx].PWM_Pin, PWM_Cfg[idx].PWM_AF);
+        }
+    }
+    for(timer = 0; timer < NUMBER_OF_PWM_TIMERS; timer++)
+    {
+        if(PWM_TimerFrequency[timer] != 0)
+        {
+            PWM_TIM[timer]->EGR = PWM_EGR_UG;       /*Load the preloaded PSC, ARR and CCR values*/
+            if(timer == PWM_TIM_1)
+            {
+                PWM_TIM[timer]->BDTR = PWM_BDTR_MOE | PWM_DEAD_TIME;
+            }
+            PWM_TIM[timer]->CR1 = PWM_CR1_ARPE | PWM_CR1_CEN;
+        }
+    }
+    return ErrorStatus;
+}
+
+PWM_ErrorStatus_t PWM_setDutyCycle(u8 PWM_Name, u16 DutyPermille)
+{
+    PWM_ErrorStatus_t ErrorStatus = PWM_OK;
+    if(PWM_Name >= _PWM_Num)
+    {
+        ErrorStatus = PWM_InvalidName;
+    }
+    else if(DutyPermille > PWM_DUTY_MAX)
+    {
+        ErrorStatus = PWM_InvalidDuty;
+    }
+    else
+    {
+        PWM_writeCompare(PWM_Name, DutyPermille);
+    }
+    return ErrorStatus;
+}
+
+PWM_ErrorStatus_t PWM_getDutyCycle(u8 PWM_Name, u16* DutyPermille)
+{
+    PWM_ErrorStatus_t ErrorStatus = PWM_OK;
+    if(DutyPermille == NULL_PTR)
+    {
+        ErrorStatus = PWM_NullPtr;
+    }
+    else if(PWM_Name >= _PWM_Num)
+    {
+        ErrorStatus = PWM_InvalidName;
+    }
+    else
+    {
+        *DutyPermille = PWM_Duty[PWM_Name];
+    }
+    return ErrorStatus;
+}
+
+PWM_ErrorStatus_t PWM_setDutyCycleSync(const u8* PWM_Names, const u16* DutyPermille, u8 Count)
+{
+    PWM_ErrorStatus_t ErrorStatus = PWM_OK;
+    boolean TimerUsed[NUMBER_OF_PWM_TIMERS] = {FALSE};
+    u8 idx = 0;
+    u8 timer = 0;
+    if((PWM_Names == NULL_PTR) || (DutyPermille == NULL_PTR))
+    {
+        ErrorStatus = PWM_NullPtr;
+    }
+    else
+    {
+        for(idx = 0; (idx < Count) && (ErrorStatus == PWM_OK); idx++)
+        {
+            if(PWM_Names[idx] >= _PWM_Num)
+            {
+                ErrorStatus = PWM_InvalidName;
+            }
+            else if(DutyPermille[idx] > PWM_DUTY_MAX)
+            {
+                ErrorStatus = PWM_InvalidDuty;
+            }
+            else
+            {
+                TimerUsed[PWM_Cfg[PWM_Names[idx]].PWM_Timer] = TRUE;
+            }
+        }
+    }
+    if(ErrorStatus == PWM_OK)
+    {
+        /*No update event while writing, the preloaded compare values are transferred together afterwards*/
+        for(timer = 0; timer < NUMBER_OF_PWM_TIMERS; timer++)
+        {
+            if(TimerUsed[timer])
+            {
+                PWM_TIM[timer]->CR1 |= PWM_CR1_UDIS;
+            }
+        }
+        for(idx = 0; idx < Count; idx++)
+        {
+            PWM_writeCompare(PWM_Names[idx], DutyPermille[idx]);
+        }
+        for(timer = 0; timer < NUMBER_OF_PWM_TIMERS; timer++)
+        {
+            if(TimerUsed[timer])
+            {
+                PWM_TIM[timer]->CR1 &= ~PWM_CR1_UDIS;
+            }
+        }
+    }
+    return ErrorStatus;
+}
+
+PWM_ErrorStatus_t PWM_setFrequency(u8 PWM_Name, u32 FrequencyHz)
+{
+    PWM_ErrorStatus_t ErrorStatus = PWM_OK;
+    u8 timer = 0;
+    u8 idx = 0;
+    if(PWM_Name >= _PWM_Num)
+    {
+        ErrorStatus = PWM_InvalidName;
+    }
+    else if(!PWM_isValidFrequency(PWM_Cfg[PWM_Name].PWM_Timer, FrequencyHz))
+    {
+        ErrorStatus = PWM_InvalidFrequency;
+    }
+    else
+    {
+        timer = PWM_Cfg[PWM_Name].PWM_Timer;
+        PWM_TIM[timer]->CR1 |= PWM_CR1_UDIS;
+        PWM_cfgTimerFrequency(timer, FrequencyHz);
+        for(idx = 0; idx < _PWM_Num; idx++)
+        {
+            if(PWM_Cfg[idx].PWM_Timer == timer)
+            {
+                PWM_writeCompare(idx, PWM_Duty[idx]);
+            }
+        }
+        PWM_TIM[timer]->CR1 &= ~PWM_CR1_UDIS;
+    }
+    return ErrorStatus;
+}
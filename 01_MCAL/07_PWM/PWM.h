@@ -0,0 +1,133 @@
+/******************************************************************************
+*
+* Module: PWM
+*
+* File Name: PWM.h
+*
+* Description: Header file for the Hardware PWM (TIM1/TIM3/TIM4) driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef D__ITI_STM32F401CC_DRIVERS_INC_MCAL_PWM_PWM_H_
+#define D__ITI_STM32F401CC_DRIVERS_INC_MCAL_PWM_PWM_H_
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "LIB/std_types.h"
+#include "MCAL/PWM/PWM_Cfg.h"
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define PWM_TIM_1                       0U      /*Advanced timer, channels 1..3 have complementary outputs*/
+#define PWM_TIM_3                       1U
+#define PWM_TIM_4                       2U
+
+#define PWM_CHANNEL_1                   0U
+#define PWM_CHANNEL_2                   1U
+#define PWM_CHANNEL_3                   2U
+#define PWM_CHANNEL_4                   3U
+
+#define PWM_POLARITY_ACTIVE_HIGH        0U
+#define PWM_POLARITY_ACTIVE_LOW         1U
+
+#define PWM_DUTY_MAX                    1000U   /*Duty cycles are given in permille*/
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef struct{
+    u8 PWM_Timer;
+    u8 PWM_Channel;
+    u8 PWM_Polarity;
+    u32 PWM_FrequencyHz;        /*Channels of the same timer must share the same frequency*/
+    void* PWM_Port;
+    u32 PWM_Pin;
+    u32 PWM_AF;
+    boolean PWM_Complementary;  /*TIM1 channels 1..3 only*/
+    void* PWM_ComplementaryPort;
+    u32 PWM_ComplementaryPin;
+}PWM_Cfg_t;
+
+typedef enum{
+    PWM_OK,
+    PWM_InvalidName,
+    PWM_InvalidTimer,
+    PWM_InvalidChannel,
+    PWM_InvalidFrequency,
+    PWM_InvalidDuty,
+    PWM_InvalidComplementary,
+    PWM_NullPtr
+}PWM_ErrorStatus_t;
+
+/********************************************************************************************************/
+/************************************************APIs****************************************************/
+/********************************************************************************************************/
+/*****************************************************
+ * Function: PWM_init
+ * Description: Configures every channel in "PWM_Cfg.c" in PWM mode 1 with preloaded compare registers,
+ *              muxes the output pins and starts the timers with a 0% duty cycle.
+ *
+ * Return:
+ *   - PWM_ErrorStatus_t: PWM_OK, PWM_InvalidTimer, PWM_InvalidChannel, PWM_InvalidFrequency or
+ *     PWM_InvalidComplementary.
+ *
+ * Notes:
+ *   - Enable the GPIO port and timer clocks using the RCC driver before calling this function.
+ *   - TIM3/TIM4 are shared with the ICU driver, a timer must be used by one of them only.
+ *****************************************************/
+PWM_ErrorStatus_t PWM_init(void);
+
+/*****************************************************
+ * Function: PWM_setDutyCycle
+ * Description: Sets the duty cycle of a channel, applied by the hardware at the next period start.
+ *
+ * Parameters:
+ *   - PWM_Name: The channel name in the configuration enum "PWM_Cfg.h".
+ *   - DutyPermille: 0 .. PWM_DUTY_MAX.
+ *
+ * Return:
+ *   - PWM_OK, PWM_InvalidName or PWM_InvalidDuty.
+ *****************************************************/
+PWM_ErrorStatus_t PWM_setDutyCycle(u8 PWM_Name, u16 DutyPermille);
+
+/*****************************************************
+ * Function: PWM_getDutyCycle
+ * Description: Reads back the last duty cycle set to a channel.
+ *
+ * Return:
+ *   - PWM_OK, PWM_InvalidName or PWM_NullPtr.
+ *****************************************************/
+PWM_ErrorStatus_t PWM_getDutyCycle(u8 PWM_Name, u16* DutyPermille);
+
+/*****************************************************
+ * Function: PWM_setDutyCycleSync
+ * Description: Sets the duty cycles of several channels so that all the channels of the same timer
+ *              switch to their new values at the same period start.
+ *
+ * Parameters:
+ *   - PWM_Names: Array of channel names.
+ *   - DutyPermille: Array of duty cycles, one for each name.
+ *   - Count: Number of channels.
+ *
+ * Return:
+ *   - PWM_OK, PWM_NullPtr, PWM_InvalidName or PWM_InvalidDuty (nothing is changed on error).
+ *
+ * Notes:
+ *   - The update event of the involved timers is disabled while the compare registers are written.
+ *****************************************************/
+PWM_ErrorStatus_t PWM_setDutyCycleSync(const u8* PWM_Names, const u16* DutyPermille, u8 Count);
+
+/*****************************************************
+ * Function: PWM_setFrequency
+ * Description: Changes the frequency of the timer driving a channel, the duty cycles of all the
+ *              channels of that timer are kept.
+ *
+ * Return:
+ *   - PWM_OK, PWM_InvalidName or PWM_InvalidFrequency.
+ *****************************************************/
+PWM_ErrorStatus_t PWM_setFrequency(u8 PWM_Name, u32 FrequencyHz);
+
+#endif // D__ITI_STM32F401CC_DRIVERS_INC_MCAL_PWM_PWM_H_
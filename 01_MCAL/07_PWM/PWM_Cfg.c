@@ -0,0 +1,45 @@
+/******************************************************************************
+*
+* Module: PWM
+*
+* File Name: PWM_Cfg.c
+*
+* Description: Source file for the PWM Configuration driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "MCAL/GPIO/GPIO.h"
+#include "MCAL/PWM/PWM.h"
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+const PWM_Cfg_t PWM_Cfg[_PWM_Num] = {
+    [PWM_StatusLed]={
+        .PWM_Timer = PWM_TIM_4,
+        .PWM_Channel = PWM_CHANNEL_1,
+        .PWM_Polarity = PWM_POLARITY_ACTIVE_HIGH,
+        .PWM_FrequencyHz = 1000,
+        .PWM_Port = GPIO_PORT_B,
+        .PWM_Pin = GPIO_PIN_6,          /*PB6 = TIM4_CH1*/
+        .PWM_AF = GPIO_FUNC_AF2,
+        .PWM_Complementary = FALSE
+    },
+    [PWM_Motor]={
+        .PWM_Timer = PWM_TIM_1,
+        .PWM_Channel = PWM_CHANNEL_1,
+        .PWM_Polarity = PWM_POLARITY_ACTIVE_HIGH,
+        .PWM_FrequencyHz = 20000,
+        .PWM_Port = GPIO_PORT_A,
+        .PWM_Pin = GPIO_PIN_8,          /*PA8 = TIM1_CH1*/
+        .PWM_AF = GPIO_FUNC_AF1,
+        .PWM_Complementary = TRUE,
+        .PWM_ComplementaryPort = GPIO_PORT_B,
+        .PWM_ComplementaryPin = GPIO_PIN_13     /*PB13 = TIM1_CH1N*/
+    }
+};
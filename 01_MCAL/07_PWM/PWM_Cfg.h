@@ -0,0 +1,30 @@
+/******************************************************************************
+*
+* Module: PWM
+*
+* File Name: PWM_Cfg.h
+*
+* Description: Header file for the PWM driver Configurations for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef D__ITI_STM32F401CC_DRIVERS_INC_MCAL_PWM_PWM_CFG_H_
+#define D__ITI_STM32F401CC_DRIVERS_INC_MCAL_PWM_PWM_CFG_H_
+
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define PWM_APB1_TIM_CLK            16000000    /*TIM3/TIM4 Clock*/
+#define PWM_APB2_TIM_CLK            16000000    /*TIM1 Clock*/
+#define PWM_DEAD_TIME               0x10        /*TIM1 BDTR DTG value inserted between complementary outputs*/
+
+enum{
+    PWM_StatusLed,
+    PWM_Motor,
+    _PWM_Num
+};
+
+#endif // D__ITI_STM32F401CC_DRIVERS_INC_MCAL_PWM_PWM_CFG_H_
@@ -0,0 +1,170 @@
+#ifdef TEST
+
+#include "unity.h"
+#include "PWM.h"
+#include "mock_GPIO.h"
+
+#define NUMBER_OF_PWM_TIMERS            3
+#define NUMBER_OF_PWM_CHANNELS          4
+#define PWM_CR1_CEN                     0x00000001
+#define PWM_CR1_UDIS                    0x00000002
+#define PWM_CR1_ARPE                    0x00000080
+#define PWM_EGR_UG                      0x00000001
+#define PWM_CCMR_OC_PWM1_PRELOAD        0x00000068
+#define PWM_CCER_CC1E                   0x00000001
+#define PWM_CCER_CC1NE                  0x00000004
+#define PWM_BDTR_MOE                    0x00008000
+
+typedef struct
+{
+    volatile u32 CR1;
+    volatile u32 CR2;
+    volatile u32 SMCR;
+    volatile u32 DIER;
+    volatile u32 SR;
+    volatile u32 EGR;
+    volatile u32 CCMR[2];
+    volatile u32 CCER;
+    volatile u32 CNT;
+    volatile u32 PSC;
+    volatile u32 ARR;
+    volatile u32 RCR;
+    volatile u32 CCR[NUMBER_OF_PWM_CHANNELS];
+    volatile u32 BDTR;
+    volatile u32 DCR;
+    volatile u32 DMAR;
+}PWM_Registers_t;
+
+extern PWM_Registers_t PWM_MockRegisters[NUMBER_OF_PWM_TIMERS];
+
+const PWM_Cfg_t PWM_Cfg[_PWM_Num] = {
+    [PWM_StatusLed] = {.PWM_Timer = PWM_TIM_4, .PWM_Channel = PWM_CHANNEL_1, .PWM_Polarity = PWM_POLARITY_ACTIVE_HIGH,
+                       .PWM_FrequencyHz = 1000, .PWM_Port = GPIO_PORT_B, .PWM_Pin = GPIO_PIN_6,
+                       .PWM_AF = GPIO_FUNC_AF2, .PWM_Complementary = FALSE},
+    [PWM_Motor] = {.PWM_Timer = PWM_TIM_1, .PWM_Channel = PWM_CHANNEL_1, .PWM_Polarity = PWM_POLARITY_ACTIVE_HIGH,
+                   .PWM_FrequencyHz = 20000, .PWM_Port = GPIO_PORT_A, .PWM_Pin = GPIO_PIN_8,
+                   .PWM_AF = GPIO_FUNC_AF1, .PWM_Complementary = TRUE,
+                   .PWM_ComplementaryPort = GPIO_PORT_B, .PWM_ComplementaryPin = GPIO_PIN_13}
+};
+
+/*Compare values driving the outputs, the preloaded CCR values are transferred on update events*/
+static u32 ActiveCompare[NUMBER_OF_PWM_TIMERS][NUMBER_OF_PWM_CHANNELS];
+
+/*Simulated update event at a period start: nothing is transferred while UDIS is set*/
+static void PWM_SimulateUpdateEvent(u8 Timer)
+{
+    u8 channel = 0;
+    if(!(PWM_MockRegisters[Timer].CR1 & PWM_CR1_UDIS))
+    {
+        for(channel = 0; channel < NUMBER_OF_PWM_CHANNELS; channel++)
+        {
+            ActiveCompare[Timer][channel] = PWM_MockRegisters[Timer].CCR[channel];
+        }
+    }
+}
+
+void setUp(void)
+{
+    PWM_Registers_t cleared = {0};
+    u8 timer = 0;
+    for(timer = 0; timer < NUMBER_OF_PWM_TIMERS; timer++)
+    {
+        PWM_MockRegisters[timer] = cleared;
+        PWM_SimulateUpdateEvent(timer);
+    }
+    TEST_ASSERT_EQUAL(PWM_OK, PWM_init());
+}
+
+void tearDown(void)
+{
+}
+
+void test_PWM_init_ConfiguresPeriodAndPreloadedPwmMode(void)
+{
+    PWM_Registers_t* Led = &PWM_MockRegisters[PWM_TIM_4];
+    PWM_Registers_t* Motor = &PWM_MockRegisters[PWM_TIM_1];
+    /*1 kHz and 20 kHz from 16 MHz without prescaling*/
+    TEST_ASSERT_EQUAL(0, Led->PSC);
+    TEST_ASSERT_EQUAL(15999, Led->ARR);
+    TEST_ASSERT_EQUAL(0, Motor->PSC);
+    TEST_ASSERT_EQUAL(799, Motor->ARR);
+    TEST_ASSERT_EQUAL(0, Led->CCR[PWM_CHANNEL_1]);
+    TEST_ASSERT_EQUAL(PWM_CCMR_OC_PWM1_PRELOAD, Led->CCMR[0] & 0xFF);
+    TEST_ASSERT_EQUAL(PWM_CR1_ARPE | PWM_CR1_CEN, Led->CR1);
+    TEST_ASSERT_EQUAL(PWM_EGR_UG, Led->EGR);
+    /*Unused timer left untouched*/
+    TEST_ASSERT_EQUAL(0, PWM_MockRegisters[PWM_TIM_3].CR1);
+}
+
+void test_PWM_init_EnablesComplementaryOutputWithDeadTime(void)
+{
+    PWM_Registers_t* Motor = &PWM_MockRegisters[PWM_TIM_1];
+    TEST_ASSERT_EQUAL(PWM_CCER_CC1E | PWM_CCER_CC1NE, Motor->CCER & 0x0F);
+    TEST_ASSERT_EQUAL(PWM_BDTR_MOE | PWM_DEAD_TIME, Motor->BDTR);
+    /*The plain channel has no complementary output*/
+    TEST_ASSERT_EQUAL(PWM_CCER_CC1E, PWM_MockRegisters[PWM_TIM_4].CCER & 0x0F);
+}
+
+void test_PWM_setDutyCycle_WritesCompare(void)
+{
+    u16 duty = 0;
+    TEST_ASSERT_EQUAL(PWM_OK, PWM_setDutyCycle(PWM_StatusLed, 250));
+    TEST_ASSERT_EQUAL(4000, PWM_MockRegisters[PWM_TIM_4].CCR[PWM_CHANNEL_1]);
+    TEST_ASSERT_EQUAL(PWM_OK, PWM_setDutyCycle(PWM_Motor, PWM_DUTY_MAX));
+    TEST_ASSERT_EQUAL(800, PWM_MockRegisters[PWM_TIM_1].CCR[PWM_CHANNEL_1]);
+    TEST_ASSERT_EQUAL(PWM_OK, PWM_getDutyCycle(PWM_StatusLed, &duty));
+    TEST_ASSERT_EQUAL(250, duty);
+}
+
+void test_PWM_setFrequency_PrescalesAndKeepsDuty(void)
+{
+    PWM_Registers_t* Led = &PWM_MockRegisters[PWM_TIM_4];
+    TEST_ASSERT_EQUAL(PWM_OK, PWM_setDutyCycle(PWM_StatusLed, 250));
+    /*100 Hz needs 160000 ticks, beyond the 16-bit counter*/
+    TEST_ASSERT_EQUAL(PWM_OK, PWM_setFrequency(PWM_StatusLed, 100));
+    TEST_ASSERT_EQUAL(2, Led->PSC);
+    TEST_ASSERT_EQUAL(53332, Led->ARR);
+    TEST_ASSERT_EQUAL(13333, Led->CCR[PWM_CHANNEL_1]);
+    TEST_ASSERT_BITS_LOW(PWM_CR1_UDIS, Led->CR1);
+}
+
+void test_PWM_setDutyCycleSync_UpdatesChannelsTogether(void)
+{
+    const u8 Names[] = {PWM_StatusLed, PWM_Motor};
+    const u16 Duties[] = {500, 250};
+    TEST_ASSERT_EQUAL(PWM_OK, PWM_setDutyCycleSync(Names, Duties, 2));
+    TEST_ASSERT_EQUAL(8000, PWM_MockRegisters[PWM_TIM_4].CCR[PWM_CHANNEL_1]);
+    TEST_ASSERT_EQUAL(200, PWM_MockRegisters[PWM_TIM_1].CCR[PWM_CHANNEL_1]);
+    /*Update events are enabled again, the outputs keep their old values until the next period start*/
+    TEST_ASSERT_BITS_LOW(PWM_CR1_UDIS, PWM_MockRegisters[PWM_TIM_4].CR1);
+    TEST_ASSERT_BITS_LOW(PWM_CR1_UDIS, PWM_MockRegisters[PWM_TIM_1].CR1);
+    TEST_ASSERT_EQUAL(0, ActiveCompare[PWM_TIM_4][PWM_CHANNEL_1]);
+    TEST_ASSERT_EQUAL(0, ActiveCompare[PWM_TIM_1][PWM_CHANNEL_1]);
+    PWM_SimulateUpdateEvent(PWM_TIM_4);
+    PWM_SimulateUpdateEvent(PWM_TIM_1);
+    TEST_ASSERT_EQUAL(8000, ActiveCompare[PWM_TIM_4][PWM_CHANNEL_1]);
+    TEST_ASSERT_EQUAL(200, ActiveCompare[PWM_TIM_1][PWM_CHANNEL_1]);
+}
+
+void test_PWM_setDutyCycleSync_ChangesNothingOnError(void)
+{
+    const u8 Names[] = {PWM_StatusLed, PWM_Motor};
+    const u16 Duties[] = {500, PWM_DUTY_MAX + 1};
+    TEST_ASSERT_EQUAL(PWM_InvalidDuty, PWM_setDutyCycleSync(Names, Duties, 2));
+    TEST_ASSERT_EQUAL(0, PWM_MockRegisters[PWM_TIM_4].CCR[PWM_CHANNEL_1]);
+    TEST_ASSERT_EQUAL(0, PWM_MockRegisters[PWM_TIM_1].CCR[PWM_CHANNEL_1]);
+    TEST_ASSERT_EQUAL(PWM_NullPtr, PWM_setDutyCycleSync(NULL_PTR, Duties, 2));
+}
+
+void test_PWM_InvalidRequests(void)
+{
+    u16 duty = 0;
+    TEST_ASSERT_EQUAL(PWM_InvalidName, PWM_setDutyCycle(_PWM_Num, 0));
+    TEST_ASSERT_EQUAL(PWM_InvalidDuty, PWM_setDutyCycle(PWM_StatusLed, PWM_DUTY_MAX + 1));
+    TEST_ASSERT_EQUAL(PWM_NullPtr, PWM_getDutyCycle(PWM_StatusLed, NULL_PTR));
+    TEST_ASSERT_EQUAL(PWM_InvalidName, PWM_getDutyCycle(_PWM_Num, &duty));
+    TEST_ASSERT_EQUAL(PWM_InvalidFrequency, PWM_setFrequency(PWM_StatusLed, 0));
+    TEST_ASSERT_EQUAL(PWM_InvalidFrequency, PWM_setFrequency(PWM_StatusLed, 9000000));
+}
+
+#endif // TEST
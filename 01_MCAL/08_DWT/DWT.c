@@ -0,0 +1,302 @@
+/******************************************************************************
+*
+* Module: DWT
+*
+* File Name: DWT.c
+*
+* Description: Source file for the DWT cycle counters and ITM stimulus ports profiling driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "MCAL/DWT/DWT.h"
+#include "MCAL/DWT/DWT_Cfg.h"
+#ifdef HOST_BUILD
+#include <stdio.h>
+#include <time.h>
+#endif
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define DWT_BASE_ADDR                   0xE0001000
+#define ITM_BASE_ADDR                   0xE0000000
+#define DEMCR_ADDR                      0xE000EDFC
+#define DEMCR_TRCENA                    0x01000000
+#define DWT_CTRL_CYCCNTENA              0x00000001
+#define DWT_CTRL_CPIEVTENA              0x00020000
+#define DWT_CTRL_EXCEVTENA              0x00040000
+#define DWT_CTRL_SLEEPEVTENA            0x00080000
+#define DWT_CTRL_LSUEVTENA              0x00100000
+#define DWT_CTRL_FOLDEVTENA             0x00200000
+#define DWT_CTRL_ALL_COUNTERS           (DWT_CTRL_CYCCNTENA | DWT_CTRL_CPIEVTENA | DWT_CTRL_EXCEVTENA |\
+                                         DWT_CTRL_SLEEPEVTENA | DWT_CTRL_LSUEVTENA | DWT_CTRL_FOLDEVTENA)
+#define DWT_EVENT_COUNTER_MASK          0x000000FF
+#define ITM_LAR_UNLOCK_KEY              0xC5ACCE55
+#define ITM_TCR_ITMENA                  0x00000001
+#define ITM_TER_ALL_PORTS               0xFFFFFFFF
+#define ITM_PORT_READY                  0x00000001
+#define DWT_HOST_ITM_PORT               0
+#define DWT_TEST_CYCLES_PER_READ        1
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef struct
+{
+    volatile u32 CTRL;
+    volatile u32 CYCCNT;
+    volatile u32 CPICNT;
+    volatile u32 EXCCNT;
+    volatile u32 SLEEPCNT;
+    volatile u32 LSUCNT;
+    volatile u32 FOLDCNT;
+    volatile u32 PCSR;
+}DWT_Registers_t;
+
+typedef struct
+{
+    volatile u32 STIM[DWT_ITM_NUMBER_OF_PORTS];
+    volatile u32 Reserved1[864];
+    volatile u32 TER;
+    volatile u32 Reserved2[15];
+    volatile u32 TPR;
+    volatile u32 Reserved3[15];
+    volatile u32 TCR;
+    volatile u32 Reserved4[75];
+    volatile u32 LAR;
+}ITM_Registers_t;
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+#ifndef HOST_BUILD
+static DWT_Registers_t* const DWT = (DWT_Registers_t*)DWT_BASE_ADDR;
+static ITM_Registers_t* const ITM = (ITM_Registers_t*)ITM_BASE_ADDR;
+static volatile u32* const DEMCR = (volatile u32*)DEMCR_ADDR;
+#endif
+
+static DWT_Profile_t DWT_Profiles[_DWT_PROFILE_Num];
+
+#if defined(HOST_BUILD) || defined(TEST)
+static u32 DWT_defaultCycles(void);
+static DWT_CycleSource_t DWT_CycleSource = DWT_defaultCycles;
+#endif
+#ifdef TEST
+static u32 DWT_VirtualCycles;
+#endif
+
+/********************************************************************************************************/
+/*********************************************Static Functions*******************************************/
+/********************************************************************************************************/
+/*A section can be measured in an interrupt and in the thread it preempted, the statistics are updated and
+  read with the interrupts masked (PRIMASK saved and restored, so it nests inside a caller's own masking)*/
+static inline u32 DWT_lockProfiles(void)
+{
+    u32 Primask = 0;
+#if !defined(HOST_BUILD) && !defined(TEST)
+    __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (Primask) : : "memory");
+#endif
+    return Primask;
+}
+
+static inline void DWT_unlockProfiles(u32 Primask)
+{
+#if !defined(HOST_BUILD) && !defined(TEST)
+    __asm volatile ("msr primask, %0" : : "r" (Primask) : "memory");
+#else
+    (void)Primask;
+#endif
+}
+
+#ifdef TEST
+/*Virtual counter of the unit tests, independent of the wall clock and of the host load*/
+static u32 DWT_defaultCycles(void)
+{
+    DWT_VirtualCycles += DWT_TEST_CYCLES_PER_READ;
+    return DWT_VirtualCycles;
+}
+#elif defined(HOST_BUILD)
+static u32 DWT_defaultCycles(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    /*Seconds and nanoseconds converted apart, their sum in nanoseconds times the clock overflows u64*/
+    return (u32)(((u64)now.tv_sec * DWT_CPU_CLK) + (((u64)now.tv_nsec * DWT_CPU_CLK) / DWT_NS_PER_SECOND));
+}
+#endif
+
+/********************************************************************************************************/
+/*********************************************APIs Implementation****************************************/
+/********************************************************************************************************/
+void DWT_init(void)
+{
+#ifndef HOST_BUILD
+    *DEMCR |= DEMCR_TRCENA;
+    DWT->CYCCNT = 0;
+    DWT->CPICNT = 0;
+    DWT->EXCCNT = 0;
+    DWT->SLEEPCNT = 0;
+    DWT->LSUCNT = 0;
+    DWT->FOLDCNT = 0;
+    DWT->CTRL |= DWT_CTRL_ALL_COUNTERS;
+    ITM->LAR = ITM_LAR_UNLOCK_KEY;
+    ITM->TCR |= ITM_TCR_ITMENA;
+    ITM->TER = ITM_TER_ALL_PORTS;
+#endif
+    DWT_resetProfiles();
+}
+
+#if defined(HOST_BUILD) || defined(TEST)
+u32 DWT_getCycles(void)
+{
+    return DWT_CycleSource();
+}
+
+void DWT_setCycleSource(DWT_CycleSource_t Source)
+{
+    DWT_CycleSource = (Source == NULL_PTR) ? DWT_defaultCycles : Source;
+}
+#endif
+
+DWT_ErrorStatus_t DWT_getEventCounters(DWT_EventCounters_t* Counters)
+{
+    DWT_ErrorStatus_t ErrorStatus = DWT_OK;
+    if(Counters == NULL_PTR)
+    {
+        ErrorStatus = DWT_NullPtr;
+    }
+    else
+    {
+#ifdef HOST_BUILD
+        Counters->CPI = 0;
+        Counters->EXC = 0;
+        Counters->SLEEP = 0;
+        Counters->LSU = 0;
+        Counters->FOLD = 0;
+#else
+        Counters->CPI = (u8)(DWT->CPICNT & DWT_EVENT_COUNTER_MASK);
+        Counters->EXC = (u8)(DWT->EXCCNT & DWT_EVENT_COUNTER_MASK);
+        Counters->SLEEP = (u8)(DWT->SLEEPCNT & DWT_EVENT_COUNTER_MASK);
+        Counters->LSU = (u8)(DWT->LSUCNT & DWT_EVENT_COUNTER_MASK);
+        Counters->FOLD = (u8)(DWT->FOLDCNT & DWT_EVENT_COUNTER_MASK);
+#endif
+    }
+    return ErrorStatus;
+}
+
+void DWT_recordProfile(u8 DWT_ProfileId, u32 Cycles)
+{
+    if(DWT_ProfileId < _DWT_PROFILE_Num)
+    {
+        DWT_Profile_t* Profile = &DWT_Profiles[DWT_ProfileId];
+        const u32 Primask = DWT_lockProfiles();
+        if((Profile->count == 0) || (Cycles < Profile->minCycles))
+        {
+            Profile->minCycles = Cycles;
+        }
+        if(Cycles > Profile->maxCycles)
+        {
+            Profile->maxCycles = Cycles;
+        }
+        Profile->totalCycles += Cycles;
+        Profile->count++;
+        DWT_unlockProfiles(Primask);
+    }
+}
+
+DWT_ErrorStatus_t DWT_getProfile(u8 DWT_ProfileId, DWT_Profile_t* Profile)
+{
+    DWT_ErrorStatus_t ErrorStatus = DWT_OK;
+    if(DWT_ProfileId >= _DWT_PROFILE_Num)
+    {
+        ErrorStatus = DWT_InvalidProfile;
+    }
+    else if(Profile == NULL_PTR)
+    {
+        ErrorStatus = DWT_NullPtr;
+    }
+    else
+    {
+        const u32 Primask = DWT_lockProfiles();
+        *Profile = DWT_Profiles[DWT_ProfileId];
+        DWT_unlockProfiles(Primask);
+    }
+    return ErrorStatus;
+}
+
+void DWT_resetProfiles(void)
+{
+    u8 Index;
+    const u32 Primask = DWT_lockProfiles();
+    for(Index = 0; Index < _DWT_PROFILE_Num; Index++)
+    {
+        DWT_Profiles[Index].count = 0;
+        DWT_Profiles[Index].minCycles = 0;
+        DWT_Profiles[Index].maxCycles = 0;
+        DWT_Profiles[Index].totalCycles = 0;
+    }
+    DWT_unlockProfiles(Primask);
+}
+
+DWT_ErrorStatus_t DWT_ITM_sendByte(u8 Port, u8 Data)
+{
+    DWT_ErrorStatus_t ErrorStatus = DWT_OK;
+    if(Port >= DWT_ITM_NUMBER_OF_PORTS)
+    {
+        ErrorStatus = DWT_InvalidPort;
+    }
+    else
+    {
+#ifdef HOST_BUILD
+        if(Port == DWT_HOST_ITM_PORT)
+        {
+            putchar(Data);
+        }
+#else
+        if(((ITM->TCR & ITM_TCR_ITMENA) == 0) || ((ITM->TER & (1UL << Port)) == 0))
+        {
+            ErrorStatus = DWT_PortDisabled;
+        }
+        else
+        {
+            while((ITM->STIM[Port] & ITM_PORT_READY) == 0);
+            *(volatile u8*)&ITM->STIM[Port] = Data;
+        }
+#endif
+    }
+    return ErrorStatus;
+}
+
+DWT_ErrorStatus_t DWT_ITM_sendWord(u8 Port, u32 Data)
+{
+    DWT_ErrorStatus_t ErrorStatus = DWT_OK;
+    if(Port >= DWT_ITM_NUMBER_OF_PORTS)
+    {
+        ErrorStatus = DWT_InvalidPort;
+    }
+    else
+    {
+#ifdef HOST_BUILD
+        if(Port == DWT_HOST_ITM_PORT)
+        {
+            printf("%08lX\n", (unsigned long)Data);
+        }
+#else
+        if(((ITM->TCR & ITM_TCR_ITMENA) == 0) || ((ITM->TER & (1UL << Port)) == 0))
+        {
+            ErrorStatus = DWT_PortDisabled;
+        }
+        else
+        {
+            while((ITM->STIM[Port] & ITM_PORT_READY) == 0);
+            ITM->STIM[Port] = Data;
+        }
+#endif
+    }
+    return ErrorStatus;
+}
@@ -0,0 +1,172 @@
+/******************************************************************************
+*
+* Module: DWT
+*
+* File Name: DWT.h
+*
+* Description: Header file for the DWT cycle counters and ITM stimulus ports profiling driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef D__ITI_STM32F401CC_DRIVERS_INC_MCAL_DWT_DWT_H_
+#define D__ITI_STM32F401CC_DRIVERS_INC_MCAL_DWT_DWT_H_
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "LIB/std_types.h"
+#include "MCAL/DWT/DWT_Cfg.h"
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define DWT_CYCCNT_ADDR                 0xE0001004
+#define DWT_NS_PER_SECOND               1000000000ULL
+#define DWT_ITM_NUMBER_OF_PORTS         32
+
+/*Cycles to microseconds at the configured core clock, DWT_US_TO_CYCLES wraps above DWT_MAX_US (the longest
+  interval the 32-bit counter measures), callers taking a time from the application check it against that*/
+#define DWT_CYCLES_TO_US(CYCLES)        ((CYCLES) / (DWT_CPU_CLK / 1000000))
+#define DWT_US_TO_CYCLES(US)            ((US) * (DWT_CPU_CLK / 1000000))
+#define DWT_MAX_US                      (0xFFFFFFFFUL / (DWT_CPU_CLK / 1000000))
+
+/*
+ * Measurement Macros:
+ * -------------------
+ * DWT_PROFILE_BEGIN/DWT_PROFILE_END measure the code between them in the same block.
+ * DWT_PROFILE_END_FROM(ID, FROM) records ID from the DWT_PROFILE_BEGIN of FROM, for a section that shares
+ * its start with another one and only ends on some paths.
+ * DWT_PROFILE_SCOPE measures the block following it: DWT_PROFILE_SCOPE(DWT_PROFILE_LCD) { ... }
+ * leaving that block with break/return/goto skips the measurement.
+ * They compile to nothing when profiling is disabled and in the unit tests builds.
+ */
+#if (DWT_PROFILING == DWT_PROFILING_ENABLE) && !defined(TEST)
+#define DWT_PROFILE_BEGIN(ID)           u32 DWT_Start_##ID = DWT_getCycles()
+#define DWT_PROFILE_END(ID)             DWT_recordProfile((ID), DWT_getCycles() - DWT_Start_##ID)
+#define DWT_PROFILE_END_FROM(ID, FROM) DWT_recordProfile((ID), DWT_getCycles() - DWT_Start_##FROM)
+#define DWT_PROFILE_SCOPE(ID)           for(u32 DWT_Start_##ID = DWT_getCycles(), DWT_Once_##ID = 1; DWT_Once_##ID;\
+                                            DWT_Once_##ID = 0, DWT_recordProfile((ID), DWT_getCycles() - DWT_Start_##ID))
+#else
+#define DWT_PROFILE_BEGIN(ID)
+#define DWT_PROFILE_END(ID)
+#define DWT_PROFILE_END_FROM(ID, FROM)
+#define DWT_PROFILE_SCOPE(ID)
+#endif
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef struct
+{
+    u32 count;
+    u32 minCycles;
+    u32 maxCycles;
+    u64 totalCycles;
+}DWT_Profile_t;
+
+typedef struct
+{
+    u8 CPI;         /*Extra cycles of multi-cycle instructions and instruction fetch stalls*/
+    u8 EXC;         /*Cycles spent in exception entry and exit*/
+    u8 SLEEP;       /*Cycles spent sleeping*/
+    u8 LSU;         /*Extra cycles of load and store instructions*/
+    u8 FOLD;        /*Folded instructions (executed in zero cycles)*/
+}DWT_EventCounters_t;
+
+typedef enum{
+    DWT_OK,
+    DWT_InvalidProfile,
+    DWT_InvalidPort,
+    DWT_PortDisabled,
+    DWT_NullPtr
+}DWT_ErrorStatus_t;
+
+/*Replacement of the cycle counter on the host and unit tests builds, see DWT_setCycleSource*/
+typedef u32 (*DWT_CycleSource_t)(void);
+
+/********************************************************************************************************/
+/************************************************APIs****************************************************/
+/********************************************************************************************************/
+/*****************************************************
+ * Function: DWT_getCycles
+ * Description: Reads the free running 32-bit core cycle counter (wraps every 2^32 cycles), on the host
+ *              and unit tests builds it reads the cycle source set by DWT_setCycleSource.
+ *
+ * Notes:
+ *   - Inlined to keep the measurement overhead to a single load, use unsigned subtraction for intervals.
+ *****************************************************/
+#if defined(HOST_BUILD) || defined(TEST)
+u32 DWT_getCycles(void);
+#else
+static inline u32 DWT_getCycles(void)
+{
+    return *(volatile u32*)DWT_CYCCNT_ADDR;
+}
+#endif
+
+#if defined(HOST_BUILD) || defined(TEST)
+/*****************************************************
+ * Function: DWT_setCycleSource
+ * Description: Host and unit tests builds only, makes DWT_getCycles return the values of Source.
+ *              NULL_PTR restores the default source: the monotonic clock converted to cycles of DWT_CPU_CLK
+ *              on the host build, a virtual counter advancing DWT_TEST_CYCLES_PER_READ per read in the unit
+ *              tests so the polling timeouts expire after the same number of reads on every run.
+ *****************************************************/
+void DWT_setCycleSource(DWT_CycleSource_t Source);
+#endif
+
+/*****************************************************
+ * Function: DWT_init
+ * Description: Enables the trace block, clears and starts the cycle counter and the CPI, EXC, SLEEP,
+ *              LSU and FOLD event counters, enables the ITM with all its stimulus ports and clears the
+ *              profiles statistics.
+ *
+ * Notes:
+ *   - Call it once at startup before any measurement, a debugger is not needed.
+ *****************************************************/
+void DWT_init(void);
+
+/*****************************************************
+ * Function: DWT_getEventCounters
+ * Description: Reads the 8-bit DWT event counters (they wrap around, sample them often or use differences).
+ *
+ * Return:
+ *   - DWT_OK or DWT_NullPtr.
+ *****************************************************/
+DWT_ErrorStatus_t DWT_getEventCounters(DWT_EventCounters_t* Counters);
+
+/*****************************************************
+ * Function: DWT_recordProfile
+ * Description: Accumulates one measurement of a profiled section, used by the measurement macros.
+ *****************************************************/
+void DWT_recordProfile(u8 DWT_ProfileId, u32 Cycles);
+
+/*****************************************************
+ * Function: DWT_getProfile
+ * Description: Reads the statistics of a profiled section (count, min, max and total cycles).
+ *
+ * Return:
+ *   - DWT_OK, DWT_InvalidProfile or DWT_NullPtr.
+ *****************************************************/
+DWT_ErrorStatus_t DWT_getProfile(u8 DWT_ProfileId, DWT_Profile_t* Profile);
+
+/*****************************************************
+ * Function: DWT_resetProfiles
+ * Description: Clears the statistics of all the profiled sections.
+ *****************************************************/
+void DWT_resetProfiles(void);
+
+/*****************************************************
+ * Function: DWT_ITM_sendByte / DWT_ITM_sendWord
+ * Description: Writes to an ITM stimulus port once its FIFO has room, on the host build port 0 is
+ *              written to the standard output.
+ *
+ * Return:
+ *   - DWT_OK, DWT_InvalidPort or DWT_PortDisabled if the port or the ITM isn't enabled.
+ *****************************************************/
+DWT_ErrorStatus_t DWT_ITM_sendByte(u8 Port, u8 Data);
+
+DWT_ErrorStatus_t DWT_ITM_sendWord(u8 Port, u32 Data);
+
+#endif // D__ITI_STM32F401CC_DRIVERS_INC_MCAL_DWT_DWT_H_
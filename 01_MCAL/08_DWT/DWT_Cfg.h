@@ -0,0 +1,34 @@
+/******************************************************************************
+*
+* Module: DWT
+*
+* File Name: DWT_Cfg.h
+*
+* Description: Header file for the DWT/ITM profiling driver Configurations for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef D__ITI_STM32F401CC_DRIVERS_INC_MCAL_DWT_DWT_CFG_H_
+#define D__ITI_STM32F401CC_DRIVERS_INC_MCAL_DWT_DWT_CFG_H_
+
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define DWT_CPU_CLK                 16000000    /*Core Clock, used to convert cycles to time*/
+
+#define DWT_PROFILING_DISABLE       0
+#define DWT_PROFILING_ENABLE        1
+#define DWT_PROFILING               DWT_PROFILING_DISABLE
+
+/*Measured code sections, each one accumulates its own statistics*/
+enum{
+    DWT_PROFILE_USART_ISR,
+    DWT_PROFILE_USART_DE_TURNAROUND,    /*USART interrupt entry to the RS-485 driver enable release*/
+    DWT_PROFILE_LCD,
+    _DWT_PROFILE_Num
+};
+
+#endif // D__ITI_STM32F401CC_DRIVERS_INC_MCAL_DWT_DWT_CFG_H_
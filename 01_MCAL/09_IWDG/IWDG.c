@@ -0,0 +1,117 @@
+/******************************************************************************
+*
+* Module: IWDG
+*
+* File Name: IWDG.c
+*
+* Description: Source file for the Independent Watchdog driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "MCAL/IWDG/IWDG.h"
+#include "MCAL/IWDG/IWDG_Cfg.h"
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define IWDG_BASE_ADDR                  0x40003000
+#define RCC_CSR_ADDR                    0x40023874
+#define DBGMCU_APB1_FZ_ADDR             0xE0042008
+#define IWDG_KEY_START                  0x0000CCCC
+#define IWDG_KEY_REFRESH                0x0000AAAA
+#define IWDG_KEY_UNLOCK                 0x00005555
+#define IWDG_SR_BUSY_MASK               0x00000003      /*PVU and RVU, registers update is ongoing*/
+#define IWDG_MAX_RELOAD                 0x00001000
+#define IWDG_MIN_DIVIDER                4
+#define IWDG_MAX_PRESCALER              6               /*Divider 4 << 6 = 256*/
+#define IWDG_MS_PER_SECOND              1000
+#define RCC_CSR_RMVF                    0x01000000
+#define RCC_CSR_IWDGRSTF                0x20000000
+#define DBGMCU_IWDG_STOP                0x00001000
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef struct
+{
+    volatile u32 KR;
+    volatile u32 PR;
+    volatile u32 RLR;
+    volatile u32 SR;
+}IWDG_Registers_t;
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+static IWDG_Registers_t* const IWDG = (IWDG_Registers_t*)IWDG_BASE_ADDR;
+static volatile u32* const RCC_CSR = (volatile u32*)RCC_CSR_ADDR;
+static volatile u32* const DBGMCU_APB1_FZ = (volatile u32*)DBGMCU_APB1_FZ_ADDR;
+
+/********************************************************************************************************/
+/*********************************************APIs Implementation****************************************/
+/********************************************************************************************************/
+IWDG_ErrorStatus_t IWDG_start(u32 TimeoutMS)
+{
+    IWDG_ErrorStatus_t ErrorStatus = IWDG_OK;
+    u32 Prescaler = 0;
+    u32 Reload = 0;
+    if((TimeoutMS < IWDG_MIN_TIMEOUT_MS) || (TimeoutMS > IWDG_MAX_TIMEOUT_MS))
+    {
+        ErrorStatus = IWDG_InvalidTimeout;
+    }
+    else
+    {
+        /*Smallest divider that fits the timeout in the 12-bit reload gives the finest resolution*/
+        do
+        {
+            Reload = ((u64)TimeoutMS * IWDG_LSI_CLK) / ((u32)(IWDG_MIN_DIVIDER << Prescaler) * IWDG_MS_PER_SECOND);
+            if(Reload > IWDG_MAX_RELOAD)
+            {
+                Prescaler++;
+            }
+        }while((Reload > IWDG_MAX_RELOAD) && (Prescaler <= IWDG_MAX_PRESCALER));
+        if(Reload == 0)
+        {
+            Reload = 1;
+        }
+#if IWDG_DEBUG_MODE == IWDG_DEBUG_FREEZE
+        *DBGMCU_APB1_FZ |= DBGMCU_IWDG_STOP;
+#endif
+        IWDG->KR = IWDG_KEY_START;
+        IWDG->KR = IWDG_KEY_UNLOCK;
+        IWDG->PR = Prescaler;
+        IWDG->RLR = Reload - 1;
+        while(IWDG->SR & IWDG_SR_BUSY_MASK);
+        IWDG->KR = IWDG_KEY_REFRESH;
+    }
+    return ErrorStatus;
+}
+
+void IWDG_refresh(void)
+{
+    IWDG->KR = IWDG_KEY_REFRESH;
+}
+
+IWDG_ErrorStatus_t IWDG_getResetFlag(boolean* WatchdogReset)
+{
+    IWDG_ErrorStatus_t ErrorStatus = IWDG_OK;
+    if(WatchdogReset == NULL_PTR)
+    {
+        ErrorStatus = IWDG_NullPtr;
+    }
+    else
+    {
+        *WatchdogReset = ((*RCC_CSR) & RCC_CSR_IWDGRSTF) ? TRUE : FALSE;
+    }
+    return ErrorStatus;
+}
+
+void IWDG_clearResetFlags(void)
+{
+    *RCC_CSR |= RCC_CSR_RMVF;
+}
@@ -0,0 +1,79 @@
+/******************************************************************************
+*
+* Module: IWDG
+*
+* File Name: IWDG.h
+*
+* Description: Header file for the Independent Watchdog driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef D__ITI_STM32F401CC_DRIVERS_INC_MCAL_IWDG_IWDG_H_
+#define D__ITI_STM32F401CC_DRIVERS_INC_MCAL_IWDG_IWDG_H_
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "LIB/std_types.h"
+#include "MCAL/IWDG/IWDG_Cfg.h"
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define IWDG_MIN_TIMEOUT_MS         1
+#define IWDG_MAX_TIMEOUT_MS         ((0x1000UL * 256UL * 1000UL) / IWDG_LSI_CLK)
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef enum{
+    IWDG_OK,
+    IWDG_InvalidTimeout,
+    IWDG_NullPtr
+}IWDG_ErrorStatus_t;
+
+/********************************************************************************************************/
+/************************************************APIs****************************************************/
+/********************************************************************************************************/
+/*****************************************************
+ * Function: IWDG_start
+ * Description: Configures the prescaler and the reload value for the requested timeout and starts the
+ *              watchdog, once started it can't be stopped except by a reset.
+ *
+ * Parameters:
+ *   - TimeoutMS: Time without a refresh after which the device is reset (IWDG_MIN_TIMEOUT_MS to IWDG_MAX_TIMEOUT_MS).
+ *
+ * Return:
+ *   - IWDG_OK or IWDG_InvalidTimeout.
+ *
+ * Notes:
+ *   - The timeout follows the LSI accuracy, leave a margin between it and the refresh period.
+ *****************************************************/
+IWDG_ErrorStatus_t IWDG_start(u32 TimeoutMS);
+
+/*****************************************************
+ * Function: IWDG_refresh
+ * Description: Reloads the watchdog counter.
+ *****************************************************/
+void IWDG_refresh(void);
+
+/*****************************************************
+ * Function: IWDG_getResetFlag
+ * Description: Reads whether the last reset was caused by the independent watchdog.
+ *
+ * Return:
+ *   - IWDG_OK or IWDG_NullPtr.
+ *
+ * Notes:
+ *   - The RCC reset flags are sticky, call IWDG_clearResetFlags after reading them.
+ *****************************************************/
+IWDG_ErrorStatus_t IWDG_getResetFlag(boolean* WatchdogReset);
+
+/*****************************************************
+ * Function: IWDG_clearResetFlags
+ * Description: Clears all the RCC reset flags so the next reset cause can be identified.
+ *****************************************************/
+void IWDG_clearResetFlags(void);
+
+#endif // D__ITI_STM32F401CC_DRIVERS_INC_MCAL_IWDG_IWDG_H_
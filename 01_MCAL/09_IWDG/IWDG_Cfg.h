@@ -0,0 +1,26 @@
+/******************************************************************************
+*
+* Module: IWDG
+*
+* File Name: IWDG_Cfg.h
+*
+* Description: Header file for the Independent Watchdog driver Configurations for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef D__ITI_STM32F401CC_DRIVERS_INC_MCAL_IWDG_IWDG_CFG_H_
+#define D__ITI_STM32F401CC_DRIVERS_INC_MCAL_IWDG_IWDG_CFG_H_
+
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define IWDG_LSI_CLK                32000       /*LSI Clock, it varies from 17 KHz to 47 KHz over temperature*/
+
+#define IWDG_DEBUG_RUN              0
+#define IWDG_DEBUG_FREEZE           1
+#define IWDG_DEBUG_MODE             IWDG_DEBUG_FREEZE   /*Stop the counter while the core is halted by a debugger*/
+
+#endif // D__ITI_STM32F401CC_DRIVERS_INC_MCAL_IWDG_IWDG_CFG_H_
@@ -0,0 +1,393 @@
+/******************************************************************************
+*
+* Module: DMA
+*
+* File Name: DMA.c
+*
+* Description: Source file for the DMA1/DMA2 streams driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "MCAL/NVIC/NVIC.h"
+#include "MCAL/DMA/DMA.h"
+#include "MCAL/DMA/DMA_Cfg.h"
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define NUMBER_OF_DMA_CONTROLLERS       2
+#define NUMBER_OF_DMA_STREAMS           8
+#define NUMBER_OF_DMA_CHANNELS          8
+#define DMA_STREAMS_PER_FLAG_REGISTER   4
+#define DMA1_BASE_ADDR                  0x40026000
+#define DMA2_BASE_ADDR                  0x40026400
+#define DMA_CR_EN                       0x00000001
+#define DMA_CR_DMEIE                    0x00000002
+#define DMA_CR_TEIE                     0x00000004
+#define DMA_CR_HTIE                     0x00000008
+#define DMA_CR_TCIE                     0x00000010
+#define DMA_CR_PINC                     0x00000200
+#define DMA_CR_MINC                     0x00000400
+#define DMA_CR_PSIZE_POS                11
+#define DMA_CR_MSIZE_POS                13
+#define DMA_CR_CHSEL_POS                25
+#define DMA_FLAG_FEIF                   0x00000001
+#define DMA_FLAG_DMEIF                  0x00000004
+#define DMA_FLAG_TEIF                   0x00000008
+#define DMA_FLAG_HTIF                   0x00000010
+#define DMA_FLAG_TCIF                   0x00000020
+#define DMA_FLAGS_MASK                  0x0000003D
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef struct
+{
+    volatile u32 CR;
+    volatile u32 NDTR;
+    volatile u32 PAR;
+    volatile u32 M0AR;
+    volatile u32 M1AR;
+    volatile u32 FCR;
+}DMA_StreamRegisters_t;
+
+typedef struct
+{
+    volatile u32 LISR;
+    volatile u32 HISR;
+    volatile u32 LIFCR;
+    volatile u32 HIFCR;
+    DMA_StreamRegisters_t S[NUMBER_OF_DMA_STREAMS];
+}DMA_Registers_t;
+
+typedef struct
+{
+    boolean allocated;
+    DMA_CallBack_t CallBack;
+    void* Context;
+}DMA_StreamState_t;
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+#ifdef TEST
+DMA_Registers_t DMA_MockRegisters[NUMBER_OF_DMA_CONTROLLERS];
+static DMA_Registers_t* const DMA[NUMBER_OF_DMA_CONTROLLERS] = {&DMA_MockRegisters[DMA_CONTROLLER_1],
+                                                                &DMA_MockRegisters[DMA_CONTROLLER_2]};
+#else
+static DMA_Registers_t* const DMA[NUMBER_OF_DMA_CONTROLLERS] = {(DMA_Registers_t*)DMA1_BASE_ADDR,
+                                                                (DMA_Registers_t*)DMA2_BASE_ADDR};
+#endif
+
+static const IRQn_Type DMA_IRQn[NUMBER_OF_DMA_CONTROLLERS][NUMBER_OF_DMA_STREAMS] = {
+    {DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn,
+     DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn},
+    {DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn,
+     DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn}
+};
+
+/*Position of each stream's flags inside LISR/HISR and LIFCR/HIFCR*/
+static const u8 DMA_FlagOffset[DMA_STREAMS_PER_FLAG_REGISTER] = {0, 6, 16, 22};
+
+static DMA_StreamState_t DMA_State[NUMBER_OF_DMA_CONTROLLERS][NUMBER_OF_DMA_STREAMS] = {0};
+
+/********************************************************************************************************/
+/*********************************************Static Functions*******************************************/
+/********************************************************************************************************/
+static u32 DMA_readFlags(u8 DMA_Controller, u8 DMA_Stream)
+{
+    u32 flags = 0;
+    if(DMA_Stream < DMA_STREAMS_PER_FLAG_REGISTER)
+    {
+        flags = DMA[DMA_Controller]->LISR >> DMA_FlagOffset[DMA_Stream];
+    }
+    else
+    {
+        flags = DMA[DMA_Controller]->HISR >> DMA_FlagOffset[DMA_Stream - DMA_STREAMS_PER_FLAG_REGISTER];
+    }
+    return flags & DMA_FLAGS_MASK;
+}
+
+static void DMA_clearFlags(u8 DMA_Controller, u8 DMA_Stream, u32 Flags)
+{
+    if(DMA_Stream < DMA_STREAMS_PER_FLAG_REGISTER)
+    {
+        DMA[DMA_Controller]->LIFCR = Flags << DMA_FlagOffset[DMA_Stream];
+    }
+    else
+    {
+        DMA[DMA_Controller]->HIFCR = Flags << DMA_FlagOffset[DMA_Stream - DMA_STREAMS_PER_FLAG_REGISTER];
+    }
+}
+
+static void DMA_IRQHandler(u8 DMA_Controller, u8 DMA_Stream)
+{
+    DMA_StreamState_t* const State = &DMA_State[DMA_Controller][DMA_Stream];
+    u32 flags = DMA_readFlags(DMA_Controller, DMA_Stream);
+    u8 events = 0;
+    DMA_clearFlags(DMA_Controller, DMA_Stream, flags);
+    if(flags & DMA_FLAG_HTIF)
+    {
+        events |= DMA_EVENT_HALF;
+    }
+    if(flags & DMA_FLAG_TCIF)
+    {
+        events |= DMA_EVENT_FULL;
+    }
+    if(flags & (DMA_FLAG_TEIF | DMA_FLAG_DMEIF))
+    {
+        events |= DMA_EVENT_ERROR;
+    }
+    if((events != 0) && (State->CallBack != NULL_PTR))
+    {
+        State->CallBack(events, State->Context);
+    }
+}
+
+/********************************************************************************************************/
+/*********************************************APIs Implementation****************************************/
+/********************************************************************************************************/
+DMA_ErrorStatus_t DMA_allocStream(u8 DMA_Controller, u8 DMA_Stream)
+{
+    DMA_ErrorStatus_t ErrorStatus = DMA_OK;
+    if(DMA_Controller >= NUMBER_OF_DMA_CONTROLLERS)
+    {
+        ErrorStatus = DMA_InvalidController;
+    }
+    else if(DMA_Stream >= NUMBER_OF_DMA_STREAMS)
+    {
+        ErrorStatus = DMA_InvalidStream;
+    }
+    else if(DMA_State[DMA_Controller][DMA_Stream].allocated == TRUE)
+    {
+        ErrorStatus = DMA_Busy;
+    }
+    else
+    {
+        DMA_State[DMA_Controller][DMA_Stream].allocated = TRUE;
+        DMA_State[DMA_Controller][DMA_Stream].CallBack = NULL_PTR;
+        NVIC_EnableIRQ(DMA_IRQn[DMA_Controller][DMA_Stream]);
+    }
+    return ErrorStatus;
+}
+
+DMA_ErrorStatus_t DMA_freeStream(u8 DMA_Controller, u8 DMA_Stream)
+{
+    DMA_ErrorStatus_t ErrorStatus = DMA_stopTransfer(DMA_Controller, DMA_Stream);
+    if((ErrorStatus == DMA_OK) && (DMA_State[DMA_Controller][DMA_Stream].allocated == FALSE))
+    {
+        ErrorStatus = DMA_NotAllocated;
+    }
+    else if(ErrorStatus == DMA_OK)
+    {
+        NVIC_DisableIRQ(DMA_IRQn[DMA_Controller][DMA_Stream]);
+        DMA_State[DMA_Controller][DMA_Stream].allocated = FALSE;
+        DMA_State[DMA_Controller][DMA_Stream].CallBack = NULL_PTR;
+    }
+    return ErrorStatus;
+}
+
+DMA_ErrorStatus_t DMA_startTransfer(const DMA_Transfer_t* DMA_Transfer)
+{
+    DMA_ErrorStatus_t ErrorStatus = DMA_OK;
+    DMA_StreamRegisters_t* Stream;
+    u32 CR_value = 0;
+    if(DMA_Transfer == NULL_PTR)
+    {
+        ErrorStatus = DMA_NullPtr;
+    }
+    else if(DMA_Transfer->DMA_Controller >= NUMBER_OF_DMA_CONTROLLERS)
+    {
+        ErrorStatus = DMA_InvalidController;
+    }
+    else if(DMA_Transfer->DMA_Stream >= NUMBER_OF_DMA_STREAMS)
+    {
+        ErrorStatus = DMA_InvalidStream;
+    }
+    else if(DMA_Transfer->DMA_Channel >= NUMBER_OF_DMA_CHANNELS)
+    {
+        ErrorStatus = DMA_InvalidChannel;
+    }
+    else if((DMA_Transfer->DMA_Direction == DMA_DIR_MEM_TO_MEM) &&
+            ((DMA_Transfer->DMA_Controller != DMA_CONTROLLER_2) || (DMA_Transfer->DMA_Mode == DMA_MODE_CIRCULAR)))
+    {
+        ErrorStatus = DMA_InvalidDirection;
+    }
+    else if(DMA_Transfer->DMA_Count == 0)
+    {
+        ErrorStatus = DMA_InvalidLength;
+    }
+    else if(DMA_State[DMA_Transfer->DMA_Controller][DMA_Transfer->DMA_Stream].allocated == FALSE)
+    {
+        ErrorStatus = DMA_NotAllocated;
+    }
+    else if(DMA[DMA_Transfer->DMA_Controller]->S[DMA_Transfer->DMA_Stream].CR & DMA_CR_EN)
+    {
+        ErrorStatus = DMA_Busy;
+    }
+    else
+    {
+        Stream = &DMA[DMA_Transfer->DMA_Controller]->S[DMA_Transfer->DMA_Stream];
+        DMA_State[DMA_Transfer->DMA_Controller][DMA_Transfer->DMA_Stream].CallBack = DMA_Transfer->CB;
+        DMA_State[DMA_Transfer->DMA_Controller][DMA_Transfer->DMA_Stream].Context = DMA_Transfer->Context;
+        /*Stale flags of the previous transfer must be cleared before enabling the stream*/
+        DMA_clearFlags(DMA_Transfer->DMA_Controller, DMA_Transfer->DMA_Stream, DMA_FLAGS_MASK);
+
+        Stream->PAR = DMA_Transfer->DMA_PeriphAddress;
+        Stream->M0AR = DMA_Transfer->DMA_MemAddress;
+        Stream->NDTR = DMA_Transfer->DMA_Count;
+        Stream->FCR = 0;        /*Direct mode*/
+
+        CR_value = ((u32)DMA_Transfer->DMA_Channel << DMA_CR_CHSEL_POS) | DMA_Transfer->DMA_Priority
+                   | (DMA_Transfer->DMA_DataSize << DMA_CR_MSIZE_POS) | (DMA_Transfer->DMA_DataSize << DMA_CR_PSIZE_POS)
+                   | DMA_CR_MINC | DMA_Transfer->DMA_Direction | DMA_Transfer->DMA_Mode
+                   | DMA_CR_TCIE | DMA_CR_TEIE | DMA_CR_DMEIE;
+        if(DMA_Transfer->DMA_Direction == DMA_DIR_MEM_TO_MEM)
+        {
+            CR_value |= DMA_CR_PINC;
+        }
+        if(DMA_Transfer->CB != NULL_PTR)
+        {
+            CR_value |= DMA_CR_HTIE;
+        }
+        Stream->CR = CR_value;
+        Stream->CR |= DMA_CR_EN;
+    }
+    return ErrorStatus;
+}
+
+DMA_ErrorStatus_t DMA_stopTransfer(u8 DMA_Controller, u8 DMA_Stream)
+{
+    DMA_ErrorStatus_t ErrorStatus = DMA_OK;
+    u32 timeOut = DMA_STOP_TIMEOUT;
+    if(DMA_Controller >= NUMBER_OF_DMA_CONTROLLERS)
+    {
+        ErrorStatus = DMA_InvalidController;
+    }
+    else if(DMA_Stream >= NUMBER_OF_DMA_STREAMS)
+    {
+        ErrorStatus = DMA_InvalidStream;
+    }
+    else
+    {
+        DMA[DMA_Controller]->S[DMA_Stream].CR &= ~(DMA_CR_EN | DMA_CR_TCIE | DMA_CR_HTIE | DMA_CR_TEIE | DMA_CR_DMEIE);
+        /*The current data item is finished before EN reads back 0*/
+        while((DMA[DMA_Controller]->S[DMA_Stream].CR & DMA_CR_EN) && timeOut)
+        {
+            timeOut--;
+        }
+        if(timeOut == 0)
+        {
+            ErrorStatus = DMA_TimeOut;
+        }
+        DMA_clearFlags(DMA_Controller, DMA_Stream, DMA_FLAGS_MASK);
+    }
+    return ErrorStatus;
+}
+
+DMA_ErrorStatus_t DMA_getRemaining(u8 DMA_Controller, u8 DMA_Stream, u16* Remaining)
+{
+    DMA_ErrorStatus_t ErrorStatus = DMA_OK;
+    if(Remaining == NULL_PTR)
+    {
+        ErrorStatus = DMA_NullPtr;
+    }
+    else if(DMA_Controller >= NUMBER_OF_DMA_CONTROLLERS)
+    {
+        ErrorStatus = DMA_InvalidController;
+    }
+    else if(DMA_Stream >= NUMBER_OF_DMA_STREAMS)
+    {
+        ErrorStatus = DMA_InvalidStream;
+    }
+    else
+    {
+        *Remaining = (u16)DMA[DMA_Controller]->S[DMA_Stream].NDTR;
+    }
+    return ErrorStatus;
+}
+
+void DMA1_Stream0_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_1, DMA_STREAM_0);
+}
+
+void DMA1_Stream1_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_1, DMA_STREAM_1);
+}
+
+void DMA1_Stream2_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_1, DMA_STREAM_2);
+}
+
+void DMA1_Stream3_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_1, DMA_STREAM_3);
+}
+
+void DMA1_Stream4_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_1, DMA_STREAM_4);
+}
+
+void DMA1_Stream5_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_1, DMA_STREAM_5);
+}
+
+void DMA1_Stream6_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_1, DMA_STREAM_6);
+}
+
+void DMA1_Stream7_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_1, DMA_STREAM_7);
+}
+
+void DMA2_Stream0_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_2, DMA_STREAM_0);
+}
+
+void DMA2_Stream1_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_2, DMA_STREAM_1);
+}
+
+void DMA2_Stream2_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_2, DMA_STREAM_2);
+}
+
+void DMA2_Stream3_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_2, DMA_STREAM_3);
+}
+
+void DMA2_Stream4_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_2, DMA_STREAM_4);
+}
+
+void DMA2_Stream5_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_2, DMA_STREAM_5);
+}
+
+void DMA2_Stream6_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_2, DMA_STREAM_6);
+}
+
+void DMA2_Stream7_IRQHandler(void)
+{
+    DMA_IRQHandler(DMA_CONTROLLER_2, DMA_STREAM_7);
+}
@@ -0,0 +1,151 @@
+/******************************************************************************
+*
+* Module: DMA
+*
+* File Name: DMA.h
+*
+* Description: Header file for the DMA1/DMA2 streams driver for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef D__ITI_STM32F401CC_DRIVERS_INC_MCAL_DMA_DMA_H_
+#define D__ITI_STM32F401CC_DRIVERS_INC_MCAL_DMA_DMA_H_
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "LIB/std_types.h"
+#include "MCAL/DMA/DMA_Cfg.h"
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define DMA_CONTROLLER_1                0U
+#define DMA_CONTROLLER_2                1U
+
+#define DMA_STREAM_0                    0U
+#define DMA_STREAM_1                    1U
+#define DMA_STREAM_2                    2U
+#define DMA_STREAM_3                    3U
+#define DMA_STREAM_4                    4U
+#define DMA_STREAM_5                    5U
+#define DMA_STREAM_6                    6U
+#define DMA_STREAM_7                    7U
+
+#define DMA_CHANNEL_0                   0U
+#define DMA_CHANNEL_1                   1U
+#define DMA_CHANNEL_2                   2U
+#define DMA_CHANNEL_3                   3U
+#define DMA_CHANNEL_4                   4U
+#define DMA_CHANNEL_5                   5U
+#define DMA_CHANNEL_6                   6U
+#define DMA_CHANNEL_7                   7U
+
+#define DMA_DIR_PERIPH_TO_MEM           0x00000000
+#define DMA_DIR_MEM_TO_PERIPH           0x00000040
+#define DMA_DIR_MEM_TO_MEM              0x00000080      /*DMA2 only*/
+
+#define DMA_SIZE_BYTE                   0x00000000
+#define DMA_SIZE_HALF_WORD              0x00000001
+#define DMA_SIZE_WORD                   0x00000002
+
+#define DMA_MODE_NORMAL                 0x00000000
+#define DMA_MODE_CIRCULAR               0x00000100
+
+#define DMA_PRIORITY_LOW                0x00000000
+#define DMA_PRIORITY_MEDIUM             0x00010000
+#define DMA_PRIORITY_HIGH               0x00020000
+#define DMA_PRIORITY_VERY_HIGH          0x00030000
+
+/*Events passed to the transfer callback, more than one can be set in the same call*/
+#define DMA_EVENT_HALF                  0x01U
+#define DMA_EVENT_FULL                  0x02U
+#define DMA_EVENT_ERROR                 0x04U
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef void (*DMA_CallBack_t)(u8 Event, void* Context);
+
+typedef struct{
+    u8 DMA_Controller;
+    u8 DMA_Stream;
+    u8 DMA_Channel;
+    u32 DMA_Direction;
+    u32 DMA_DataSize;
+    u32 DMA_Mode;
+    u32 DMA_Priority;
+    u32 DMA_PeriphAddress;      /*Source address for memory to memory transfers*/
+    u32 DMA_MemAddress;
+    u16 DMA_Count;              /*Number of data items of DMA_DataSize*/
+    DMA_CallBack_t CB;          /*Optional, the half transfer event is only enabled when it's set*/
+    void* Context;
+}DMA_Transfer_t;
+
+typedef enum{
+    DMA_OK,
+    DMA_InvalidController,
+    DMA_InvalidStream,
+    DMA_InvalidChannel,
+    DMA_InvalidDirection,
+    DMA_InvalidLength,
+    DMA_NullPtr,
+    DMA_Busy,
+    DMA_NotAllocated,
+    DMA_TimeOut
+}DMA_ErrorStatus_t;
+
+/********************************************************************************************************/
+/************************************************APIs****************************************************/
+/********************************************************************************************************/
+/*****************************************************
+ * Function: DMA_allocStream
+ * Description: Reserves a stream for the caller and enables its interrupt, a driver tries the streams its
+ *              peripheral request is mapped to and falls back to another method when all are taken.
+ *
+ * Return:
+ *   - DMA_OK, DMA_InvalidController, DMA_InvalidStream or DMA_Busy if the stream is already allocated.
+ *****************************************************/
+DMA_ErrorStatus_t DMA_allocStream(u8 DMA_Controller, u8 DMA_Stream);
+
+/*****************************************************
+ * Function: DMA_freeStream
+ * Description: Stops the stream, disables its interrupt and returns it to the free streams.
+ *
+ * Return:
+ *   - DMA_OK, DMA_InvalidController, DMA_InvalidStream, DMA_TimeOut or DMA_NotAllocated.
+ *****************************************************/
+DMA_ErrorStatus_t DMA_freeStream(u8 DMA_Controller, u8 DMA_Stream);
+
+/*****************************************************
+ * Function: DMA_startTransfer
+ * Description: Programs an allocated stream and enables it, the memory address is incremented and the
+ *              peripheral address is fixed (both are incremented for memory to memory).
+ *
+ * Return:
+ *   - DMA_OK, DMA_NullPtr, DMA_InvalidController, DMA_InvalidStream, DMA_InvalidChannel,
+ *     DMA_InvalidDirection, DMA_InvalidLength, DMA_NotAllocated or DMA_Busy if the stream is running.
+ *
+ * Notes:
+ *   - The callback runs in the stream interrupt with DMA_EVENT_HALF, DMA_EVENT_FULL and DMA_EVENT_ERROR,
+ *     in normal mode the stream is disabled by the hardware after DMA_EVENT_FULL or DMA_EVENT_ERROR.
+ *****************************************************/
+DMA_ErrorStatus_t DMA_startTransfer(const DMA_Transfer_t* DMA_Transfer);
+
+/*****************************************************
+ * Function: DMA_stopTransfer
+ * Description: Disables the stream and waits until the hardware confirms it.
+ *
+ * Return:
+ *   - DMA_OK, DMA_InvalidController, DMA_InvalidStream or DMA_TimeOut.
+ *****************************************************/
+DMA_ErrorStatus_t DMA_stopTransfer(u8 DMA_Controller, u8 DMA_Stream);
+
+/*****************************************************
+ * Function: DMA_getRemaining
+ * Description: Reads the number of data items the stream still has to transfer (NDTR).
+ *****************************************************/
+DMA_ErrorStatus_t DMA_getRemaining(u8 DMA_Controller, u8 DMA_Stream, u16* Remaining);
+
+#endif // D__ITI_STM32F401CC_DRIVERS_INC_MCAL_DMA_DMA_H_
@@ -0,0 +1,22 @@
+/******************************************************************************
+*
+* Module: DMA
+*
+* File Name: DMA_Cfg.h
+*
+* Description: Header file for the DMA driver Configurations for STM32F401xC
+*
+* Author: Momen Elsayed Shaban
+*
+*******************************************************************************/
+
+#ifndef D__ITI_STM32F401CC_DRIVERS_INC_MCAL_DMA_DMA_CFG_H_
+#define D__ITI_STM32F401CC_DRIVERS_INC_MCAL_DMA_DMA_CFG_H_
+
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define DMA_STOP_TIMEOUT            1000        /*Polls of the EN bit before a stream disable is reported as failed*/
+
+#endif // D__ITI_STM32F401CC_DRIVERS_INC_MCAL_DMA_DMA_CFG_H_
@@ -0,0 +1,195 @@
+#ifdef TEST
+
+#include <string.h>
+#include "unity.h"
+#include "DMA.h"
+#include "mock_NVIC.h"
+
+#define NUMBER_OF_DMA_CONTROLLERS       2
+#define NUMBER_OF_DMA_STREAMS           8
+#define DMA_CR_EN                       0x00000001
+#define DMA_CR_HTIE                     0x00000008
+#define DMA_CR_TCIE                     0x00000010
+#define DMA_CR_MINC                     0x00000400
+#define DMA_CR_CHSEL_POS                25
+#define DMA_FLAG_TEIF                   0x00000008
+#define DMA_FLAG_HTIF                   0x00000010
+#define DMA_FLAG_TCIF                   0x00000020
+
+typedef struct
+{
+    volatile u32 CR;
+    volatile u32 NDTR;
+    volatile u32 PAR;
+    volatile u32 M0AR;
+    volatile u32 M1AR;
+    volatile u32 FCR;
+}DMA_StreamRegisters_t;
+
+typedef struct
+{
+    volatile u32 LISR;
+    volatile u32 HISR;
+    volatile u32 LIFCR;
+    volatile u32 HIFCR;
+    DMA_StreamRegisters_t S[NUMBER_OF_DMA_STREAMS];
+}DMA_Registers_t;
+
+extern DMA_Registers_t DMA_MockRegisters[NUMBER_OF_DMA_CONTROLLERS];
+extern void DMA1_Stream1_IRQHandler(void);
+extern void DMA2_Stream7_IRQHandler(void);
+
+static u8 buffer[16];
+static u32 callBackCount;
+static u8 callBackEvents;
+static void* callBackContext;
+
+static void DMA_TestCallBack(u8 Event, void* Context)
+{
+    callBackCount++;
+    callBackEvents = Event;
+    callBackContext = Context;
+}
+
+static DMA_Transfer_t DMA_usart1Tx(void)
+{
+    DMA_Transfer_t Transfer = {
+        .DMA_Controller = DMA_CONTROLLER_2,
+        .DMA_Stream = DMA_STREAM_7,
+        .DMA_Channel = DMA_CHANNEL_4,
+        .DMA_Direction = DMA_DIR_MEM_TO_PERIPH,
+        .DMA_DataSize = DMA_SIZE_BYTE,
+        .DMA_Mode = DMA_MODE_NORMAL,
+        .DMA_Priority = DMA_PRIORITY_HIGH,
+        .DMA_PeriphAddress = 0x40011004,
+        .DMA_MemAddress = (u32)buffer,
+        .DMA_Count = sizeof(buffer),
+        .CB = DMA_TestCallBack,
+        .Context = buffer
+    };
+    return Transfer;
+}
+
+static void DMA_release(u8 DMA_Controller, u8 DMA_Stream, IRQn_Type IRQn)
+{
+    NVIC_DisableIRQ_ExpectAndReturn(IRQn, NVIC_OK);
+    TEST_ASSERT_EQUAL(DMA_OK, DMA_freeStream(DMA_Controller, DMA_Stream));
+}
+
+void setUp(void)
+{
+    memset(DMA_MockRegisters, 0, sizeof(DMA_MockRegisters));
+    callBackCount = 0;
+    callBackEvents = 0;
+    callBackContext = NULL_PTR;
+}
+
+void tearDown(void)
+{
+}
+
+void test_DMA_allocStream_onlyOnce(void)
+{
+    NVIC_EnableIRQ_ExpectAndReturn(DMA2_Stream7_IRQn, NVIC_OK);
+    TEST_ASSERT_EQUAL(DMA_OK, DMA_allocStream(DMA_CONTROLLER_2, DMA_STREAM_7));
+    TEST_ASSERT_EQUAL(DMA_Busy, DMA_allocStream(DMA_CONTROLLER_2, DMA_STREAM_7));
+    TEST_ASSERT_EQUAL(DMA_InvalidController, DMA_allocStream(2, DMA_STREAM_7));
+    TEST_ASSERT_EQUAL(DMA_InvalidStream, DMA_allocStream(DMA_CONTROLLER_2, 8));
+    DMA_release(DMA_CONTROLLER_2, DMA_STREAM_7, DMA2_Stream7_IRQn);
+    TEST_ASSERT_EQUAL(DMA_NotAllocated, DMA_freeStream(DMA_CONTROLLER_2, DMA_STREAM_7));
+}
+
+void test_DMA_startTransfer_requiresAllocation(void)
+{
+    DMA_Transfer_t Transfer = DMA_usart1Tx();
+    TEST_ASSERT_EQUAL(DMA_NotAllocated, DMA_startTransfer(&Transfer));
+    TEST_ASSERT_EQUAL(0, DMA_MockRegisters[DMA_CONTROLLER_2].S[DMA_STREAM_7].CR);
+}
+
+void test_DMA_startTransfer_programsStream(void)
+{
+    DMA_Transfer_t Transfer = DMA_usart1Tx();
+    DMA_StreamRegisters_t* Stream = &DMA_MockRegisters[DMA_CONTROLLER_2].S[DMA_STREAM_7];
+    NVIC_EnableIRQ_ExpectAndReturn(DMA2_Stream7_IRQn, NVIC_OK);
+    DMA_allocStream(DMA_CONTROLLER_2, DMA_STREAM_7);
+    TEST_ASSERT_EQUAL(DMA_OK, DMA_startTransfer(&Transfer));
+    TEST_ASSERT_EQUAL(0x40011004, Stream->PAR);
+    TEST_ASSERT_EQUAL((u32)buffer, Stream->M0AR);
+    TEST_ASSERT_EQUAL(sizeof(buffer), Stream->NDTR);
+    TEST_ASSERT_EQUAL(DMA_CHANNEL_4, Stream->CR >> DMA_CR_CHSEL_POS);
+    TEST_ASSERT_TRUE(Stream->CR & DMA_DIR_MEM_TO_PERIPH);
+    TEST_ASSERT_TRUE(Stream->CR & DMA_CR_MINC);
+    TEST_ASSERT_TRUE(Stream->CR & DMA_CR_TCIE);
+    TEST_ASSERT_TRUE(Stream->CR & DMA_CR_HTIE);
+    TEST_ASSERT_TRUE(Stream->CR & DMA_CR_EN);
+    /*Stream 7 flags are the bits 22 to 27 of HIFCR*/
+    TEST_ASSERT_EQUAL(0x3D << 22, DMA_MockRegisters[DMA_CONTROLLER_2].HIFCR);
+    TEST_ASSERT_EQUAL(DMA_Busy, DMA_startTransfer(&Transfer));
+    DMA_release(DMA_CONTROLLER_2, DMA_STREAM_7, DMA2_Stream7_IRQn);
+}
+
+void test_DMA_startTransfer_invalidArguments(void)
+{
+    DMA_Transfer_t Transfer = DMA_usart1Tx();
+    TEST_ASSERT_EQUAL(DMA_NullPtr, DMA_startTransfer(NULL_PTR));
+    Transfer.DMA_Count = 0;
+    TEST_ASSERT_EQUAL(DMA_InvalidLength, DMA_startTransfer(&Transfer));
+    Transfer = DMA_usart1Tx();
+    Transfer.DMA_Channel = 8;
+    TEST_ASSERT_EQUAL(DMA_InvalidChannel, DMA_startTransfer(&Transfer));
+    Transfer = DMA_usart1Tx();
+    Transfer.DMA_Controller = DMA_CONTROLLER_1;
+    Transfer.DMA_Direction = DMA_DIR_MEM_TO_MEM;
+    TEST_ASSERT_EQUAL(DMA_InvalidDirection, DMA_startTransfer(&Transfer));
+}
+
+void test_DMA_IRQHandler_reportsHalfAndFull(void)
+{
+    DMA_Transfer_t Transfer = DMA_usart1Tx();
+    NVIC_EnableIRQ_ExpectAndReturn(DMA2_Stream7_IRQn, NVIC_OK);
+    DMA_allocStream(DMA_CONTROLLER_2, DMA_STREAM_7);
+    DMA_startTransfer(&Transfer);
+
+    DMA_MockRegisters[DMA_CONTROLLER_2].HISR = DMA_FLAG_HTIF << 22;
+    DMA2_Stream7_IRQHandler();
+    TEST_ASSERT_EQUAL(1, callBackCount);
+    TEST_ASSERT_EQUAL(DMA_EVENT_HALF, callBackEvents);
+    TEST_ASSERT_EQUAL_PTR(buffer, callBackContext);
+    TEST_ASSERT_EQUAL(DMA_FLAG_HTIF << 22, DMA_MockRegisters[DMA_CONTROLLER_2].HIFCR);
+
+    DMA_MockRegisters[DMA_CONTROLLER_2].HISR = (DMA_FLAG_HTIF | DMA_FLAG_TCIF) << 22;
+    DMA2_Stream7_IRQHandler();
+    TEST_ASSERT_EQUAL(2, callBackCount);
+    TEST_ASSERT_EQUAL(DMA_EVENT_HALF | DMA_EVENT_FULL, callBackEvents);
+    DMA_release(DMA_CONTROLLER_2, DMA_STREAM_7, DMA2_Stream7_IRQn);
+}
+
+void test_DMA_IRQHandler_lowStreamFlagsAndError(void)
+{
+    DMA_Transfer_t Transfer = DMA_usart1Tx();
+    Transfer.DMA_Controller = DMA_CONTROLLER_1;
+    Transfer.DMA_Stream = DMA_STREAM_1;
+    Transfer.DMA_Direction = DMA_DIR_PERIPH_TO_MEM;
+    NVIC_EnableIRQ_ExpectAndReturn(DMA1_Stream1_IRQn, NVIC_OK);
+    DMA_allocStream(DMA_CONTROLLER_1, DMA_STREAM_1);
+    DMA_startTransfer(&Transfer);
+
+    /*Stream 1 flags are the bits 6 to 11 of LISR, flags of other streams are ignored*/
+    DMA_MockRegisters[DMA_CONTROLLER_1].LISR = (DMA_FLAG_TEIF << 6) | DMA_FLAG_TCIF;
+    DMA1_Stream1_IRQHandler();
+    TEST_ASSERT_EQUAL(1, callBackCount);
+    TEST_ASSERT_EQUAL(DMA_EVENT_ERROR, callBackEvents);
+    TEST_ASSERT_EQUAL(DMA_FLAG_TEIF << 6, DMA_MockRegisters[DMA_CONTROLLER_1].LIFCR);
+    DMA_release(DMA_CONTROLLER_1, DMA_STREAM_1, DMA1_Stream1_IRQn);
+}
+
+void test_DMA_getRemaining(void)
+{
+    u16 remaining = 0;
+    DMA_MockRegisters[DMA_CONTROLLER_2].S[DMA_STREAM_7].NDTR = 5;
+    TEST_ASSERT_EQUAL(DMA_OK, DMA_getRemaining(DMA_CONTROLLER_2, DMA_STREAM_7, &remaining));
+    TEST_ASSERT_EQUAL(5, remaining);
+    TEST_ASSERT_EQUAL(DMA_NullPtr, DMA_getRemaining(DMA_CONTROLLER_2, DMA_STREAM_7, NULL_PTR));
+}
+
+#endif // TEST
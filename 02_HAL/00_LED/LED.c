@@ -10,10 +10,20 @@
  *
  *******************************************************************************/
 #include "GPIO.h"
+#include "PWM.h"
 #include "LED.h"
 
+#define LED_PERMILLE_PER_PERCENT    (PWM_DUTY_MAX / LED_BRIGHTNESS_MAX)
+
 extern const LED_Cfg_t LEDS[_LEDS_NUM];
 
+/*The active low LEDs (reverse direction) are dimmed by inverting the duty cycle*/
+static u16 LED_brightnessToDuty(u32 LedName, u8 Brightness)
+{
+    u16 duty = (u16)Brightness * LED_PERMILLE_PER_PERCENT;
+    return (LEDS[LedName].dir == LED_DIR_REVERSE) ? (PWM_DUTY_MAX - duty) : duty;
+}
+
 
 LED_ErrorStatus_t LED_Init()
 {
@@ -28,6 +38,10 @@ LED_ErrorStatus_t LED_Init()
         {
             Error_Status = LED_InvalidDir;
         }
+        else if(LEDS[iterator].dimmable)
+        {
+            /*Pin is configured in its alternate function by PWM_init*/
+        }
         else{
             Led.GPIO_Pin = LEDS[iterator].pin;
             Led.GPIO_Port = LEDS[iterator].port;
@@ -48,6 +62,10 @@ LED_ErrorStatus_t LED_setState(u32 LedName, u8 Led_state)
     {
         Error_Status = LED_InvalidState;
     }
+    else if(LEDS[LedName].dimmable)
+    {
+        PWM_setDutyCycle(LEDS[LedName].pwm, LED_brightnessToDuty(LedName, Led_state * LED_BRIGHTNESS_MAX));
+    }
     else
     {
          /*Using Xor will give the corresponding value based on the dir*/ 
@@ -60,10 +78,24 @@ LED_ErrorStatus_t LED_toggle(u32 LedName)
 {
 	LED_ErrorStatus_t Error_Status = LED_OK;
 	u8 led_state = 0;
+	u16 duty = 0;
 	if(LedName > _LEDS_NUM)
 	{
 	    Error_Status = LED_InvalidLedName;
 	}
+	else if(LEDS[LedName].dimmable)
+	{
+		/*A dimmed LED is considered ON, toggling it turns it OFF*/
+		PWM_getDutyCycle(LEDS[LedName].pwm, &duty);
+		if(duty == LED_brightnessToDuty(LedName, 0))
+		{
+			PWM_setDutyCycle(LEDS[LedName].pwm, LED_brightnessToDuty(LedName, LED_BRIGHTNESS_MAX));
+		}
+		else
+		{
+			PWM_setDutyCycle(LEDS[LedName].pwm, LED_brightnessToDuty(LedName, 0));
+		}
+	}
 	else
 	{
 		GPIO_getPinValue(LEDS[LedName].port, LEDS[LedName].pin, &led_state);
@@ -72,3 +104,25 @@ LED_ErrorStatus_t LED_toggle(u32 LedName)
     return Error_Status;
 
 }
+
+LED_ErrorStatus_t LED_setBrightness(u32 LedName, u8 Brightness)
+{
+    LED_ErrorStatus_t Error_Status = LED_OK;
+    if(LedName >= _LEDS_NUM)
+    {
+        Error_Status = LED_InvalidLedName;
+    }
+    else if(Brightness > LED_BRIGHTNESS_MAX)
+    {
+        Error_Status = LED_InvalidBrightness;
+    }
+    else if(!LEDS[LedName].dimmable)
+    {
+        Error_Status = LED_NotDimmable;
+    }
+    else
+    {
+        PWM_setDutyCycle(LEDS[LedName].pwm, LED_brightnessToDuty(LedName, Brightness));
+    }
+    return Error_Status;
+}
@@ -22,11 +22,14 @@
 #define LED_DIR_REVERSE     1
 #define LED_STATE_ON        1
 #define LED_STATE_OFF       0
+#define LED_BRIGHTNESS_MAX  100
 
 typedef struct{
     void* port;
     u32 pin;
     u8 dir;
+    boolean dimmable;   /*Pin driven by a PWM channel through its alternate function*/
+    u8 pwm;             /*PWM channel name in "PWM_Cfg.h" used when dimmable*/
 }LED_Cfg_t;
 
 
@@ -34,7 +37,9 @@ typedef enum{
     LED_OK,
     LED_InvalidDir,
     LED_InvalidLedName,
-    LED_InvalidState
+    LED_InvalidState,
+    LED_InvalidBrightness,
+    LED_NotDimmable
 }LED_ErrorStatus_t;
 
 /*******************************************************************************
@@ -110,5 +115,29 @@ LED_ErrorStatus_t LED_setState(u32 Led, u8 Led_state);
  *****************************************************/
 LED_ErrorStatus_t LED_toggle(u32 LedName);
 
+/*****************************************************
+ * Function: LED_setBrightness
+ * Description: Sets the brightness of a dimmable LED using its hardware PWM channel.
+ *
+ * Parameters:
+ *   - LedName: The Name of the LED in the configuration enum "LED_Cfg.h".
+ *   - Brightness: Brightness in percent (0 .. LED_BRIGHTNESS_MAX).
+ *
+ * Return:
+ *   - LED_ErrorStatus_t: Status of the operation.
+ *     - LED_OK: Operation successful.
+ *     - LED_InvalidLedName: The specified LED name/index is invalid.
+ *     - LED_InvalidBrightness: The brightness is above LED_BRIGHTNESS_MAX.
+ *     - LED_NotDimmable: The LED pin is not configured on a PWM channel.
+ *
+ * Usage: LED_ErrorStatus_t error = LED_setBrightness(LED_Status, 25);
+ *
+ * Notes:
+ *   - The PWM channel is configured by PWM_init, LED_Init leaves dimmable LEDs to it.
+ *   - LED_setState and LED_toggle drive dimmable LEDs at full or zero brightness.
+ *   - The LED direction is applied by inverting the duty cycle.
+ *****************************************************/
+LED_ErrorStatus_t LED_setBrightness(u32 LedName, u8 Brightness);
+
 
 #endif /*LED_H_*/
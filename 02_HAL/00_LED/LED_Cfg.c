@@ -11,6 +11,7 @@
  *******************************************************************************/
 #include "GPIO.h"
 #include "LED.h"
+#include "PWM.h"
 
 const LED_Cfg_t LEDS[_LEDS_NUM] = 
 {
@@ -18,5 +19,12 @@ const LED_Cfg_t LEDS[_LEDS_NUM] =
         .port = GPIO_PORT_A,
         .pin = GPIO_PIN_0,
         .dir = LED_DIR_FORWARD
+    },
+    [LED_Status] = {
+        .port = GPIO_PORT_B,
+        .pin = GPIO_PIN_6,
+        .dir = LED_DIR_FORWARD,
+        .dimmable = TRUE,
+        .pwm = PWM_StatusLed
     }
 };
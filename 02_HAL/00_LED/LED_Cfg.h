@@ -14,6 +14,7 @@
 
 enum{
     LED_Alarm,
+    LED_Status,
     _LEDS_NUM   /*Total Number of LEDS*/
 };
 
@@ -2,9 +2,12 @@
 
 #include "unity.h"
 #include "mock_GPIO.h"
+#include "mock_PWM.h"
 #include "LED.h"
 
-LED_Cfg_t LEDS[_LEDS_NUM];
+LED_Cfg_t LEDS[_LEDS_NUM] = {
+    [LED_Status] = {.dimmable = TRUE, .pwm = PWM_StatusLed}
+};
 
 void setUp(void)
 {
@@ -59,5 +62,35 @@ void test_LED_setState_InvalidState(void)
     TEST_ASSERT_EQUAL(LED_InvalidState, LED_setState(0, 0xff));
 }
 
+void test_LED_setBrightness_ValidParameters(void)
+{
+    PWM_setDutyCycle_ExpectAndReturn(PWM_StatusLed, 250, PWM_OK);
+    TEST_ASSERT_EQUAL(LED_OK, LED_setBrightness(LED_Status, 25));
+}
+
+void test_LED_setBrightness_ReverseDirection(void)
+{
+    LEDS[LED_Status].dir = LED_DIR_REVERSE;
+    PWM_setDutyCycle_ExpectAndReturn(PWM_StatusLed, 750, PWM_OK);
+    TEST_ASSERT_EQUAL(LED_OK, LED_setBrightness(LED_Status, 25));
+    LEDS[LED_Status].dir = LED_DIR_FORWARD;
+}
+
+void test_LED_setBrightness_NotDimmable(void)
+{
+    TEST_ASSERT_EQUAL(LED_NotDimmable, LED_setBrightness(LED_Alarm, 50));
+}
+
+void test_LED_setBrightness_InvalidBrightness(void)
+{
+    TEST_ASSERT_EQUAL(LED_InvalidBrightness, LED_setBrightness(LED_Status, LED_BRIGHTNESS_MAX + 1));
+}
+
+void test_LED_setState_Dimmable(void)
+{
+    PWM_setDutyCycle_ExpectAndReturn(PWM_StatusLed, PWM_DUTY_MAX, PWM_OK);
+    TEST_ASSERT_EQUAL(LED_OK, LED_setState(LED_Status, LED_STATE_ON));
+}
+
 
 #endif // TEST
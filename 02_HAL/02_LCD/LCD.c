@@ -11,6 +11,8 @@
  *******************************************************************************/
 #include "LCD.h"
 #include "GPIO.h"
+#include "DWT.h"
+#include "TIM.h"
 
 
 /*
@@ -55,6 +57,9 @@
  *                              Static Functions	                           *
  *******************************************************************************/
 static void LCD_InitStateMachine();
+static void LCD_step(void);
+static void LCD_stepCallBack(void* Context);
+static u8 LCD_hasWork(void);
 static void LCD_setTriggerEnable(u8 value);
 static void LCD_writeCommandAsync(u8 Copy_u8command);
 static void LCD_writeDataAsync(u8 Copy_u8data);
@@ -133,6 +138,9 @@ LCD_State_t	LCD_state = LCD_initState;
 LCD_writeState_t LCD_writeState = Write_Start;
 LCD_clearState_t LCD_clearState = Clear_Start;
 
+static volatile u8 LCD_stepRunning = 0;		/* A TIM one-shot event is armed for the next step */
+static u32 LCD_executionUS = LCD_COMMAND_US;	/* Wait after the enable falls for the last written command */
+
 
 
 /*******************************************************************************
@@ -224,7 +232,60 @@ LCD_enumErrorState_t LCD_InitAsync()
 	return loc_LCD_ErrorState;
 }
 
+/*
+ * The runnable only starts a chain of steps, each step arms a TIM one-shot event for the next one with
+ * the time the LCD needs: the enable pulse width while the enable is high, the command execution time
+ * once it falls. The chain stops when there is nothing left to write.
+ */
 void LCD_Runnable()
+{
+	TIM_Req_t Req = {LCD_TIM_NUMBER, LCD_TIM_CHANNEL, TIM_MODE_ONE_SHOT, LCD_COMMAND_US, LCD_stepCallBack, NULL_PTR};
+	DWT_PROFILE_BEGIN(DWT_PROFILE_LCD);
+	if((LCD_stepRunning == 0) && LCD_hasWork())
+	{
+		if((LCD_state == LCD_initState) && (LCD_initMode == LCD_PowerOn))
+		{
+			Req.TIM_TimeUS = LCD_POWER_ON_US;
+		}
+		LCD_stepRunning = 1;
+		if(TIM_startEvent(Req) != TIM_OK)
+		{
+			LCD_stepRunning = 0;	/*Retried on the next runnable call*/
+		}
+	}
+	DWT_PROFILE_END(DWT_PROFILE_LCD);
+}
+
+static u8 LCD_hasWork(void)
+{
+	return (LCD_state == LCD_initState) ||
+	       ((LCD_state == LCD_operationalState) && (LCD_UserReq.Req_state == LCD_ReqBusy));
+}
+
+/* Called from the timer interrupt */
+static void LCD_stepCallBack(void* Context)
+{
+	TIM_Req_t Req = {LCD_TIM_NUMBER, LCD_TIM_CHANNEL, TIM_MODE_ONE_SHOT, LCD_ENABLE_PULSE_US, LCD_stepCallBack, NULL_PTR};
+	(void)Context;
+	LCD_step();
+	if(!LCD_hasWork())
+	{
+		LCD_stepRunning = 0;
+	}
+	else
+	{
+		if(LCD_triggerEnableState == LCD_TRIGGER_ENABLE_LOW)
+		{
+			Req.TIM_TimeUS = LCD_executionUS;
+		}
+		if(TIM_startEvent(Req) != TIM_OK)
+		{
+			LCD_stepRunning = 0;
+		}
+	}
+}
+
+static void LCD_step(void)
 {
 	switch (LCD_state)
 	{
@@ -256,20 +317,15 @@ void LCD_Runnable()
 	}
 }
 
-/*Every 2 ms*/
+/*One step per TIM event, the first one comes LCD_POWER_ON_US after the first runnable call*/
 static void LCD_InitStateMachine()
 {
-	static u8 counts = 0;
 	switch(LCD_initMode)
 	{
 		case LCD_PowerOn:
-			counts++;
-			if(counts == 15)	/*wait for 30 ms until the power ON*/
-			{
-				LCD_initMode = LCD_FunctionSet1;
-				LCD_triggerEnableState = LCD_TRIGGER_ENABLE_LOW;
-				LCD_setTriggerEnable(LCD_triggerEnableState);
-			}
+			LCD_initMode = LCD_FunctionSet1;
+			LCD_triggerEnableState = LCD_TRIGGER_ENABLE_LOW;
+			LCD_setTriggerEnable(LCD_triggerEnableState);
 			break;
 		case LCD_FunctionSet1:
 #if LCD_BIT_MODE_SELECT == LCD_EIGHT_BITS_MODE
@@ -567,6 +623,7 @@ static void LCD_writeCommandAsync(u8 Copy_u8command)
 	/* Set the LCD in command mode (RS = 0, RW = 0) */
 	GPIO_setPinValue(LCD_strCfg[RS].port, LCD_strCfg[RS].pin, LCD_enumLogicLow);
 	GPIO_setPinValue(LCD_strCfg[RW].port, LCD_strCfg[RW].pin, LCD_enumLogicLow);
+	LCD_executionUS = (Copy_u8command == LCD_CLEAR_DISPLAY) ? LCD_CLEAR_US : LCD_COMMAND_US;
     /* Write the command to the data pins based on the selected bit mode */
 #if LCD_BIT_MODE_SELECT == LCD_EIGHT_BITS_MODE
     /* Local variables */
@@ -613,6 +670,7 @@ static void LCD_writeDataAsync(u8 Copy_u8data)
 	/* Set the LCD in command mode (RS = 0, RW = 0) */
 	GPIO_setPinValue(LCD_strCfg[RS].port, LCD_strCfg[RS].pin, LCD_enumLogicHigh);
 	GPIO_setPinValue(LCD_strCfg[RW].port, LCD_strCfg[RW].pin, LCD_enumLogicLow);
+	LCD_executionUS = LCD_COMMAND_US;
     /* Write the command to the data pins based on the selected bit mode */
 #if LCD_BIT_MODE_SELECT == LCD_EIGHT_BITS_MODE
     /* Local variables */
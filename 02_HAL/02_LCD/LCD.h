@@ -106,6 +106,8 @@ extern LCD_strPinCfg_t LCD_strCfg[NUMBER_OF_LCD_PINS];
  *   - Each LCD pin is configured as an output with a specified speed.
  *   - Configuration is based on the bit mode selected (eight bits or four bits).
  *   - The actual initialization process may be handled asynchronously by the GPIO module.
+ *   - The enable pulses are timed by one-shot events on LCD_TIM_CHANNEL of LCD_TIM_NUMBER, TIM_init
+ *     must be called and the timer interrupt enabled before LCD_Runnable starts.
  *****************************************************/
 LCD_enumErrorState_t LCD_InitAsync();
 
@@ -58,6 +58,14 @@
 #define NUMBER_OF_LCD_PINS					11   /* Specify the maximum number of LCD Pins (typically 11) */
 #define NUMBER_OF_REQ_SPECIAL_CHAR			1	 /* Specify the maximum number of required Special characters */
 
+/* Enable Pulse Timing Configuration, the steps are paced by TIM one-shot events */
+#define LCD_TIM_NUMBER                      TIM_NUMBER_2    /* Timer driving the LCD steps, initialized by TIM_init */
+#define LCD_TIM_CHANNEL                     TIM_CHANNEL_1   /* Compare channel reserved for the LCD */
+#define LCD_POWER_ON_US                     30000   /* Wait after power on before the first function set */
+#define LCD_ENABLE_PULSE_US                 1       /* Enable high time, at least 450 ns */
+#define LCD_COMMAND_US                      40      /* Execution time of a command or data write */
+#define LCD_CLEAR_US                        1640    /* Execution time of the clear display command */
+
 
 
 #endif /* LCD_CFG_H_ */
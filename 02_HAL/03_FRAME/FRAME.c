@@ -0,0 +1,451 @@
+/******************************************************************************
+ *
+ * Module: FRAME
+ *
+ * File Name: FRAME.c
+ *
+ * Description: Source file for the COBS framing layer over USART for STM32F401xC
+ *
+ * Author: Momen Elsayed Shaban
+ *
+ *******************************************************************************/
+#include "USART.h"
+#include "FRAME.h"
+
+/*
+ * COBS: every zero of the frame is replaced by a code giving the distance to the next zero, the first code
+ * leads the frame and FRAME_DELIMITER ends it. A run of 254 bytes with no zero takes the code 0xFF, which
+ * isn't followed by an implicit zero when decoding.
+ */
+#define FRAME_MAX_RUN               (FRAME_MAX_CODE - 1)
+/*A leading code, one more per 254 byte run and the delimiter*/
+#define FRAME_MAX_ENCODED_SIZE      (FRAME_MAX_SIZE + (FRAME_MAX_SIZE / FRAME_MAX_RUN) + 2)
+
+#define FRAME_DECODE_MORE           0U      /*Byte stored, the frame goes on*/
+#define FRAME_DECODE_FRAME          1U      /*Delimiter after a well-formed frame*/
+#define FRAME_DECODE_EMPTY          2U      /*Delimiter with nothing before it*/
+#define FRAME_DECODE_DROP           3U      /*Delimiter after a truncated or too long frame*/
+
+#define FRAME_CODES_16(BASE)        (BASE) + 0x0, (BASE) + 0x1, (BASE) + 0x2, (BASE) + 0x3, (BASE) + 0x4,\
+                                    (BASE) + 0x5, (BASE) + 0x6, (BASE) + 0x7, (BASE) + 0x8, (BASE) + 0x9,\
+                                    (BASE) + 0xA, (BASE) + 0xB, (BASE) + 0xC, (BASE) + 0xD, (BASE) + 0xE,\
+                                    (BASE) + 0xF
+
+/*******************************************************************************
+ *                                   Types                                     *
+ *******************************************************************************/
+typedef struct{
+    u8* data;
+    u16 capacity;
+    u16 length;
+    u8 code;            /*Code of the current block*/
+    u8 remaining;       /*Bytes of the current block still to come*/
+    boolean started;
+    boolean overflow;
+}FRAME_Decoder_t;
+
+/*Gather list of a frame in flight (or the frame encoded when the list is too short), released by the USART completion*/
+typedef struct{
+    USART_Segment_t segments[FRAME_MAX_SEGMENTS];
+    u8 encoded[FRAME_MAX_ENCODED_SIZE];
+    FRAME_TxCallBack_t CallBack;
+    void* Context;
+    u8 channel;
+    volatile boolean busy;
+}FRAME_TxSlot_t;
+
+typedef struct{
+    FRAME_RxCallBack_t CallBack;
+    void* Context;
+}FRAME_RxNotify_t;
+
+/*******************************************************************************
+ *                                 Variables                                   *
+ *******************************************************************************/
+extern const FRAME_Cfg_t FRAMES[_FRAME_NUM];
+
+/*Code bytes are sent from here, so encoding a frame never writes a byte*/
+static const u8 FRAME_Codes[256] = {
+    FRAME_CODES_16(0x00), FRAME_CODES_16(0x10), FRAME_CODES_16(0x20), FRAME_CODES_16(0x30),
+    FRAME_CODES_16(0x40), FRAME_CODES_16(0x50), FRAME_CODES_16(0x60), FRAME_CODES_16(0x70),
+    FRAME_CODES_16(0x80), FRAME_CODES_16(0x90), FRAME_CODES_16(0xA0), FRAME_CODES_16(0xB0),
+    FRAME_CODES_16(0xC0), FRAME_CODES_16(0xD0), FRAME_CODES_16(0xE0), FRAME_CODES_16(0xF0)
+};
+
+static FRAME_TxSlot_t Frame_TxSlots[_FRAME_NUM][FRAME_TX_SLOTS];
+static FRAME_Decoder_t Frame_Decoders[_FRAME_NUM];
+static u8 Frame_RxBuffers[_FRAME_NUM][FRAME_MAX_SIZE];
+static FRAME_RxNotify_t Frame_RxNotify[_FRAME_NUM];
+static volatile FRAME_Stats_t Frame_Stats[_FRAME_NUM];
+
+/*******************************************************************************
+ *                              Static Functions                               *
+ *******************************************************************************/
+static void FRAME_resetDecoder(FRAME_Decoder_t* Decoder)
+{
+    Decoder->length = 0;
+    Decoder->code = 0;
+    Decoder->remaining = 0;
+    Decoder->started = FALSE;
+    Decoder->overflow = FALSE;
+}
+
+/*A frame longer than the buffer is kept out of it and dropped at its delimiter*/
+static void FRAME_append(FRAME_Decoder_t* Decoder, u8 Byte)
+{
+    if(Decoder->length < Decoder->capacity)
+    {
+        Decoder->data[Decoder->length] = Byte;
+        Decoder->length++;
+    }
+    else
+    {
+        Decoder->overflow = TRUE;
+    }
+}
+
+static u8 FRAME_decodeByte(FRAME_Decoder_t* Decoder, u8 Byte)
+{
+    u8 result = FRAME_DECODE_MORE;
+    if(Byte == FRAME_DELIMITER)
+    {
+        if((Decoder->overflow == TRUE) || (Decoder->remaining != 0))
+        {
+            result = FRAME_DECODE_DROP;
+        }
+        else if(Decoder->length == 0)
+        {
+            result = FRAME_DECODE_EMPTY;
+        }
+        else
+        {
+            result = FRAME_DECODE_FRAME;
+        }
+    }
+    else if((Decoder->started == FALSE) || (Decoder->remaining == 0))
+    {
+        /*A new block: the zero the previous code stood for goes first*/
+        if((Decoder->started == TRUE) && (Decoder->code != FRAME_MAX_CODE))
+        {
+            FRAME_append(Decoder, 0);
+        }
+        Decoder->code = Byte;
+        Decoder->remaining = Byte - 1;
+        Decoder->started = TRUE;
+    }
+    else
+    {
+        FRAME_append(Decoder, Byte);
+        Decoder->remaining--;
+    }
+    return result;
+}
+
+/*Adds a block code and its run, leaving room for the delimiter*/
+static boolean FRAME_addBlock(USART_Segment_t* Segments, u8* Count, const u8* Run, u16 RunLength)
+{
+    boolean added = FALSE;
+    if((*Count + ((RunLength > 0) ? 2 : 1)) < FRAME_MAX_SEGMENTS)
+    {
+        Segments[*Count].data = &FRAME_Codes[RunLength + 1];
+        Segments[*Count].length = 1;
+        (*Count)++;
+        if(RunLength > 0)
+        {
+            Segments[*Count].data = Run;
+            Segments[*Count].length = RunLength;
+            (*Count)++;
+        }
+        added = TRUE;
+    }
+    return added;
+}
+
+/*Builds the gather list of the encoded frame, returns its segments count or 0 if it doesn't fit*/
+static u8 FRAME_buildSegments(USART_Segment_t* Segments, const u8* Data, u16 Length)
+{
+    u8 count = 0;
+    u16 runStart = 0;
+    u16 idx = 0;
+    boolean fits = TRUE;
+    for(idx = 0; (idx < Length) && (fits == TRUE); idx++)
+    {
+        if(Data[idx] == 0)
+        {
+            fits = FRAME_addBlock(Segments, &count, &Data[runStart], idx - runStart);
+            runStart = idx + 1;
+        }
+        else if((idx + 1 - runStart) == FRAME_MAX_RUN)
+        {
+            fits = FRAME_addBlock(Segments, &count, &Data[runStart], FRAME_MAX_RUN);
+            runStart = idx + 1;
+        }
+    }
+    if((fits == TRUE) && (FRAME_addBlock(Segments, &count, &Data[runStart], Length - runStart) == TRUE))
+    {
+        Segments[count].data = &FRAME_Codes[FRAME_DELIMITER];
+        Segments[count].length = 1;
+        count++;
+    }
+    else
+    {
+        count = 0;
+    }
+    return count;
+}
+
+/*Encodes the frame and its delimiter into Encoded (FRAME_MAX_ENCODED_SIZE bytes for FRAME_MAX_SIZE bytes of Data),
+  returns the encoded length*/
+static u16 FRAME_encode(u8* Encoded, const u8* Data, u16 Length)
+{
+    u16 codeIdx = 0;
+    u16 outIdx = 1;
+    u16 idx = 0;
+    u8 code = 1;
+    for(idx = 0; idx < Length; idx++)
+    {
+        if(Data[idx] == 0)
+        {
+            Encoded[codeIdx] = code;
+            codeIdx = outIdx;
+            outIdx++;
+            code = 1;
+        }
+        else
+        {
+            Encoded[outIdx] = Data[idx];
+            outIdx++;
+            code++;
+            if(code == FRAME_MAX_CODE)
+            {
+                Encoded[codeIdx] = code;
+                codeIdx = outIdx;
+                outIdx++;
+                code = 1;
+            }
+        }
+    }
+    Encoded[codeIdx] = code;
+    Encoded[outIdx] = FRAME_DELIMITER;
+    outIdx++;
+    return outIdx;
+}
+
+static void FRAME_TxDone(const USART_Completion_t* Completion)
+{
+    FRAME_TxSlot_t* const Slot = (FRAME_TxSlot_t*)Completion->Context;
+    FRAME_TxCallBack_t CallBack = Slot->CallBack;
+    void* Context = Slot->Context;
+    u8 Channel = Slot->channel;
+    Frame_Stats[Channel].framesSent++;
+    Slot->busy = FALSE;
+    if(CallBack != NULL_PTR)
+    {
+        CallBack(Channel, Context);
+    }
+}
+
+/*******************************************************************************
+ *                         Functions Implementation                            *
+ *******************************************************************************/
+FRAME_ErrorStatus_t FRAME_Init(void)
+{
+    FRAME_ErrorStatus_t Error_Status = FRAME_OK;
+    u8 channel = 0;
+    u8 slot = 0;
+    for(channel = 0; channel < _FRAME_NUM; channel++)
+    {
+        Frame_Decoders[channel].data = Frame_RxBuffers[channel];
+        Frame_Decoders[channel].capacity = FRAME_MAX_SIZE;
+        FRAME_resetDecoder(&Frame_Decoders[channel]);
+        for(slot = 0; slot < FRAME_TX_SLOTS; slot++)
+        {
+            Frame_TxSlots[channel][slot].channel = channel;
+            Frame_TxSlots[channel][slot].busy = FALSE;
+        }
+        if(USART_startContinuousRx(FRAMES[channel].USART_Number) != USART_OK)
+        {
+            Error_Status = FRAME_UsartError;
+        }
+    }
+    return Error_Status;
+}
+
+FRAME_ErrorStatus_t FRAME_send(u8 Channel, const u8* Data, u16 Length, FRAME_TxCallBack_t CB, void* Context)
+{
+    FRAME_ErrorStatus_t Error_Status = FRAME_OK;
+    FRAME_TxSlot_t* Slot = NULL_PTR;
+    USART_GatherReq_t Req;
+    u8 idx = 0;
+    if(Data == NULL_PTR)
+    {
+        Error_Status = FRAME_NullPtr;
+    }
+    else if(Channel >= _FRAME_NUM)
+    {
+        Error_Status = FRAME_InvalidChannel;
+    }
+    else if(Length == 0)
+    {
+        Error_Status = FRAME_InvalidLength;
+    }
+    else
+    {
+        for(idx = 0; (idx < FRAME_TX_SLOTS) && (Slot == NULL_PTR); idx++)
+        {
+            if(Frame_TxSlots[Channel][idx].busy == FALSE)
+            {
+                Slot = &Frame_TxSlots[Channel][idx];
+            }
+        }
+        if(Slot == NULL_PTR)
+        {
+            Error_Status = FRAME_Busy;
+        }
+        else
+        {
+            Req.USART_Number = FRAMES[Channel].USART_Number;
+            Req.segments = Slot->segments;
+            Req.count = FRAME_buildSegments(Slot->segments, Data, Length);
+            if((Req.count == 0) && (Length <= FRAME_MAX_SIZE))
+            {
+                /*Dense zeros: one segment of the frame encoded into the slot*/
+                Slot->segments[0].data = Slot->encoded;
+                Slot->segments[0].length = FRAME_encode(Slot->encoded, Data, Length);
+                Req.count = 1;
+            }
+            Req.CB = FRAME_TxDone;
+            Req.Context = Slot;
+            Slot->CallBack = CB;
+            Slot->Context = Context;
+            if(Req.count == 0)
+            {
+                Error_Status = FRAME_TooManySegments;
+            }
+            else
+            {
+                /*Taken before posting, the completion may run before USART_sendGatherAsyncZC returns*/
+                Slot->busy = TRUE;
+                if(USART_sendGatherAsyncZC(Req) != USART_OK)
+                {
+                    Slot->busy = FALSE;
+                    Error_Status = FRAME_Busy;
+                }
+            }
+        }
+    }
+    return Error_Status;
+}
+
+FRAME_ErrorStatus_t FRAME_setRxCallBack(u8 Channel, FRAME_RxCallBack_t CB, void* Context)
+{
+    FRAME_ErrorStatus_t Error_Status = FRAME_OK;
+    if(Channel >= _FRAME_NUM)
+    {
+        Error_Status = FRAME_InvalidChannel;
+    }
+    else
+    {
+        Frame_RxNotify[Channel].CallBack = CB;
+        Frame_RxNotify[Channel].Context = Context;
+    }
+    return Error_Status;
+}
+
+FRAME_ErrorStatus_t FRAME_process(u8 Channel)
+{
+    FRAME_ErrorStatus_t Error_Status = FRAME_OK;
+    FRAME_Decoder_t* Decoder;
+    const u8* received = NULL_PTR;
+    u16 readLength = 0;
+    u16 idx = 0;
+    u8 result = FRAME_DECODE_MORE;
+    if(Channel >= _FRAME_NUM)
+    {
+        Error_Status = FRAME_InvalidChannel;
+    }
+    else
+    {
+        Decoder = &Frame_Decoders[Channel];
+        /*Decoded straight out of the ring into the frame buffer, a span ends at the end of the ring buffer*/
+        do
+        {
+            USART_peekRx(FRAMES[Channel].USART_Number, &received, &readLength);
+            for(idx = 0; idx < readLength; idx++)
+            {
+                result = FRAME_decodeByte(Decoder, received[idx]);
+                if(result == FRAME_DECODE_FRAME)
+                {
+                    Frame_Stats[Channel].framesReceived++;
+                    if(Frame_RxNotify[Channel].CallBack != NULL_PTR)
+                    {
+                        Frame_RxNotify[Channel].CallBack(Channel, Decoder->data, Decoder->length,
+                                                         Frame_RxNotify[Channel].Context);
+                    }
+                }
+                else if(result == FRAME_DECODE_DROP)
+                {
+                    Frame_Stats[Channel].framesDropped++;
+                }
+                if(result != FRAME_DECODE_MORE)
+                {
+                    FRAME_resetDecoder(Decoder);
+                }
+            }
+            USART_consumeRx(FRAMES[Channel].USART_Number, readLength);
+        }while(readLength != 0);
+    }
+    return Error_Status;
+}
+
+FRAME_ErrorStatus_t FRAME_decodeInPlace(u8* Data, u16 Length, u16* Decoded)
+{
+    FRAME_ErrorStatus_t Error_Status = FRAME_OK;
+    FRAME_Decoder_t Decoder;
+    u16 idx = 0;
+    u8 result = FRAME_DECODE_MORE;
+    if((Data == NULL_PTR) || (Decoded == NULL_PTR))
+    {
+        Error_Status = FRAME_NullPtr;
+    }
+    else
+    {
+        /*Each byte is read before its slot can be written, the output trails the input by the codes*/
+        Decoder.data = Data;
+        Decoder.capacity = Length;
+        FRAME_resetDecoder(&Decoder);
+        for(idx = 0; (idx < Length) && (result == FRAME_DECODE_MORE); idx++)
+        {
+            result = FRAME_decodeByte(&Decoder, Data[idx]);
+        }
+        if((result == FRAME_DECODE_DROP) || (Decoder.remaining != 0))
+        {
+            Error_Status = FRAME_InvalidFrame;
+        }
+        else
+        {
+            *Decoded = Decoder.length;
+        }
+    }
+    return Error_Status;
+}
+
+FRAME_ErrorStatus_t FRAME_getStats(u8 Channel, FRAME_Stats_t* Stats)
+{
+    FRAME_ErrorStatus_t Error_Status = FRAME_OK;
+    if(Stats == NULL_PTR)
+    {
+        Error_Status = FRAME_NullPtr;
+    }
+    else if(Channel >= _FRAME_NUM)
+    {
+        Error_Status = FRAME_InvalidChannel;
+    }
+    else
+    {
+        Stats->framesSent = Frame_Stats[Channel].framesSent;
+        Stats->framesReceived = Frame_Stats[Channel].framesReceived;
+        Stats->framesDropped = Frame_Stats[Channel].framesDropped;
+    }
+    return Error_Status;
+}
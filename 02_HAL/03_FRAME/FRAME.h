@@ -0,0 +1,116 @@
+/******************************************************************************
+ *
+ * Module: FRAME
+ *
+ * File Name: FRAME.h
+ *
+ * Description: Header file for the COBS framing layer over USART for STM32F401xC
+ *
+ * Author: Momen Elsayed Shaban
+ *
+ *******************************************************************************/
+#ifndef FRAME_H_
+#define FRAME_H_
+
+#include "FRAME_Cfg.h"
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Type Decelerations                           *
+ *******************************************************************************/
+#define FRAME_DELIMITER         0x00    /*Ends every encoded frame, never appears inside one*/
+#define FRAME_MAX_CODE          0xFF    /*Code of a 254 byte run with no zero after it*/
+
+typedef struct{
+    u8 USART_Number;
+}FRAME_Cfg_t;
+
+/*Called from FRAME_process, the frame is only valid until the callback returns*/
+typedef void (*FRAME_RxCallBack_t)(u8 Channel, const u8* Frame, u16 Length, void* Context);
+
+/*Called from the USART interrupt once the frame is on the line, its buffer can be reused*/
+typedef void (*FRAME_TxCallBack_t)(u8 Channel, void* Context);
+
+typedef struct{
+    u32 framesSent;
+    u32 framesReceived;
+    u32 framesDropped;      /*Malformed frames and frames longer than FRAME_MAX_SIZE*/
+}FRAME_Stats_t;
+
+typedef enum{
+    FRAME_OK,
+    FRAME_InvalidChannel,
+    FRAME_NullPtr,
+    FRAME_InvalidLength,
+    FRAME_TooManySegments,
+    FRAME_Busy,
+    FRAME_InvalidFrame,
+    FRAME_UsartError
+}FRAME_ErrorStatus_t;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/*****************************************************
+ * Function: FRAME_Init
+ * Description: Starts the continuous USART receive of every configured channel and clears the decoders.
+ *
+ * Return:
+ *   - FRAME_OK or FRAME_UsartError if the continuous receive of a channel didn't start (instance not
+ *     configured, or a buffer receive or a double buffered receive runs on it).
+ *
+ * Notes:
+ *   - USART_init must be called first.
+ *****************************************************/
+FRAME_ErrorStatus_t FRAME_Init(void);
+
+/*****************************************************
+ * Function: FRAME_send
+ * Description: Sends Data as one COBS frame without copying or encoding it into a buffer: the frame is posted
+ *              to the USART transmit queue as a gather list of code bytes (from a constant table) and runs
+ *              of Data sent in place, followed by the delimiter. A frame with too many zeros for
+ *              FRAME_MAX_SEGMENTS is encoded into the buffer of its slot instead.
+ *
+ * Return:
+ *   - FRAME_OK, FRAME_NullPtr, FRAME_InvalidChannel, FRAME_InvalidLength (empty frame),
+ *     FRAME_TooManySegments if Data has too many zeros for FRAME_MAX_SEGMENTS and is longer than
+ *     FRAME_MAX_SIZE or FRAME_Busy if all the FRAME_TX_SLOTS or the USART queue are taken.
+ *
+ * Notes:
+ *   - Data must stay valid until CB is called, CB can be NULL_PTR.
+ *****************************************************/
+FRAME_ErrorStatus_t FRAME_send(u8 Channel, const u8* Data, u16 Length, FRAME_TxCallBack_t CB, void* Context);
+
+/*****************************************************
+ * Function: FRAME_setRxCallBack
+ * Description: Sets the callback receiving the decoded frames of the channel, NULL_PTR removes it.
+ *****************************************************/
+FRAME_ErrorStatus_t FRAME_setRxCallBack(u8 Channel, FRAME_RxCallBack_t CB, void* Context);
+
+/*****************************************************
+ * Function: FRAME_process
+ * Description: Drains the channel USART ring and decodes it byte by byte, in place in the ring (USART_peekRx),
+ *              straight into the channel frame buffer, every complete frame is handed to the receive callback.
+ *
+ * Notes:
+ *   - Call it periodically (e.g. from a scheduler runnable) often enough to keep the ring from filling.
+ *****************************************************/
+FRAME_ErrorStatus_t FRAME_process(u8 Channel);
+
+/*****************************************************
+ * Function: FRAME_decodeInPlace
+ * Description: Decodes a COBS frame received by other means (e.g. a USART DMA receive) over itself, the
+ *              decoded bytes never overtake the encoded ones.
+ *
+ * Parameters:
+ *   - Length: Encoded bytes, decoding stops at the first delimiter if there's one.
+ *   - Decoded: Receives the decoded length.
+ *
+ * Return:
+ *   - FRAME_OK, FRAME_NullPtr or FRAME_InvalidFrame if a code points past the end of the frame.
+ *****************************************************/
+FRAME_ErrorStatus_t FRAME_decodeInPlace(u8* Data, u16 Length, u16* Decoded);
+
+FRAME_ErrorStatus_t FRAME_getStats(u8 Channel, FRAME_Stats_t* Stats);
+
+#endif /*FRAME_H_*/
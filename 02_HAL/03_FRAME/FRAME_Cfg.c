@@ -0,0 +1,20 @@
+/******************************************************************************
+ *
+ * Module: FRAME
+ *
+ * File Name: FRAME_Cfg.c
+ *
+ * Description: Source file for the COBS framing layer over USART Configurations
+ *
+ * Author: Momen Elsayed Shaban
+ *
+ *******************************************************************************/
+#include "USART.h"
+#include "FRAME.h"
+
+const FRAME_Cfg_t FRAMES[_FRAME_NUM] =
+{
+    [FRAME_Link] = {
+        .USART_Number = USART_NUMBER_1
+    }
+};
@@ -0,0 +1,25 @@
+/******************************************************************************
+ *
+ * Module: FRAME
+ *
+ * File Name: FRAME_Cfg.h
+ *
+ * Description: Header file for the COBS framing layer over USART Configurations
+ *
+ * Author: Momen Elsayed Shaban
+ *
+ *******************************************************************************/
+#ifndef FRAME_CFG_H_
+#define FRAME_CFG_H_
+
+#define FRAME_MAX_SIZE          256     /*Largest decoded frame, longer frames are dropped*/
+#define FRAME_TX_SLOTS          2       /*Frames in flight per channel*/
+#define FRAME_MAX_SEGMENTS      32      /*Gather segments of a frame: 2 per zero byte (or 254 byte run) + 3, frames
+                                          needing more are encoded into the slot buffer*/
+
+enum{
+    FRAME_Link,
+    _FRAME_NUM      /*Total Number of framed channels*/
+};
+
+#endif /*FRAME_CFG_H_*/
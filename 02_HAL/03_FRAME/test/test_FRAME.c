@@ -0,0 +1,339 @@
+#ifdef TEST
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "unity.h"
+#include "USART.h"
+#include "USART_TestSupport.h"
+#include "FRAME.h"
+#include "mock_DMA.h"
+#include "mock_GPIO.h"
+
+#define LOOPBACK_PROCESS_PERIOD         64      /*Bytes on the line between two FRAME_process calls*/
+
+const USART_Cfg_t USART_Cfg[_USART_Num] = {
+    [USART1] = {USART_TEST_CFG_8N1(USART_NUMBER_1, 9600)}
+};
+
+const FRAME_Cfg_t FRAMES[_FRAME_NUM] = {
+    [FRAME_Link] = {.USART_Number = USART_NUMBER_1}
+};
+
+static u8 wire[1024];
+static u32 wireLen;
+static u8 received[FRAME_MAX_SIZE];
+static u16 receivedLength;
+static u32 rxCallBackCount;
+static u32 txCallBackCount;
+
+static void FRAME_TestRxCallBack(u8 Channel, const u8* Frame, u16 Length, void* Context)
+{
+    memcpy(received, Frame, Length);
+    receivedLength = Length;
+    rxCallBackCount++;
+}
+
+static void FRAME_TestRxDone(const USART_Completion_t* Completion)
+{
+    (void)Completion;
+}
+
+static void FRAME_TestTxCallBack(u8 Channel, void* Context)
+{
+    txCallBackCount++;
+}
+
+/*Simulated loopback: every byte the transmit interrupt writes to DR comes back on the receiver*/
+static void FRAME_SimulateLoopback(void)
+{
+    u32 bytes = 0;
+    u16 word = 0;
+    boolean written = FALSE;
+    while((USART_MockRegisters[USART_NUMBER_1].CR1 & USART_TXEIE_ENABLE) && (bytes < 100000))
+    {
+        written = USART_SimulateTxe(USART_NUMBER_1, &word);
+        /*The receive interrupt of the looped back byte must not send the next one*/
+        USART_MockRegisters[USART_NUMBER_1].SR &= ~USART_SR_TXE;
+        if(written == TRUE)
+        {
+            if(wireLen < sizeof(wire))
+            {
+                wire[wireLen++] = (u8)word;
+            }
+            USART_SimulateRxWord(USART_NUMBER_1, word, 0);
+            bytes++;
+            if((bytes % LOOPBACK_PROCESS_PERIOD) == 0)
+            {
+                FRAME_process(FRAME_Link);
+            }
+        }
+    }
+    FRAME_process(FRAME_Link);
+}
+
+/*Simulated line noise or a peer: raw bytes straight into the receiver*/
+static void FRAME_SimulateRx(const u8* Data, u32 Length)
+{
+    USART_SimulateRx(USART_NUMBER_1, Data, Length, 0);
+}
+
+void setUp(void)
+{
+    USART_stopContinuousRx(USART_NUMBER_1);
+    memset(USART_MockRegisters, 0, sizeof(USART_MockRegisters));
+    memset(wire, 0, sizeof(wire));
+    wireLen = 0;
+    receivedLength = 0;
+    rxCallBackCount = 0;
+    txCallBackCount = 0;
+    USART_init();
+    FRAME_Init();
+    FRAME_setRxCallBack(FRAME_Link, FRAME_TestRxCallBack, NULL_PTR);
+}
+
+void tearDown(void)
+{
+}
+
+void test_FRAME_Init_reportsTheUsartFailure(void)
+{
+    u8 data[4];
+    USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = data, .length = sizeof(data), .CB = FRAME_TestRxDone};
+    USART_stopContinuousRx(USART_NUMBER_1);
+    TEST_ASSERT_EQUAL(USART_OK, USART_recieveBufferAsyncZC(Req));
+    TEST_ASSERT_EQUAL(FRAME_UsartError, FRAME_Init());
+    FRAME_SimulateRx(data, sizeof(data));
+    TEST_ASSERT_EQUAL(FRAME_OK, FRAME_Init());
+}
+
+void test_FRAME_send_encodesCOBS(void)
+{
+    const u8 data[] = {0x11, 0x22, 0x00, 0x33};
+    TEST_ASSERT_EQUAL(FRAME_OK, FRAME_send(FRAME_Link, data, sizeof(data), FRAME_TestTxCallBack, NULL_PTR));
+    FRAME_SimulateLoopback();
+    TEST_ASSERT_EQUAL(6, wireLen);
+    TEST_ASSERT_EQUAL_MEMORY("\x03\x11\x22\x02\x33\x00", wire, 6);
+    TEST_ASSERT_EQUAL(1, txCallBackCount);
+    TEST_ASSERT_EQUAL(1, rxCallBackCount);
+    TEST_ASSERT_EQUAL(sizeof(data), receivedLength);
+    TEST_ASSERT_EQUAL_MEMORY(data, received, sizeof(data));
+}
+
+void test_FRAME_send_zerosOnly(void)
+{
+    const u8 data[] = {0x00, 0x00};
+    TEST_ASSERT_EQUAL(FRAME_OK, FRAME_send(FRAME_Link, data, sizeof(data), NULL_PTR, NULL_PTR));
+    FRAME_SimulateLoopback();
+    TEST_ASSERT_EQUAL_MEMORY("\x01\x01\x01\x00", wire, 4);
+    TEST_ASSERT_EQUAL(2, receivedLength);
+    TEST_ASSERT_EQUAL_MEMORY(data, received, 2);
+}
+
+void test_FRAME_send_longRunUsesMaxCode(void)
+{
+    u8 data[FRAME_MAX_SIZE];
+    u16 idx = 0;
+    for(idx = 0; idx < sizeof(data); idx++)
+    {
+        data[idx] = (u8)((idx % 255) + 1);
+    }
+    TEST_ASSERT_EQUAL(FRAME_OK, FRAME_send(FRAME_Link, data, 254, NULL_PTR, NULL_PTR));
+    FRAME_SimulateLoopback();
+    TEST_ASSERT_EQUAL(257, wireLen);
+    TEST_ASSERT_EQUAL(0xFF, wire[0]);
+    TEST_ASSERT_EQUAL(0x01, wire[255]);
+    TEST_ASSERT_EQUAL(254, receivedLength);
+    TEST_ASSERT_EQUAL_MEMORY(data, received, 254);
+    wireLen = 0;
+    TEST_ASSERT_EQUAL(FRAME_OK, FRAME_send(FRAME_Link, data, sizeof(data), NULL_PTR, NULL_PTR));
+    FRAME_SimulateLoopback();
+    TEST_ASSERT_EQUAL(sizeof(data), receivedLength);
+    TEST_ASSERT_EQUAL_MEMORY(data, received, sizeof(data));
+}
+
+void test_FRAME_send_invalidArguments(void)
+{
+    u8 zeros[FRAME_MAX_SIZE + 1] = {0};
+    TEST_ASSERT_EQUAL(FRAME_NullPtr, FRAME_send(FRAME_Link, NULL_PTR, 1, NULL_PTR, NULL_PTR));
+    TEST_ASSERT_EQUAL(FRAME_InvalidChannel, FRAME_send(_FRAME_NUM, zeros, 1, NULL_PTR, NULL_PTR));
+    TEST_ASSERT_EQUAL(FRAME_InvalidLength, FRAME_send(FRAME_Link, zeros, 0, NULL_PTR, NULL_PTR));
+    TEST_ASSERT_EQUAL(FRAME_TooManySegments, FRAME_send(FRAME_Link, zeros, sizeof(zeros), NULL_PTR, NULL_PTR));
+}
+
+void test_FRAME_send_denseZerosEncodedIntoTheSlot(void)
+{
+    u8 data[FRAME_MAX_SEGMENTS] = {0};
+    data[1] = 0x11;
+    TEST_ASSERT_EQUAL(FRAME_OK, FRAME_send(FRAME_Link, data, sizeof(data), FRAME_TestTxCallBack, NULL_PTR));
+    FRAME_SimulateLoopback();
+    TEST_ASSERT_EQUAL(sizeof(data) + 2, wireLen);
+    TEST_ASSERT_EQUAL_MEMORY("\x01\x02\x11\x01\x01", wire, 5);
+    TEST_ASSERT_EQUAL(0, wire[wireLen - 1]);
+    TEST_ASSERT_EQUAL(1, txCallBackCount);
+    TEST_ASSERT_EQUAL(sizeof(data), receivedLength);
+    TEST_ASSERT_EQUAL_MEMORY(data, received, sizeof(data));
+}
+
+void test_FRAME_send_slotsFull(void)
+{
+    const u8 data[] = "a";
+    u8 idx = 0;
+    for(idx = 0; idx < FRAME_TX_SLOTS; idx++)
+    {
+        TEST_ASSERT_EQUAL(FRAME_OK, FRAME_send(FRAME_Link, data, 1, FRAME_TestTxCallBack, NULL_PTR));
+    }
+    TEST_ASSERT_EQUAL(FRAME_Busy, FRAME_send(FRAME_Link, data, 1, FRAME_TestTxCallBack, NULL_PTR));
+    FRAME_SimulateLoopback();
+    TEST_ASSERT_EQUAL(FRAME_TX_SLOTS, txCallBackCount);
+    TEST_ASSERT_EQUAL(FRAME_TX_SLOTS, rxCallBackCount);
+    TEST_ASSERT_EQUAL(FRAME_OK, FRAME_send(FRAME_Link, data, 1, FRAME_TestTxCallBack, NULL_PTR));
+    FRAME_SimulateLoopback();
+}
+
+void test_FRAME_process_dropsMalformedAndTooLong(void)
+{
+    FRAME_Stats_t before;
+    FRAME_Stats_t after;
+    u8 tooLong[FRAME_MAX_SIZE + 4];    /*Well-formed, decodes to FRAME_MAX_SIZE + 1 bytes*/
+    memset(tooLong, 0x55, sizeof(tooLong));
+    tooLong[0] = 0xFF;
+    tooLong[255] = 0x04;
+    tooLong[sizeof(tooLong) - 1] = 0x00;
+    FRAME_getStats(FRAME_Link, &before);
+    FRAME_SimulateRx((const u8*)"\x05\x11\x22\x00", 4);        /*Truncated block*/
+    FRAME_process(FRAME_Link);
+    FRAME_SimulateRx(tooLong, 130);
+    FRAME_process(FRAME_Link);
+    FRAME_SimulateRx(&tooLong[130], sizeof(tooLong) - 130);
+    FRAME_process(FRAME_Link);
+    FRAME_SimulateRx((const u8*)"\x00\x00\x02\x42\x00", 5);    /*Empty frames then a good one*/
+    FRAME_process(FRAME_Link);
+    FRAME_getStats(FRAME_Link, &after);
+    TEST_ASSERT_EQUAL(2, after.framesDropped - before.framesDropped);
+    TEST_ASSERT_EQUAL(1, after.framesReceived - before.framesReceived);
+    TEST_ASSERT_EQUAL(1, rxCallBackCount);
+    TEST_ASSERT_EQUAL(1, receivedLength);
+    TEST_ASSERT_EQUAL(0x42, received[0]);
+}
+
+void test_FRAME_decodeInPlace(void)
+{
+    u8 frame[] = {0x03, 0x11, 0x22, 0x02, 0x33, 0x00, 0x99};
+    u8 truncated[] = {0x04, 0x11, 0x22};
+    u16 decoded = 0;
+    TEST_ASSERT_EQUAL(FRAME_OK, FRAME_decodeInPlace(frame, sizeof(frame), &decoded));
+    TEST_ASSERT_EQUAL(4, decoded);
+    TEST_ASSERT_EQUAL_MEMORY("\x11\x22\x00\x33", frame, 4);
+    TEST_ASSERT_EQUAL(FRAME_InvalidFrame, FRAME_decodeInPlace(truncated, sizeof(truncated), &decoded));
+    TEST_ASSERT_EQUAL(FRAME_NullPtr, FRAME_decodeInPlace(NULL_PTR, 1, &decoded));
+}
+
+/*Random frames with random zeros (within FRAME_MAX_SEGMENTS) must come back unchanged through the loopback*/
+void test_FRAME_fuzz_loopbackRoundTrip(void)
+{
+    u8 data[FRAME_MAX_SIZE];
+    u16 length = 0;
+    u16 zeros = 0;
+    u16 idx = 0;
+    u32 iteration = 0;
+    srand(42);
+    for(iteration = 0; iteration < 2000; iteration++)
+    {
+        length = (u16)((rand() % FRAME_MAX_SIZE) + 1);
+        zeros = (u16)(rand() % ((FRAME_MAX_SEGMENTS / 2) - 3));
+        for(idx = 0; idx < length; idx++)
+        {
+            data[idx] = (u8)((rand() % 255) + 1);
+        }
+        for(idx = 0; idx < zeros; idx++)
+        {
+            data[rand() % length] = 0;
+        }
+        wireLen = 0;
+        receivedLength = 0;
+        TEST_ASSERT_EQUAL(FRAME_OK, FRAME_send(FRAME_Link, data, length, NULL_PTR, NULL_PTR));
+        FRAME_SimulateLoopback();
+        TEST_ASSERT_EQUAL(iteration + 1, rxCallBackCount);
+        TEST_ASSERT_EQUAL(length, receivedLength);
+        TEST_ASSERT_EQUAL_MEMORY(data, received, length);
+        TEST_ASSERT_EQUAL(0, wire[wireLen - 1]);
+        TEST_ASSERT_EQUAL_PTR(NULL_PTR, memchr(wire, 0, wireLen - 1));
+    }
+}
+
+/*Frames of up to FRAME_MAX_SIZE zeros, most beyond FRAME_MAX_SEGMENTS, must come back unchanged too*/
+void test_FRAME_fuzz_denseZerosRoundTrip(void)
+{
+    u8 data[FRAME_MAX_SIZE];
+    u16 length = 0;
+    u16 idx = 0;
+    u32 iteration = 0;
+    srand(1234);
+    for(iteration = 0; iteration < 2000; iteration++)
+    {
+        length = (u16)((rand() % FRAME_MAX_SIZE) + 1);
+        for(idx = 0; idx < length; idx++)
+        {
+            data[idx] = (rand() % 2 == 0) ? 0 : (u8)((rand() % 255) + 1);
+        }
+        wireLen = 0;
+        receivedLength = 0;
+        TEST_ASSERT_EQUAL(FRAME_OK, FRAME_send(FRAME_Link, data, length, NULL_PTR, NULL_PTR));
+        FRAME_SimulateLoopback();
+        TEST_ASSERT_EQUAL(iteration + 1, rxCallBackCount);
+        TEST_ASSERT_EQUAL(length, receivedLength);
+        TEST_ASSERT_EQUAL_MEMORY(data, received, length);
+        TEST_ASSERT_EQUAL(0, wire[wireLen - 1]);
+        TEST_ASSERT_EQUAL_PTR(NULL_PTR, memchr(wire, 0, wireLen - 1));
+    }
+}
+
+/*Random line noise must never crash the decoder or deliver a frame above FRAME_MAX_SIZE*/
+void test_FRAME_fuzz_noise(void)
+{
+    u8 noise[97];
+    u32 iteration = 0;
+    u16 idx = 0;
+    srand(7);
+    for(iteration = 0; iteration < 500; iteration++)
+    {
+        for(idx = 0; idx < sizeof(noise); idx++)
+        {
+            noise[idx] = (rand() % 8 == 0) ? 0 : (u8)rand();
+        }
+        FRAME_SimulateRx(noise, sizeof(noise));
+        FRAME_process(FRAME_Link);
+        TEST_ASSERT_TRUE(receivedLength <= FRAME_MAX_SIZE);
+    }
+}
+
+/*Host throughput of the encode, interrupt loopback and decode path, reported on the test output*/
+void test_FRAME_throughput_loopback(void)
+{
+    u8 data[FRAME_MAX_SIZE];
+    char message[96];
+    u32 frames = 0;
+    u16 idx = 0;
+    clock_t start = 0;
+    double seconds = 0;
+    for(idx = 0; idx < sizeof(data); idx++)
+    {
+        data[idx] = (idx % 32 == 0) ? 0 : (u8)idx;
+    }
+    start = clock();
+    for(frames = 0; frames < 5000; frames++)
+    {
+        wireLen = 0;
+        FRAME_send(FRAME_Link, data, sizeof(data), NULL_PTR, NULL_PTR);
+        FRAME_SimulateLoopback();
+    }
+    seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    TEST_ASSERT_EQUAL(5000, rxCallBackCount);
+    snprintf(message, sizeof(message), "FRAME loopback: %.1f MB/s payload (%u frames of %u bytes)",
+             (seconds > 0) ? ((double)frames * sizeof(data) / seconds / 1e6) : 0.0, (unsigned)frames, (unsigned)sizeof(data));
+    TEST_MESSAGE(message);
+}
+
+#endif // TEST
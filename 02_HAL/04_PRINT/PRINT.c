@@ -0,0 +1,461 @@
+/******************************************************************************
+ *
+ * Module: PRINT
+ *
+ * File Name: PRINT.c
+ *
+ * Description: Source file for the heap free formatted output over USART for STM32F401xC
+ *
+ * Author: Momen Elsayed Shaban
+ *
+ *******************************************************************************/
+#include <stdarg.h>
+#include "USART.h"
+#include "PRINT.h"
+
+#define PRINT_FLAG_LEFT             0x01U
+#define PRINT_FLAG_ZERO             0x02U
+#define PRINT_FLAG_PLUS             0x04U
+#define PRINT_FLAG_UPPER            0x08U
+#define PRINT_LENGTH_INT            0U
+#define PRINT_LENGTH_LONG           1U
+#define PRINT_LENGTH_LONG_LONG      2U
+#define PRINT_DEFAULT_DECIMALS      6U
+#define PRINT_MAX_DECIMALS          9U
+#define PRINT_NUMBER_DIGITS         24      /*u64 in decimal (20 digits) and a fraction separator*/
+
+#if (PRINT_CHUNKS == 0) || (PRINT_CHUNKS > USART_TX_QUEUE_SIZE)
+#error "PRINT_CHUNKS must be 1 to USART_TX_QUEUE_SIZE"
+#endif
+
+/*******************************************************************************
+ *                                   Types                                     *
+ *******************************************************************************/
+typedef struct PRINT_Out PRINT_Out_t;
+
+/*Called with a full buffer, gives the output its next buffer (size 0 when there's none)*/
+typedef void (*PRINT_Flush_t)(PRINT_Out_t* Out);
+
+struct PRINT_Out{
+    char* buffer;
+    u16 size;
+    u16 pos;
+    u32 dropped;
+    PRINT_Flush_t flush;
+    s8 chunk;           /*Chunk held by a PRINT_printf output, -1 if none*/
+};
+
+/*******************************************************************************
+ *                                 Variables                                   *
+ *******************************************************************************/
+static const char PRINT_DigitsLower[] = "0123456789abcdef";
+static const char PRINT_DigitsUpper[] = "0123456789ABCDEF";
+
+#if (PRINT_FLOAT == PRINT_FLOAT_ENABLE)
+static const u32 PRINT_Pow10[PRINT_MAX_DECIMALS + 1] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000,
+                                                        100000000, 1000000000};
+#endif
+
+static char Print_Chunks[PRINT_CHUNKS][PRINT_CHUNK_SIZE];
+static volatile boolean Print_ChunkBusy[PRINT_CHUNKS];
+static volatile u32 Print_Dropped;
+
+/*******************************************************************************
+ *                              Static Functions                               *
+ *******************************************************************************/
+static void PRINT_putChar(PRINT_Out_t* Out, char Char)
+{
+    if((Out->pos == Out->size) && (Out->flush != NULL_PTR))
+    {
+        Out->flush(Out);
+    }
+    if(Out->pos < Out->size)
+    {
+        Out->buffer[Out->pos] = Char;
+        Out->pos++;
+    }
+    else
+    {
+        Out->dropped++;
+    }
+}
+
+static void PRINT_putRepeated(PRINT_Out_t* Out, char Char, u32 Count)
+{
+    for(; Count > 0; Count--)
+    {
+        PRINT_putChar(Out, Char);
+    }
+}
+
+/*Prints Prefix (sign or "0x") and Body padded to Width as the flags ask*/
+static void PRINT_putField(PRINT_Out_t* Out, const char* Prefix, const char* Body, u32 BodyLength, u32 Width, u8 Flags)
+{
+    u32 prefixLength = 0;
+    u32 padding = 0;
+    u32 idx = 0;
+    while(Prefix[prefixLength] != '\0')
+    {
+        prefixLength++;
+    }
+    padding = (Width > (prefixLength + BodyLength)) ? (Width - prefixLength - BodyLength) : 0;
+    if((Flags & (PRINT_FLAG_LEFT | PRINT_FLAG_ZERO)) == 0)
+    {
+        PRINT_putRepeated(Out, ' ', padding);
+    }
+    for(idx = 0; idx < prefixLength; idx++)
+    {
+        PRINT_putChar(Out, Prefix[idx]);
+    }
+    if((Flags & (PRINT_FLAG_LEFT | PRINT_FLAG_ZERO)) == PRINT_FLAG_ZERO)
+    {
+        PRINT_putRepeated(Out, '0', padding);
+    }
+    for(idx = 0; idx < BodyLength; idx++)
+    {
+        PRINT_putChar(Out, Body[idx]);
+    }
+    if(Flags & PRINT_FLAG_LEFT)
+    {
+        PRINT_putRepeated(Out, ' ', padding);
+    }
+}
+
+/*Writes Value backwards ending at End, returns the first digit, 32-bit values skip the 64-bit division*/
+static char* PRINT_convert(char* End, u64 Value, u8 Base, u8 Flags)
+{
+    const char* digits = (Flags & PRINT_FLAG_UPPER) ? PRINT_DigitsUpper : PRINT_DigitsLower;
+    u32 value32 = 0;
+    while(Value > 0xFFFFFFFFULL)
+    {
+        End--;
+        *End = digits[Value % Base];
+        Value /= Base;
+    }
+    value32 = (u32)Value;
+    do
+    {
+        End--;
+        *End = digits[value32 % Base];
+        value32 /= Base;
+    }while(value32 != 0);
+    return End;
+}
+
+static void PRINT_putNumber(PRINT_Out_t* Out, u64 Value, const char* Prefix, u8 Base, u32 Width, u8 Flags)
+{
+    char text[PRINT_NUMBER_DIGITS];
+    char* const end = &text[PRINT_NUMBER_DIGITS];
+    char* first = PRINT_convert(end, Value, Base, Flags);
+    PRINT_putField(Out, Prefix, first, (u32)(end - first), Width, Flags);
+}
+
+static const char* PRINT_signPrefix(boolean Negative, u8 Flags)
+{
+    return Negative ? "-" : ((Flags & PRINT_FLAG_PLUS) ? "+" : "");
+}
+
+#if (PRINT_FLOAT == PRINT_FLOAT_ENABLE)
+/*Scales the fraction to an integer of Decimals digits rounded half away from zero, no libm needed*/
+static void PRINT_putFloat(PRINT_Out_t* Out, f64 Value, u32 Decimals, u32 Width, u8 Flags)
+{
+    char text[PRINT_NUMBER_DIGITS + PRINT_MAX_DECIMALS];
+    char* const end = &text[sizeof(text)];
+    char* first = end;
+    boolean negative = (Value < 0) ? TRUE : FALSE;
+    u64 integer = 0;
+    u32 fraction = 0;
+    u32 idx = 0;
+    if(negative == TRUE)
+    {
+        Value = -Value;
+    }
+    if(!(Value < 18446744073709551615.0))       /*Too large or NaN*/
+    {
+        PRINT_putField(Out, "", "ovf", 3, Width, Flags & ~PRINT_FLAG_ZERO);
+    }
+    else
+    {
+        integer = (u64)Value;
+        fraction = (u32)(((Value - (f64)integer) * PRINT_Pow10[Decimals]) + 0.5);
+        if(fraction >= PRINT_Pow10[Decimals])
+        {
+            integer++;
+            fraction -= PRINT_Pow10[Decimals];
+        }
+        if(Decimals > 0)
+        {
+            for(idx = 0; idx < Decimals; idx++)
+            {
+                first--;
+                *first = (char)('0' + (fraction % 10));
+                fraction /= 10;
+            }
+            first--;
+            *first = '.';
+        }
+        first = PRINT_convert(first, integer, 10, Flags);
+        PRINT_putField(Out, PRINT_signPrefix(negative, Flags), first, (u32)(end - first), Width, Flags);
+    }
+}
+#endif
+
+/*Reads a width or precision: digits or '*' taken from the arguments*/
+static const char* PRINT_parseNumber(const char* Format, va_list* Args, u32* Number)
+{
+    s32 argument = 0;
+    *Number = 0;
+    if(*Format == '*')
+    {
+        argument = va_arg(*Args, int);
+        *Number = (argument > 0) ? (u32)argument : 0;
+        Format++;
+    }
+    else
+    {
+        while((*Format >= '0') && (*Format <= '9'))
+        {
+            *Number = (*Number * 10) + (u32)(*Format - '0');
+            Format++;
+        }
+    }
+    return Format;
+}
+
+/*Returns FALSE if it stopped at a conversion outside the subset, its arguments can't be skipped safely*/
+static boolean PRINT_formatArgs(PRINT_Out_t* Out, const char* Format, va_list* Args)
+{
+    boolean supported = TRUE;
+    u8 flags = 0;
+    u8 length = PRINT_LENGTH_INT;
+    u32 width = 0;
+    u32 precision = 0;
+    boolean hasPrecision = FALSE;
+    s64 signedValue = 0;
+    u64 value = 0;
+    const char* text = NULL_PTR;
+    u32 textLength = 0;
+    char character = 0;
+    while((*Format != '\0') && (supported == TRUE))
+    {
+        if(*Format != '%')
+        {
+            PRINT_putChar(Out, *Format);
+            Format++;
+            continue;
+        }
+        Format++;
+        flags = 0;
+        length = PRINT_LENGTH_INT;
+        hasPrecision = FALSE;
+        for(; (*Format == '-') || (*Format == '0') || (*Format == '+'); Format++)
+        {
+            flags |= (*Format == '-') ? PRINT_FLAG_LEFT : ((*Format == '0') ? PRINT_FLAG_ZERO : PRINT_FLAG_PLUS);
+        }
+        Format = PRINT_parseNumber(Format, Args, &width);
+        if(*Format == '.')
+        {
+            hasPrecision = TRUE;
+            Format = PRINT_parseNumber(Format + 1, Args, &precision);
+        }
+        for(; (*Format == 'l') || (*Format == 'h'); Format++)
+        {
+            /*Shorter types are promoted to int, only the long ones change the argument*/
+            length += (*Format == 'l') ? 1 : 0;
+        }
+        if((hasPrecision == TRUE) && (*Format != 's') && (*Format != 'f'))
+        {
+            supported = FALSE;      /*The precision of the integers (least digits) isn't in the subset*/
+        }
+        else
+        {
+            switch(*Format)
+            {
+                case 'd':
+                case 'i':
+                    signedValue = (length == PRINT_LENGTH_INT) ? va_arg(*Args, int) :
+                                  ((length == PRINT_LENGTH_LONG) ? va_arg(*Args, long) : va_arg(*Args, long long));
+                    value = (signedValue < 0) ? ((u64)0 - (u64)signedValue) : (u64)signedValue;
+                    PRINT_putNumber(Out, value, PRINT_signPrefix((signedValue < 0) ? TRUE : FALSE, flags), 10, width, flags);
+                    break;
+                case 'u':
+                case 'x':
+                case 'X':
+                    value = (length == PRINT_LENGTH_INT) ? va_arg(*Args, unsigned int) :
+                            ((length == PRINT_LENGTH_LONG) ? va_arg(*Args, unsigned long) : va_arg(*Args, unsigned long long));
+                    flags |= (*Format == 'X') ? PRINT_FLAG_UPPER : 0;
+                    PRINT_putNumber(Out, value, "", (*Format == 'u') ? 10 : 16, width, flags);
+                    break;
+                case 'p':
+                    value = (u64)(unsigned long)va_arg(*Args, void*);
+                    PRINT_putNumber(Out, value, "0x", 16, width, flags);
+                    break;
+                case 'c':
+                    character = (char)va_arg(*Args, int);
+                    PRINT_putField(Out, "", &character, 1, width, flags & ~PRINT_FLAG_ZERO);
+                    break;
+                case 's':
+                    text = va_arg(*Args, const char*);
+                    text = (text == NULL_PTR) ? "(null)" : text;
+                    for(textLength = 0; (text[textLength] != '\0') && ((hasPrecision == FALSE) || (textLength < precision));
+                        textLength++)
+                    {
+                    }
+                    PRINT_putField(Out, "", text, textLength, width, flags & ~PRINT_FLAG_ZERO);
+                    break;
+#if (PRINT_FLOAT == PRINT_FLOAT_ENABLE)
+                case 'f':
+                    PRINT_putFloat(Out, va_arg(*Args, double),
+                                   (hasPrecision == FALSE) ? PRINT_DEFAULT_DECIMALS :
+                                   ((precision > PRINT_MAX_DECIMALS) ? PRINT_MAX_DECIMALS : precision), width, flags);
+                    break;
+#endif
+                case '%':
+                    PRINT_putChar(Out, '%');
+                    break;
+                case '\0':
+                    Format--;       /*A lone '%' ends the format*/
+                    break;
+                default:
+                    /*Other flags, lengths and conversions, %f with PRINT_FLOAT disabled*/
+                    supported = FALSE;
+                    break;
+            }
+        }
+        Format++;
+    }
+    return supported;
+}
+
+static s8 PRINT_acquireChunk(void)
+{
+    s8 chunk = -1;
+    u8 idx = 0;
+    for(idx = 0; (idx < PRINT_CHUNKS) && (chunk < 0); idx++)
+    {
+        if(Print_ChunkBusy[idx] == FALSE)
+        {
+            Print_ChunkBusy[idx] = TRUE;
+            chunk = (s8)idx;
+        }
+    }
+    return chunk;
+}
+
+static void PRINT_ChunkSent(const USART_Completion_t* Completion)
+{
+    Print_ChunkBusy[(char(*)[PRINT_CHUNK_SIZE])Completion->Context - Print_Chunks] = FALSE;
+}
+
+/*Posts the filled part of the held chunk, a chunk the queue refuses is dropped*/
+static void PRINT_postChunk(PRINT_Out_t* Out)
+{
+    USART_Req_t Req;
+    if(Out->chunk >= 0)
+    {
+        if(Out->pos > 0)
+        {
+            Req.USART_Number = PRINT_USART_NUMBER;
+            Req.data = (u8*)Print_Chunks[Out->chunk];
+            Req.length = Out->pos;
+            Req.CB = PRINT_ChunkSent;
+            Req.HalfCB = NULL_PTR;
+            Req.frame = FALSE;
+            Req.Context = &Print_Chunks[Out->chunk];
+            if(USART_sendBufferAsyncZC(Req) != USART_OK)
+            {
+                Out->dropped += Out->pos;
+                Print_ChunkBusy[Out->chunk] = FALSE;
+            }
+        }
+        else
+        {
+            Print_ChunkBusy[Out->chunk] = FALSE;
+        }
+        Out->chunk = -1;
+    }
+}
+
+static void PRINT_nextChunk(PRINT_Out_t* Out)
+{
+    PRINT_postChunk(Out);
+    Out->chunk = PRINT_acquireChunk();
+    Out->buffer = (Out->chunk >= 0) ? Print_Chunks[Out->chunk] : NULL_PTR;
+    Out->size = (Out->chunk >= 0) ? PRINT_CHUNK_SIZE : 0;
+    Out->pos = 0;
+}
+
+/*******************************************************************************
+ *                         Functions Implementation                            *
+ *******************************************************************************/
+PRINT_ErrorStatus_t PRINT_printf(const char* Format, ...)
+{
+    PRINT_ErrorStatus_t Error_Status = PRINT_OK;
+    PRINT_Out_t Out = {.buffer = NULL_PTR, .size = 0, .pos = 0, .dropped = 0, .flush = PRINT_nextChunk, .chunk = -1};
+    boolean supported = TRUE;
+    va_list Args;
+    if(Format == NULL_PTR)
+    {
+        Error_Status = PRINT_NullPtr;
+    }
+    else
+    {
+        va_start(Args, Format);
+        supported = PRINT_formatArgs(&Out, Format, &Args);
+        va_end(Args);
+        PRINT_postChunk(&Out);
+        if(Out.dropped > 0)
+        {
+            Print_Dropped += Out.dropped;
+            Error_Status = PRINT_Truncated;
+        }
+        if(supported == FALSE)
+        {
+            Error_Status = PRINT_Unsupported;
+        }
+    }
+    return Error_Status;
+}
+
+PRINT_ErrorStatus_t PRINT_format(char* Buffer, u16 Size, u16* Length, const char* Format, ...)
+{
+    PRINT_ErrorStatus_t Error_Status = PRINT_OK;
+    PRINT_Out_t Out = {.buffer = Buffer, .size = (Size > 0) ? (Size - 1) : 0, .pos = 0, .dropped = 0,
+                       .flush = NULL_PTR, .chunk = -1};
+    boolean supported = TRUE;
+    va_list Args;
+    if((Buffer == NULL_PTR) || (Format == NULL_PTR))
+    {
+        Error_Status = PRINT_NullPtr;
+    }
+    else
+    {
+        va_start(Args, Format);
+        supported = PRINT_formatArgs(&Out, Format, &Args);
+        va_end(Args);
+        if(Size > 0)
+        {
+            Buffer[Out.pos] = '\0';
+        }
+        if(Length != NULL_PTR)
+        {
+            *Length = Out.pos;
+        }
+        Error_Status = (supported == FALSE) ? PRINT_Unsupported : ((Out.dropped > 0) ? PRINT_Truncated : PRINT_OK);
+    }
+    return Error_Status;
+}
+
+PRINT_ErrorStatus_t PRINT_getDropped(u32* Dropped)
+{
+    PRINT_ErrorStatus_t Error_Status = PRINT_OK;
+    if(Dropped == NULL_PTR)
+    {
+        Error_Status = PRINT_NullPtr;
+    }
+    else
+    {
+        *Dropped = Print_Dropped;
+    }
+    return Error_Status;
+}
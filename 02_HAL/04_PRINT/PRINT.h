@@ -0,0 +1,86 @@
+/******************************************************************************
+ *
+ * Module: PRINT
+ *
+ * File Name: PRINT.h
+ *
+ * Description: Header file for the heap free formatted output over USART for STM32F401xC
+ *
+ * Author: Momen Elsayed Shaban
+ *
+ *******************************************************************************/
+#ifndef PRINT_H_
+#define PRINT_H_
+
+#include "PRINT_Cfg.h"
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Type Decelerations                           *
+ *******************************************************************************/
+/*
+ * Supported Format:
+ * -----------------
+ * %[flags][width][.precision][length]conversion
+ *   - flags: '-' left align, '0' zero pad, '+' sign of positive numbers.
+ *   - width and precision: digits or '*'. The precision is the decimals of %f (6 by default, up to 9) and
+ *     the most characters of %s, the other conversions take none.
+ *   - length: hh, h, l, ll.
+ *   - conversion: d i u x X c s p f %.
+ * %f rounds exact halves away from zero (the C library rounds them to even) and prints "ovf" from 2^64 up.
+ * The formats are checked at compile time like printf's. Formatting stops at the first flag, length or
+ * conversion outside the subset (and at %f with PRINT_FLOAT disabled) and reports PRINT_Unsupported, the
+ * arguments of such a conversion can't be skipped without taking them the C library way.
+ */
+#if defined(__GNUC__)
+#define PRINT_FORMAT_CHECK(FORMAT, FIRST_ARG)   __attribute__((format(printf, FORMAT, FIRST_ARG)))
+#else
+#define PRINT_FORMAT_CHECK(FORMAT, FIRST_ARG)
+#endif
+
+typedef enum{
+    PRINT_OK,
+    PRINT_NullPtr,
+    PRINT_Truncated,    /*The buffer or the free chunks were too short, the rest was dropped*/
+    PRINT_Unsupported   /*Stopped at a conversion outside the supported format, the output ends before it*/
+}PRINT_ErrorStatus_t;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/*****************************************************
+ * Function: PRINT_printf
+ * Description: Formats straight into PRINT_CHUNK_SIZE chunks, each full chunk is posted to the
+ *              PRINT_USART_NUMBER transmit queue while the next one is filled, the last one when the format ends.
+ *
+ * Return:
+ *   - PRINT_OK, PRINT_NullPtr, PRINT_Truncated if no chunk was free or the USART queue was full, the
+ *     dropped characters are counted (PRINT_getDropped), or PRINT_Unsupported (the output before the
+ *     conversion is sent).
+ *
+ * Notes:
+ *   - Never blocks and never allocates, the chunks are freed by the USART transmit interrupt.
+ *   - Call it from the thread context only, like USART_sendBufferAsyncZC.
+ *****************************************************/
+PRINT_ErrorStatus_t PRINT_printf(const char* Format, ...) PRINT_FORMAT_CHECK(1, 2);
+
+/*****************************************************
+ * Function: PRINT_format
+ * Description: Formats into Buffer, always terminated by '\0' when Size isn't 0.
+ *
+ * Parameters:
+ *   - Length: Optional, receives the written characters without the terminator.
+ *
+ * Return:
+ *   - PRINT_OK, PRINT_NullPtr, PRINT_Truncated or PRINT_Unsupported (Buffer holds the output before the
+ *     conversion).
+ *****************************************************/
+PRINT_ErrorStatus_t PRINT_format(char* Buffer, u16 Size, u16* Length, const char* Format, ...) PRINT_FORMAT_CHECK(4, 5);
+
+/*****************************************************
+ * Function: PRINT_getDropped
+ * Description: Reads how many PRINT_printf characters were dropped since startup.
+ *****************************************************/
+PRINT_ErrorStatus_t PRINT_getDropped(u32* Dropped);
+
+#endif /*PRINT_H_*/
@@ -0,0 +1,23 @@
+/******************************************************************************
+ *
+ * Module: PRINT
+ *
+ * File Name: PRINT_Cfg.h
+ *
+ * Description: Header file for the USART formatted output Configurations
+ *
+ * Author: Momen Elsayed Shaban
+ *
+ *******************************************************************************/
+#ifndef PRINT_CFG_H_
+#define PRINT_CFG_H_
+
+#define PRINT_USART_NUMBER      USART_NUMBER_1  /*Instance receiving PRINT_printf output*/
+#define PRINT_CHUNK_SIZE        32              /*Characters per USART transmit request*/
+#define PRINT_CHUNKS            4               /*Chunks in flight, at most USART_TX_QUEUE_SIZE*/
+
+#define PRINT_FLOAT_DISABLE     0
+#define PRINT_FLOAT_ENABLE      1
+#define PRINT_FLOAT             PRINT_FLOAT_ENABLE  /*%f support, disable it to save code size*/
+
+#endif /*PRINT_CFG_H_*/
@@ -0,0 +1,178 @@
+#ifdef TEST
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "unity.h"
+#include "USART.h"
+#include "USART_TestSupport.h"
+#include "PRINT.h"
+#include "mock_DMA.h"
+#include "mock_GPIO.h"
+
+#define BENCH_ITERATIONS                200000
+
+const USART_Cfg_t USART_Cfg[_USART_Num] = {
+    [USART1] = {USART_TEST_CFG_8N1(USART_NUMBER_1, 9600)}
+};
+
+static u8 wire[512];
+static u32 wireLen;
+
+/*Transmits through the shared line model onto the suite wire*/
+static void PRINT_SimulateTx(void)
+{
+    USART_SimulateTx(USART_NUMBER_1, wire, &wireLen, sizeof(wire));
+}
+
+/*PRINT_format must match the C library on every format of the supported subset*/
+#define PRINT_CHECK(...)                                                                    \
+    do                                                                                      \
+    {                                                                                       \
+        char expected[96];                                                                  \
+        char actual[96];                                                                    \
+        u16 length = 0;                                                                     \
+        snprintf(expected, sizeof(expected), __VA_ARGS__);                                  \
+        TEST_ASSERT_EQUAL(PRINT_OK, PRINT_format(actual, sizeof(actual), &length, __VA_ARGS__)); \
+        TEST_ASSERT_EQUAL_STRING(expected, actual);                                         \
+        TEST_ASSERT_EQUAL(strlen(expected), length);                                        \
+    }while(0)
+
+void setUp(void)
+{
+    PRINT_SimulateTx();     /*Drain anything a previous test left queued*/
+    memset(USART_MockRegisters, 0, sizeof(USART_MockRegisters));
+    memset(wire, 0, sizeof(wire));
+    wireLen = 0;
+    USART_init();
+}
+
+void tearDown(void)
+{
+}
+
+void test_PRINT_format_integers(void)
+{
+    PRINT_CHECK("%d %i %u", 0, -42, 42u);
+    PRINT_CHECK("%d %d", 2147483647, (int)-2147483647 - 1);
+    PRINT_CHECK("[%5d] [%-5d] [%05d] [%+d] [%+d]", 42, 42, -42, 42, -7);
+    PRINT_CHECK("%ld %lu %lld %llu", (long)-123456, (unsigned long)4000000000UL, -9000000000000000000LL,
+                18446744073709551615ULL);
+    PRINT_CHECK("%hd %hhu", (short)-3, (unsigned char)200);
+    PRINT_CHECK("%*d|%-*u|", 6, 12, 4, 7u);
+}
+
+void test_PRINT_format_hex(void)
+{
+    PRINT_CHECK("%x %X %08lX %llx", 0xBEEFu, 0xbeefu, (unsigned long)0x1234ABUL, 0x123456789ABCDEFULL);
+}
+
+void test_PRINT_format_stringsAndChars(void)
+{
+    PRINT_CHECK("%s|%8s|%-8s|%.3s|%c%c", "abc", "right", "left", "truncate", 'o', 'k');
+    PRINT_CHECK("100%% %5c", 'x');
+}
+
+void test_PRINT_format_fixedPoint(void)
+{
+    char buffer[32];
+    PRINT_CHECK("%f %.2f %.0f %.3f", 3.14159, -2.005, 2.6, 0.0005);
+    PRINT_CHECK("%8.3f|%-8.1f|%08.2f|%+.1f", 1.5, -1.26, -3.75, 0.3);
+    PRINT_CHECK("%.9f %.1f", 1.000000001, 9.96);
+    PRINT_format(buffer, sizeof(buffer), NULL_PTR, "%.0f %.1f", 2.5, -0.25);
+    TEST_ASSERT_EQUAL_STRING("3 -0.3", buffer);
+}
+
+void test_PRINT_format_stopsAtAnUnsupportedConversion(void)
+{
+    char buffer[32];
+    u16 length = 0;
+    TEST_ASSERT_EQUAL(PRINT_Unsupported, PRINT_format(buffer, sizeof(buffer), &length, "a=%d %o b=%d", 1, 8u, 2));
+    TEST_ASSERT_EQUAL_STRING("a=1 ", buffer);
+    TEST_ASSERT_EQUAL(4, length);
+    TEST_ASSERT_EQUAL(PRINT_Unsupported, PRINT_format(buffer, sizeof(buffer), &length, "%d|%#x|%d", 1, 2u, 3));
+    TEST_ASSERT_EQUAL_STRING("1|", buffer);
+    TEST_ASSERT_EQUAL(PRINT_Unsupported, PRINT_format(buffer, sizeof(buffer), &length, "%zu|%d", (size_t)5, 7));
+    TEST_ASSERT_EQUAL_STRING("", buffer);
+    TEST_ASSERT_EQUAL(PRINT_Unsupported, PRINT_format(buffer, sizeof(buffer), &length, "%s %.3d", "x", 4));
+    TEST_ASSERT_EQUAL_STRING("x ", buffer);
+    TEST_ASSERT_EQUAL(PRINT_Unsupported, PRINT_printf("up to here%e", 1.0));
+    PRINT_SimulateTx();
+    TEST_ASSERT_EQUAL(10, wireLen);
+    TEST_ASSERT_EQUAL_MEMORY("up to here", wire, 10);
+}
+
+void test_PRINT_format_truncatesAndTerminates(void)
+{
+    char buffer[8];
+    u16 length = 0;
+    TEST_ASSERT_EQUAL(PRINT_Truncated, PRINT_format(buffer, sizeof(buffer), &length, "%s", "0123456789"));
+    TEST_ASSERT_EQUAL_STRING("0123456", buffer);
+    TEST_ASSERT_EQUAL(7, length);
+    TEST_ASSERT_EQUAL(PRINT_NullPtr, PRINT_format(NULL_PTR, 1, &length, "x"));
+    TEST_ASSERT_EQUAL(PRINT_NullPtr, PRINT_format(buffer, sizeof(buffer), &length, NULL_PTR));
+}
+
+void test_PRINT_printf_sendsChunks(void)
+{
+    const char expected[] = "temperature=23.05 C, status=0x001F, node=pump\r\n";
+    TEST_ASSERT_EQUAL(PRINT_OK, PRINT_printf("temperature=%d.%02u C, status=0x%04X, node=%s\r\n", 23, 5u, 0x1Fu, "pump"));
+    PRINT_SimulateTx();
+    TEST_ASSERT_EQUAL(sizeof(expected) - 1, wireLen);
+    TEST_ASSERT_EQUAL_MEMORY(expected, wire, sizeof(expected) - 1);
+}
+
+void test_PRINT_printf_dropsWhenChunksRunOut(void)
+{
+    char line[PRINT_CHUNK_SIZE * (PRINT_CHUNKS + 1)];
+    u32 droppedBefore = 0;
+    u32 droppedAfter = 0;
+    memset(line, 'a', sizeof(line) - 1);
+    line[sizeof(line) - 1] = '\0';
+    PRINT_getDropped(&droppedBefore);
+    TEST_ASSERT_EQUAL(PRINT_Truncated, PRINT_printf("%s", line));
+    PRINT_getDropped(&droppedAfter);
+    TEST_ASSERT_EQUAL(sizeof(line) - 1 - (PRINT_CHUNK_SIZE * PRINT_CHUNKS), droppedAfter - droppedBefore);
+    PRINT_SimulateTx();
+    TEST_ASSERT_EQUAL(PRINT_CHUNK_SIZE * PRINT_CHUNKS, wireLen);
+    wireLen = 0;
+    TEST_ASSERT_EQUAL(PRINT_OK, PRINT_printf("%s", "free again"));
+    PRINT_SimulateTx();
+    TEST_ASSERT_EQUAL(10, wireLen);
+    TEST_ASSERT_EQUAL(PRINT_NullPtr, PRINT_printf(NULL_PTR));
+}
+
+/*Host cycles per character against the C library, the target figures come from 03_APP/PRINT_Benchmark*/
+void test_PRINT_benchmark_againstSnprintf(void)
+{
+    char buffer[96];
+    char message[128];
+    u16 length = 0;
+    u32 idx = 0;
+    u32 characters = 0;
+    clock_t start = 0;
+    double printSeconds = 0;
+    double librarySeconds = 0;
+    start = clock();
+    for(idx = 0; idx < BENCH_ITERATIONS; idx++)
+    {
+        PRINT_format(buffer, sizeof(buffer), &length, "id=%lu t=%5d.%03u v=0x%08lX %-6s", (unsigned long)idx,
+                     (int)(idx % 1000), (unsigned)(idx % 1000), (unsigned long)(idx * 2654435761UL), "ok");
+        characters += length;
+    }
+    printSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for(idx = 0; idx < BENCH_ITERATIONS; idx++)
+    {
+        snprintf(buffer, sizeof(buffer), "id=%lu t=%5d.%03u v=0x%08lX %-6s", (unsigned long)idx,
+                 (int)(idx % 1000), (unsigned)(idx % 1000), (unsigned long)(idx * 2654435761UL), "ok");
+    }
+    librarySeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    snprintf(message, sizeof(message), "PRINT_format %.1f ns/char, snprintf %.1f ns/char (%lu chars)",
+             printSeconds * 1e9 / characters, librarySeconds * 1e9 / characters, (unsigned long)characters);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(characters > 0);
+}
+
+#endif // TEST
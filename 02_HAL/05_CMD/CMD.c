@@ -0,0 +1,254 @@
+/******************************************************************************
+ *
+ * Module: CMD
+ *
+ * File Name: CMD.c
+ *
+ * Description: Source file for the binary command and telemetry server over USART for STM32F401xC
+ *
+ * Author: Momen Elsayed Shaban
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "USART.h"
+#include "CMD.h"
+
+#define CMD_SLOT_FREE           0U
+#define CMD_SLOT_READY          1U      /*Reply built, the transmit queue was full when it was posted*/
+#define CMD_SLOT_SENDING        2U
+
+/*Request fields*/
+#define CMD_REQUEST_ID          1U
+#define CMD_REQUEST_SEQ         2U
+#define CMD_REQUEST_ARG         3U
+
+/*******************************************************************************
+ *                                   Types                                     *
+ *******************************************************************************/
+/*A reply is built in its slot and sent from it, the USART completion frees the slot*/
+typedef struct{
+    u8 data[CMD_REPLY_MAX_SIZE];
+    u8 length;
+    volatile u8 state;
+}CMD_TxSlot_t;
+
+/*******************************************************************************
+ *                                 Variables                                   *
+ *******************************************************************************/
+extern const CMD_Command_t CMD_Commands[_CMD_NUM];
+
+static USART_Handle_t Cmd_Usart = NULL_PTR;
+static u8 Cmd_Request[CMD_REQUEST_SIZE];
+static u8 Cmd_RequestLength;
+static CMD_TxSlot_t Cmd_TxSlots[CMD_TX_SLOTS];
+static volatile CMD_Stats_t Cmd_Stats;
+
+/*******************************************************************************
+ *                              Static Functions                               *
+ *******************************************************************************/
+static u8 CMD_sum(const u8* Data, u8 Length)
+{
+    u8 sum = 0;
+    u8 idx = 0;
+    for(idx = 0; idx < Length; idx++)
+    {
+        sum += Data[idx];
+    }
+    return sum;
+}
+
+/*Drops the buffered request bytes before the first sync byte at or after From*/
+static void CMD_resync(u8 From)
+{
+    u8 idx = From;
+    while((idx < Cmd_RequestLength) && (Cmd_Request[idx] != CMD_REQUEST_SYNC))
+    {
+        idx++;
+    }
+    if(idx != 0)
+    {
+        Cmd_Stats.skippedBytes += idx;
+        Cmd_RequestLength -= idx;
+        memmove(Cmd_Request, &Cmd_Request[idx], Cmd_RequestLength);
+    }
+}
+
+static CMD_TxSlot_t* CMD_findSlot(u8 State)
+{
+    CMD_TxSlot_t* Slot = NULL_PTR;
+    u8 idx = 0;
+    for(idx = 0; (idx < CMD_TX_SLOTS) && (Slot == NULL_PTR); idx++)
+    {
+        if(Cmd_TxSlots[idx].state == State)
+        {
+            Slot = &Cmd_TxSlots[idx];
+        }
+    }
+    return Slot;
+}
+
+static void CMD_TxDone(const USART_Completion_t* Completion)
+{
+    CMD_TxSlot_t* const Slot = (CMD_TxSlot_t*)Completion->Context;
+    Cmd_Stats.replies++;
+    Slot->state = CMD_SLOT_FREE;
+}
+
+/*Posts the slot reply, a full transmit queue leaves it ready for the next run*/
+static boolean CMD_post(CMD_TxSlot_t* Slot)
+{
+    boolean posted = TRUE;
+    /*Taken before posting, the completion may run before USART_send returns*/
+    Slot->state = CMD_SLOT_SENDING;
+    if(USART_send(Cmd_Usart, Slot->data, Slot->length, CMD_TxDone, Slot) != USART_OK)
+    {
+        Slot->state = CMD_SLOT_READY;
+        posted = FALSE;
+    }
+    return posted;
+}
+
+/*Runs the handler of the buffered request with the slot payload as its output*/
+static void CMD_serve(CMD_TxSlot_t* Slot)
+{
+    u8* const Reply = Slot->data;
+    const u32 arg = (u32)Cmd_Request[CMD_REQUEST_ARG] | ((u32)Cmd_Request[CMD_REQUEST_ARG + 1] << 8) |
+                    ((u32)Cmd_Request[CMD_REQUEST_ARG + 2] << 16) | ((u32)Cmd_Request[CMD_REQUEST_ARG + 3] << 24);
+    CMD_Handler_t Handler = NULL_PTR;
+    u8 status = CMD_STATUS_UNKNOWN;
+    u8 length = 0;
+    u8 idx = 0;
+    for(idx = 0; (idx < _CMD_NUM) && (Handler == NULL_PTR); idx++)
+    {
+        if(CMD_Commands[idx].id == Cmd_Request[CMD_REQUEST_ID])
+        {
+            Handler = CMD_Commands[idx].handler;
+        }
+    }
+    if(Handler != NULL_PTR)
+    {
+        status = Handler(arg, &Reply[CMD_REPLY_HEADER_SIZE], CMD_MAX_PAYLOAD, &length);
+        if(length > CMD_MAX_PAYLOAD)
+        {
+            status = CMD_STATUS_FAILED;
+            length = 0;
+        }
+    }
+    else
+    {
+        Cmd_Stats.unknown++;
+    }
+    Reply[0] = CMD_REPLY_SYNC;
+    Reply[1] = Cmd_Request[CMD_REQUEST_ID];
+    Reply[2] = Cmd_Request[CMD_REQUEST_SEQ];
+    Reply[3] = status;
+    Reply[4] = length;
+    Reply[CMD_REPLY_HEADER_SIZE + length] = (u8)(0U - CMD_sum(Reply, CMD_REPLY_HEADER_SIZE + length));
+    Slot->length = CMD_REPLY_HEADER_SIZE + length + 1;
+    Cmd_Stats.requests++;
+}
+
+/*******************************************************************************
+ *                         Functions Implementation                            *
+ *******************************************************************************/
+CMD_ErrorStatus_t CMD_Init(void)
+{
+    CMD_ErrorStatus_t Error_Status = CMD_OK;
+    USART_Handle_t Usart = NULL_PTR;
+    u8 number = 0;
+    u8 slot = 0;
+    Cmd_Usart = NULL_PTR;
+    Cmd_RequestLength = 0;
+    for(slot = 0; slot < CMD_TX_SLOTS; slot++)
+    {
+        Cmd_TxSlots[slot].state = CMD_SLOT_FREE;
+    }
+    if((USART_getHandle(CMD_USART_CFG, &Usart) != USART_OK) || (USART_getNumber(Usart, &number) != USART_OK) ||
+       (USART_startContinuousRx(number) != USART_OK))
+    {
+        Error_Status = CMD_InvalidConfig;
+    }
+    else
+    {
+        Cmd_Usart = Usart;
+    }
+    return Error_Status;
+}
+
+void CMD_Runnable(void)
+{
+    CMD_TxSlot_t* Slot = NULL_PTR;
+    u16 budget = CMD_MAX_REQUESTS_PER_RUN * CMD_REQUEST_SIZE;   /*Bytes taken per run, garbage included*/
+    u16 wanted = 0;
+    u16 readLength = 0;
+    u8 served = 0;
+    boolean stop = (Cmd_Usart == NULL_PTR) ? TRUE : FALSE;
+    if(stop == FALSE)
+    {
+        /*A reply the full queue refused goes first, the replies leave in request order*/
+        Slot = CMD_findSlot(CMD_SLOT_READY);
+        if(Slot != NULL_PTR)
+        {
+            stop = (CMD_post(Slot) == TRUE) ? FALSE : TRUE;
+        }
+    }
+    while((stop == FALSE) && (served < CMD_MAX_REQUESTS_PER_RUN))
+    {
+        readLength = 0;
+        if((Cmd_RequestLength < CMD_REQUEST_SIZE) && (budget != 0))
+        {
+            /*Only the bytes of one request are taken, the rest of a burst waits in the ring*/
+            wanted = CMD_REQUEST_SIZE - Cmd_RequestLength;
+            wanted = (wanted > budget) ? budget : wanted;
+            USART_receive(Cmd_Usart, &Cmd_Request[Cmd_RequestLength], wanted, &readLength);
+            budget -= readLength;
+            Cmd_RequestLength += readLength;
+            CMD_resync(0);
+        }
+        if(Cmd_RequestLength < CMD_REQUEST_SIZE)
+        {
+            stop = (readLength == 0) ? TRUE : FALSE;
+        }
+        else if(CMD_sum(Cmd_Request, CMD_REQUEST_SIZE) != 0)
+        {
+            Cmd_Stats.checksumErrors++;
+            CMD_resync(1);
+        }
+        else
+        {
+            Slot = CMD_findSlot(CMD_SLOT_FREE);
+            if(Slot == NULL_PTR)
+            {
+                /*The request stays buffered until a reply is out*/
+                Cmd_Stats.deferred++;
+                stop = TRUE;
+            }
+            else
+            {
+                CMD_serve(Slot);
+                Cmd_RequestLength = 0;
+                served++;
+                stop = (CMD_post(Slot) == TRUE) ? FALSE : TRUE;
+            }
+        }
+    }
+}
+
+CMD_ErrorStatus_t CMD_getStats(CMD_Stats_t* Stats)
+{
+    CMD_ErrorStatus_t Error_Status = CMD_OK;
+    if(Stats == NULL_PTR)
+    {
+        Error_Status = CMD_NullPtr;
+    }
+    else
+    {
+        Stats->requests = Cmd_Stats.requests;
+        Stats->replies = Cmd_Stats.replies;
+        Stats->unknown = Cmd_Stats.unknown;
+        Stats->checksumErrors = Cmd_Stats.checksumErrors;
+        Stats->skippedBytes = Cmd_Stats.skippedBytes;
+        Stats->deferred = Cmd_Stats.deferred;
+    }
+    return Error_Status;
+}
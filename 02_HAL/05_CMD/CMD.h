@@ -0,0 +1,114 @@
+/******************************************************************************
+ *
+ * Module: CMD
+ *
+ * File Name: CMD.h
+ *
+ * Description: Header file for the binary command and telemetry server over USART for STM32F401xC
+ *
+ * Author: Momen Elsayed Shaban
+ *
+ *******************************************************************************/
+#ifndef CMD_H_
+#define CMD_H_
+
+#include "CMD_Cfg.h"
+#include "std_types.h"
+
+/*
+ * Protocol:
+ * ---------
+ * Request, always CMD_REQUEST_SIZE bytes:
+ *   CMD_REQUEST_SYNC | id | seq | arg (u32, little endian) | checksum
+ * Reply:
+ *   CMD_REPLY_SYNC | id | seq | status (CMD_STATUS_x) | length | payload (length bytes) | checksum
+ * The checksum makes the 8-bit sum of every byte of the message, itself included, zero. seq is echoed so
+ * the host can match replies to requests. Bytes before a sync byte and requests with a wrong checksum are
+ * skipped, the parser resynchronizes on the next sync byte.
+ */
+#define CMD_REQUEST_SYNC        0xA5U
+#define CMD_REPLY_SYNC          0x5AU
+#define CMD_REQUEST_SIZE        8U
+#define CMD_REPLY_HEADER_SIZE   5U
+#define CMD_REPLY_MAX_SIZE      (CMD_REPLY_HEADER_SIZE + CMD_MAX_PAYLOAD + 1U)
+
+/*Reply status*/
+#define CMD_STATUS_OK           0x00U
+#define CMD_STATUS_UNKNOWN      0x01U   /*No handler for the id*/
+#define CMD_STATUS_INVALID_ARG  0x02U
+#define CMD_STATUS_FAILED       0x03U   /*The handler couldn't read its data*/
+
+/*******************************************************************************
+ *                                Type Decelerations                           *
+ *******************************************************************************/
+/*
+ * Writes the reply payload in place (the reply buffer that is sent, no copy) and its length, and returns the
+ * CMD_STATUS_x of the reply. Payload has room for Capacity bytes (CMD_MAX_PAYLOAD): a handler whose reply
+ * doesn't fit writes nothing and returns CMD_STATUS_FAILED. Called from CMD_Runnable, it must not block.
+ */
+typedef u8 (*CMD_Handler_t)(u32 Arg, u8* Payload, u8 Capacity, u8* Length);
+
+typedef struct{
+    u8 id;
+    CMD_Handler_t handler;
+}CMD_Command_t;
+
+typedef struct{
+    u32 requests;           /*Well-formed requests served, unknown ids included*/
+    u32 replies;            /*Replies completely sent*/
+    u32 unknown;
+    u32 checksumErrors;
+    u32 skippedBytes;       /*Bytes dropped to find the next sync byte*/
+    u32 deferred;           /*Runs that left requests in the ring for lack of a free reply slot*/
+}CMD_Stats_t;
+
+typedef enum{
+    CMD_OK,
+    CMD_NullPtr,
+    CMD_InvalidConfig
+}CMD_ErrorStatus_t;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/*****************************************************
+ * Function: CMD_Init
+ * Description: Binds the server to the CMD_USART_CFG instance, starts its continuous receive and frees the
+ *              reply slots.
+ *
+ * Return:
+ *   - CMD_OK or CMD_InvalidConfig if USART_init rejected the entry or its receiver is busy.
+ *
+ * Notes:
+ *   - USART_init must be called first.
+ *****************************************************/
+CMD_ErrorStatus_t CMD_Init(void);
+
+/*****************************************************
+ * Function: CMD_Runnable
+ * Description: Scheduler runnable of the server: takes the requests waiting in the USART ring and posts
+ *              their replies to the transmit queue.
+ *
+ * Notes:
+ *   - Bounded: at most CMD_MAX_REQUESTS_PER_RUN requests per call, and none once the CMD_TX_SLOTS replies
+ *     are in flight. The rest of a burst stays in the ring for the next call, with RTS flow control the
+ *     peer is held off when it fills.
+ *   - Does nothing before a successful CMD_Init.
+ *****************************************************/
+void CMD_Runnable(void);
+
+CMD_ErrorStatus_t CMD_getStats(CMD_Stats_t* Stats);
+
+/*****************************************************
+ * Function: CMD_packU32
+ * Description: Writes Value little endian at Payload, for the handlers.
+ *****************************************************/
+static inline void CMD_packU32(u8* Payload, u32 Value)
+{
+    Payload[0] = (u8)Value;
+    Payload[1] = (u8)(Value >> 8);
+    Payload[2] = (u8)(Value >> 16);
+    Payload[3] = (u8)(Value >> 24);
+}
+
+#endif /*CMD_H_*/
@@ -0,0 +1,166 @@
+/******************************************************************************
+ *
+ * Module: CMD
+ *
+ * File Name: CMD_Cfg.c
+ *
+ * Description: Source file for the binary command and telemetry server over USART Configurations
+ *
+ * Author: Momen Elsayed Shaban
+ *
+ *******************************************************************************/
+#include "USART.h"
+#include "GPIO.h"
+#include "Scheduler.h"
+#include "CMD.h"
+
+/*Request ids, the reply payloads are little endian*/
+#define CMD_ID_PING             0x01U   /*Payload: arg echoed (u32)*/
+#define CMD_ID_SCHED_LOAD       0x02U   /*Payload: scheduler load in permille, watchdog resets (u32 each)*/
+#define CMD_ID_USART_STATS      0x03U   /*Arg: USART_NUMBER_x. Payload: USART_RxStats_t counters (u32 each)*/
+#define CMD_ID_GPIO_STATE       0x04U   /*Arg: port (0 A, 1 B, 2 C) in byte 0, pin in byte 1. Payload: state (u8)*/
+#define CMD_ID_SERVER_STATS     0x05U   /*Payload: CMD_Stats_t counters (u32 each)*/
+
+/*Reply payload lengths, a handler checks its length against the capacity before writing in place*/
+#define CMD_PING_LENGTH         4U
+#define CMD_SCHED_LOAD_LENGTH   8U
+#define CMD_USART_STATS_LENGTH  28U
+#define CMD_GPIO_STATE_LENGTH   1U
+#define CMD_SERVER_STATS_LENGTH 24U
+
+_Static_assert((CMD_PING_LENGTH <= CMD_MAX_PAYLOAD) && (CMD_SCHED_LOAD_LENGTH <= CMD_MAX_PAYLOAD) &&
+               (CMD_USART_STATS_LENGTH <= CMD_MAX_PAYLOAD) && (CMD_GPIO_STATE_LENGTH <= CMD_MAX_PAYLOAD) &&
+               (CMD_SERVER_STATS_LENGTH <= CMD_MAX_PAYLOAD), "A reply payload is larger than CMD_MAX_PAYLOAD");
+
+static void* const CMD_GpioPorts[] = {GPIO_PORT_A, GPIO_PORT_B, GPIO_PORT_C};
+
+static u8 CMD_ping(u32 Arg, u8* Payload, u8 Capacity, u8* Length)
+{
+    u8 status = CMD_STATUS_OK;
+    if(Capacity < CMD_PING_LENGTH)
+    {
+        status = CMD_STATUS_FAILED;
+    }
+    else
+    {
+        CMD_packU32(Payload, Arg);
+        *Length = CMD_PING_LENGTH;
+    }
+    return status;
+}
+
+static u8 CMD_schedLoad(u32 Arg, u8* Payload, u8 Capacity, u8* Length)
+{
+    u8 status = CMD_STATUS_OK;
+    Sched_PostMortem_t record;
+    (void)Arg;
+    if(Capacity < CMD_SCHED_LOAD_LENGTH)
+    {
+        status = CMD_STATUS_FAILED;
+    }
+    else
+    {
+        Sched_getPostMortem(&record);
+        CMD_packU32(&Payload[0], Sched_getLoad());
+        CMD_packU32(&Payload[4], record.watchdogResets);
+        *Length = CMD_SCHED_LOAD_LENGTH;
+    }
+    return status;
+}
+
+static u8 CMD_usartStats(u32 Arg, u8* Payload, u8 Capacity, u8* Length)
+{
+    u8 status = CMD_STATUS_OK;
+    USART_RxStats_t stats;
+    if(Capacity < CMD_USART_STATS_LENGTH)
+    {
+        status = CMD_STATUS_FAILED;
+    }
+    else if((Arg > 0xFFU) || (USART_getRxStats((u8)Arg, &stats) != USART_OK))
+    {
+        status = CMD_STATUS_INVALID_ARG;
+    }
+    else
+    {
+        CMD_packU32(&Payload[0], stats.received);
+        CMD_packU32(&Payload[4], stats.dropped);
+        CMD_packU32(&Payload[8], stats.overruns);
+        CMD_packU32(&Payload[12], stats.parityErrors);
+        CMD_packU32(&Payload[16], stats.framingErrors);
+        CMD_packU32(&Payload[20], stats.noiseErrors);
+        CMD_packU32(&Payload[24], stats.bufferOverruns);
+        *Length = CMD_USART_STATS_LENGTH;
+    }
+    return status;
+}
+
+static u8 CMD_gpioState(u32 Arg, u8* Payload, u8 Capacity, u8* Length)
+{
+    u8 status = CMD_STATUS_OK;
+    const u8 port = (u8)Arg;
+    const u8 pin = (u8)(Arg >> 8);
+    if(Capacity < CMD_GPIO_STATE_LENGTH)
+    {
+        status = CMD_STATUS_FAILED;
+    }
+    else if((port >= (sizeof(CMD_GpioPorts) / sizeof(CMD_GpioPorts[0]))) || (pin > GPIO_PIN_15))
+    {
+        status = CMD_STATUS_INVALID_ARG;
+    }
+    else if(GPIO_getPinValue(CMD_GpioPorts[port], pin, &Payload[0]) != GPIO_OK)
+    {
+        status = CMD_STATUS_FAILED;
+    }
+    else
+    {
+        *Length = CMD_GPIO_STATE_LENGTH;
+    }
+    return status;
+}
+
+static u8 CMD_serverStats(u32 Arg, u8* Payload, u8 Capacity, u8* Length)
+{
+    u8 status = CMD_STATUS_OK;
+    CMD_Stats_t stats;
+    (void)Arg;
+    if(Capacity < CMD_SERVER_STATS_LENGTH)
+    {
+        status = CMD_STATUS_FAILED;
+    }
+    else
+    {
+        CMD_getStats(&stats);
+        CMD_packU32(&Payload[0], stats.requests);
+        CMD_packU32(&Payload[4], stats.replies);
+        CMD_packU32(&Payload[8], stats.unknown);
+        CMD_packU32(&Payload[12], stats.checksumErrors);
+        CMD_packU32(&Payload[16], stats.skippedBytes);
+        CMD_packU32(&Payload[20], stats.deferred);
+        *Length = CMD_SERVER_STATS_LENGTH;
+    }
+    return status;
+}
+
+const CMD_Command_t CMD_Commands[_CMD_NUM] =
+{
+    [CMD_Ping] = {
+        .id = CMD_ID_PING,
+        .handler = CMD_ping
+    },
+    [CMD_SchedLoad] = {
+        .id = CMD_ID_SCHED_LOAD,
+        .handler = CMD_schedLoad
+    },
+    [CMD_UsartStats] = {
+        .id = CMD_ID_USART_STATS,
+        .handler = CMD_usartStats
+    },
+    [CMD_GpioState] = {
+        .id = CMD_ID_GPIO_STATE,
+        .handler = CMD_gpioState
+    },
+    [CMD_ServerStats] = {
+        .id = CMD_ID_SERVER_STATS,
+        .handler = CMD_serverStats
+    }
+};
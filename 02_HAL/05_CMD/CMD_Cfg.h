@@ -0,0 +1,30 @@
+/******************************************************************************
+ *
+ * Module: CMD
+ *
+ * File Name: CMD_Cfg.h
+ *
+ * Description: Header file for the binary command and telemetry server over USART Configurations
+ *
+ * Author: Momen Elsayed Shaban
+ *
+ *******************************************************************************/
+#ifndef CMD_CFG_H_
+#define CMD_CFG_H_
+
+#define CMD_USART_CFG               USART1  /*USART_Cfg entry the server listens and replies on*/
+#define CMD_MAX_PAYLOAD             32      /*Largest reply payload a handler can write*/
+#define CMD_TX_SLOTS                4       /*Replies in flight, a burst beyond it waits in the USART ring*/
+#define CMD_MAX_REQUESTS_PER_RUN    4       /*Requests served by one CMD_Runnable call*/
+
+/*Commands of the handler table (CMD_Cfg.c)*/
+enum{
+    CMD_Ping,
+    CMD_SchedLoad,
+    CMD_UsartStats,
+    CMD_GpioState,
+    CMD_ServerStats,
+    _CMD_NUM
+};
+
+#endif /*CMD_CFG_H_*/
@@ -0,0 +1,242 @@
+#ifdef TEST
+
+#include <string.h>
+#include "unity.h"
+#include "USART.h"
+#include "USART_TestSupport.h"
+#include "CMD.h"
+#include "mock_DMA.h"
+#include "mock_GPIO.h"
+
+#define TEST_ID_PING                    0x01
+#define TEST_ID_OVERSIZE                0x02
+#define TEST_ID_FAILING                 0x03
+#define TEST_ID_UNKNOWN                 0x7E
+#define BURST_REQUESTS                  10
+
+const USART_Cfg_t USART_Cfg[_USART_Num] = {
+    [USART1] = {USART_TEST_CFG_8N1(USART_NUMBER_1, 115200)}
+};
+
+static u8 oversizeCapacity;
+
+static u8 Test_ping(u32 Arg, u8* Payload, u8 Capacity, u8* Length)
+{
+    CMD_packU32(Payload, Arg);
+    *Length = 4;
+    return CMD_STATUS_OK;
+}
+
+/*Fills all the room it was given and claims one byte more*/
+static u8 Test_oversize(u32 Arg, u8* Payload, u8 Capacity, u8* Length)
+{
+    oversizeCapacity = Capacity;
+    memset(Payload, 0xEE, Capacity);
+    *Length = Capacity + 1;
+    return CMD_STATUS_OK;
+}
+
+static u8 Test_failing(u32 Arg, u8* Payload, u8 Capacity, u8* Length)
+{
+    return CMD_STATUS_FAILED;
+}
+
+const CMD_Command_t CMD_Commands[_CMD_NUM] = {
+    [CMD_Ping] = {.id = TEST_ID_PING, .handler = Test_ping},
+    [CMD_SchedLoad] = {.id = TEST_ID_OVERSIZE, .handler = Test_oversize},
+    [CMD_UsartStats] = {.id = TEST_ID_FAILING, .handler = Test_failing},
+    [CMD_GpioState] = {.id = TEST_ID_PING, .handler = Test_ping},
+    [CMD_ServerStats] = {.id = TEST_ID_PING, .handler = Test_ping}
+};
+
+static u8 wire[512];
+static u32 wireLen;
+static u32 wireRead;
+static u32 otherSent;
+
+static void Test_otherSent(const USART_Completion_t* Completion)
+{
+    otherSent++;
+}
+
+/*A host request as the peer sends it, with Corrupt its checksum is off by one*/
+static void Host_request(u8 Id, u8 Seq, u32 Arg, boolean Corrupt)
+{
+    u8 request[CMD_REQUEST_SIZE] = {CMD_REQUEST_SYNC, Id, Seq, (u8)Arg, (u8)(Arg >> 8), (u8)(Arg >> 16), (u8)(Arg >> 24), 0};
+    u8 sum = 0;
+    u8 idx = 0;
+    for(idx = 0; idx < (CMD_REQUEST_SIZE - 1); idx++)
+    {
+        sum += request[idx];
+    }
+    request[CMD_REQUEST_SIZE - 1] = (u8)(0U - sum) + ((Corrupt == TRUE) ? 1 : 0);
+    USART_SimulateRx(USART_NUMBER_1, request, CMD_REQUEST_SIZE, 0);
+}
+
+/*Lets the transmitter send everything queued, the bytes land on the wire*/
+static void Line_drainTx(void)
+{
+    USART_SimulateTx(USART_NUMBER_1, wire, &wireLen, sizeof(wire));
+}
+
+/*Checks the next reply on the wire and returns its payload length*/
+static u8 Host_expectReply(u8 Id, u8 Seq, u8 Status)
+{
+    u8* reply = &wire[wireRead];
+    u8 length = 0;
+    u8 sum = 0;
+    u8 idx = 0;
+    TEST_ASSERT_GREATER_OR_EQUAL(wireRead + CMD_REPLY_HEADER_SIZE + 1, wireLen);
+    TEST_ASSERT_EQUAL_HEX32(CMD_REPLY_SYNC, reply[0]);
+    TEST_ASSERT_EQUAL(Id, reply[1]);
+    TEST_ASSERT_EQUAL(Seq, reply[2]);
+    TEST_ASSERT_EQUAL(Status, reply[3]);
+    length = reply[4];
+    TEST_ASSERT_GREATER_OR_EQUAL(wireRead + CMD_REPLY_HEADER_SIZE + length + 1, wireLen);
+    for(idx = 0; idx < (CMD_REPLY_HEADER_SIZE + length + 1); idx++)
+    {
+        sum += reply[idx];
+    }
+    TEST_ASSERT_EQUAL(0, sum);
+    wireRead += CMD_REPLY_HEADER_SIZE + length + 1;
+    return length;
+}
+
+void setUp(void)
+{
+    USART_stopContinuousRx(USART_NUMBER_1);
+    memset(USART_MockRegisters, 0, sizeof(USART_MockRegisters));
+    memset(wire, 0, sizeof(wire));
+    wireLen = 0;
+    wireRead = 0;
+    otherSent = 0;
+    USART_init();
+    TEST_ASSERT_EQUAL(CMD_OK, CMD_Init());
+}
+
+void tearDown(void)
+{
+    /*Replies left in flight by a test go out, freeing their slots for the next one*/
+    Line_drainTx();
+}
+
+void test_CMD_ping_repliesWithTheArgument(void)
+{
+    Host_request(TEST_ID_PING, 0x42, 0x11223344, FALSE);
+    CMD_Runnable();
+    Line_drainTx();
+    TEST_ASSERT_EQUAL(4, Host_expectReply(TEST_ID_PING, 0x42, CMD_STATUS_OK));
+    TEST_ASSERT_EQUAL_MEMORY("\x44\x33\x22\x11", &wire[CMD_REPLY_HEADER_SIZE], 4);
+    TEST_ASSERT_EQUAL(wireLen, wireRead);
+}
+
+void test_CMD_reportsUnknownAndFailedCommands(void)
+{
+    CMD_Stats_t before;
+    CMD_Stats_t after;
+    CMD_getStats(&before);
+    Host_request(TEST_ID_UNKNOWN, 1, 0, FALSE);
+    Host_request(TEST_ID_OVERSIZE, 2, 0, FALSE);
+    Host_request(TEST_ID_FAILING, 3, 0, FALSE);
+    CMD_Runnable();
+    Line_drainTx();
+    TEST_ASSERT_EQUAL(0, Host_expectReply(TEST_ID_UNKNOWN, 1, CMD_STATUS_UNKNOWN));
+    TEST_ASSERT_EQUAL(0, Host_expectReply(TEST_ID_OVERSIZE, 2, CMD_STATUS_FAILED));
+    TEST_ASSERT_EQUAL(CMD_MAX_PAYLOAD, oversizeCapacity);
+    TEST_ASSERT_EQUAL(0, Host_expectReply(TEST_ID_FAILING, 3, CMD_STATUS_FAILED));
+    TEST_ASSERT_EQUAL(CMD_OK, CMD_getStats(&after));
+    TEST_ASSERT_EQUAL(1, after.unknown - before.unknown);
+    TEST_ASSERT_EQUAL(3, after.requests - before.requests);
+    TEST_ASSERT_EQUAL(3, after.replies - before.replies);
+    TEST_ASSERT_EQUAL(CMD_NullPtr, CMD_getStats(NULL_PTR));
+}
+
+/*Noise before a request and a corrupted request are skipped, the next good request is served*/
+void test_CMD_resynchronizesOnTheNextSyncByte(void)
+{
+    const u8 noise[] = {0x00, 0x13, CMD_REQUEST_SYNC, 0x01};
+    CMD_Stats_t before;
+    CMD_Stats_t after;
+    CMD_getStats(&before);
+    USART_SimulateRx(USART_NUMBER_1, noise, sizeof(noise), 0);
+    Host_request(TEST_ID_PING, 7, 0xA5A5A5A5, TRUE);
+    Host_request(TEST_ID_PING, 8, 0x0000A5A5, FALSE);
+    CMD_Runnable();
+    CMD_Runnable();
+    CMD_Runnable();
+    Line_drainTx();
+    TEST_ASSERT_EQUAL(4, Host_expectReply(TEST_ID_PING, 8, CMD_STATUS_OK));
+    TEST_ASSERT_EQUAL(wireLen, wireRead);
+    TEST_ASSERT_EQUAL(CMD_OK, CMD_getStats(&after));
+    TEST_ASSERT_EQUAL(1, after.requests - before.requests);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, after.checksumErrors - before.checksumErrors);
+    TEST_ASSERT_GREATER_OR_EQUAL(sizeof(noise) + CMD_REQUEST_SIZE, after.skippedBytes - before.skippedBytes);
+}
+
+/*A burst is served a bounded share per run, in order, with the rest left in the ring*/
+void test_CMD_burstIsServedWithoutBlocking(void)
+{
+    CMD_Stats_t before;
+    CMD_Stats_t after;
+    u16 available = 0;
+    u8 seq = 0;
+    u32 runs = 0;
+    CMD_getStats(&before);
+    for(seq = 0; seq < BURST_REQUESTS; seq++)
+    {
+        Host_request(TEST_ID_PING, seq, seq, FALSE);
+    }
+    CMD_Runnable();
+    TEST_ASSERT_EQUAL(CMD_OK, CMD_getStats(&after));
+    TEST_ASSERT_EQUAL(CMD_MAX_REQUESTS_PER_RUN, after.requests - before.requests);
+    USART_getRxAvailable(USART_NUMBER_1, &available);
+    TEST_ASSERT_EQUAL((BURST_REQUESTS - CMD_MAX_REQUESTS_PER_RUN) * CMD_REQUEST_SIZE, available);
+
+    /*Nothing sent yet: every slot is in flight, the next run leaves the ring alone*/
+    CMD_Runnable();
+    TEST_ASSERT_EQUAL(CMD_OK, CMD_getStats(&after));
+    TEST_ASSERT_EQUAL(CMD_TX_SLOTS, after.requests - before.requests);
+    TEST_ASSERT_EQUAL(1, after.deferred - before.deferred);
+
+    for(runs = 0; (runs < BURST_REQUESTS) && ((after.requests - before.requests) < BURST_REQUESTS); runs++)
+    {
+        Line_drainTx();
+        CMD_Runnable();
+        CMD_getStats(&after);
+    }
+    Line_drainTx();
+    for(seq = 0; seq < BURST_REQUESTS; seq++)
+    {
+        TEST_ASSERT_EQUAL(4, Host_expectReply(TEST_ID_PING, seq, CMD_STATUS_OK));
+        TEST_ASSERT_EQUAL(seq, wire[wireRead - 5]);
+    }
+    CMD_getStats(&after);
+    TEST_ASSERT_EQUAL(BURST_REQUESTS, after.replies - before.replies);
+}
+
+/*A reply the full transmit queue refused is posted first on the next run*/
+void test_CMD_fullTransmitQueueKeepsTheReply(void)
+{
+    static u8 other[USART_TX_QUEUE_SIZE];
+    USART_Handle_t handle = NULL_PTR;
+    u8 idx = 0;
+    USART_getHandle(USART1, &handle);
+    for(idx = 0; idx < USART_TX_QUEUE_SIZE; idx++)
+    {
+        other[idx] = idx;
+        TEST_ASSERT_EQUAL(USART_OK, USART_send(handle, &other[idx], 1, Test_otherSent, NULL_PTR));
+    }
+    Host_request(TEST_ID_PING, 1, 1, FALSE);
+    Host_request(TEST_ID_PING, 2, 2, FALSE);
+    CMD_Runnable();
+    Line_drainTx();
+    TEST_ASSERT_EQUAL(USART_TX_QUEUE_SIZE, otherSent);
+    TEST_ASSERT_EQUAL(USART_TX_QUEUE_SIZE, wireLen);
+    wireRead = USART_TX_QUEUE_SIZE;
+    CMD_Runnable();
+    Line_drainTx();
+    TEST_ASSERT_EQUAL(4, Host_expectReply(TEST_ID_PING, 1, CMD_STATUS_OK));
+    TEST_ASSERT_EQUAL(4, Host_expectReply(TEST_ID_PING, 2, CMD_STATUS_OK));
+}
+
+#endif // TEST
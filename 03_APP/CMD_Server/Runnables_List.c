@@ -0,0 +1,20 @@
+/*
+ * Runnables_List.c
+ *
+ *  Created on: 11 Mar 2024
+ *      Author: Momen El Sayed
+ */
+
+#include "Runnables_List.h"
+#include "Scheduler.h"
+#include "CMD.h"
+
+const runnable_t Runnables_List[_Runnables_Num] =
+{
+        [CMD_Server] = {
+            .name = "Command Server",
+            .periodicityMS = 10,
+            .deadlineMS = 100,
+            .callBackFn = &CMD_Runnable
+        }
+};
@@ -0,0 +1,18 @@
+/*
+ * Runnables_List.h
+ *
+ *  Created on: 11 Mar 2024
+ *      Author: Momen El Sayed
+ */
+
+#ifndef RUNNABLES_LIST_H_
+#define RUNNABLES_LIST_H_
+
+enum{
+	CMD_Server,
+	_Runnables_Num
+};
+
+
+
+#endif /* RUNNABLES_LIST_H_ */
@@ -0,0 +1,38 @@
+#include "RCC.h"
+#include "GPIO.h"
+#include "NVIC.h"
+#include "USART.h"
+#include "DWT.h"
+#include "CMD.h"
+#include "Scheduler.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wmissing-declarations"
+#pragma GCC diagnostic ignored "-Wreturn-type"
+
+/*
+ * Command and telemetry server: USART1 (PA9 Tx, PA10 Rx) of USART_Cfg.c answers the binary requests of CMD.h
+ * (ping, scheduler load, USART receive counters, GPIO pin states and the server counters) from a 10 ms
+ * runnable. Each reply is posted to the USART transmit queue and sent by its interrupt, so a burst of
+ * requests costs the tick only the parsing and the handlers.
+ */
+int main(int argc, char* argv[])
+{
+  GPIO_Pin_t UsartTx = {.GPIO_Port = GPIO_PORT_A, .GPIO_Pin = GPIO_PIN_9, .GPIO_Mode = GPIO_MODE_AF_PP, .GPIO_Speed = GPIO_SPEED_HIGH};
+  GPIO_Pin_t UsartRx = {.GPIO_Port = GPIO_PORT_A, .GPIO_Pin = GPIO_PIN_10, .GPIO_Mode = GPIO_MODE_AF_PP, .GPIO_Speed = GPIO_SPEED_HIGH};
+  RCC_Ctrl_AHB1_Clk(RCC_GPIOA_ENABLE_DISABLE, RCC_enuPeriphralEnable);
+  RCC_Ctrl_APB2_Clk(RCC_USART1_ENABLE_DISABLE, RCC_enuPeriphralEnable);
+  GPIO_Init(&UsartTx);
+  GPIO_Init(&UsartRx);
+  GPIO_CfgAlternateFn(GPIO_PORT_A, GPIO_PIN_9, GPIO_FUNC_AF7);
+  GPIO_CfgAlternateFn(GPIO_PORT_A, GPIO_PIN_10, GPIO_FUNC_AF7);
+  DWT_init();
+  USART_init();
+  NVIC_EnableIRQ(USART1_IRQn);
+  CMD_Init();
+  Sched_Init();
+  Sched_Start();
+}
+
+#pragma GCC diagnostic pop
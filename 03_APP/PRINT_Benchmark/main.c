@@ -0,0 +1,84 @@
+#include "RCC.h"
+#include "GPIO.h"
+#include "NVIC.h"
+#include "USART.h"
+#include "DWT.h"
+#include "PRINT.h"
+#if PRINT_BENCH_NEWLIB
+#include <stdio.h>
+#endif
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wmissing-declarations"
+#pragma GCC diagnostic ignored "-Wreturn-type"
+
+/*
+ * PRINT against newlib benchmark: formats the same line BENCH_ITERATIONS times with PRINT_format and, when
+ * built with PRINT_BENCH_NEWLIB=1, with newlib snprintf, and reports the cycles per character of each on
+ * USART1 (PA9) through PRINT_printf.
+ * Code size: build with PRINT_BENCH_NEWLIB=0 and =1 and compare arm-none-eabi-size of the two images, the
+ * difference is what snprintf pulls in (formatter, locale and the _reent/malloc support it needs).
+ */
+#ifndef PRINT_BENCH_NEWLIB
+#define PRINT_BENCH_NEWLIB      0
+#endif
+#define BENCH_ITERATIONS        1000
+#define BENCH_FORMAT            "id=%lu t=%5d.%03u v=0x%08lX %-6s"
+
+static char BenchBuffer[96];
+
+static u32 Bench_formatCycles(u32* Characters)
+{
+  u32 start = DWT_getCycles();
+  u32 idx = 0;
+  u16 length = 0;
+  *Characters = 0;
+  for(idx = 0; idx < BENCH_ITERATIONS; idx++)
+  {
+    PRINT_format(BenchBuffer, sizeof(BenchBuffer), &length, BENCH_FORMAT, idx, (int)(idx % 1000),
+                 (unsigned)(idx % 1000), idx * 2654435761UL, "ok");
+    *Characters += length;
+  }
+  return DWT_getCycles() - start;
+}
+
+#if PRINT_BENCH_NEWLIB
+static u32 Bench_snprintfCycles(void)
+{
+  u32 start = DWT_getCycles();
+  u32 idx = 0;
+  for(idx = 0; idx < BENCH_ITERATIONS; idx++)
+  {
+    snprintf(BenchBuffer, sizeof(BenchBuffer), BENCH_FORMAT, idx, (int)(idx % 1000),
+             (unsigned)(idx % 1000), idx * 2654435761UL, "ok");
+  }
+  return DWT_getCycles() - start;
+}
+#endif
+
+int main(int argc, char* argv[])
+{
+  GPIO_Pin_t UsartTx = {.GPIO_Port = GPIO_PORT_A, .GPIO_Pin = GPIO_PIN_9, .GPIO_Mode = GPIO_MODE_AF_PP, .GPIO_Speed = GPIO_SPEED_HIGH};
+  u32 characters = 0;
+  u32 cycles = 0;
+  RCC_Ctrl_AHB1_Clk(RCC_GPIOA_ENABLE_DISABLE, RCC_enuPeriphralEnable);
+  RCC_Ctrl_APB2_Clk(RCC_USART1_ENABLE_DISABLE, RCC_enuPeriphralEnable);
+  GPIO_Init(&UsartTx);
+  GPIO_CfgAlternateFn(GPIO_PORT_A, GPIO_PIN_9, GPIO_FUNC_AF7);
+  DWT_init();
+  USART_init();
+  NVIC_EnableIRQ(USART1_IRQn);
+
+  cycles = Bench_formatCycles(&characters);
+  PRINT_printf("PRINT_format: %lu cycles/char x100 (%lu chars)\r\n", (cycles * 100) / characters, characters);
+#if PRINT_BENCH_NEWLIB
+  cycles = Bench_snprintfCycles();
+  PRINT_printf("snprintf:     %lu cycles/char x100\r\n", (cycles * 100) / characters);
+#endif
+  while (1)
+  {
+  }
+}
+
+#pragma GCC diagnostic pop
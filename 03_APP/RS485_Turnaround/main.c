@@ -0,0 +1,111 @@
+#include "RCC.h"
+#include "GPIO.h"
+#include "NVIC.h"
+#include "USART.h"
+#include "DWT.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wmissing-declarations"
+#pragma GCC diagnostic ignored "-Wreturn-type"
+
+/*
+ * RS-485 driver enable turnaround: USART1 (PA9 Tx) must be configured half duplex in USART_Cfg.c with the
+ * transceiver DE on its USART_DePin (PA8 here), and DWT_PROFILING enabled in DWT_Cfg.h. BENCH_FRAMES frames
+ * are sent with USART_sendBufferAsyncZC and the DWT_PROFILE_USART_DE_TURNAROUND statistics (USART interrupt
+ * entry to the DE release) go out on ITM port 0 as min, average and max cycles and nanoseconds.
+ * The time from the stop bit to the release is that figure plus the 12 cycles of the exception entry, a
+ * scope on TX and DE shows the same edge to edge.
+ */
+#define BENCH_FRAMES            100
+#define BENCH_FRAME_SIZE        8
+#define BENCH_ITM_PORT          0
+#define BENCH_ENTRY_CYCLES      12
+
+static u8 BenchFrame[BENCH_FRAME_SIZE] = {0x55, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xAA};
+static volatile boolean BenchSent;
+
+static void Bench_print(const char* Text)
+{
+  while(*Text)
+  {
+    DWT_ITM_sendByte(BENCH_ITM_PORT, (u8)*Text);
+    Text++;
+  }
+}
+
+static void Bench_printNumber(u32 Number)
+{
+  char digits[11];
+  u8 idx = sizeof(digits) - 1;
+  digits[idx] = '\0';
+  do
+  {
+    idx--;
+    digits[idx] = (char)('0' + (Number % 10));
+    Number /= 10;
+  }while(Number != 0);
+  Bench_print(&digits[idx]);
+}
+
+static void Bench_printCycles(const char* Name, u32 Cycles)
+{
+  Bench_print(Name);
+  Bench_printNumber(Cycles);
+  Bench_print(" cycles ");
+  Bench_printNumber((u32)(((u64)Cycles * 1000000000ULL) / DWT_CPU_CLK));
+  Bench_print(" ns\n");
+}
+
+static void Bench_done(const USART_Completion_t* Completion)
+{
+  BenchSent = TRUE;
+}
+
+int main(int argc, char* argv[])
+{
+  GPIO_Pin_t UsartTx = {.GPIO_Port = GPIO_PORT_A, .GPIO_Pin = GPIO_PIN_9, .GPIO_Mode = GPIO_MODE_AF_PP, .GPIO_Speed = GPIO_SPEED_HIGH};
+  USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .data = BenchFrame, .length = BENCH_FRAME_SIZE, .CB = Bench_done};
+  DWT_Profile_t Turnaround;
+  u32 idx = 0;
+  u32 start = 0;
+  RCC_Ctrl_AHB1_Clk(RCC_GPIOA_ENABLE_DISABLE, RCC_enuPeriphralEnable);
+  RCC_Ctrl_APB2_Clk(RCC_USART1_ENABLE_DISABLE, RCC_enuPeriphralEnable);
+  GPIO_Init(&UsartTx);
+  GPIO_CfgAlternateFn(GPIO_PORT_A, GPIO_PIN_9, GPIO_FUNC_AF7);
+  DWT_init();
+  USART_init();
+  NVIC_EnableIRQ(USART1_IRQn);
+
+  for(idx = 0; idx < BENCH_FRAMES; idx++)
+  {
+    BenchSent = FALSE;
+    USART_sendBufferAsyncZC(Req);
+    while(BenchSent == FALSE)
+    {
+    }
+    /*Two character times at 9600 baud, the TC interrupt releases DE well within it*/
+    start = DWT_getCycles();
+    while((DWT_getCycles() - start) < DWT_US_TO_CYCLES(2000))
+    {
+    }
+  }
+
+  if(DWT_getProfile(DWT_PROFILE_USART_DE_TURNAROUND, &Turnaround) == DWT_OK)
+  {
+    Bench_print("releases ");
+    Bench_printNumber(Turnaround.count);
+    Bench_print("\n");
+    if(Turnaround.count != 0)
+    {
+      Bench_printCycles("min ", Turnaround.minCycles + BENCH_ENTRY_CYCLES);
+      Bench_printCycles("avg ", (u32)(Turnaround.totalCycles / Turnaround.count) + BENCH_ENTRY_CYCLES);
+      Bench_printCycles("max ", Turnaround.maxCycles + BENCH_ENTRY_CYCLES);
+    }
+  }
+  while (1)
+  {
+  }
+}
+
+#pragma GCC diagnostic pop
@@ -2,7 +2,7 @@
 #include "NVIC.h"
 #include "SYSTICK.h"
 #include "LED.h"
-#include "sched.h"
+#include "Scheduler.h"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
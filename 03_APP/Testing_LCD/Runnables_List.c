@@ -6,7 +6,7 @@
  */
 
 #include "Runnables_List.h"
-#include "sched.h"
+#include "Scheduler.h"
 
 extern void Runnable_APP1(void);
 extern void Runnable_APP2(void);
@@ -20,31 +20,37 @@ const runnable_t Runnables_List[_Runnables_Num] =
         [APP1] = {
             .name = "Toggle Led For 1 Second",
             .periodicityMS = 1000,
+            .deadlineMS = 1500,
             .callBackFn = &Runnable_APP1
         },
         [Switches_Run] = {
         	.name = "Get Switch Status",
         	.periodicityMS = 50,
+        	.deadlineMS = 100,
 			.callBackFn = &SW_Runnable
         },
         [APP2] = {
         	.name = "Control Led With Switch",
 			.periodicityMS = 50,
+			.deadlineMS = 100,
 			.callBackFn = &Runnable_APP2
         },
 		[trafficLightAPP] = {
 		    .name = "Traffic Light",
 			.periodicityMS = 1000,
+			.deadlineMS = 1500,
 			.callBackFn = &trafficLight
 		},
 		[LCD_Run] = {
 			.name = "LCD Main Task",
 			.periodicityMS = 2,
+			.deadlineMS = 50,
 			.callBackFn = &LCD_Runnable
 		},
         [LCD_task] = {
         	.name = "LCD Task",
 			.periodicityMS = 100,
+			.deadlineMS = 200,
 			.callBackFn = &LCD_writeName
         }
 };
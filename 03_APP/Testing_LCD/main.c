@@ -1,8 +1,9 @@
 #include "RCC.h"
 #include "NVIC.h"
 #include "SYSTICK.h"
+#include "TIM.h"
 #include "LCD.h"
-#include "sched.h"
+#include "Scheduler.h"
 
 
 #pragma GCC diagnostic push
@@ -14,6 +15,9 @@
 int main(int argc, char* argv[])
 {
 	RCC_Ctrl_AHB1_Clk(RCC_GPIOA_ENABLE_DISABLE,RCC_enuPeriphralEnable);
+	RCC_Ctrl_APB1_Clk(RCC_TIM2_ENABLE_DISABLE,RCC_enuPeriphralEnable);
+	TIM_init();						/*Paces the LCD enable pulses*/
+	NVIC_EnableIRQ(TIM2_IRQn);
 	LCD_InitAsync();
 	Sched_Init();
 	Sched_Start();
@@ -0,0 +1,113 @@
+#include "RCC.h"
+#include "GPIO.h"
+#include "USART.h"
+#include "DWT.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wmissing-declarations"
+#pragma GCC diagnostic ignored "-Wreturn-type"
+
+/*
+ * Blocking USART throughput benchmark: USART1 (PA9 Tx, PA10 Rx, loop them or leave Rx open) sends
+ * BENCH_BUFFER_SIZE bytes at each baud rate, once as a burst with USART_sendBlocking and once byte by byte
+ * with USART_sendByte, timed on the DWT cycle counter.
+ * Each line goes out on ITM port 0 (SWO viewer): baud, ideal bytes/s (baud / 10 for 8N1), burst bytes/s and
+ * byte by byte bytes/s. The byte by byte figure is lower since every call waits for TC before returning.
+ */
+#define BENCH_BUFFER_SIZE       512
+#define BENCH_ITM_PORT          0
+#define BENCH_TIMEOUT_US        2000000
+
+static const u32 BenchBaudRates[] = {9600, 19200, 57600, 115200, 230400, 460800, 1000000, 2000000};
+static u8 BenchBuffer[BENCH_BUFFER_SIZE];
+
+static void Bench_print(const char* Text)
+{
+  while(*Text)
+  {
+    DWT_ITM_sendByte(BENCH_ITM_PORT, (u8)*Text);
+    Text++;
+  }
+}
+
+static void Bench_printNumber(u32 Number)
+{
+  char digits[11];
+  u8 idx = sizeof(digits) - 1;
+  digits[idx] = '\0';
+  do
+  {
+    idx--;
+    digits[idx] = (char)('0' + (Number % 10));
+    Number /= 10;
+  }while(Number != 0);
+  Bench_print(&digits[idx]);
+}
+
+/*Bytes per second of Length bytes sent in Cycles*/
+static u32 Bench_rate(u32 Length, u32 Cycles)
+{
+  return (Cycles == 0) ? 0 : (u32)(((u64)Length * DWT_CPU_CLK) / Cycles);
+}
+
+static u32 Bench_sendBurst(void)
+{
+  u32 start = DWT_getCycles();
+  USART_sendBlocking(USART_NUMBER_1, BenchBuffer, BENCH_BUFFER_SIZE, BENCH_TIMEOUT_US);
+  return DWT_getCycles() - start;
+}
+
+static u32 Bench_sendBytes(void)
+{
+  USART_Req_t Req = {.USART_Number = USART_NUMBER_1};
+  u32 start = DWT_getCycles();
+  u16 idx = 0;
+  for(idx = 0; idx < BENCH_BUFFER_SIZE; idx++)
+  {
+    Req.data = &BenchBuffer[idx];
+    USART_sendByte(Req);
+  }
+  return DWT_getCycles() - start;
+}
+
+int main(int argc, char* argv[])
+{
+  GPIO_Pin_t UsartTx = {.GPIO_Port = GPIO_PORT_A, .GPIO_Pin = GPIO_PIN_9, .GPIO_Mode = GPIO_MODE_AF_PP, .GPIO_Speed = GPIO_SPEED_HIGH};
+  GPIO_Pin_t UsartRx = {.GPIO_Port = GPIO_PORT_A, .GPIO_Pin = GPIO_PIN_10, .GPIO_Mode = GPIO_MODE_AF_PP, .GPIO_Speed = GPIO_SPEED_HIGH};
+  u8 idx = 0;
+  u16 byte = 0;
+  RCC_Ctrl_AHB1_Clk(RCC_GPIOA_ENABLE_DISABLE, RCC_enuPeriphralEnable);
+  RCC_Ctrl_APB2_Clk(RCC_USART1_ENABLE_DISABLE, RCC_enuPeriphralEnable);
+  GPIO_Init(&UsartTx);
+  GPIO_Init(&UsartRx);
+  GPIO_CfgAlternateFn(GPIO_PORT_A, GPIO_PIN_9, GPIO_FUNC_AF7);
+  GPIO_CfgAlternateFn(GPIO_PORT_A, GPIO_PIN_10, GPIO_FUNC_AF7);
+  DWT_init();
+  USART_init();
+  for(byte = 0; byte < BENCH_BUFFER_SIZE; byte++)
+  {
+    BenchBuffer[byte] = (u8)byte;
+  }
+
+  Bench_print("baud ideal_Bps burst_Bps byte_Bps\n");
+  for(idx = 0; idx < (sizeof(BenchBaudRates) / sizeof(BenchBaudRates[0])); idx++)
+  {
+    if(USART_setBaudRate(USART_NUMBER_1, BenchBaudRates[idx]) == USART_OK)
+    {
+      Bench_printNumber(BenchBaudRates[idx]);
+      Bench_print(" ");
+      Bench_printNumber(BenchBaudRates[idx] / 10);
+      Bench_print(" ");
+      Bench_printNumber(Bench_rate(BENCH_BUFFER_SIZE, Bench_sendBurst()));
+      Bench_print(" ");
+      Bench_printNumber(Bench_rate(BENCH_BUFFER_SIZE, Bench_sendBytes()));
+      Bench_print("\n");
+    }
+  }
+  while (1)
+  {
+  }
+}
+
+#pragma GCC diagnostic pop
@@ -1,15 +1,17 @@
 /*
- * sched.h
+ * Scheduler.h
  *
  *  Created on: 11 Mar 2024
  *      Author: Momen El Sayed
  */
 
-#ifndef SCHED_H_
-#define SCHED_H_
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
 
 #include "std_types.h"
 
+#define SCHED_NO_RUNNABLE	0xFFFFFFFF
+
 /*******************************************************************************
  *                                Type Decelerations                           *
  *******************************************************************************/
@@ -18,9 +20,17 @@ typedef void (*runnableCB_t) (void);
 typedef struct{
 	char* name;
 	u32 periodicityMS;
+	u32 deadlineMS;			/*Max time between two completions before the watchdog is starved, 0 = not supervised*/
 	runnableCB_t callBackFn;
 }runnable_t;
 
+typedef struct{
+	u32 offender;			/*Runnable that missed its deadline*/
+	u32 running;			/*Runnable that was executing when it was detected, SCHED_NO_RUNNABLE if none*/
+	u32 elapsedMS;			/*Time since the offender's last completion*/
+	u32 watchdogResets;		/*Resets caused by the supervisor since power on*/
+}Sched_PostMortem_t;
+
 
 /*******************************************************************************
  *                              Functions Prototypes                           *
@@ -66,4 +76,38 @@ void Sched_Init();
  *****************************************************/
 void Sched_Start();
 
-#endif /* SCHED_H_ */
+/*****************************************************
+ * Function: Sched_getPostMortem
+ * Description: Reads the record the supervisor left in no-init RAM before the watchdog reset the device.
+ *
+ * Parameters:
+ *   - PostMortem: Pointer to receive the record.
+ *
+ * Return:
+ *   - TRUE if the last reset was caused by the watchdog after a missed deadline, FALSE otherwise.
+ *
+ * Usage:
+ *   Sched_PostMortem_t record;
+ *   if(Sched_getPostMortem(&record)) { ... Runnables_List[record.offender].name ... }
+ *
+ * Notes:
+ *   - Valid after Sched_Init, which reads and clears the reset flags.
+ *   - The supervisor runs in the SysTick callback: it refreshes the watchdog only while every supervised
+ *     runnable completed within its deadlineMS, so a hung runnable or a hung main loop both end in a reset.
+ *****************************************************/
+boolean Sched_getPostMortem(Sched_PostMortem_t* PostMortem);
+
+/*****************************************************
+ * Function: Sched_getLoad
+ * Description: Reads the share of the CPU time the runnables took over the last complete second, timed on
+ *              the DWT cycle counter around each scheduler pass.
+ *
+ * Return:
+ *   - The load in permille, above 1000 when passes fell behind the tick (pending ticks piled up).
+ *
+ * Notes:
+ *   - DWT_init must be called before Sched_Start, interrupt handlers are counted in the pass they preempt.
+ *****************************************************/
+u32 Sched_getLoad(void);
+
+#endif /* SCHEDULER_H_ */
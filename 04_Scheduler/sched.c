@@ -7,13 +7,34 @@
 
 #include "RCC.h"
 #include "SYSTICK.h"
-#include "sched.h"
+#include "IWDG.h"
+#include "DWT.h"
+#include "Scheduler.h"
 #include "Runnables_List.h"
 
 #define SCHED_TICK_TIME_MS 10
+#define SCHED_WATCHDOG_TIMEOUT_MS 100
+#define SCHED_POST_MORTEM_MAGIC 0x5CED0DEDUL
+#define SCHED_LOAD_WINDOW_MS 1000
+#define SCHED_LOAD_WINDOW_CYCLES ((u64)DWT_CPU_CLK * SCHED_LOAD_WINDOW_MS / 1000)
 
+/*Survives the watchdog reset, the linker script must place .noinit in RAM as NOLOAD*/
+typedef struct{
+	u32 magic;
+	Sched_PostMortem_t record;
+}Sched_NoInit_t;
 
 static volatile u32 pendingTicks = 0;
+static volatile u32 schedTimeMS = 0;
+static volatile u32 lastCompletionMS[_Runnables_Num];
+static volatile u32 runningRunnable = SCHED_NO_RUNNABLE;
+static volatile boolean supervisorTripped = FALSE;
+static Sched_NoInit_t postMortem __attribute__((section(".noinit")));
+static Sched_PostMortem_t lastPostMortem;
+static boolean lastPostMortemValid = FALSE;
+static u64 loadBusyCycles = 0;
+static u32 loadWindowMS = 0;
+static volatile u32 loadPermille = 0;
 
 extern const runnable_t Runnables_List[_Runnables_Num];
 
@@ -25,34 +46,112 @@ static void Sched()
 	{
 		if((Runnables_List[iterator].callBackFn) && ((timeStamp % Runnables_List[iterator].periodicityMS) == 0))
 		{
+			runningRunnable = iterator;
 			Runnables_List[iterator].callBackFn();
+			runningRunnable = SCHED_NO_RUNNABLE;
+			lastCompletionMS[iterator] = schedTimeMS;
 		}
 	}
 	timeStamp+= SCHED_TICK_TIME_MS;
 }
 
+/*Runs in the SysTick interrupt so it keeps checking while a runnable or the main loop is stuck*/
+static void Sched_Supervisor(void)
+{
+	u32 iterator = 0;
+	u32 elapsedMS = 0;
+	for(iterator = 0 ; (iterator < _Runnables_Num) && (supervisorTripped == FALSE); iterator++)
+	{
+		elapsedMS = schedTimeMS - lastCompletionMS[iterator];
+		if((Runnables_List[iterator].deadlineMS) && (elapsedMS > Runnables_List[iterator].deadlineMS))
+		{
+			postMortem.record.offender = iterator;
+			postMortem.record.running = runningRunnable;
+			postMortem.record.elapsedMS = elapsedMS;
+			postMortem.record.watchdogResets++;
+			postMortem.magic = SCHED_POST_MORTEM_MAGIC;
+			supervisorTripped = TRUE;
+		}
+	}
+	if(supervisorTripped == FALSE)
+	{
+		IWDG_refresh();
+	}
+}
+
+/*Adds the cycles of one scheduler pass, the load of a window is published once it's complete*/
+static void Sched_accountLoad(u32 Cycles)
+{
+	loadBusyCycles += Cycles;
+	loadWindowMS += SCHED_TICK_TIME_MS;
+	if(loadWindowMS >= SCHED_LOAD_WINDOW_MS)
+	{
+		loadPermille = (u32)((loadBusyCycles * 1000) / SCHED_LOAD_WINDOW_CYCLES);
+		loadBusyCycles = 0;
+		loadWindowMS = 0;
+	}
+}
+
 void Sched_TickCallBack(void)
 {
 	pendingTicks++;
+	schedTimeMS += SCHED_TICK_TIME_MS;
+	Sched_Supervisor();
 }
 
 void Sched_Init()
 {
+	boolean watchdogReset = FALSE;
+	IWDG_getResetFlag(&watchdogReset);
+	IWDG_clearResetFlags();
+	if(postMortem.magic != SCHED_POST_MORTEM_MAGIC)
+	{
+		/*Power on: the no-init RAM holds garbage*/
+		postMortem.magic = SCHED_POST_MORTEM_MAGIC;
+		postMortem.record.offender = SCHED_NO_RUNNABLE;
+		postMortem.record.running = SCHED_NO_RUNNABLE;
+		postMortem.record.elapsedMS = 0;
+		postMortem.record.watchdogResets = 0;
+		watchdogReset = FALSE;
+	}
+	lastPostMortem = postMortem.record;
+	lastPostMortemValid = (watchdogReset && (postMortem.record.offender != SCHED_NO_RUNNABLE)) ? TRUE : FALSE;
+	/*Don't blame the same runnable for a later reset of another cause*/
+	postMortem.record.offender = SCHED_NO_RUNNABLE;
+	postMortem.record.running = SCHED_NO_RUNNABLE;
 	SYSTICK_setTimeMS(SCHED_TICK_TIME_MS);
 	SYSTICK_setCallBack(Sched_TickCallBack, 0);
 }
 
 void Sched_Start()
 {
+	u32 start = 0;
+	IWDG_start(SCHED_WATCHDOG_TIMEOUT_MS);
 	SYSTICK_start(SYSTICK_CLK_AHB);
 	while(1)
 	{
 		if(pendingTicks)
 		{
 			pendingTicks--;
+			start = DWT_getCycles();
 			Sched();
+			Sched_accountLoad(DWT_getCycles() - start);
 		}
 	}
 }
 
+boolean Sched_getPostMortem(Sched_PostMortem_t* PostMortem)
+{
+	boolean valid = FALSE;
+	if(PostMortem != NULL_PTR)
+	{
+		*PostMortem = lastPostMortem;
+		valid = lastPostMortemValid;
+	}
+	return valid;
+}
 
+u32 Sched_getLoad(void)
+{
+	return loadPermille;
+}
@@ -0,0 +1,685 @@
+#define _GNU_SOURCE                 /*posix_openpt, ptsname and cfmakeraw*/
+/******************************************************************************
+ *
+ * Module: USART_Emu
+ *
+ * File Name: USART_Emu.c
+ *
+ * Description: Source file for the host model of the STM32F401xC USART peripheral
+ *
+ * Author: Momen Elsayed Shaban
+ *
+ *******************************************************************************/
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "USART_Emu.h"
+#include "USART.h"
+#include "USART_Port.h"
+#include "GPIO.h"
+#include "DMA.h"
+#include "ICU.h"
+
+/*termios.h names its carriage return delays CR1 to CR3, here they are the control registers*/
+#undef CR1
+#undef CR2
+#undef CR3
+
+/*******************************************************************************
+ *                                   Defines                                   *
+ *******************************************************************************/
+#define EMU_SR_PE                   0x00000001
+#define EMU_SR_FE                   0x00000002
+#define EMU_SR_NE                   0x00000004
+#define EMU_SR_ORE                  0x00000008
+#define EMU_SR_IDLE                 0x00000010
+#define EMU_SR_RXNE                 0x00000020
+#define EMU_SR_TC                   0x00000040
+#define EMU_SR_TXE                  0x00000080
+#define EMU_SR_RESET                (EMU_SR_TXE | EMU_SR_TC)
+#define EMU_CR1_RWU                 0x00000002
+#define EMU_CR1_RE                  0x00000004
+#define EMU_CR1_TE                  0x00000008
+#define EMU_CR1_IDLEIE              0x00000010
+#define EMU_CR1_RXNEIE              0x00000020
+#define EMU_CR1_TCIE                0x00000040
+#define EMU_CR1_TXEIE               0x00000080
+#define EMU_CR1_PEIE                0x00000100
+#define EMU_CR1_PCE                 0x00000400
+#define EMU_CR1_WAKE                0x00000800
+#define EMU_CR1_M                   0x00001000
+#define EMU_CR1_UE                  0x00002000
+#define EMU_CR1_OVER8               0x00008000
+#define EMU_CR2_ADD_MASK            0x0000000F
+#define EMU_CR2_STOP_MASK           0x00003000
+#define EMU_CR2_STOP_SHIFT          12
+#define EMU_CR3_EIE                 0x00000001
+#define EMU_NS_PER_SECOND           1000000000ULL
+#define EMU_RX_QUEUE_MASK           (USART_EMU_RX_QUEUE_SIZE - 1)
+#define EMU_MAX_HANDLER_CALLS       16          /*Handler calls per dispatch, bounds a handler that never clears its event*/
+#define EMU_PTY_CHUNK               64
+#define EMU_NO_PTY                  (-1)
+
+#if (USART_EMU_RX_QUEUE_SIZE & EMU_RX_QUEUE_MASK) != 0
+#error "USART_EMU_RX_QUEUE_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+ *                                Type Decelerations                           *
+ *******************************************************************************/
+typedef struct
+{
+    volatile u32 SR;
+    volatile u32 DR;
+    volatile u32 BRR;
+    volatile u32 CR1;
+    volatile u32 CR2;
+    volatile u32 CR3;
+    volatile u32 GTPR;
+}USART_Registers_t;
+
+/*A character on the RX line and the time its stop bit ends*/
+typedef struct
+{
+    u16 data;
+    u64 end;
+}Emu_Char_t;
+
+typedef struct
+{
+    /*Transmitter: data register and shift register*/
+    u16 tdr;
+    boolean tdrFull;
+    boolean shifting;
+    u16 shiftData;
+    u64 shiftEnd;
+    /*Receiver*/
+    u16 rdr;
+    Emu_Char_t rxQueue[USART_EMU_RX_QUEUE_SIZE];
+    u32 rxHead;
+    u32 rxTail;
+    u64 rxLineEnd;          /*End of the last character put on the RX line*/
+    u64 lastRxEnd;          /*End of the last character received, for the idle line detection*/
+    boolean idlePending;
+    boolean srRead;         /*SR read since the last DR access, the first half of the clearing sequences*/
+    /*Times the flags were raised, for the interrupt latency*/
+    u64 txeTime;
+    u64 tcTime;
+    u64 rxneTime;
+    u64 idleTime;
+    boolean loopback;
+    int pty;
+    u32 control;            /*CR1 at the last look, to see the interrupt enables the driver sets*/
+    boolean inHandler;
+    USART_EmuStats_t stats;
+}Emu_Instance_t;
+
+/*******************************************************************************
+ *                                   Variables                                 *
+ *******************************************************************************/
+extern USART_Registers_t USART_MockRegisters[USART_EMU_INSTANCES];
+extern void USART1_IRQHandler(void);
+extern void USART2_IRQHandler(void);
+extern void USART6_IRQHandler(void);
+
+static void (*const Emu_Handlers[USART_EMU_INSTANCES])(void) = {USART1_IRQHandler, USART2_IRQHandler, USART6_IRQHandler};
+static Emu_Instance_t Emu[USART_EMU_INSTANCES];
+
+/*Stop bits of the CR2 STOP field in half bits: 1, 0.5, 2 and 1.5*/
+static const u8 Emu_StopHalfBits[4] = {2, 1, 4, 3};
+
+/*******************************************************************************
+ *                              Static Functions                               *
+ *******************************************************************************/
+static u64 Emu_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((u64)now.tv_sec * EMU_NS_PER_SECOND) + (u64)now.tv_nsec;
+}
+
+/*Start bit, M data bits (parity included) and the stop bits at CLK / USARTDIV, USARTDIV read back from BRR*/
+static u64 Emu_charTimeNs(u8 USART_Number)
+{
+    const USART_Registers_t* Usart = &USART_MockRegisters[USART_Number];
+    u64 divider = Usart->BRR;
+    u64 halfBits = 2 * (1 + ((Usart->CR1 & EMU_CR1_M) ? 9 : 8)) +
+                   Emu_StopHalfBits[(Usart->CR2 & EMU_CR2_STOP_MASK) >> EMU_CR2_STOP_SHIFT];
+    if(Usart->CR1 & EMU_CR1_OVER8)
+    {
+        divider = ((divider >> 1) & ~0x7ULL) | (divider & 0x7ULL);
+    }
+    if(divider == 0)
+    {
+        divider = 0xFFFF;
+    }
+    return (divider * halfBits * EMU_NS_PER_SECOND) / (2ULL * USART_CLK);
+}
+
+static u16 Emu_wordMask(u8 USART_Number)
+{
+    return (USART_MockRegisters[USART_Number].CR1 & EMU_CR1_M) ? 0x1FF : 0xFF;
+}
+
+/*Most significant data bit, the address mark of the mute mode*/
+static u16 Emu_addressMark(u8 USART_Number)
+{
+    u8 bit = (USART_MockRegisters[USART_Number].CR1 & EMU_CR1_M) ? 8 : 7;
+    if(USART_MockRegisters[USART_Number].CR1 & EMU_CR1_PCE)
+    {
+        bit--;
+    }
+    return (u16)(1U << bit);
+}
+
+static void Emu_queueRx(u8 USART_Number, u16 Data, u64 End)
+{
+    Emu_Instance_t* const Instance = &Emu[USART_Number];
+    if((Instance->rxHead - Instance->rxTail) < USART_EMU_RX_QUEUE_SIZE)
+    {
+        Instance->rxQueue[Instance->rxHead & EMU_RX_QUEUE_MASK].data = Data;
+        Instance->rxQueue[Instance->rxHead & EMU_RX_QUEUE_MASK].end = End;
+        Instance->rxHead++;
+        Instance->rxLineEnd = End;
+    }
+}
+
+/*A character that left the shift register at End goes to the wired receivers*/
+static void Emu_lineOut(u8 USART_Number, u16 Data, u64 End)
+{
+    Emu_Instance_t* const Instance = &Emu[USART_Number];
+    u8 byte = (u8)Data;
+    Instance->stats.txCharacters++;
+    if(Instance->loopback == TRUE)
+    {
+        Emu_queueRx(USART_Number, Data, End);
+    }
+    if(Instance->pty != EMU_NO_PTY)
+    {
+        (void)write(Instance->pty, &byte, 1);      /*A full pty drops it, like a line nobody listens to*/
+    }
+}
+
+/*One character time without a start bit after the last reception: IDLE, or the idle line wakeup*/
+static void Emu_checkIdle(u8 USART_Number, u64 Until)
+{
+    Emu_Instance_t* const Instance = &Emu[USART_Number];
+    USART_Registers_t* const Usart = &USART_MockRegisters[USART_Number];
+    const u64 idleAt = Instance->lastRxEnd + Emu_charTimeNs(USART_Number);
+    if((Instance->idlePending == TRUE) && (idleAt <= Until))
+    {
+        Instance->idlePending = FALSE;
+        if(Usart->CR1 & EMU_CR1_RWU)
+        {
+            if((Usart->CR1 & EMU_CR1_WAKE) == 0)
+            {
+                Usart->CR1 &= ~EMU_CR1_RWU;
+            }
+        }
+        else
+        {
+            Usart->SR |= EMU_SR_IDLE;
+            Instance->idleTime = idleAt;
+        }
+    }
+}
+
+static void Emu_receive(u8 USART_Number, u16 Data, u64 End)
+{
+    Emu_Instance_t* const Instance = &Emu[USART_Number];
+    USART_Registers_t* const Usart = &USART_MockRegisters[USART_Number];
+    Instance->stats.rxCharacters++;
+    Data &= Emu_wordMask(USART_Number);
+    Emu_checkIdle(USART_Number, End - Emu_charTimeNs(USART_Number));
+    if((Usart->CR1 & (EMU_CR1_UE | EMU_CR1_RE)) == (EMU_CR1_UE | EMU_CR1_RE))
+    {
+        if((Usart->CR1 & EMU_CR1_WAKE) && (Data & Emu_addressMark(USART_Number)))
+        {
+            if((Data & EMU_CR2_ADD_MASK) == (Usart->CR2 & EMU_CR2_ADD_MASK))
+            {
+                Usart->CR1 &= ~EMU_CR1_RWU;
+            }
+            else
+            {
+                Usart->CR1 |= EMU_CR1_RWU;
+            }
+        }
+        if((Usart->CR1 & EMU_CR1_RWU) == 0)
+        {
+            if(Usart->SR & EMU_SR_RXNE)
+            {
+                Usart->SR |= EMU_SR_ORE;
+                Instance->stats.overruns++;
+            }
+            else
+            {
+                Instance->rdr = Data;
+                Usart->SR |= EMU_SR_RXNE;
+                Instance->rxneTime = End;
+            }
+        }
+        Instance->lastRxEnd = End;
+        Instance->idlePending = TRUE;
+    }
+}
+
+/*
+ * Brings the instance to Now: finishes the characters whose stop bit ended and takes the next ones.
+ * A side stops at an event its interrupt is enabled for, the handler runs at that point of the line time
+ * and the host scheduling delays before the call don't overrun the receiver or stretch the transmission.
+ */
+static void Emu_advance(u8 USART_Number, u64 Now)
+{
+    Emu_Instance_t* const Instance = &Emu[USART_Number];
+    USART_Registers_t* const Usart = &USART_MockRegisters[USART_Number];
+    while((Instance->shifting == TRUE) && (Instance->shiftEnd <= Now) &&
+          (((Usart->SR & EMU_SR_TXE) == 0) || ((Usart->CR1 & EMU_CR1_TXEIE) == 0)))
+    {
+        Emu_lineOut(USART_Number, Instance->shiftData, Instance->shiftEnd);
+        if(Instance->tdrFull == TRUE)
+        {
+            Instance->shiftData = Instance->tdr;
+            Instance->tdrFull = FALSE;
+            Usart->SR |= EMU_SR_TXE;
+            Instance->txeTime = Instance->shiftEnd;
+            Instance->shiftEnd += Emu_charTimeNs(USART_Number);
+        }
+        else
+        {
+            Instance->shifting = FALSE;
+            Usart->SR |= EMU_SR_TC;
+            Instance->tcTime = Instance->shiftEnd;
+        }
+    }
+    while((Instance->rxTail != Instance->rxHead) && (Instance->rxQueue[Instance->rxTail & EMU_RX_QUEUE_MASK].end <= Now) &&
+          (((Usart->SR & EMU_SR_RXNE) == 0) || ((Usart->CR1 & EMU_CR1_RXNEIE) == 0)))
+    {
+        Emu_receive(USART_Number, Instance->rxQueue[Instance->rxTail & EMU_RX_QUEUE_MASK].data,
+                    Instance->rxQueue[Instance->rxTail & EMU_RX_QUEUE_MASK].end);
+        Instance->rxTail++;
+    }
+    if(Instance->rxTail == Instance->rxHead)
+    {
+        Emu_checkIdle(USART_Number, Now);
+    }
+}
+
+/*Earliest time among the enabled pending events, 0 if none is pending*/
+static u64 Emu_pendingSince(u8 USART_Number)
+{
+    const Emu_Instance_t* const Instance = &Emu[USART_Number];
+    const USART_Registers_t* const Usart = &USART_MockRegisters[USART_Number];
+    const u32 status = Usart->SR;
+    const u32 control = Usart->CR1;
+    u64 since = 0;
+    u64 times[4] = {0};
+    u8 idx = 0;
+    times[0] = ((status & EMU_SR_TXE) && (control & EMU_CR1_TXEIE)) ? Instance->txeTime : 0;
+    times[1] = ((status & EMU_SR_TC) && (control & EMU_CR1_TCIE)) ? Instance->tcTime : 0;
+    times[2] = (((status & (EMU_SR_RXNE | EMU_SR_ORE)) && (control & EMU_CR1_RXNEIE)) ||
+                ((status & EMU_SR_PE) && (control & EMU_CR1_PEIE)) ||
+                ((status & (EMU_SR_FE | EMU_SR_NE | EMU_SR_ORE)) && (Usart->CR3 & EMU_CR3_EIE))) ? Instance->rxneTime : 0;
+    times[3] = ((status & EMU_SR_IDLE) && (control & EMU_CR1_IDLEIE)) ? Instance->idleTime : 0;
+    for(idx = 0; idx < 4; idx++)
+    {
+        if((times[idx] != 0) && ((since == 0) || (times[idx] < since)))
+        {
+            since = times[idx];
+        }
+    }
+    return since;
+}
+
+/*An event already pending when its interrupt gets enabled (TXE of an idle transmitter) counts from the
+  enable, as seen at the first register access or poll after it*/
+static void Emu_trackEnables(u8 USART_Number, u64 Now)
+{
+    Emu_Instance_t* const Instance = &Emu[USART_Number];
+    const u32 control = USART_MockRegisters[USART_Number].CR1;
+    const u32 enabled = control & ~Instance->control;
+    if(enabled & EMU_CR1_TXEIE)
+    {
+        Instance->txeTime = Now;
+    }
+    if(enabled & EMU_CR1_TCIE)
+    {
+        Instance->tcTime = Now;
+    }
+    if(enabled & (EMU_CR1_RXNEIE | EMU_CR1_PEIE))
+    {
+        Instance->rxneTime = Now;
+    }
+    if(enabled & EMU_CR1_IDLEIE)
+    {
+        Instance->idleTime = Now;
+    }
+    Instance->control = control;
+}
+
+/*Takes the instance interrupt while an enabled event is pending, never nested in its own handler*/
+static void Emu_dispatch(u8 USART_Number)
+{
+    Emu_Instance_t* const Instance = &Emu[USART_Number];
+    u64 since = 0;
+    u64 now = 0;
+    u8 calls = 0;
+    if(Instance->inHandler == FALSE)
+    {
+        Emu_trackEnables(USART_Number, Emu_now());
+        since = Emu_pendingSince(USART_Number);
+        while((since != 0) && (calls < EMU_MAX_HANDLER_CALLS))
+        {
+            now = Emu_now();
+            if((now > since) && ((now - since) > Instance->stats.latencyMaxNs))
+            {
+                Instance->stats.latencyMaxNs = (u32)(now - since);
+            }
+            Instance->stats.latencyTotalNs += (now > since) ? (now - since) : 0;
+            Instance->stats.interrupts++;
+            Instance->inHandler = TRUE;
+            Emu_Handlers[USART_Number]();
+            Instance->inHandler = FALSE;
+            calls++;
+            now = Emu_now();
+            Emu_advance(USART_Number, now);
+            Emu_trackEnables(USART_Number, now);
+            since = Emu_pendingSince(USART_Number);
+        }
+    }
+}
+
+static void Emu_service(u8 USART_Number)
+{
+    Emu_advance(USART_Number, Emu_now());
+    Emu_dispatch(USART_Number);
+}
+
+static void Emu_pollPty(u8 USART_Number)
+{
+    Emu_Instance_t* const Instance = &Emu[USART_Number];
+    u8 chunk[EMU_PTY_CHUNK];
+    ssize_t count = 0;
+    ssize_t idx = 0;
+    u16 data[EMU_PTY_CHUNK];
+    if(Instance->pty != EMU_NO_PTY)
+    {
+        count = read(Instance->pty, chunk, sizeof(chunk));
+        for(idx = 0; idx < count; idx++)
+        {
+            data[idx] = chunk[idx];
+        }
+        if(count > 0)
+        {
+            USART_Emu_sendToRx(USART_Number, data, (u32)count);
+        }
+    }
+}
+
+/*******************************************************************************
+ *                              APIs Implementation                            *
+ *******************************************************************************/
+void USART_Emu_init(void)
+{
+    u8 idx = 0;
+    for(idx = 0; idx < USART_EMU_INSTANCES; idx++)
+    {
+        if(Emu[idx].pty > 0)
+        {
+            close(Emu[idx].pty);
+        }
+        memset(&Emu[idx], 0, sizeof(Emu[idx]));
+        Emu[idx].pty = EMU_NO_PTY;
+        memset((void*)&USART_MockRegisters[idx], 0, sizeof(USART_MockRegisters[idx]));
+        USART_MockRegisters[idx].SR = EMU_SR_RESET;
+    }
+}
+
+USART_Emu_ErrorStatus_t USART_Emu_setLoopback(u8 USART_Number, boolean Enable)
+{
+    USART_Emu_ErrorStatus_t ErrorStatus = USART_Emu_OK;
+    if(USART_Number >= USART_EMU_INSTANCES)
+    {
+        ErrorStatus = USART_Emu_InvalidNumber;
+    }
+    else
+    {
+        Emu[USART_Number].loopback = Enable;
+    }
+    return ErrorStatus;
+}
+
+USART_Emu_ErrorStatus_t USART_Emu_openPty(u8 USART_Number, char* Name, u32 Size)
+{
+    USART_Emu_ErrorStatus_t ErrorStatus = USART_Emu_OK;
+    struct termios raw;
+    int pty = EMU_NO_PTY;
+    if(Name == NULL_PTR)
+    {
+        ErrorStatus = USART_Emu_NullPtr;
+    }
+    else if(USART_Number >= USART_EMU_INSTANCES)
+    {
+        ErrorStatus = USART_Emu_InvalidNumber;
+    }
+    else
+    {
+        pty = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+        if((pty < 0) || (grantpt(pty) != 0) || (unlockpt(pty) != 0) || (ptsname(pty) == NULL_PTR) ||
+           (tcgetattr(pty, &raw) != 0))
+        {
+            ErrorStatus = USART_Emu_PtyError;
+        }
+        else
+        {
+            /*Raw so the bytes cross unchanged (no echo, no line editing, no CR/LF translation)*/
+            cfmakeraw(&raw);
+            tcsetattr(pty, TCSANOW, &raw);
+            strncpy(Name, ptsname(pty), Size);
+            if(Size != 0)
+            {
+                Name[Size - 1] = '\0';
+            }
+            Emu[USART_Number].pty = pty;
+        }
+        if((ErrorStatus != USART_Emu_OK) && (pty >= 0))
+        {
+            close(pty);
+        }
+    }
+    return ErrorStatus;
+}
+
+USART_Emu_ErrorStatus_t USART_Emu_sendToRx(u8 USART_Number, const u16* Data, u32 Length)
+{
+    USART_Emu_ErrorStatus_t ErrorStatus = USART_Emu_OK;
+    u64 start = 0;
+    u32 idx = 0;
+    if(Data == NULL_PTR)
+    {
+        ErrorStatus = USART_Emu_NullPtr;
+    }
+    else if(USART_Number >= USART_EMU_INSTANCES)
+    {
+        ErrorStatus = USART_Emu_InvalidNumber;
+    }
+    else
+    {
+        start = Emu_now();
+        for(idx = 0; idx < Length; idx++)
+        {
+            if(Emu[USART_Number].rxLineEnd > start)
+            {
+                start = Emu[USART_Number].rxLineEnd;
+            }
+            Emu_queueRx(USART_Number, Data[idx], start + Emu_charTimeNs(USART_Number));
+        }
+    }
+    return ErrorStatus;
+}
+
+void USART_Emu_poll(void)
+{
+    u8 idx = 0;
+    for(idx = 0; idx < USART_EMU_INSTANCES; idx++)
+    {
+        Emu_pollPty(idx);
+        Emu_service(idx);
+    }
+}
+
+USART_Emu_ErrorStatus_t USART_Emu_getStats(u8 USART_Number, USART_EmuStats_t* Stats)
+{
+    USART_Emu_ErrorStatus_t ErrorStatus = USART_Emu_OK;
+    if(Stats == NULL_PTR)
+    {
+        ErrorStatus = USART_Emu_NullPtr;
+    }
+    else if(USART_Number >= USART_EMU_INSTANCES)
+    {
+        ErrorStatus = USART_Emu_InvalidNumber;
+    }
+    else
+    {
+        *Stats = Emu[USART_Number].stats;
+    }
+    return ErrorStatus;
+}
+
+USART_Emu_ErrorStatus_t USART_Emu_resetStats(u8 USART_Number)
+{
+    USART_Emu_ErrorStatus_t ErrorStatus = USART_Emu_OK;
+    if(USART_Number >= USART_EMU_INSTANCES)
+    {
+        ErrorStatus = USART_Emu_InvalidNumber;
+    }
+    else
+    {
+        memset(&Emu[USART_Number].stats, 0, sizeof(Emu[USART_Number].stats));
+    }
+    return ErrorStatus;
+}
+
+u32 USART_Port_readSR(u8 USART_Number)
+{
+    Emu_service(USART_Number);
+    Emu[USART_Number].srRead = TRUE;
+    return USART_MockRegisters[USART_Number].SR;
+}
+
+u32 USART_Port_readDR(u8 USART_Number)
+{
+    Emu_Instance_t* const Instance = &Emu[USART_Number];
+    USART_Registers_t* const Usart = &USART_MockRegisters[USART_Number];
+    Emu_service(USART_Number);
+    Usart->SR &= ~EMU_SR_RXNE;
+    if(Instance->srRead == TRUE)
+    {
+        Usart->SR &= ~(EMU_SR_ORE | EMU_SR_IDLE | EMU_SR_PE | EMU_SR_FE | EMU_SR_NE);
+        Instance->srRead = FALSE;
+    }
+    Usart->DR = Instance->rdr;
+    return Instance->rdr;
+}
+
+void USART_Port_writeDR(u8 USART_Number, u32 Value)
+{
+    Emu_Instance_t* const Instance = &Emu[USART_Number];
+    USART_Registers_t* const Usart = &USART_MockRegisters[USART_Number];
+    u64 now = 0;
+    Emu_service(USART_Number);
+    now = Emu_now();
+    if(Instance->srRead == TRUE)
+    {
+        Usart->SR &= ~EMU_SR_TC;
+        Instance->srRead = FALSE;
+    }
+    Usart->DR = Value;
+    if((Usart->CR1 & (EMU_CR1_UE | EMU_CR1_TE)) == (EMU_CR1_UE | EMU_CR1_TE))
+    {
+        Instance->tdr = (u16)(Value & Emu_wordMask(USART_Number));
+        if(Instance->shifting == FALSE)
+        {
+            /*An empty shift register takes the character at once, TXE is set again*/
+            Instance->shifting = TRUE;
+            Instance->shiftData = Instance->tdr;
+            Instance->shiftEnd = now + Emu_charTimeNs(USART_Number);
+            Instance->txeTime = now;
+            Usart->SR |= EMU_SR_TXE;
+        }
+        else
+        {
+            Instance->tdrFull = TRUE;
+            Usart->SR &= ~EMU_SR_TXE;
+        }
+    }
+}
+
+/*******************************************************************************
+ *                     Host peripherals USART.c links against                  *
+ *******************************************************************************/
+/*The pins have nothing to drive on the host*/
+GPIO_ErrorStatus_t GPIO_Init(GPIO_Pin_t* GPIOx)
+{
+    return (GPIOx == NULL_PTR) ? GPIO_NULLPTR : GPIO_OK;
+}
+
+GPIO_ErrorStatus_t GPIO_setPinValue(void* GPIO_Port, u8 GPIO_pin, u8 GPIO_State)
+{
+    (void)GPIO_pin;
+    (void)GPIO_State;
+    return (GPIO_Port == NULL_PTR) ? GPIO_NULLPTR : GPIO_OK;
+}
+
+GPIO_ErrorStatus_t GPIO_CfgAlternateFn(void* GPIO_Port, u32 GPIO_Pin, u32 GPIO_AF)
+{
+    (void)GPIO_Pin;
+    (void)GPIO_AF;
+    return (GPIO_Port == NULL_PTR) ? GPIO_NULLPTR : GPIO_OK;
+}
+
+/*No stream is ever free on the host, USART_init keeps every instance on its interrupt path*/
+DMA_ErrorStatus_t DMA_allocStream(u8 DMA_Controller, u8 DMA_Stream)
+{
+    (void)DMA_Controller;
+    (void)DMA_Stream;
+    return DMA_Busy;
+}
+
+DMA_ErrorStatus_t DMA_freeStream(u8 DMA_Controller, u8 DMA_Stream)
+{
+    (void)DMA_Controller;
+    (void)DMA_Stream;
+    return DMA_NotAllocated;
+}
+
+DMA_ErrorStatus_t DMA_startTransfer(const DMA_Transfer_t* DMA_Transfer)
+{
+    (void)DMA_Transfer;
+    return DMA_NotAllocated;
+}
+
+DMA_ErrorStatus_t DMA_stopTransfer(u8 DMA_Controller, u8 DMA_Stream)
+{
+    (void)DMA_Controller;
+    (void)DMA_Stream;
+    return DMA_NotAllocated;
+}
+
+DMA_ErrorStatus_t DMA_getRemaining(u8 DMA_Controller, u8 DMA_Stream, u16* Remaining)
+{
+    (void)DMA_Controller;
+    (void)DMA_Stream;
+    (void)Remaining;
+    return DMA_NotAllocated;
+}
+
+/*No capture input watches the line, USART_startAutoBaud reports USART_InvalidCapture*/
+ICU_ErrorStatus_t ICU_setEdgeCallBack(u8 ICU_Name, ICU_EdgeCallBack_t CB)
+{
+    (void)ICU_Name;
+    (void)CB;
+    return ICU_InvalidName;
+}
@@ -0,0 +1,111 @@
+/******************************************************************************
+ *
+ * Module: USART_Emu
+ *
+ * File Name: USART_Emu.h
+ *
+ * Description: Header file for the host model of the STM32F401xC USART peripheral, runs the real USART
+ *              driver (USART.c built with HOST_BUILD) and its interrupt handlers on Linux
+ *
+ * Author: Momen Elsayed Shaban
+ *
+ *******************************************************************************/
+#ifndef USART_EMU_H_
+#define USART_EMU_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                   Defines                                   *
+ *******************************************************************************/
+#define USART_EMU_INSTANCES         3           /*USART1, USART2 and USART6, indexed by USART_NUMBER_x*/
+#define USART_EMU_RX_QUEUE_SIZE     1024        /*Characters on their way to a receiver, must be a power of two*/
+
+/*******************************************************************************
+ *                                Type Decelerations                           *
+ *******************************************************************************/
+/*
+ * Model:
+ * ------
+ * The register block is the one USART.c uses on the host (USART_MockRegisters). CR1, CR2, CR3 and BRR are
+ * plain memory read by the model, SR and DR go through the register access port of the driver
+ * (USART_Port.h), which the model implements so their side effects happen:
+ *   - A DR write fills the transmit data register, it moves to the shift register (TXE set again) as soon
+ *     as that one is empty, each character takes start + M data + stop bits at the BRR baud rate on the
+ *     monotonic clock. TC is set when the shift register empties with nothing behind it and cleared by an
+ *     SR read followed by a DR write.
+ *   - A received character sets RXNE at the end of its stop bit, or ORE if RXNE was still set. A DR read
+ *     clears RXNE, after an SR read also ORE and IDLE. IDLE is set one character time after the last one.
+ *   - Mute mode follows the WAKE, RWU and ADD rules of the hardware.
+ * Interrupts are taken when the driver accesses SR or DR from the thread context and on USART_Emu_poll,
+ * the instance handler is called while an enabled event is pending. The line time of a side waits at an
+ * event its interrupt is enabled for until the handler ran, so host scheduling delays show in the latency
+ * (time from the event to the handler call) but don't overrun the receiver. Polled flags get no such help.
+ */
+typedef struct
+{
+    u32 interrupts;             /*Handler calls*/
+    u32 txCharacters;           /*Characters that left the shift register*/
+    u32 rxCharacters;           /*Characters that reached the receiver (including overrun and muted ones)*/
+    u32 overruns;
+    u64 latencyTotalNs;
+    u32 latencyMaxNs;
+}USART_EmuStats_t;
+
+typedef enum{
+    USART_Emu_OK,
+    USART_Emu_InvalidNumber,
+    USART_Emu_NullPtr,
+    USART_Emu_PtyError
+}USART_Emu_ErrorStatus_t;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/*****************************************************
+ * Function: USART_Emu_init
+ * Description: Resets the model of every instance (idle lines, empty registers, no loopback nor pty),
+ *              call it before USART_init.
+ *****************************************************/
+void USART_Emu_init(void);
+
+/*****************************************************
+ * Function: USART_Emu_setLoopback
+ * Description: Wires the instance TX line to its own RX line, each sent character reaches the receiver
+ *              at the end of its stop bit.
+ *****************************************************/
+USART_Emu_ErrorStatus_t USART_Emu_setLoopback(u8 USART_Number, boolean Enable);
+
+/*****************************************************
+ * Function: USART_Emu_openPty
+ * Description: Bridges the instance to a new pseudo terminal in raw mode, its slave path (e.g. /dev/pts/3)
+ *              is copied to Name for a terminal program or another process. Sent characters are written
+ *              to it, characters read from it are received back to back at the instance baud rate.
+ *
+ * Return:
+ *   - USART_Emu_OK, USART_Emu_InvalidNumber, USART_Emu_NullPtr or USART_Emu_PtyError.
+ *****************************************************/
+USART_Emu_ErrorStatus_t USART_Emu_openPty(u8 USART_Number, char* Name, u32 Size);
+
+/*****************************************************
+ * Function: USART_Emu_sendToRx
+ * Description: Puts characters on the instance RX line, back to back after what is already on it.
+ *****************************************************/
+USART_Emu_ErrorStatus_t USART_Emu_sendToRx(u8 USART_Number, const u16* Data, u32 Length);
+
+/*****************************************************
+ * Function: USART_Emu_poll
+ * Description: Advances every line to the current time, moves the pty bytes and takes the pending
+ *              interrupts, the host equivalent of waiting for an interrupt in a main loop.
+ *****************************************************/
+void USART_Emu_poll(void);
+
+/*****************************************************
+ * Function: USART_Emu_getStats / USART_Emu_resetStats
+ * Description: Reads or clears the model counters of an instance.
+ *****************************************************/
+USART_Emu_ErrorStatus_t USART_Emu_getStats(u8 USART_Number, USART_EmuStats_t* Stats);
+
+USART_Emu_ErrorStatus_t USART_Emu_resetStats(u8 USART_Number);
+
+#endif /*USART_EMU_H_*/
@@ -0,0 +1,28 @@
+#!/bin/sh
+#
+# Builds the USART emulator benchmark on the host: ./build.sh [output], then run it with ./usart_bench
+# (or ./usart_bench --pty). The drivers include their headers as "MCAL/<Module>/<File>.h" and
+# "LIB/<File>.h", the script maps these names onto the repository folders in a temporary include folder.
+# USART_Cfg.c isn't built: main.c has its own USART_Cfg table, linking both gives a duplicate definition.
+#
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HERE/../.." && pwd)
+OUT=${1:-usart_bench}
+INC=$(mktemp -d)
+trap 'rm -rf "$INC"' EXIT
+
+mkdir "$INC/MCAL"
+ln -s "$ROOT/00_LIB" "$INC/LIB"
+INCLUDES="-I$INC -I$ROOT/00_LIB -I$HERE"
+for DIR in "$ROOT"/01_MCAL/*/; do
+    DIR=${DIR%/}
+    NAME=$(basename "$DIR")
+    ln -s "$DIR" "$INC/MCAL/${NAME#*_}"
+    INCLUDES="$INCLUDES -I$DIR"
+done
+
+gcc -std=gnu11 -O2 -Wall -Wextra -DHOST_BUILD $INCLUDES \
+    "$HERE/main.c" "$HERE/USART_Emu.c" "$ROOT/01_MCAL/04_USART/USART.c" "$ROOT/01_MCAL/08_DWT/DWT.c" \
+    -o "$OUT"
@@ -0,0 +1,300 @@
+#include <stdio.h>
+#include <string.h>
+#include "USART.h"
+#include "DWT.h"
+#include "USART_Emu.h"
+
+/*
+ * USART driver benchmarks on the host model: the real USART.c (built with HOST_BUILD) runs against
+ * USART_Emu with USART1 looped back, at each baud rate BENCH_BYTES are sent with
+ *   - sync:      USART_sendBlocking, polling TXE then TC.
+ *   - interrupt: one USART_sendBufferAsyncZC request of the whole buffer.
+ *   - queued:    BENCH_CHUNK byte requests kept posted in the transmit queue.
+ * and the line prints the achieved and ideal bytes/s, the interrupts taken, their average and worst
+ * latency (event to handler) and whether the continuous receive ring got every byte back in order.
+ * The sync API doesn't drain the ring while it blocks, it runs without the loopback.
+ *
+ * The mute line then counts the receive interrupts (handler calls of the continuous receive) of the same
+ * multi-drop traffic, BENCH_MUTE_FRAMES frames for BENCH_MUTE_NODES nodes put on the USART1 RX line, with
+ * the receiver never muted (plain address bytes) and muted with the address mark wakeup (USART1 is node
+ * BENCH_MUTE_ADDRESS), and whether the muted node still got its own frames. The benchmark data keeps bit 7
+ * clear, so it never carries the address mark of the 8 bit words.
+ *
+ * With --pty USART1 is bridged to a pseudo terminal instead and echoes what it receives, open the printed
+ * path with a terminal program.
+ *
+ * Build with ./build.sh (gcc -std=gnu11 -O2 -DHOST_BUILD main.c USART_Emu.c USART.c DWT.c with the include
+ * folders mapped, see the script), not with USART_Cfg.c: the USART_Cfg table below replaces it.
+ */
+#define BENCH_BYTES             2048
+#define BENCH_CHUNK             32
+#define BENCH_TIMEOUT_US        10000000
+#define BENCH_PTY_NAME_SIZE     64
+#define BENCH_ECHO_SIZE         64
+#define BENCH_MUTE_NODES        5
+#define BENCH_MUTE_FRAMES       50
+#define BENCH_MUTE_DATA         16
+#define BENCH_MUTE_ADDRESS      2
+#define BENCH_MUTE_MARK         0x80        /*Most significant bit of an 8 bit word without parity*/
+#define BENCH_MUTE_CHARS        (BENCH_MUTE_FRAMES * (BENCH_MUTE_DATA + 1))
+
+typedef enum{
+  BENCH_SYNC,
+  BENCH_INTERRUPT,
+  BENCH_QUEUED,
+  _BENCH_API_NUM
+}Bench_Api_t;
+
+const USART_Cfg_t USART_Cfg[_USART_Num] = {
+  [USART1] = {
+    .USART_Number = USART_NUMBER_1,
+    USART_BRR_CFG(115200, USART_OVERSAMPLING_8),
+    .USART_WordLen = USART_WORD_LEN_8,
+    .USART_ParityControl = USART_PARITY_CONTROL_DISABLE,
+    .USART_ParitySelection = USART_PARITY_CONTROL_DISABLE,
+    .USART_StopBits = USART_STOPBITS_1,
+    .USART_Wakeup = USART_WAKEUP_ADDRESS_MARK,
+    .USART_Address = BENCH_MUTE_ADDRESS
+  }
+};
+
+static const char* const BenchApiNames[_BENCH_API_NUM] = {"sync", "interrupt", "queued"};
+static const u32 BenchBaudRates[] = {115200, 460800, 1000000, 2000000};
+static u8 BenchTx[BENCH_BYTES];
+static u8 BenchRx[BENCH_BYTES];
+static u32 BenchRxLength;
+static volatile u32 BenchDone;
+
+static void Bench_done(const USART_Completion_t* Completion)
+{
+  (void)Completion;
+  BenchDone++;
+}
+
+/*Moves what the ring received so far to BenchRx*/
+static void Bench_drain(void)
+{
+  u16 readLength = 0;
+  u16 room = (u16)(BENCH_BYTES - BenchRxLength);
+  USART_read(USART_NUMBER_1, &BenchRx[BenchRxLength], room, &readLength);
+  BenchRxLength += readLength;
+}
+
+static void Bench_wait(void)
+{
+  USART_Emu_poll();
+  Bench_drain();
+}
+
+static void Bench_send(Bench_Api_t Api)
+{
+  USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .CB = Bench_done};
+  u32 posted = 0;
+  BenchDone = 0;
+  switch(Api)
+  {
+  case BENCH_SYNC:
+    USART_sendBlocking(USART_NUMBER_1, BenchTx, BENCH_BYTES, BENCH_TIMEOUT_US);
+    break;
+  case BENCH_INTERRUPT:
+    Req.data = BenchTx;
+    Req.length = BENCH_BYTES;
+    USART_sendBufferAsyncZC(Req);
+    while(BenchDone == 0)
+    {
+      Bench_wait();
+    }
+    break;
+  case BENCH_QUEUED:
+    while(BenchDone < (BENCH_BYTES / BENCH_CHUNK))
+    {
+      Req.data = &BenchTx[posted * BENCH_CHUNK];
+      Req.length = BENCH_CHUNK;
+      if((posted < (BENCH_BYTES / BENCH_CHUNK)) && (USART_sendBufferAsyncZC(Req) == USART_OK))
+      {
+        posted++;
+      }
+      else
+      {
+        Bench_wait();
+      }
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+static void Bench_run(Bench_Api_t Api, u32 BaudRate)
+{
+  USART_EmuStats_t stats;
+  u32 start = 0;
+  u32 cycles = 0;
+  u32 idx = 0;
+  boolean received = FALSE;
+  BenchRxLength = 0;
+  memset(BenchRx, 0, sizeof(BenchRx));
+  /*The sync API can't drain the ring while it blocks, its run sends to an open line*/
+  USART_Emu_setLoopback(USART_NUMBER_1, (Api == BENCH_SYNC) ? FALSE : TRUE);
+  if(Api != BENCH_SYNC)
+  {
+    USART_startContinuousRx(USART_NUMBER_1);
+  }
+  USART_Emu_resetStats(USART_NUMBER_1);
+
+  start = DWT_getCycles();
+  Bench_send(Api);
+  cycles = DWT_getCycles() - start;
+
+  if(Api != BENCH_SYNC)
+  {
+    /*The last character comes back at the end of its stop bit*/
+    for(idx = 0; (idx < 1000000) && (BenchRxLength < BENCH_BYTES); idx++)
+    {
+      Bench_wait();
+    }
+    received = ((BenchRxLength == BENCH_BYTES) && (memcmp(BenchTx, BenchRx, BENCH_BYTES) == 0)) ? TRUE : FALSE;
+    USART_stopContinuousRx(USART_NUMBER_1);
+  }
+  USART_Emu_getStats(USART_NUMBER_1, &stats);
+  printf("%-9s %7lu %9lu %9lu %6lu %8lu %8lu %s\n", BenchApiNames[Api], (unsigned long)BaudRate,
+         (unsigned long)(BaudRate / 10),
+         (unsigned long)((cycles == 0) ? 0 : ((u64)BENCH_BYTES * DWT_CPU_CLK) / cycles),
+         (unsigned long)stats.interrupts,
+         (unsigned long)((stats.interrupts == 0) ? 0 : (stats.latencyTotalNs / stats.interrupts)),
+         (unsigned long)stats.latencyMaxNs,
+         (Api == BENCH_SYNC) ? "-" : ((received == TRUE) ? "ok" : "FAIL"));
+}
+
+/*Puts the bus traffic on the RX line, waits for the last character and returns the receive interrupts*/
+static u32 Bench_muteRun(boolean Mute)
+{
+  static u16 traffic[BENCH_MUTE_CHARS];
+  USART_EmuStats_t stats;
+  u32 frame = 0;
+  u32 byte = 0;
+  u32 idx = 0;
+  for(frame = 0; frame < BENCH_MUTE_FRAMES; frame++)
+  {
+    traffic[frame * (BENCH_MUTE_DATA + 1)] = (u16)((frame % BENCH_MUTE_NODES) | ((Mute == TRUE) ? BENCH_MUTE_MARK : 0));
+    for(byte = 0; byte < BENCH_MUTE_DATA; byte++)
+    {
+      traffic[(frame * (BENCH_MUTE_DATA + 1)) + 1 + byte] = (u16)(((frame * 7) + byte) & 0x7F);
+    }
+  }
+  BenchRxLength = 0;
+  USART_startContinuousRx(USART_NUMBER_1);
+  if(Mute == TRUE)
+  {
+    USART_enterMute(USART_NUMBER_1);
+  }
+  USART_Emu_resetStats(USART_NUMBER_1);
+  USART_Emu_sendToRx(USART_NUMBER_1, traffic, BENCH_MUTE_CHARS);
+  do
+  {
+    Bench_wait();
+    USART_Emu_getStats(USART_NUMBER_1, &stats);
+    idx++;
+  }while((stats.rxCharacters < BENCH_MUTE_CHARS) && (idx < 10000000));
+  Bench_wait();
+  USART_stopContinuousRx(USART_NUMBER_1);
+  return stats.interrupts;
+}
+
+/*The muted node must receive exactly its frames, address character included*/
+static boolean Bench_muteCheck(void)
+{
+  boolean received = (BenchRxLength == ((BENCH_MUTE_FRAMES / BENCH_MUTE_NODES) * (BENCH_MUTE_DATA + 1))) ? TRUE : FALSE;
+  u32 frame = 0;
+  u32 byte = 0;
+  u32 idx = 0;
+  for(frame = BENCH_MUTE_ADDRESS; (frame < BENCH_MUTE_FRAMES) && (received == TRUE); frame += BENCH_MUTE_NODES)
+  {
+    received = (BenchRx[idx++] == (BENCH_MUTE_MARK | BENCH_MUTE_ADDRESS)) ? TRUE : FALSE;
+    for(byte = 0; byte < BENCH_MUTE_DATA; byte++)
+    {
+      received = ((received == TRUE) && (BenchRx[idx++] == (((frame * 7) + byte) & 0x7F))) ? TRUE : FALSE;
+    }
+  }
+  return received;
+}
+
+static void Bench_mute(void)
+{
+  u32 unmuted = 0;
+  u32 muted = 0;
+  USART_Emu_setLoopback(USART_NUMBER_1, FALSE);
+  USART_setBaudRate(USART_NUMBER_1, USART_Cfg[USART1].USART_BaudRate);
+  unmuted = Bench_muteRun(FALSE);
+  muted = Bench_muteRun(TRUE);
+  printf("mute: rx interrupts for %d frames on %d nodes, unmuted %lu, address mark %lu, own frames %s\n",
+         BENCH_MUTE_FRAMES, BENCH_MUTE_NODES, (unsigned long)unmuted, (unsigned long)muted,
+         (Bench_muteCheck() == TRUE) ? "ok" : "FAIL");
+}
+
+/*Echoes what the pty sends, until the process is stopped*/
+static void Bench_echo(void)
+{
+  static u8 echo[2][BENCH_ECHO_SIZE];
+  USART_Req_t Req = {.USART_Number = USART_NUMBER_1, .CB = Bench_done};
+  u16 readLength = 0;
+  u8 current = 0;
+  USART_startContinuousRx(USART_NUMBER_1);
+  BenchDone = 1;
+  while(1)
+  {
+    USART_Emu_poll();
+    if(BenchDone != 0)
+    {
+      USART_read(USART_NUMBER_1, echo[current], BENCH_ECHO_SIZE, &readLength);
+      if(readLength != 0)
+      {
+        BenchDone = 0;
+        Req.data = echo[current];
+        Req.length = readLength;
+        USART_sendBufferAsyncZC(Req);
+        current ^= 1;
+      }
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  char ptyName[BENCH_PTY_NAME_SIZE];
+  u32 idx = 0;
+  u8 api = 0;
+  for(idx = 0; idx < BENCH_BYTES; idx++)
+  {
+    BenchTx[idx] = (u8)(((idx * 7) + (idx >> 8)) & 0x7F);
+  }
+  USART_Emu_init();
+  DWT_init();
+  USART_init();
+
+  if((argc > 1) && (strcmp(argv[1], "--pty") == 0))
+  {
+    if(USART_Emu_openPty(USART_NUMBER_1, ptyName, sizeof(ptyName)) != USART_Emu_OK)
+    {
+      printf("pty bridge unavailable\n");
+      return 1;
+    }
+    printf("USART1 on %s at %lu baud\n", ptyName, (unsigned long)USART_Cfg[USART1].USART_BaudRate);
+    fflush(stdout);
+    Bench_echo();
+  }
+
+  printf("api          baud  ideal_Bps       Bps    isr  lat_avg  lat_max rx\n");
+  for(idx = 0; idx < (sizeof(BenchBaudRates) / sizeof(BenchBaudRates[0])); idx++)
+  {
+    if(USART_setBaudRate(USART_NUMBER_1, BenchBaudRates[idx]) == USART_OK)
+    {
+      for(api = 0; api < _BENCH_API_NUM; api++)
+      {
+        Bench_run((Bench_Api_t)api, BenchBaudRates[idx]);
+      }
+    }
+  }
+  Bench_mute();
+  return 0;
+}